@@ -4,9 +4,11 @@
 #include "inventoryitem.h"
 
 #include "globalhelpers.h"
+#include "mappedfile.h"
 #include "platforms/windows_specific.h"
 
 #include <QDirIterator>
+#include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
 
@@ -15,6 +17,9 @@ AdvancementTabDock::AdvancementTabDock(QWidget *parent) :
     ui->setupUi(this);
     hide();
 
+    // Only one load runs at a time
+    m_loader.setMaxThreadCount(1);
+
     connect(this, &QDockWidget::visibilityChanged, this,
             [this](const bool visible) {
         if (visible && m_pendingLoad) {
@@ -32,10 +37,112 @@ AdvancementTabDock::AdvancementTabDock(QWidget *parent) :
 }
 
 AdvancementTabDock::~AdvancementTabDock() {
+    m_isCanceled.storeRelaxed(1);
+    m_loader.waitForDone();
     delete ui;
 }
 
+/*!
+ * \brief Reloads the advancements of the current datapack.
+ *
+ * The datapack is scanned and the advancement files are read on worker
+ * threads. Files which haven't been modified since the last load aren't read
+ * again. Only the tabs are built on the GUI thread once all files are read.
+ */
 void AdvancementTabDock::loadAdvancements() {
+    if (isHidden()) {
+        m_pendingLoad = true;
+        return;
+    }
+    if (m_isLoading) {
+        m_reloadQueued = true;
+        return;
+    }
+
+    m_isLoading = true;
+    ui->reloadBtn->setEnabled(false);
+
+    m_loader.start([this, dirPath = QDir::currentPath(), cache = m_files]() {
+        auto &&files = readAdvancements(dirPath, cache, m_isCanceled);
+        if (m_isCanceled.loadRelaxed()) {
+            return;
+        }
+        QMetaObject::invokeMethod(this, [this, files = std::move(files)]() {
+            m_files     = files;
+            m_isLoading = false;
+            ui->reloadBtn->setEnabled(true);
+            populateTabs(m_files);
+            if (m_reloadQueued) {
+                m_reloadQueued = false;
+                loadAdvancements();
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+/*!
+ * \brief Finds the advancement files in \a dirPath and reads them on all
+ * cores. The files whose modification time and size match their entries in
+ * the \a cache are reused as is.
+ */
+AdvancementTabDock::AdvancementFiles AdvancementTabDock::readAdvancements(
+    const QString &dirPath, const AdvancementFiles &cache,
+    const QAtomicInt &isCanceled) {
+    AdvancementFiles files;
+    QStringList      changedPaths;
+
+    QDirIterator it(dirPath, { "*.json"_QL1 }, QDir::Files,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString &&path = it.next();
+        if (Glhp::pathToFileType(dirPath, path) != CodeFile::Advancement) {
+            continue;
+        }
+
+        const auto &&finfo = it.fileInfo();
+        const auto &&cached = cache.constFind(path);
+        if ((cached != cache.cend())
+            && (cached->lastModified == finfo.lastModified())
+            && (cached->size == finfo.size())) {
+            files.insert(path, *cached);
+        } else {
+            changedPaths += path;
+        }
+    }
+
+    const int   fileCount = changedPaths.size();
+    QAtomicInt  nextIndex = 0;
+    QThreadPool pool;
+    const int   workerCount = qBound(0, pool.maxThreadCount(), fileCount);
+    QVector<AdvancementFiles> results(workerCount);
+    for (auto &result: results) {
+        pool.start([&result, &changedPaths, &nextIndex, &isCanceled, &dirPath,
+                    fileCount]() {
+            for (int i = nextIndex.fetchAndAddRelaxed(1); i < fileCount;
+                 i = nextIndex.fetchAndAddRelaxed(1)) {
+                if (isCanceled.loadRelaxed()) {
+                    break;
+                }
+                const QString &path = changedPaths.at(i);
+                result.insert(path, readAdvancement(dirPath, path));
+            }
+        });
+    }
+    pool.waitForDone();
+
+    for (const auto &result: qAsConst(results)) {
+        files.insert(result);
+    }
+    return files;
+}
+
+/*!
+ * \brief Reads the display info of the advancement file at \a path.
+ *
+ * This function is run by worker threads.
+ */
+AdvancementTabDock::AdvancementFile AdvancementTabDock::readAdvancement(
+    const QString &dirPath, const QString &path) {
     const static QMap<QString,
                       AdvancemDisplayInfo::FrameType> stringToFrameType = {
         { "task",      AdvancemDisplayInfo::FrameType::Task      },
@@ -43,95 +150,82 @@ void AdvancementTabDock::loadAdvancements() {
         { "challenge", AdvancemDisplayInfo::FrameType::Challenge },
     };
 
-    if (isHidden()) {
-        m_pendingLoad = true;
-        return;
-    }
-
-#ifndef QT_NO_CURSOR
-    QGuiApplication::setOverrideCursor(Qt::WaitCursor);
-#endif
+    AdvancementFile advancem;
+    QJsonObject     obj;
 
-    // Read all showable advancements
+    if (const MappedFile file(path); file.isOpen()) {
+        const QFileInfo finfo(path);
+        advancem.lastModified = finfo.lastModified();
+        advancem.size         = finfo.size();
 
-    QDir          &&dir     = QDir::current();
-    const QString &&dirPath = dir.path();
+        const auto &&doc = QJsonDocument::fromJson(file.bytes());
+        if (!doc.isNull() && doc.isObject()) {
+            obj = doc.object();
+        }
+    }
+    if (obj.isEmpty() || !obj.contains("display")) {
+        return advancem;
+    }
 
-    dir.setFilter(QDir::AllEntries | QDir::NoDotAndDotDot);
-    dir.setNameFilters({ "*.json"_QL1 });
+    advancem.id = Glhp::toNamespacedID(dirPath, path);
 
-    QDirIterator it(dir, QDirIterator::Subdirectories);
+    const auto &&display = obj["display"].toObject();
+    if (display.contains("icon")) {
+        const auto &&icon = display["icon"].toObject();
+        if (icon.contains("item")) {
+            advancem.iconItem = icon["item"].toString();
+            if (advancem.iconItem.isEmpty()) {
+                qWarning() << "No item in" << advancem.id;
+                return advancem;
+            }
+        }
+    }
+    if (display.contains("title")) {
+        advancem.title = display["title"];
+    } else {
+        qWarning() << "No title in" << advancem.id;
+        return advancem;
+    }
+    if (display.contains("description")) {
+        advancem.description = display["description"];
+    } else {
+        qWarning() << "No description in" << advancem.id;
+        return advancem;
+    }
+    advancem.backgroundPath = display.value("background").toString();
+    advancem.frameType      = stringToFrameType.value(
+        display.value("frame").toString("task"));
+    advancem.hidden = display.value("hidden").toBool();
+    advancem.parent = obj.value("parent").toString();
+    if (!obj.contains("criteria")) {
+        qWarning() << "No criteria in" << advancem.id;
+        return advancem;
+    }
+    advancem.isShowable = true;
+    return advancem;
+}
 
+void AdvancementTabDock::populateTabs(const AdvancementFiles &files) {
     std::map<QString, AdvancemDisplayInfo> advancements;
     QVector<QString>                       rootAdvancements;
-    while (it.hasNext()) {
-        const QString &&path = it.next();
 
-        const auto &&finfo = it.fileInfo();
-        if (finfo.isFile()) {
-            if (Glhp::pathToFileType(dirPath, path) == CodeFile::Advancement) {
-                QJsonObject obj;
-                QFile       file(path);
-                if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                    const QByteArray &&data = file.readAll();
-                    const auto       &&doc  = QJsonDocument::fromJson(data);
-                    if (!doc.isNull() && doc.isObject()) {
-                        obj = doc.object();
-                    }
-                    file.close();
-                }
-                if (!obj.isEmpty()) {
-                    AdvancemDisplayInfo advancemInfo;
-                    if (obj.contains("display")) {
-                        const auto &&display = obj["display"].toObject();
-                        if (display.contains("icon")) {
-                            const auto &&icon = display["icon"].toObject();
-                            if (icon.contains("item")) {
-                                const auto &&item = icon["item"].toString();
-                                if (!item.isEmpty()) {
-                                    advancemInfo.displayIcon =
-                                        InventoryItem{ item }.getPixmap();
-                                } else {
-                                    qWarning() << "No item in" <<
-                                        Glhp::toNamespacedID(dirPath, path);
-                                    continue;
-                                }
-                            }
-                        }
-                        if (display.contains("title")) {
-                            advancemInfo.title = display["title"];
-                        } else {
-                            qWarning() << "No title in" << Glhp::toNamespacedID(
-                                dirPath, path);
-                            continue;
-                        }
-                        if (display.contains("description")) {
-                            advancemInfo.description = display["description"];
-                        } else {
-                            qWarning() << "No description in" <<
-                                Glhp::toNamespacedID(dirPath, path);
-                            continue;
-                        }
-                        advancemInfo.backgroundPath =
-                            display.value("background").toString();
-                        advancemInfo.frameType =
-                            stringToFrameType.value(
-                                display.value("frame").toString("task"));
-                        advancemInfo.hidden = display.value("hidden").toBool();
-                    } else {
-                        continue;
-                    }
-                    advancemInfo.parent = obj.value("parent").toString();
-                    if (!obj.contains("criteria")) {
-                        qWarning() << "No criteria in" << Glhp::toNamespacedID(
-                            dirPath, path);
-                        continue;
-                    }
-                    const auto &&id = Glhp::toNamespacedID(dirPath, path);
-                    advancements[id] = std::move(advancemInfo);
-                }
-            }
+    for (const auto &file: files) {
+        if (!file.isShowable) {
+            continue;
         }
+
+        AdvancemDisplayInfo advancemInfo;
+        if (!file.iconItem.isEmpty()) {
+            advancemInfo.displayIcon =
+                InventoryItem{ file.iconItem }.getPixmap();
+        }
+        advancemInfo.title          = file.title;
+        advancemInfo.description    = file.description;
+        advancemInfo.backgroundPath = file.backgroundPath;
+        advancemInfo.frameType      = file.frameType;
+        advancemInfo.hidden         = file.hidden;
+        advancemInfo.parent         = file.parent;
+        advancements[file.id]       = std::move(advancemInfo);
     }
 
     // Build advancement trees from the list
@@ -175,10 +269,6 @@ void AdvancementTabDock::loadAdvancements() {
             ++it;
         }
     }
-
-#ifndef QT_NO_CURSOR
-    QGuiApplication::restoreOverrideCursor();
-#endif
 }
 
 void AdvancementTabDock::changeEvent(QEvent *e) {
@@ -3,8 +3,11 @@
 
 #include "advancementtab.h"
 
+#include <QAtomicInt>
+#include <QDateTime>
 #include <QDockWidget>
 #include <QJsonValue>
+#include <QThreadPool>
 
 namespace Ui {
     class AdvancementTabDock;
@@ -13,6 +16,29 @@ namespace Ui {
 class AdvancementTabDock : public QDockWidget {
     Q_OBJECT
 
+    /*!
+     * \brief The display info read from an advancement file, which is kept
+     * until the file is modified.
+     *
+     * It holds the ID of the icon instead of its pixmap, since pixmaps can
+     * only be created on the GUI thread.
+     */
+    struct AdvancementFile {
+        QDateTime                      lastModified;
+        qint64                         size = -1;
+        QString                        id;
+        QString                        iconItem;
+        QJsonValue                     title;
+        QJsonValue                     description;
+        QString                        backgroundPath;
+        QString                        parent;
+        AdvancemDisplayInfo::FrameType frameType =
+            AdvancemDisplayInfo::FrameType::Task;
+        bool                           hidden     = false;
+        bool                           isShowable = false;
+    };
+    using AdvancementFiles = QHash<QString, AdvancementFile>; // By file path
+
 public:
     explicit AdvancementTabDock(QWidget *parent = nullptr);
     ~AdvancementTabDock();
@@ -29,7 +55,19 @@ private:
     Ui::AdvancementTabDock *ui;
 
     QMap<QString, AdvancementTab *> m_tabs;
-    bool m_pendingLoad = false;
+    AdvancementFiles m_files;
+    QThreadPool m_loader;
+    QAtomicInt m_isCanceled = 0;
+    bool m_pendingLoad      = false;
+    bool m_isLoading        = false;
+    bool m_reloadQueued     = false;
+
+    static AdvancementFiles readAdvancements(const QString &dirPath,
+                                             const AdvancementFiles &cache,
+                                             const QAtomicInt &isCanceled);
+    static AdvancementFile readAdvancement(const QString &dirPath,
+                                           const QString &path);
+    void populateTabs(const AdvancementFiles &files);
 };
 
 #endif // ADVANCEMENTTABDOCK_H
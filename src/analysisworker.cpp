@@ -0,0 +1,343 @@
+#include "analysisworker.h"
+
+#include "codepalette.h"
+#include "game.h"
+#include "parsers/command/mcfunctionparser.h"
+#include "parsers/jsonparser.h"
+#include "parsers/jsonvalidator.h"
+#include "parsers/command/visitors/nodeformatter.h"
+#include "parsers/command/visitors/semanticvalidator.h"
+
+/*!
+ * \brief Merges a subsequent change, which is relative to the text after this
+ * change, so that this change covers both of them.
+ */
+void TextChange::merge(const int position, const int removed,
+                       const int added) {
+    if (!isValid()) {
+        pos          = position;
+        charsRemoved = removed;
+        charsAdded   = added;
+        return;
+    }
+
+    const int start = qMin(pos, position);
+    const int end   = qMax(pos + charsAdded, position + removed);
+
+    charsRemoved = end - (charsAdded - charsRemoved) - start;
+    charsAdded   = end + (added - removed) - start;
+    pos          = start;
+}
+
+void TextChange::merge(const TextChange &other) {
+    if (other.isValid()) {
+        merge(other.pos, other.charsRemoved, other.charsAdded);
+    }
+}
+
+/*!
+ * \class AnalysisWorker
+ * \brief Parses the text of an editor, formats its syntax tree and checks
+ * the IDs in it in the thread the worker lives in.
+ *
+ * Each request carries a revision number. A request is skipped if a newer one
+ * has been made before it starts, and the parser abandons the current parse
+ * as soon as a newer request is made. Results are posted back through
+ * the finished() signal.
+ */
+
+AnalysisWorker::AnalysisWorker(std::unique_ptr<Parser> parser)
+    : m_parser(std::move(parser)),
+    m_palette(std::make_unique<CodePalette>(defaultCodePalette)) {
+    qRegisterMetaType<AnalysisWorker::Result>();
+
+    m_parser->setCancellationCheck([this]() {
+        return m_latestRevision.loadRelaxed() != m_revision;
+    });
+}
+
+AnalysisWorker::~AnalysisWorker() {
+}
+
+/*!
+ * \brief Requests an analysis of the \a text of the given \a revision,
+ * where \a change is the change from the text of the previous request.
+ * An invalid \a change causes the whole text to be parsed.
+ *
+ * This method can be called from any thread.
+ */
+void AnalysisWorker::analyze(const int revision, const QString &text,
+                             const TextChange &change) {
+    m_latestRevision.storeRelaxed(revision);
+    QMetaObject::invokeMethod(this, [this, revision, text, change]() {
+        run(revision, text, change);
+    }, Qt::QueuedConnection);
+}
+
+/*!
+ * \brief Sets the palette used to format the syntax tree.
+ *
+ * This method can be called from any thread.
+ */
+void AnalysisWorker::setPalette(const CodePalette &palette) {
+    QMetaObject::invokeMethod(this, [this, palette]() {
+        m_palette = std::make_unique<CodePalette>(palette);
+        m_formattedLines.clear();
+        m_lineFormats.clear();
+    }, Qt::QueuedConnection);
+}
+
+/*!
+ * \brief Sets whether the IDs of commands are checked against the game and
+ * the datapack after parsing. They are checked by default.
+ *
+ * This method can be called from any thread.
+ */
+void AnalysisWorker::setValidatesIds(const bool validates) {
+    QMetaObject::invokeMethod(this, [this, validates]() {
+        m_validatesIds = validates;
+        m_validatedLines.clear();
+        m_lineProblems.clear();
+    }, Qt::QueuedConnection);
+}
+
+/*!
+ * \brief Sets the type of the analyzed file, which selects the schema that
+ * JSON documents are checked against.
+ *
+ * This method can be called from any thread.
+ */
+void AnalysisWorker::setFileType(const CodeFile::FileType fileType) {
+    QMetaObject::invokeMethod(this, [this, fileType]() {
+        m_fileType = fileType;
+    }, Qt::QueuedConnection);
+}
+
+/*!
+ * \brief Abandons the current and pending requests.
+ */
+void AnalysisWorker::cancel() {
+    m_latestRevision.storeRelaxed(-1);
+}
+
+void AnalysisWorker::run(const int revision, const QString &text,
+                         const TextChange &change) {
+    // Accumulate the changes since the last finished parse
+    if (change.isValid()) {
+        m_pendingChange.merge(change);
+    } else {
+        m_needsFullParse = true;
+    }
+
+    if (revision != m_latestRevision.loadRelaxed()) {
+        return;
+    }
+    m_revision = revision;
+
+    auto *mcfParser = dynamic_cast<Command::McfunctionParser *>(m_parser.get());
+    auto *jsonParser      = dynamic_cast<JsonParser *>(m_parser.get());
+    const bool canReparse = !m_needsFullParse && m_pendingChange.isValid();
+    bool       ok;
+    if (mcfParser && canReparse) {
+        ok = mcfParser->reparse(text, m_pendingChange.pos,
+                                m_pendingChange.charsRemoved,
+                                m_pendingChange.charsAdded);
+    } else if (jsonParser && canReparse) {
+        ok = jsonParser->reparse(text, m_pendingChange.pos,
+                                 m_pendingChange.charsRemoved,
+                                 m_pendingChange.charsAdded);
+    } else {
+        ok = m_parser->parse(text);
+    }
+    if (m_parser->wasCancelled()) {
+        return;
+    }
+    m_pendingChange  = TextChange();
+    m_needsFullParse = false;
+
+    Result result;
+    result.revision = revision;
+    result.ok       = ok;
+    result.errors   = m_parser->errors();
+    if (mcfParser) {
+        const auto &&tree = mcfParser->syntaxTree();
+        // The parser keeps modifying its tree in place, so post a copy of it.
+        result.syntaxTree = QSharedPointer<Command::FileNode>::create(*tree);
+        result.formats    = formatLines(tree.get());
+        if (m_validatesIds) {
+            result.warnings = validateLines(tree.get(), text);
+        }
+    } else if (jsonParser) {
+        // The nodes are immutable, so the tree can be shared between threads
+        result.jsonTree = jsonParser->syntaxTree();
+        result.formats  = formatJsonLines(result.jsonTree, text);
+
+        const auto &&schema = Json::Schema::forVersion(Game::versionString());
+        result.warnings = Json::SchemaValidator(schema).validate(
+            result.jsonTree, text, m_fileType);
+    }
+    emit finished(result);
+}
+
+/*!
+ * \brief Returns the format ranges of each line of the \a tree.
+ * Lines whose nodes were also in the previous tree are not formatted again.
+ */
+QVector<AnalysisWorker::FormatRanges> AnalysisWorker::formatLines(
+    const Command::FileNode *tree) {
+    QHash<const Command::ParseNode *, int> formattedIndexes;
+
+    formattedIndexes.reserve(m_formattedLines.size());
+    for (int i = 0; i < m_formattedLines.size(); ++i) {
+        formattedIndexes.insert(m_formattedLines.at(i).get(), i);
+    }
+
+    const auto &&lines = tree->lines();
+    QVector<FormatRanges>  formats(lines.size());
+    Command::NodeFormatter formatter(*m_palette);
+    for (int i = 0; i < lines.size(); ++i) {
+        auto *line = lines.at(i).get();
+        if (line->kind() != Command::ParseNode::Kind::Root) {
+            continue;
+        }
+        if (const auto &&it = formattedIndexes.constFind(line);
+            it != formattedIndexes.cend()) {
+            formats[i] = m_lineFormats.at(*it);
+        } else {
+            formatter.startVisiting(line);
+            formats[i] = formatter.formatRanges();
+            formatter.reset();
+        }
+    }
+
+    m_formattedLines = lines;
+    m_lineFormats    = formats;
+    return formats;
+}
+
+/*!
+ * \brief Returns the format ranges of each line of the JSON \a tree parsed
+ * from the \a text. Keys are distinguished from other strings.
+ */
+QVector<AnalysisWorker::FormatRanges> AnalysisWorker::formatJsonLines(
+    const Json::NodePtr &tree, const QString &text) const {
+    using Json::Node;
+
+    QVector<FormatRanges> formats(text.count('\n') + 1);
+    int                   line      = 0;
+    int                   lineStart = 0;
+
+    // Tokens don't span lines since strings end at line breaks
+    auto &&addRange = [&](const int pos, const int length,
+                          const CodePalette::Role role) {
+        while (true) {
+            const int lineEnd = text.indexOf('\n', lineStart);
+            if ((lineEnd == -1) || (pos <= lineEnd)) {
+                break;
+            }
+            ++line;
+            lineStart = lineEnd + 1;
+        }
+        formats[line] << QTextLayout::FormatRange{ pos - lineStart, length,
+                                                   (*m_palette)[role] };
+    };
+
+    std::function<void(const Node *, int, bool)> visit =
+        [&](const Node *node, const int pos, const bool isKey) {
+        switch (node->kind()) {
+            case Node::Kind::String: {
+                addRange(pos, node->length(),
+                         isKey ? CodePalette::Key : CodePalette::QuotedString);
+                break;
+            }
+            case Node::Kind::Number: {
+                addRange(pos, node->length(), CodePalette::Number);
+                break;
+            }
+            case Node::Kind::True:
+            case Node::Kind::False:
+            case Node::Kind::Null: {
+                addRange(pos, node->length(), CodePalette::Keyword);
+                break;
+            }
+            default: {
+                const bool  isMember = node->kind() == Node::Kind::Member;
+                const auto &children = node->children();
+                for (int i = 0; i < children.size(); ++i) {
+                    const auto &child = children.at(i);
+                    visit(child.node.get(), pos + child.offset,
+                          isMember && (i == 0));
+                }
+            }
+        }
+    };
+
+    if (tree) {
+        visit(tree.get(), 0, false);
+    }
+    return formats;
+}
+
+/*!
+ * \brief Returns the unknown IDs in the lines of the \a tree parsed from
+ * the \a text, with physical positions.
+ * Lines whose nodes were also in the previous tree are not checked again,
+ * unless the game version or the datapack has changed since then.
+ */
+Parser::Errors AnalysisWorker::validateLines(Command::FileNode *tree,
+                                             const QString &text) {
+    using Command::SemanticValidator;
+
+    const QString &&dataKey = SemanticValidator::dataKey();
+    QHash<const Command::ParseNode *, int> validatedIndexes;
+
+    if (dataKey == m_validationDataKey) {
+        validatedIndexes.reserve(m_validatedLines.size());
+        for (int i = 0; i < m_validatedLines.size(); ++i) {
+            validatedIndexes.insert(m_validatedLines.at(i).get(), i);
+        }
+    }
+
+    QVector<int> physLineStarts{ 0 };
+    for (int i = text.indexOf('\n'); i != -1; i = text.indexOf('\n', i + 1)) {
+        physLineStarts << i + 1;
+    }
+
+    const auto &mapper = tree->sourceMapper();
+    const auto &&lines = tree->lines();
+    QVector<Parser::Errors> lineProblems(lines.size());
+    Parser::Errors          problems;
+    SemanticValidator       validator;
+    for (int i = 0; i < lines.size(); ++i) {
+        auto *line = lines.at(i).get();
+        if (line->kind() != Command::ParseNode::Kind::Root) {
+            continue;
+        }
+        if (const auto &&it = validatedIndexes.constFind(line);
+            it != validatedIndexes.cend()) {
+            lineProblems[i] = m_lineProblems.at(*it);
+        } else {
+            validator.startVisiting(line);
+            lineProblems[i] = validator.problems();
+            validator.reset();
+        }
+
+        const int physLine = mapper.logicalLines.value(i, i);
+        if (lineProblems[i].isEmpty()
+            || (physLine >= physLineStarts.size())) {
+            continue;
+        }
+        // Positions of the validator are relative to the line
+        const int lineStart = mapper.logicalPosOf(physLineStarts[physLine]);
+        for (auto problem: qAsConst(lineProblems[i])) {
+            problem.pos += lineStart;
+            problems << std::move(problem);
+        }
+    }
+    Command::McfunctionParser::mapErrorsToPhysical(problems, mapper);
+
+    m_validatedLines    = lines;
+    m_lineProblems      = lineProblems;
+    m_validationDataKey = dataKey;
+    return problems;
+}
@@ -0,0 +1,94 @@
+#ifndef ANALYSISWORKER_H
+#define ANALYSISWORKER_H
+
+#include "codefile.h"
+#include "parsers/parser.h"
+#include "parsers/jsonnode.h"
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QTextLayout>
+
+#include <memory>
+
+class CodePalette;
+
+namespace Command {
+    class FileNode;
+    class ParseNode;
+}
+
+/*!
+ * \brief Describes a range of a text which has been replaced, in the same way
+ * as QTextDocument::contentsChange().
+ */
+struct TextChange {
+    int pos          = -1;
+    int charsRemoved = 0;
+    int charsAdded   = 0;
+
+    bool isValid() const {
+        return pos != -1;
+    }
+
+    void merge(const int position, const int removed, const int added);
+    void merge(const TextChange &other);
+};
+
+class AnalysisWorker : public QObject {
+    Q_OBJECT
+
+public:
+    using FormatRanges = QVector<QTextLayout::FormatRange>;
+
+    struct Result {
+        QSharedPointer<Command::FileNode> syntaxTree;
+        Json::NodePtr jsonTree;
+        Parser::Errors errors;
+        Parser::Errors warnings; // Unknown IDs and schema violations
+        // Indexes are logical line numbers, which are the physical ones
+        // in JSON documents
+        QVector<FormatRanges> formats;
+        int revision = 0;
+        bool ok      = false;
+    };
+
+    explicit AnalysisWorker(std::unique_ptr<Parser> parser);
+    ~AnalysisWorker();
+
+    void analyze(const int revision, const QString &text,
+                 const TextChange &change);
+    void setPalette(const CodePalette &palette);
+    void setValidatesIds(const bool validates);
+    void setFileType(const CodeFile::FileType fileType);
+    void cancel();
+
+signals:
+    void finished(const AnalysisWorker::Result &result);
+
+private:
+    std::unique_ptr<Parser> m_parser;
+    std::unique_ptr<CodePalette> m_palette;
+    QVector<QSharedPointer<Command::ParseNode> > m_formattedLines;
+    QVector<FormatRanges> m_lineFormats;
+    QVector<QSharedPointer<Command::ParseNode> > m_validatedLines;
+    QVector<Parser::Errors> m_lineProblems;
+    QString m_validationDataKey;
+    TextChange m_pendingChange;
+    QAtomicInt m_latestRevision   = 0;
+    int m_revision                = 0;
+    CodeFile::FileType m_fileType = CodeFile::Text;
+    bool m_needsFullParse         = true;
+    bool m_validatesIds           = true;
+
+    void run(const int revision, const QString &text,
+             const TextChange &change);
+    QVector<FormatRanges> formatLines(const Command::FileNode *tree);
+    QVector<FormatRanges> formatJsonLines(const Json::NodePtr &tree,
+                                          const QString &text) const;
+    Parser::Errors validateLines(Command::FileNode *tree, const QString &text);
+};
+
+Q_DECLARE_METATYPE(AnalysisWorker::Result)
+
+#endif // ANALYSISWORKER_H
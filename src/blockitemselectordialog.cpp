@@ -4,7 +4,6 @@
 #include "game.h"
 
 #include <QDebug>
-#include <QIcon>
 
 BlockItemSelectorDialog::BlockItemSelectorDialog(QWidget *parent,
                                                  SelectCategory category)
@@ -74,8 +73,6 @@ BlockItemSelectorDialog::BlockItemSelectorDialog(QWidget *parent,
 }
 
 void BlockItemSelectorDialog::setupListView() {
-    constexpr int itemPixmapSize = 32 + (3 * 2);
-
     model.setParent(ui->listView);
     filterModel.setSourceModel(&model);
     filterModel.setFilterCaseSensitivity(Qt::CaseInsensitive);
@@ -84,43 +81,48 @@ void BlockItemSelectorDialog::setupListView() {
     const auto &&MCRItemInfo  = Game::getInfo(QStringLiteral("item"));
     const auto &&MCRBlockInfo = Game::getInfo(QStringLiteral("block"));
 
-    auto blockIter = MCRBlockInfo.constBegin();
-    auto itemIter  = (m_category == SelectCategory::Blocks)
-                        ? MCRItemInfo.constEnd() : MCRItemInfo.constBegin();
-    while ((blockIter != MCRBlockInfo.constEnd())
-           || (itemIter != MCRItemInfo.constEnd())) {
-        const auto &blockIterVal = blockIter.value();
-        if ((blockIterVal.type() == QVariant::Map)
-            && (blockIterVal.toMap().contains(QStringLiteral("unobtainable"))))
+    /* Only the IDs, names and kinds are collected here, like
+     * InventoryItem does. The items and their icons are created by the model
+     * when the rows are shown. */
+    using Entry = InventoryItemModel::Entry;
+    const auto &&nameOf = [](const QVariant &info) {
+        return info.toMap().value(QStringLiteral("name")).toString();
+    };
+
+    QVector<Entry> entries;
+    entries.reserve(MCRBlockInfo.size() + MCRItemInfo.size());
+    for (auto it = MCRBlockInfo.constBegin(); it != MCRBlockInfo.constEnd();
+         ++it) {
+        const auto &blockIterVal   = it.value();
+        const bool  isUnobtainable = (blockIterVal.type() == QVariant::Map)
+                                     && blockIterVal.toMap().contains(
+            QStringLiteral("unobtainable"));
+        if ((m_category == SelectCategory::ObtainableItems) && isUnobtainable)
         {
-            if (m_category == SelectCategory::ObtainableItems) {
-                /* This block doesn't have a item form and
-                 * the selectCategory is ObtainableItems,
-                 * so this block will be skipped. */
-                if ((blockIter != MCRBlockInfo.constEnd())) {
-                    ++blockIter;
-                } else {
-                    ++itemIter;
-                }
-                continue;
-            }
+            /* This block doesn't have a item form and
+             * the selectCategory is ObtainableItems,
+             * so this block will be skipped. */
+            continue;
+        }
+
+        const QString &&id = QStringLiteral("minecraft:") + it.key();
+        if (MCRItemInfo.contains(it.key())) {
+            entries << Entry{ id, nameOf(MCRItemInfo.value(it.key())),
+                              InventoryItem::Item };
+        } else {
+            entries << Entry{ id, nameOf(blockIterVal),
+                              isUnobtainable ? InventoryItem::Block
+                                             : InventoryItem::BlockItem };
+        }
+    }
+    if (m_category != SelectCategory::Blocks) {
+        for (auto it = MCRItemInfo.constBegin(); it != MCRItemInfo.constEnd();
+             ++it) {
+            entries << Entry{ QStringLiteral("minecraft:") + it.key(),
+                              nameOf(it.value()), InventoryItem::Item };
         }
-        const QString &key = (blockIter != MCRBlockInfo.constEnd())
-                       ? blockIter.key() : itemIter.key();
-        InventoryItem invItem(key);
-        auto         *item = new QStandardItem();
-        item->setIcon(QIcon(invItem.getPixmap()));
-        item->setSizeHint(QSize(itemPixmapSize, itemPixmapSize));
-        const QVariant &&vari = QVariant::fromValue(invItem);
-        item->setData(vari, Qt::UserRole + 1);
-        item->setToolTip(invItem.toolTip());
-        /*qDebug() << item << vari; */
-        model.appendRow(item);
-        if (blockIter != MCRBlockInfo.constEnd())
-            ++blockIter;
-        else
-            ++itemIter;
     }
+    model.setEntries(entries);
 }
 
 BlockItemSelectorDialog::~BlockItemSelectorDialog() {
@@ -134,9 +136,8 @@ QString BlockItemSelectorDialog::getSelectedID() {
 
     if (indexes.isEmpty()) return QString();
 
-    QStandardItem *item =
-        model.itemFromIndex(filterModel.mapToSource(indexes[0]));
-    auto &&invItem = item->data(Qt::UserRole + 1).value<InventoryItem>();
+    const auto &&invItem =
+        model.itemAt(filterModel.mapToSource(indexes[0]).row());
     return invItem.getNamespacedID();
 }
 
@@ -148,10 +149,7 @@ QVector<InventoryItem> BlockItemSelectorDialog::getSelectedItems() {
     if (indexes.isEmpty()) return items;
 
     for (const auto &index : qAsConst(indexes)) {
-        QStandardItem *item =
-            model.itemFromIndex(filterModel.mapToSource(index));
-        auto &&invItem =
-            item->data(Qt::UserRole + 1).value<InventoryItem>();
+        auto &&invItem = model.itemAt(filterModel.mapToSource(index).row());
         if (items.contains(invItem)) continue;
         items.push_back(invItem);
     }
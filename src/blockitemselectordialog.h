@@ -3,9 +3,9 @@
 
 #include "inventoryslot.h"
 #include "inventoryitemfiltermodel.h"
+#include "inventoryitemmodel.h"
 
 #include <QDialog>
-#include <QStandardItemModel>
 #include <QPushButton>
 
 
@@ -37,7 +37,7 @@ private slots:
 
 private:
     InventoryItemFilterModel filterModel;
-    QStandardItemModel model;
+    InventoryItemModel model;
     Ui::BlockItemSelectorDialog *ui;
     QPushButton *selectButton = nullptr;
     SelectCategory m_category = SelectCategory::ObtainableItems;
@@ -6,8 +6,13 @@
 #include "QFindDialogs/src/finddialog.h"
 #include "QFindDialogs/src/findreplacedialog.h"
 #include "stripedscrollbar.h"
+#include "mcfunctionhighlighter.h"
 #include "parsers/command/mcfunctionparser.h"
 #include "parsers/command/visitors/completionprovider.h"
+#include "parsers/command/visitors/symbolcollector.h"
+#include "parsers/jsonparser.h"
+#include "jsonhighlighter.h"
+#include "referencesmenu.h"
 #include "stringvectormodel.h"
 
 #include <QPainter>
@@ -69,6 +74,8 @@ CodeEditor::CodeEditor(QWidget *parent) : QPlainTextEdit(parent) {
             this, &CodeEditor::onUndoAvailable);
     connect(this, &QPlainTextEdit::redoAvailable,
             this, &CodeEditor::onRedoAvailable);
+    connect(document(), &QTextDocument::contentsChange,
+            this, &CodeEditor::onContentsChange);
     connect(document(), &QTextDocument::contentsChanged,
             this, &CodeEditor::onTextChanged);
 
@@ -102,6 +109,9 @@ CodeEditor::CodeEditor(QWidget *parent) : QPlainTextEdit(parent) {
 
     errorHighlightRule.setUnderlineStyle(QTextCharFormat::SpellCheckUnderline);
     errorHighlightRule.setUnderlineColor(Qt::red);
+    warningHighlightRule.setUnderlineStyle(
+        QTextCharFormat::SpellCheckUnderline);
+    warningHighlightRule.setUnderlineColor(QColor(255, 165, 0));
 
 /*
       errorHighlightRule.setBackground(QColor(255, 127, 127, 63));
@@ -113,10 +123,22 @@ CodeEditor::CodeEditor(QWidget *parent) : QPlainTextEdit(parent) {
     onCursorPositionChanged();
 }
 
+CodeEditor::~CodeEditor() {
+    if (m_analysisThread) {
+        m_analyzer->cancel();
+        m_analysisThread->quit();
+        m_analysisThread->wait();
+    }
+}
+
 void CodeEditor::setFileType(CodeFile::FileType type) {
     m_fileType = type;
 
     initCompleter();
+    if (m_analyzer) {
+        m_analyzer->setFileType(m_fileType);
+        m_analyzer->analyze(++m_revision, toPlainText(), TextChange());
+    }
 }
 
 void CodeEditor::initCompleter() {
@@ -130,7 +152,6 @@ void CodeEditor::initCompleter() {
 //        }
     }
     completer->setModel(new StringVectorModel(this));
-    completer->setModelSorting(QCompleter::CaseInsensitivelySortedModel);
     completer->setCaseSensitivity(Qt::CaseInsensitive);
     completer->setWrapAround(false);
     setCompleter(completer);
@@ -174,6 +195,13 @@ void CodeEditor::readPrefSettings() {
                         ? (option.flags() | Flag::ShowTabsAndSpaces)
                         : option.flags() & ~Flag::ShowTabsAndSpaces);
     document()->setDefaultTextOption(option);
+
+    const bool validatesIds = settings.value("validateIds", true).toBool();
+    if (m_analyzer && (validatesIds != m_validatesIds)) {
+        m_analyzer->setValidatesIds(validatesIds);
+        m_analyzer->analyze(++m_revision, toPlainText(), TextChange());
+    }
+    m_validatesIds = validatesIds;
     settings.endGroup();
 }
 
@@ -381,48 +409,47 @@ void CodeEditor::handleKeyPressEvent(QKeyEvent *e) {
 }
 
 void CodeEditor::startCompletion(const QString &completionPrefix) {
+    // Only the best candidates are listed, since typing narrows them quickly
+    constexpr int completionLimit = 200;
+
     if (m_completer->popup()->isHidden()) {
         qDebug() << "Combining final completions";
 
-        QVector<QString> completionInfo;
-        if (const auto *parser =
-                dynamic_cast<Command::McfunctionParser *>(m_parser.get())) {
+        m_completionQuery.clear();
+        if (m_syntaxTree) {
             const int curLine =
-                parser->syntaxTree()->sourceMapper().logicalLinesIndexOf(
+                m_syntaxTree->sourceMapper().logicalLinesIndexOf(
                     textCursor().blockNumber());
             if (curLine != -1) {
                 const int posInLine = textCursor().positionInBlock();
 
-                if (auto *line = parser->syntaxTree()->at(curLine).get();
+                if (auto *line = m_syntaxTree->at(curLine).get();
                     line->kind() == Command::ParseNode::Kind::Root) {
                     Command::CompletionProvider suggester{ posInLine };
                     suggester.startVisiting(line);
-                    completionInfo = suggester.suggestions();
-                    std::sort(completionInfo.begin(), completionInfo.end());
-                    completionInfo.erase(std::unique(completionInfo.begin(),
-                                                     completionInfo.end()),
-                                         completionInfo.end());
+                    m_completionQuery = suggester.query();
                 }
             }
         }
+    }
 
-        if (auto *model =
-                qobject_cast<StringVectorModel *>(m_completer->model())) {
-            m_completer->setCompletionPrefix(QString());
-            model->setVector(completionInfo);
-        }
-        //            qDebug() << minecraftCompletionInfo.size() <<
-        //                m_completer->model()->rowCount() <<
-        //                m_completer->completionModel()->rowCount();
+    // The candidates are filtered and ranked by the query, not the completer
+    const auto &&completions = m_completionQuery.complete(completionPrefix,
+                                                          completionLimit);
+    if (auto *model =
+            qobject_cast<StringVectorModel *>(m_completer->model())) {
+        model->setVector(completions);
+    }
+    m_needCompleting = false;
+    if (completions.isEmpty()) {
+        m_completer->popup()->hide();
+        return;
     }
 
     m_completer->setCompletionPrefix(completionPrefix);
     m_completer->popup()->setCurrentIndex(
         m_completer->completionModel()->index(0, 0));
 
-//    qDebug() << m_completer->completionCount() << m_completer->model() <<
-//        completionPrefix;
-
     QRect     cr = cursorRect();
     const int prefixOffset
         = fontMetrics().horizontalAdvance(completionPrefix,
@@ -431,7 +458,6 @@ void CodeEditor::startCompletion(const QString &completionPrefix) {
     cr.setWidth(m_completer->popup()->sizeHintForColumn(0)
                 + m_completer->popup()->verticalScrollBar()->sizeHint().width());
 
-    m_needCompleting = false;
     m_completer->complete(cr);       // popup it up!
 }
 
@@ -516,6 +542,54 @@ void CodeEditor::dropEvent(QDropEvent *e) {
     QPlainTextEdit::dropEvent(e);
 }
 
+/*!
+ * \brief Adds a menu of the locations of the symbol under the \a cursor,
+ * if there is one, to the \a menu.
+ */
+void CodeEditor::addReferencesMenu(QMenu *menu, const QTextCursor &cursor) {
+    if (!m_syntaxTree) {
+        return;
+    }
+
+    // Find the logical line which the physical line of the cursor belongs to
+    const auto &mapper       = m_syntaxTree->sourceMapper();
+    const auto &logicalLines = mapper.logicalLines;
+    const int   physLine     = cursor.blockNumber();
+    const int   lineIndex    = logicalLines.isEmpty()
+        ? physLine
+        : std::upper_bound(logicalLines.cbegin(), logicalLines.cend(),
+                           physLine) - logicalLines.cbegin() - 1;
+    if ((lineIndex < 0) || (lineIndex >= m_syntaxTree->size())) {
+        return;
+    }
+
+    auto *line = m_syntaxTree->at(lineIndex).get();
+    if (line->kind() != Command::ParseNode::Kind::Root) {
+        return;
+    }
+
+    const QTextBlock &&lineStart = document()->findBlockByNumber(
+        logicalLines.value(lineIndex, lineIndex));
+    const int column = mapper.logicalPosOf(cursor.position())
+                       - mapper.logicalPosOf(lineStart.position());
+
+    Command::SymbolCollector collector;
+    collector.startVisiting(line);
+    for (const auto &symbol: collector.symbols()) {
+        if ((column >= symbol.pos)
+            && (column <= symbol.pos + symbol.length)) {
+            auto *refMenu = new ReferencesMenu(
+                tr("References to %1").arg(symbol.name), QDir::currentPath(),
+                SymbolIndex::instance()->locations(symbol.kind, symbol.name),
+                menu);
+            connect(refMenu, &ReferencesMenu::locationTriggered,
+                    this, &CodeEditor::openFileWithLineRequest);
+            menu->addMenu(refMenu);
+            return;
+        }
+    }
+}
+
 void CodeEditor::contextMenuEvent(QContextMenuEvent *e) {
     QMenu *menu = createStandardContextMenu(e->pos());
 
@@ -543,6 +617,8 @@ void CodeEditor::contextMenuEvent(QContextMenuEvent *e) {
     }
     menu->addAction(formatAction);
 
+    addReferencesMenu(menu, cursorForPosition(e->pos()));
+
     /*... */
     menu->exec(e->globalPos());
     delete menu;
@@ -631,7 +707,14 @@ void CodeEditor::changeEvent(QEvent *e) {
             onCursorPositionChanged();
             if (m_highlighter->hasAdvancedHighlighting()) {
                 m_highlighter->ensureDelayedRehighlightAll();
-                m_highlighter->rehighlightDelayed();
+                if (m_analyzer) {
+                    // Format ranges are made by the analyzer
+                    m_analyzer->setPalette(m_highlighter->palette());
+                    m_analyzer->analyze(++m_revision, toPlainText(),
+                                        TextChange{ 0, 0, 0 });
+                } else {
+                    m_highlighter->rehighlightDelayed();
+                }
             } else {
                 m_highlighter->rehighlight();
             }
@@ -693,6 +776,30 @@ void CodeEditor::updateGutter(const QRect &rect, int dy) {
 
     if (rect.contains(viewport()->rect()))
         updateGutterWidth(0);
+
+    updateVisibleBlockRange();
+}
+
+/*!
+ * \brief Tells the highlighter which blocks are shown in the viewport, so
+ * that they are highlighted before the other ones.
+ */
+void CodeEditor::updateVisibleBlockRange() {
+    if (!m_highlighter)
+        return;
+
+    QTextBlock &&block = firstVisibleBlock();
+    const int    first = block.blockNumber();
+    int          last  = first;
+    int          top   = qRound(blockBoundingGeometry(block).translated(
+                                    contentOffset()).top());
+
+    while (block.isValid() && top <= viewport()->height()) {
+        last  = block.blockNumber();
+        top  += qRound(blockBoundingRect(block).height());
+        block = block.next();
+    }
+    m_highlighter->setVisibleBlockRange(first, last);
 }
 
 void CodeEditor::openFindDialog() {
@@ -905,32 +1012,88 @@ void CodeEditor::insertCompletion(const QString &completion) {
     setTextCursor(tc);
 }
 
+/*!
+ * \brief Accumulates the document changes since the last analysis request
+ * into a single edit range, so that the text can be reparsed incrementally.
+ */
+void CodeEditor::onContentsChange(int position, int charsRemoved,
+                                  int charsAdded) {
+    m_pendingChange.merge(position, charsRemoved, charsAdded);
+}
+
 void CodeEditor::onTextChanged() {
 //    qDebug() << "CodeEditor::onTextChanged";
-    if (m_parser) {
-        bool ok = m_parser->parse(toPlainText());
-        m_problems.clear();
-        if (!ok) {
-            m_problems.reserve(m_parser->errors().size());
-            for (const auto &error: qAsConst(m_parser->errors())) {
-                ProblemInfo problem{ ProblemInfo::Type::Error,
-                                     error.pos, error.length,
-                                     error.toLocalizedMessage() };
-                m_problems << std::move(problem);
-            }
-        }
-        if (m_highlighter) {
-            m_highlighter->rehighlightDelayed();
+    if (m_analyzer) {
+        m_analyzer->analyze(++m_revision, toPlainText(), m_pendingChange);
+    }
+    m_pendingChange = TextChange();
+}
+
+/*!
+ * \brief Applies the \a result of the analysis if the text hasn't been changed
+ * since it was requested.
+ */
+void CodeEditor::onAnalysisFinished(const AnalysisWorker::Result &result) {
+    if (result.revision != m_revision) {
+        return;
+    }
+
+    m_syntaxTree       = result.syntaxTree;
+    m_jsonTree         = result.jsonTree;
+    m_jsonTreeRevision = result.revision;
+    m_problems.clear();
+    if (!result.ok) {
+        m_problems.reserve(result.errors.size());
+        for (const auto &error: result.errors) {
+            ProblemInfo problem{ ProblemInfo::Type::Error,
+                                 error.pos, error.length,
+                                 error.toLocalizedMessage() };
+            m_problems << std::move(problem);
         }
-        if (m_needCompleting && m_completer) {
-            startCompletion(textUnderCursor());
+    }
+    for (const auto &warning: result.warnings) {
+        ProblemInfo problem{ ProblemInfo::Type::Warning,
+                             warning.pos, warning.length,
+                             warning.localizedDescription() };
+        m_problems << std::move(problem);
+    }
+    if (m_highlighter) {
+        if (auto *highlighter =
+                dynamic_cast<McfunctionHighlighter *>(m_highlighter)) {
+            highlighter->setAnalysisResult(result.syntaxTree, result.formats);
+        } else if (auto *highlighter =
+                       dynamic_cast<JsonHighlighter *>(m_highlighter)) {
+            highlighter->setAnalysisResult(result.formats);
         }
-        updateErrorSelections();
+        updateVisibleBlockRange();
+        m_highlighter->rehighlightDelayed();
     }
+    if (m_needCompleting && m_completer) {
+        startCompletion(textUnderCursor());
+    }
+    updateErrorSelections();
 }
 
-Parser * CodeEditor::parser() const {
-    return m_parser.get();
+/*!
+ * \brief Returns the value of the JSON document in the editor, or a null value
+ * if the document has syntax errors. The syntax tree of the background
+ * analysis is used if it's up to date, otherwise the text is parsed now.
+ */
+QJsonValue CodeEditor::jsonValue() const {
+    const QString &&text = toPlainText();
+    Json::NodePtr   tree;
+
+    if (m_jsonTree && (m_jsonTreeRevision == m_revision)) {
+        tree = m_jsonTree;
+    } else {
+        JsonParser parser;
+        parser.parse(text);
+        tree = parser.syntaxTree();
+    }
+    if (!tree || tree->hasErrors()) {
+        return QJsonValue();
+    }
+    return tree->toJsonValue(text);
 }
 
 void CodeEditor::goToLine(const int lineNo) {
@@ -941,8 +1104,45 @@ void CodeEditor::goToLine(const int lineNo) {
     centerCursor();
 }
 
+/*!
+ * \brief Sets the parser used to analyze the text in a background thread.
+ * The editor takes ownership of the parser.
+ */
 void CodeEditor::setParser(std::unique_ptr<Parser> newParser) {
-    m_parser = std::move(newParser);
+    if (m_analysisThread) {
+        m_analyzer->cancel();
+        m_analysisThread->quit();
+        m_analysisThread->wait();
+        delete m_analysisThread;
+        m_analysisThread = nullptr;
+        m_analyzer       = nullptr;
+    }
+    m_syntaxTree.reset();
+    m_jsonTree.reset();
+    m_jsonTreeRevision = -1;
+    if (!newParser) {
+        return;
+    }
+
+    m_analysisThread = new QThread(this);
+    m_analyzer       = new AnalysisWorker(std::move(newParser));
+    m_analyzer->moveToThread(m_analysisThread);
+    m_analyzer->setValidatesIds(m_validatesIds);
+    m_analyzer->setFileType(m_fileType);
+    connect(m_analysisThread, &QThread::finished,
+            m_analyzer, &QObject::deleteLater);
+    connect(m_analyzer, &AnalysisWorker::finished,
+            this, &CodeEditor::onAnalysisFinished);
+    m_analysisThread->start(QThread::LowPriority);
+
+    if (m_highlighter) {
+        m_analyzer->setPalette(m_highlighter->palette());
+        if (m_highlighter->hasAdvancedHighlighting()) {
+            m_highlighter->ensureDelayedRehighlightAll();
+        }
+    }
+    m_pendingChange = TextChange();
+    m_analyzer->analyze(++m_revision, toPlainText(), m_pendingChange);
 }
 
 Highlighter * CodeEditor::highlighter() const {
@@ -968,7 +1168,8 @@ void CodeEditor::setCompleter(QCompleter *c) {
 
     m_completer->popup()->setFont(font());
     m_completer->setWidget(this);
-    m_completer->setCompletionMode(QCompleter::PopupCompletion);
+    // The model only contains the ranked candidates for the current prefix
+    m_completer->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
     m_completer->setCaseSensitivity(Qt::CaseInsensitive);
     QObject::connect(m_completer,
                      qOverload<const QString &>(&QCompleter::activated),
@@ -990,6 +1191,9 @@ void CodeEditor::setHighlighter(Highlighter *value) {
     } else {
         m_highlighter->setPalette(defaultCodePalette);
     }
+    if (m_analyzer) {
+        m_analyzer->setPalette(m_highlighter->palette());
+    }
 }
 
 void CodeEditor::displayErrors() {
@@ -1013,7 +1217,7 @@ void CodeEditor::displayErrors() {
 void CodeEditor::updateErrorSelections() {
     /*qDebug() << "CodeEditor::updateErrorSelections"; */
     if (!isReadOnly()) {
-        if (!document() || !m_parser)
+        if (!document() || !m_analyzer)
             return;
 
         problemExtraSelections.clear();
@@ -1039,7 +1243,8 @@ void CodeEditor::updateErrorSelections() {
                 selCursor.select(QTextCursor::WordUnderCursor);
             }
             selection.cursor = selCursor;
-            selection.format = errorHighlightRule;
+            selection.format = (problem.type == ProblemInfo::Type::Warning)
+                                   ? warningHighlightRule : errorHighlightRule;
             selection.format.setToolTip(problem.message);
             problemExtraSelections << selection;
         }
@@ -1050,6 +1255,10 @@ void CodeEditor::updateErrorSelections() {
 void CodeEditor::matchParentheses() {
     /*bool match = false; */
 
+    if (matchJsonBrackets()) {
+        return;
+    }
+
     TextBlockData *data =
         dynamic_cast<TextBlockData *>(textCursor().block().userData());
 
@@ -1092,6 +1301,46 @@ void CodeEditor::matchParentheses() {
     }
 }
 
+/*!
+ * \brief Matches the brackets of the object or array next to the text cursor
+ * using the JSON syntax tree. Returns false if the tree isn't up to date,
+ * so that the brackets collected by the highlighter are used instead.
+ */
+bool CodeEditor::matchJsonBrackets() {
+    if (!m_jsonTree || (m_jsonTreeRevision != m_revision)) {
+        return false;
+    }
+
+    const int curPos = textCursor().position();
+    // The character on the right of the cursor takes precedence
+    for (const int pos: { curPos, curPos - 1 }) {
+        const auto &&nodes = Json::nodesAt(m_jsonTree, pos);
+        if (nodes.isEmpty()) {
+            continue;
+        }
+
+        const auto &located = nodes.constLast();
+        const auto  kind    = located.node->kind();
+        if (((kind != Json::Node::Kind::Object)
+             && (kind != Json::Node::Kind::Array))
+            || !located.node->isClosed()) {
+            continue;
+        }
+
+        const int  closePos = located.pos + located.node->length() - 1;
+        const bool isOpen   = pos == located.pos;
+        if (!isOpen && (pos != closePos)) {
+            continue;
+        }
+
+        const bool isPrimary = isOpen == (pos == curPos);
+        createBracketSelection(located.pos, isPrimary);
+        createBracketSelection(closePos, isPrimary);
+        break;
+    }
+    return true;
+}
+
 bool CodeEditor::matchLeftBracket(QTextBlock currentBlock,
                                   int i, char chr, char corresponder,
                                   int numLeftParentheses, bool isPrimary) {
@@ -4,18 +4,25 @@
 #include <QPlainTextEdit>
 #include <QPointer>
 #include <QSettings>
+#include <QThread>
 
+#include "analysisworker.h"
 #include "codefile.h"
-#include "parsers/parser.h"
+#include "completionindex.h"
 
 QT_BEGIN_NAMESPACE
 class QCompleter;
+class QMenu;
 QT_END_NAMESPACE
 
 class CodeGutter;
 class Highlighter;
 class Parser;
 
+namespace Command {
+    class FileNode;
+}
+
 struct ProblemInfo {
     enum class Type {
         Invalid,
@@ -36,6 +43,7 @@ public:
     using Problems = QVector<ProblemInfo>;
 
     explicit CodeEditor(QWidget *parent = nullptr);
+    ~CodeEditor();
 
     void setFileType(CodeFile::FileType type);
 
@@ -55,12 +63,14 @@ public:
     QCompleter * completer() const;
 
     void setParser(std::unique_ptr<Parser> newParser);
-    Parser * parser() const;
 
     void goToLine(const int lineNo);
 
+    QJsonValue jsonValue() const;
+
 signals:
     void openFileRequest(const QString &filepath);
+    void openFileWithLineRequest(const QString &filepath, const int lineNo);
     void updateStatusBarRequest(CodeEditor *editor);
     void showMessageRequest(const QString &msg, int timeout);
 
@@ -95,7 +105,9 @@ private /*slots*/ :
     void onUndoAvailable(bool value);
     void onRedoAvailable(bool value);
     void insertCompletion(const QString &completion);
+    void onContentsChange(int position, int charsRemoved, int charsAdded);
     void onTextChanged();
+    void onAnalysisFinished(const AnalysisWorker::Result &result);
 
 private:
     QTextCharFormat bracketSeclectFmt;
@@ -104,10 +116,17 @@ private:
     CodeGutter *m_gutter;
     QCompleter *m_completer          = nullptr;
     Highlighter *m_highlighter       = nullptr;
-    std::unique_ptr<Parser> m_parser = nullptr;
+    AnalysisWorker *m_analyzer       = nullptr;
+    QThread *m_analysisThread        = nullptr;
+    QSharedPointer<Command::FileNode> m_syntaxTree;
+    Json::NodePtr m_jsonTree;
     QList<QTextEdit::ExtraSelection> problemExtraSelections;
     Problems m_problems;
+    TextChange m_pendingChange;
+    CompletionQuery m_completionQuery;
     int problemSelectionStartIndex;
+    int m_revision                = 0;
+    int m_jsonTreeRevision        = -1;
     int m_fontSize                = 13;
     int m_tabSize                 = 4;
     CodeFile::FileType m_fileType = CodeFile::Text;
@@ -115,9 +134,12 @@ private:
     bool canRedo                  = false;
     bool m_insertTabAsSpaces      = true;
     bool m_needCompleting         = false;
+    bool m_validatesIds           = true;
 
     void highlightCurrentLine();
+    void updateVisibleBlockRange();
     void matchParentheses();
+    bool matchJsonBrackets();
     bool matchLeftBracket(QTextBlock currentBlock,
                           int i, char chr, char corresponder,
                           int numLeftParentheses, bool isPrimary);
@@ -135,6 +157,7 @@ private:
     static QString textUnderCursorExtended(QTextCursor tc);
     static void selectEnclosingLines(QTextCursor &cursor);
     void startCompletion(const QString &completionPrefix);
+    void addReferencesMenu(QMenu *menu, const QTextCursor &cursor);
 };
 
 
@@ -0,0 +1,283 @@
+#include "completionindex.h"
+
+#include <QSet>
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+    constexpr int matchScore       = 1;
+    constexpr int consecutiveBonus = 4;
+    constexpr int boundaryBonus    = 6;
+    constexpr int maxLeadingGap    = 3;
+
+    bool isWordBoundary(const QChar ch) {
+        return (ch == ':') || (ch == '/') || (ch == '_') || (ch == '.')
+               || (ch == '-') || (ch == '#');
+    }
+
+    /*!
+     * \internal
+     * \brief A fuzzy match of a candidate which isn't a prefix match.
+     */
+    struct FuzzyMatch {
+        int                    score = 0;
+        QStringView            key;
+        const CompletionIndex *index = nullptr;
+        int                    pos   = 0;
+
+        /*!
+         * \brief Returns whether this match ranks higher than \a other.
+         * Ties are broken alphabetically.
+         */
+        bool isBetterThan(const FuzzyMatch &other) const {
+            if (score != other.score) {
+                return score > other.score;
+            }
+            return key < other.key;
+        }
+    };
+}
+
+/*!
+ * \brief Constructs an index of the \a words. Duplicated words are removed.
+ */
+CompletionIndex::CompletionIndex(const QVector<QString> &words) {
+    QVector<QString> keys;
+
+    keys.reserve(words.size());
+    for (const auto &word: words) {
+        keys << word.toCaseFolded();
+    }
+
+    QVector<int> order(words.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](const int a, const int b) {
+        const int cmp = keys.at(a).compare(keys.at(b));
+        return (cmp != 0) ? (cmp < 0) : (words.at(a) < words.at(b));
+    });
+
+    m_words.reserve(words.size());
+    m_keys.reserve(words.size());
+    for (const int i: qAsConst(order)) {
+        if (!m_words.isEmpty() && (m_words.constLast() == words.at(i))) {
+            continue;
+        }
+        m_words << words.at(i);
+        m_keys << keys.at(i);
+    }
+}
+
+int CompletionIndex::size() const {
+    return m_words.size();
+}
+
+bool CompletionIndex::isEmpty() const {
+    return m_words.isEmpty();
+}
+
+QString CompletionIndex::at(const int i) const {
+    return m_words.at(i);
+}
+
+/*!
+ * \brief Returns the case-folded form of the candidate at \a i.
+ */
+QStringView CompletionIndex::keyAt(const int i) const {
+    return m_keys.at(i);
+}
+
+CompletionIndex::Range CompletionIndex::all() const {
+    return { 0, size() };
+}
+
+/*!
+ * \brief Returns the range of the candidates which start with
+ * the case-folded \a foldedPrefix.
+ */
+CompletionIndex::Range CompletionIndex::prefixRange(QStringView foldedPrefix)
+const {
+    return prefixRange(foldedPrefix, all());
+}
+
+/*!
+ * \brief Returns the range of the candidates which start with
+ * \a foldedPrefix within the range \a within, which must be the range of
+ * a prefix of \a foldedPrefix.
+ */
+CompletionIndex::Range CompletionIndex::prefixRange(QStringView foldedPrefix,
+                                                    const Range &within) const {
+    const auto begin = m_keys.cbegin() + within.begin;
+    const auto end   = m_keys.cbegin() + within.end;
+
+    const auto first = std::lower_bound(
+        begin, end, foldedPrefix, [](const QString &key, QStringView prefix) {
+        return key.compare(prefix) < 0;
+    });
+    const auto last = std::partition_point(
+        first, end, [foldedPrefix](const QString &key) {
+        return key.startsWith(foldedPrefix);
+    });
+
+    return { int(first - m_keys.cbegin()), int(last - m_keys.cbegin()) };
+}
+
+/*!
+ * \brief Returns the score of the candidate \a key if the characters of
+ * \a foldedPattern appear in it in order, or -1 if they don't.
+ *
+ * Runs of consecutive characters and characters at the start of a word
+ * (after a \c :, \c / or \c _ for instance) score higher, so \c "dsw" ranks
+ * \c "diamond_sword" above \c "deepslate_wall".
+ */
+int CompletionIndex::fuzzyScore(QStringView key, QStringView foldedPattern) {
+    if (foldedPattern.size() > key.size()) {
+        return -1;
+    }
+
+    int score     = 0;
+    int lastMatch = -2;
+    int pos       = 0;
+    for (const QChar ch: foldedPattern) {
+        while ((pos < key.size()) && (key.at(pos) != ch)) {
+            ++pos;
+        }
+        if (pos == key.size()) {
+            return -1;
+        }
+
+        score += matchScore;
+        if (pos == lastMatch + 1) {
+            score += consecutiveBonus;
+        } else if ((pos == 0) || isWordBoundary(key.at(pos - 1))) {
+            score += boundaryBonus;
+        }
+        lastMatch = pos++;
+    }
+    // Prefer matches which start near the start of the candidate
+    const int firstMatch = key.indexOf(foldedPattern.front());
+    return score - std::min(firstMatch, maxLeadingGap);
+}
+
+void CompletionQuery::addIndex(const CompletionIndexPtr &index) {
+    if (index && !index->isEmpty()) {
+        m_sources << Source{ index, index->all() };
+        m_prefix.clear();
+    }
+}
+
+void CompletionQuery::addWords(const QVector<QString> &words) {
+    if (!words.isEmpty()) {
+        addIndex(CompletionIndexPtr::create(words));
+    }
+}
+
+void CompletionQuery::clear() {
+    m_sources.clear();
+    m_prefix.clear();
+}
+
+bool CompletionQuery::isEmpty() const {
+    return m_sources.isEmpty();
+}
+
+/*!
+ * \brief Returns at most \a limit candidates of all indexes for
+ * the \a prefix.
+ *
+ * Candidates starting with the prefix come first in alphabetical order,
+ * followed by fuzzy matches from the best to the worst. If the prefix extends
+ * the prefix of the previous call, the prefix ranges are only searched within
+ * the previous ones. The candidates are never collected into a full list;
+ * fuzzy matches are only scored if there are fewer prefix matches than
+ * the \a limit, and only the best ones are kept.
+ */
+QVector<QString> CompletionQuery::complete(const QString &prefix,
+                                           const int limit) {
+    const QString &&folded    = prefix.toCaseFolded();
+    const bool      narrowing = !m_prefix.isNull() && folded.startsWith(
+        m_prefix);
+
+    for (auto &source: m_sources) {
+        source.range = source.index->prefixRange(
+            folded, narrowing ? source.range : source.index->all());
+    }
+    m_prefix = folded;
+
+    QVector<QString> results;
+    QSet<QString>    taken;
+
+    // Merge the prefix ranges of all indexes in order
+    QVector<int> positions;
+    positions.reserve(m_sources.size());
+    for (const auto &source: qAsConst(m_sources)) {
+        positions << source.range.begin;
+    }
+    while (results.size() < limit) {
+        int next = -1;
+        for (int i = 0; i < m_sources.size(); ++i) {
+            if (positions[i] >= m_sources[i].range.end) {
+                continue;
+            }
+            if ((next == -1)
+                || (m_sources[i].index->keyAt(positions[i])
+                    < m_sources[next].index->keyAt(positions[next]))) {
+                next = i;
+            }
+        }
+        if (next == -1) {
+            break;
+        }
+
+        const QString &&word = m_sources[next].index->at(positions[next]++);
+        if (!taken.contains(word)) {
+            taken.insert(word);
+            results << word;
+        }
+    }
+
+    const int fuzzyLimit = limit - results.size();
+    if ((fuzzyLimit <= 0) || folded.isEmpty()) {
+        return results;
+    }
+
+    // Keep the best fuzzy matches in a heap whose top is the worst of them
+    const auto &&isWorse = [](const FuzzyMatch &a, const FuzzyMatch &b) {
+        return a.isBetterThan(b);
+    };
+    std::vector<FuzzyMatch> heap;
+    heap.reserve(fuzzyLimit);
+    for (const auto &source: qAsConst(m_sources)) {
+        const auto *index = source.index.get();
+        for (int i = 0; i < index->size(); ++i) {
+            if (source.range.contains(i)) {
+                continue;
+            }
+            const QStringView key   = index->keyAt(i);
+            const int         score = CompletionIndex::fuzzyScore(key, folded);
+            if (score < 0) {
+                continue;
+            }
+
+            FuzzyMatch match{ score, key, index, i };
+            if (int(heap.size()) < fuzzyLimit) {
+                heap.push_back(match);
+                std::push_heap(heap.begin(), heap.end(), isWorse);
+            } else if (match.isBetterThan(heap.front())) {
+                std::pop_heap(heap.begin(), heap.end(), isWorse);
+                heap.back() = match;
+                std::push_heap(heap.begin(), heap.end(), isWorse);
+            }
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end(), isWorse);
+    for (const auto &match: heap) {
+        const QString &&word = match.index->at(match.pos);
+        if (!taken.contains(word)) {
+            taken.insert(word);
+            results << word;
+        }
+    }
+    return results;
+}
@@ -0,0 +1,74 @@
+#ifndef COMPLETIONINDEX_H
+#define COMPLETIONINDEX_H
+
+#include <QSharedPointer>
+#include <QVector>
+
+/*!
+ * \brief An immutable index of completion candidates.
+ *
+ * Candidates are sorted by their case-folded forms, so the candidates which
+ * start with a prefix form a contiguous range of the index, like the subtree
+ * of a prefix trie flattened into an array. The range of a longer prefix is
+ * searched within the range of the shorter one, so the matches are narrowed
+ * incrementally as the user types.
+ */
+class CompletionIndex {
+public:
+    struct Range {
+        int begin = 0;
+        int end   = 0;
+
+        bool isEmpty() const {
+            return begin >= end;
+        }
+        bool contains(const int i) const {
+            return (i >= begin) && (i < end);
+        }
+    };
+
+    CompletionIndex() = default;
+    explicit CompletionIndex(const QVector<QString> &words);
+
+    int size() const;
+    bool isEmpty() const;
+    QString at(const int i) const;
+    QStringView keyAt(const int i) const;
+
+    Range all() const;
+    Range prefixRange(QStringView foldedPrefix) const;
+    Range prefixRange(QStringView foldedPrefix, const Range &within) const;
+
+    static int fuzzyScore(QStringView key, QStringView foldedPattern);
+
+private:
+    QVector<QString> m_words;
+    QVector<QString> m_keys; // Case-folded words in the same order
+};
+
+using CompletionIndexPtr = QSharedPointer<const CompletionIndex>;
+
+/*!
+ * \brief Ranks the candidates of several indexes against a prefix which is
+ * typed incrementally.
+ */
+class CompletionQuery {
+public:
+    void addIndex(const CompletionIndexPtr &index);
+    void addWords(const QVector<QString> &words);
+    void clear();
+    bool isEmpty() const;
+
+    QVector<QString> complete(const QString &prefix, const int limit);
+
+private:
+    struct Source {
+        CompletionIndexPtr     index;
+        CompletionIndex::Range range;
+    };
+
+    QVector<Source> m_sources;
+    QString m_prefix; // The case-folded prefix which the ranges are for
+};
+
+#endif // COMPLETIONINDEX_H
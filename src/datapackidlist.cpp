@@ -0,0 +1,72 @@
+#include "datapackidlist.h"
+
+#include "datapackindex.h"
+#include "globalhelpers.h"
+
+#include <QDir>
+#include <QHash>
+#include <QWeakPointer>
+
+/*!
+ * \class DatapackIdList
+ * \brief The IDs of the files in a category directory of the opened
+ * datapack, shared by all the models that list them.
+ *
+ * A list is created by forCategory() for the first observer of a category and
+ * destroyed with the last one, so that a category is listed again only once
+ * whenever the datapack changes, however many editors show it.
+ * Lists must be used in the GUI thread.
+ */
+
+namespace {
+    QHash<QString, QWeakPointer<DatapackIdList> > idLists;
+}
+
+DatapackIdList::DatapackIdList(const QString &catDir) : m_category(catDir) {
+    connect(DatapackIndex::instance(), &DatapackIndex::idsChanged,
+            this, &DatapackIdList::update);
+    m_ids = Glhp::fileIdList(QDir::currentPath(), m_category);
+}
+
+DatapackIdList::~DatapackIdList() {
+    // The list may have been replaced before its deferred deletion
+    const auto it = idLists.find(m_category);
+
+    if ((it != idLists.end()) && it->isNull()) {
+        idLists.erase(it);
+    }
+}
+
+/*!
+ * \brief Returns the shared list of the IDs in the \a catDir directory.
+ */
+QSharedPointer<DatapackIdList> DatapackIdList::forCategory(
+    const QString &catDir) {
+    auto &weakList = idLists[catDir];
+
+    if (auto &&list = weakList.toStrongRef()) {
+        return list;
+    }
+
+    QSharedPointer<DatapackIdList> list(new DatapackIdList(catDir),
+                                        &QObject::deleteLater);
+    weakList = list;
+    return list;
+}
+
+QString DatapackIdList::category() const {
+    return m_category;
+}
+
+QVector<QString> DatapackIdList::ids() const {
+    return m_ids;
+}
+
+void DatapackIdList::update() {
+    auto &&ids = Glhp::fileIdList(QDir::currentPath(), m_category);
+
+    if (ids != m_ids) {
+        m_ids = std::move(ids);
+        emit idsChanged();
+    }
+}
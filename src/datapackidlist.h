@@ -0,0 +1,31 @@
+#ifndef DATAPACKIDLIST_H
+#define DATAPACKIDLIST_H
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QVector>
+
+class DatapackIdList : public QObject {
+    Q_OBJECT
+
+public:
+    ~DatapackIdList();
+
+    static QSharedPointer<DatapackIdList> forCategory(const QString &catDir);
+
+    QString category() const;
+    QVector<QString> ids() const;
+
+signals:
+    void idsChanged();
+
+private:
+    QString m_category;
+    QVector<QString> m_ids;
+
+    explicit DatapackIdList(const QString &catDir);
+
+    void update();
+};
+
+#endif // DATAPACKIDLIST_H
@@ -0,0 +1,289 @@
+#include "datapackindex.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileSystemWatcher>
+
+/*!
+ * \class DatapackIndex
+ * \brief An in-memory index of the namespaced IDs of the files in the opened
+ * datapack, which is kept up to date with a file system watcher.
+ *
+ * The index is shared by the highlighters, Glhp::fileIdList() and code
+ * completion, so that looking up an ID doesn't touch the file system.
+ * It can be read from any thread.
+ */
+
+DatapackIndex::DatapackIndex(QObject *parent) : QObject(parent) {
+}
+
+/*!
+ * \brief Returns the index, which is created on the first call.
+ *
+ * The index is owned by the application object, so that its file system
+ * watcher is destroyed before the application rather than after it.
+ * The first call must be made from the main thread.
+ */
+DatapackIndex * DatapackIndex::instance() {
+    static auto *index = new DatapackIndex(qApp);
+
+    return index;
+}
+
+/*!
+ * \brief Indexes the datapack in \a dirPath and watches it for changes.
+ */
+void DatapackIndex::load(const QString &dirPath) {
+    if (m_watcher) {
+        delete m_watcher;
+        m_watcher = nullptr;
+    }
+
+    QStringList dirs;
+    {
+        QWriteLocker locker(&m_lock);
+        m_dirPath  = dirPath;
+        m_dataPath = dirPath + QStringLiteral("/data");
+        m_entriesByCategory.clear();
+        if (QFileInfo(m_dataPath).isDir()) {
+            dirs << m_dataPath;
+            scanDirectory(m_dataPath, dirs);
+        }
+        rebuildLookup();
+        ++m_revision;
+    }
+
+    m_watcher = new QFileSystemWatcher(this);
+    if (!dirs.isEmpty()) {
+        m_watcher->addPaths(dirs);
+    }
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged,
+            this, &DatapackIndex::onDirectoryChanged);
+
+    emit idsChanged();
+}
+
+void DatapackIndex::clear() {
+    if (m_watcher) {
+        delete m_watcher;
+        m_watcher = nullptr;
+    }
+    {
+        QWriteLocker locker(&m_lock);
+        m_dirPath.clear();
+        m_dataPath.clear();
+        m_entriesByCategory.clear();
+        m_pathsById.clear();
+        ++m_revision;
+    }
+    emit idsChanged();
+}
+
+QString DatapackIndex::dirPath() const {
+    QReadLocker locker(&m_lock);
+
+    return m_dirPath;
+}
+
+/*!
+ * \brief Returns whether the datapack in \a dirPath is the indexed one.
+ */
+bool DatapackIndex::isLoaded(const QString &dirPath) const {
+    QReadLocker locker(&m_lock);
+
+    return !m_dirPath.isEmpty() && (m_dirPath == dirPath);
+}
+
+/*!
+ * \brief Returns a number which changes whenever the indexed IDs change,
+ * so that data derived from them can be cached.
+ */
+int DatapackIndex::revision() const {
+    QReadLocker locker(&m_lock);
+
+    return m_revision;
+}
+
+/*!
+ * \brief Returns the path of the file referred by the namespaced \a id,
+ * which starts with a \c # if it's a tag. Returns an empty string if no files
+ * are found.
+ */
+QString DatapackIndex::locate(QStringView id) const {
+    QReadLocker locker(&m_lock);
+
+    return m_pathsById.value(id.toString());
+}
+
+/*!
+ * \brief Returns the files in the \a catDir category directory of
+ * all namespaces.
+ */
+QVector<DatapackIndex::Entry> DatapackIndex::entries(const QString &catDir)
+const {
+    QReadLocker locker(&m_lock);
+
+    return m_entriesByCategory.value(catDir);
+}
+
+/*!
+ * \brief Returns the IDs of the files in the \a catDir directory (or all
+ * category directories if it's empty) of the \a nspace namespace (or all
+ * namespaces if it's empty), in the same way as Glhp::fileIdList().
+ */
+QVector<QString> DatapackIndex::ids(const QString &catDir,
+                                    const QString &nspace,
+                                    bool noTagForm) const {
+    QReadLocker      locker(&m_lock);
+    QVector<QString> idList;
+
+    const QString &&catPrefix = catDir + '/';
+    for (auto it = m_entriesByCategory.cbegin();
+         it != m_entriesByCategory.cend(); ++it) {
+        if (!catDir.isEmpty() && (it.key() != catDir)
+            && !it.key().startsWith(catPrefix)) {
+            continue;
+        }
+        for (const auto &entry: it.value()) {
+            if (!nspace.isEmpty() && (entry.nspace != nspace)) {
+                continue;
+            }
+            if (entry.isTag && !noTagForm) {
+                idList << '#' + entry.nspace + ':' + entry.id;
+            } else {
+                idList << entry.nspace + ':' + entry.id;
+            }
+        }
+    }
+    return idList;
+}
+
+void DatapackIndex::onDirectoryChanged(const QString &path) {
+    QStringList newDirs;
+    {
+        QWriteLocker locker(&m_lock);
+        removeFilesIn(path);
+        if (QFileInfo(path).isDir()) {
+            scanDirectory(path, newDirs);
+        }
+        rebuildLookup();
+        ++m_revision;
+    }
+    if (!newDirs.isEmpty()) {
+        const auto &&watchedDirs = m_watcher->directories();
+        newDirs.erase(std::remove_if(newDirs.begin(), newDirs.end(),
+                                     [&watchedDirs](const QString &dir) {
+            return watchedDirs.contains(dir);
+        }), newDirs.end());
+        if (!newDirs.isEmpty()) {
+            m_watcher->addPaths(newDirs);
+        }
+    }
+    emit idsChanged();
+}
+
+/*!
+ * \brief Adds the files in the \a path directory recursively and appends its
+ * subdirectories to \a subdirs.
+ */
+void DatapackIndex::scanDirectory(const QString &path, QStringList &subdirs) {
+    QDirIterator it(path, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot,
+                    QDirIterator::Subdirectories);
+
+    while (it.hasNext()) {
+        const QString &&filePath = it.next();
+        if (it.fileInfo().isDir()) {
+            subdirs << filePath;
+        } else {
+            addFile(filePath);
+        }
+    }
+}
+
+void DatapackIndex::addFile(const QString &path) {
+    const int      lastDot = path.lastIndexOf('.');
+    const QString &&suffix = path.mid(lastDot + 1);
+
+    if ((lastDot == -1) || ((suffix != QLatin1String("mcfunction"))
+                            && (suffix != QLatin1String("json"))
+                            && (suffix != QLatin1String("nbt")))) {
+        return;
+    }
+
+    // Path segments: <namespace>/[tags/]<category>[/<subcategory>]/<id>
+    const QString   &&relPath  = path.mid(m_dataPath.size() + 1);
+    const QStringList segments = relPath.split('/');
+    int               index    = 0;
+
+    Entry entry;
+    entry.path   = path;
+    entry.nspace = segments.value(index++);
+
+    QString category;
+    if (segments.value(index) == QLatin1String("tags")) {
+        entry.isTag = true;
+        category    = QStringLiteral("tags/");
+        ++index;
+    }
+    if (segments.value(index) == QLatin1String("worldgen")) {
+        category += QStringLiteral("worldgen/");
+        ++index;
+    }
+    // The ID must have at least a segment after the category
+    if (index + 1 >= segments.size()) {
+        return;
+    }
+    category += segments.at(index++);
+
+    entry.id = segments.mid(index).join('/');
+    entry.id.chop(suffix.size() + 1);
+    m_entriesByCategory[category] << std::move(entry);
+}
+
+void DatapackIndex::removeFilesIn(const QString &dirPath) {
+    const QString &&prefix = dirPath + '/';
+
+    for (auto it = m_entriesByCategory.begin();
+         it != m_entriesByCategory.end();) {
+        auto &entries = it.value();
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [&prefix](const Entry &entry) {
+            return entry.path.startsWith(prefix);
+        }), entries.end());
+        if (entries.isEmpty()) {
+            it = m_entriesByCategory.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/*!
+ * \brief Rebuilds the ID to path lookup table.
+ *
+ * If an ID exists in multiple categories, the alphabetically first category
+ * wins. Functions are looked up as .mcfunction files and other categories
+ * as JSON files.
+ */
+void DatapackIndex::rebuildLookup() {
+    m_pathsById.clear();
+    for (auto it = m_entriesByCategory.cbegin();
+         it != m_entriesByCategory.cend(); ++it) {
+        const QLatin1String suffix = (it.key() == QLatin1String("functions"))
+                                         ? QLatin1String(".mcfunction")
+                                         : QLatin1String(".json");
+        for (const auto &entry: it.value()) {
+            if (!entry.path.endsWith(suffix)) {
+                continue;
+            }
+            QString &&key = entry.nspace + ':' + entry.id;
+            if (entry.isTag) {
+                key.prepend('#');
+            }
+            if (!m_pathsById.contains(key)) {
+                m_pathsById.insert(key, entry.path);
+            }
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef DATAPACKINDEX_H
+#define DATAPACKINDEX_H
+
+#include <QObject>
+#include <QHash>
+#include <QMap>
+#include <QReadWriteLock>
+
+QT_BEGIN_NAMESPACE
+class QFileSystemWatcher;
+QT_END_NAMESPACE
+
+class DatapackIndex : public QObject {
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief A file of the datapack which can be referred by an ID.
+     */
+    struct Entry {
+        QString path;
+        QString nspace;
+        QString id; // Without the namespace
+        bool    isTag = false;
+    };
+
+    static DatapackIndex * instance();
+
+    void load(const QString &dirPath);
+    void clear();
+
+    QString dirPath() const;
+    bool isLoaded(const QString &dirPath) const;
+    int revision() const;
+
+    QString locate(QStringView id) const;
+    QVector<Entry> entries(const QString &catDir) const;
+    QVector<QString> ids(const QString &catDir = QString(),
+                         const QString &nspace = QString(),
+                         bool noTagForm        = true) const;
+
+signals:
+    void idsChanged();
+
+private:
+    explicit DatapackIndex(QObject *parent = nullptr);
+
+    mutable QReadWriteLock m_lock;
+    QString m_dirPath;
+    QString m_dataPath;
+    // Category directories relative to namespace directories
+    QMap<QString, QVector<Entry> > m_entriesByCategory;
+    QHash<QString, QString> m_pathsById;
+    QFileSystemWatcher *m_watcher = nullptr;
+    int m_revision                = 0;
+
+    void onDirectoryChanged(const QString &path);
+    void scanDirectory(const QString &path, QStringList &subdirs);
+    void addFile(const QString &path);
+    void removeFilesIn(const QString &dirPath);
+    void rebuildLookup();
+};
+
+#endif // DATAPACKINDEX_H
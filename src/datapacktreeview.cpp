@@ -4,6 +4,8 @@
 
 #include "globalhelpers.h"
 #include "game.h"
+#include "mappedfile.h"
+#include "referencesmenu.h"
 
 #include <QModelIndex>
 #include <QFile>
@@ -102,6 +104,10 @@ QMenu * DatapackTreeView::mkContextMenu(QModelIndex index) {
             cMenu->addAction(cMenuActionInTickDotJson);
         }
     }
+    if ((path == QLatin1String("data"))
+        || path.startsWith(QLatin1String("data/"))) {
+        addReferencesMenus(cMenu, finfo, fileType);
+    }
 
 
     if (path != QLatin1String("data") &&
@@ -291,6 +297,52 @@ QModelIndex DatapackTreeView::getSelected() {
     return (!indexes.isEmpty()) ? indexes.at(0) : QModelIndex();
 }
 
+/*!
+ * \brief Adds the menus of the callers of a function or function tag file,
+ * or of the unused functions in a directory.
+ */
+void DatapackTreeView::addReferencesMenus(QMenu *menu, const QFileInfo &finfo,
+                                          const CodeFile::FileType fileType) {
+    const auto     *index = SymbolIndex::instance();
+    ReferencesMenu *refMenu;
+
+    if (finfo.isDir()) {
+        const QString &&prefix  = finfo.filePath() + '/';
+        const QString &&pattern = dirPath + QStringLiteral(
+            "/data/%1/functions/%2.mcfunction");
+        QVector<SymbolIndex::Location> unused;
+        for (const auto &id: index->unusedFunctions()) {
+            const int     sepIndex = id.indexOf(':');
+            const QString &&path   = pattern.arg(id.left(sepIndex),
+                                                 id.mid(sepIndex + 1));
+            if (path.startsWith(prefix)) {
+                unused << SymbolIndex::Location{ path };
+            }
+        }
+        refMenu = new ReferencesMenu(tr("Unused functions"), dirPath,
+                                     unused, menu);
+    } else if ((fileType == CodeFile::Function)
+               || (fileType == CodeFile::FunctionTag)) {
+        const auto kind = (fileType == CodeFile::Function)
+                              ? SymbolIndex::Kind::Function
+                              : SymbolIndex::Kind::FunctionTag;
+        QVector<SymbolIndex::Location> uses;
+        for (const auto &location: index->locations(
+                 kind, Glhp::toNamespacedID(dirPath, finfo.filePath(), true))) {
+            if (location.role == SymbolIndex::Role::Use) {
+                uses << location;
+            }
+        }
+        refMenu = new ReferencesMenu(tr("References"), dirPath, uses, menu);
+    } else {
+        return;
+    }
+
+    connect(refMenu, &ReferencesMenu::locationTriggered,
+            this, &DatapackTreeView::openFileWithLineRequested);
+    menu->addMenu(refMenu);
+}
+
 void DatapackTreeView::load(const QDir &dir) {
     dirPath = dir.path();
     dirModel.setRootPath(dirPath);
@@ -472,11 +524,9 @@ bool DatapackTreeView::isStringInTagFile(const QString &filepath,
                                          const QString &str) {
     if (!QFileInfo::exists(filepath)) return false;
 
-    QFile inFile(filepath);
-    inFile.open(QIODevice::ReadOnly | QIODevice::Text);
-    QJsonDocument doc = QJsonDocument::fromJson(inFile.readAll());
-    inFile.close();
-    QJsonObject root = doc.object();
+    const MappedFile inFile(filepath);
+    QJsonDocument    doc  = QJsonDocument::fromJson(inFile.bytes());
+    QJsonObject      root = doc.object();
     if (!root.isEmpty()) {
         if (root.contains("values") && root.value("values").isArray()) {
             auto values = root.value("values").toArray();
@@ -517,12 +567,9 @@ void DatapackTreeView::contextMenuModifyTagFile(const QString &filepath,
         }
     }
 
-    QFile       file(filepath);
     QJsonObject root;
-    if (file.open(QIODevice::ReadOnly)) {
-        QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
-        root = doc.object();
-        file.close();
+    if (const MappedFile inFile(filepath); inFile.isOpen()) {
+        root = QJsonDocument::fromJson(inFile.bytes()).object();
     }
     if (!root.isEmpty()) {
         if (root.contains("values") && root.value("values").isArray()) {
@@ -534,6 +581,7 @@ void DatapackTreeView::contextMenuModifyTagFile(const QString &filepath,
             }
             root["values"] = QJsonArray::fromStringList(values);
 
+            QFile file(filepath);
             if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
                 QTextStream out(&file);
                 out.setCodec("UTF-8");
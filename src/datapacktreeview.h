@@ -2,6 +2,7 @@
 #define DATAPACKTREEVIEW_H
 
 #include "datapackfileiconprovider.h"
+#include "codefile.h"
 
 #include <QTreeView>
 #include <QFileSystemModel>
@@ -20,6 +21,7 @@ public:
 signals:
     void datapackChanged();
     void openFileRequested(const QString &path);
+    void openFileWithLineRequested(const QString &path, const int lineNo);
     void fileRenamed(const QString &path, const QString &oldName,
                      const QString &newName);
     void fileDeteted(const QString &path);
@@ -56,6 +58,8 @@ private:
                             const QString &catDir  = QString(),
                             const QString &nspace = QString());
     QModelIndex getSelected();
+    void addReferencesMenus(QMenu *menu, const QFileInfo &finfo,
+                            const CodeFile::FileType fileType);
     bool isStringInTagFile(const QString &filepath, const QString &str);
     void contextMenuModifyTagFile(const QString &filepath, const QString &str,
                                   bool added = true);
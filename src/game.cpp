@@ -1,6 +1,6 @@
 #include "game.h"
 
-#include "lru/lru.hpp"
+#include "gamedatabundle.h"
 
 #include <QSettings>
 #include <QDebug>
@@ -27,23 +27,25 @@ QVector<QString> Game::getRegistry(const QString &type) {
 
 QVector<QString> Game::getRegistry(const QString &type,
                                    const QString &version) {
-    static LRU::Cache<std::tuple<QString, QString>,
-                      QVector<QString> > cache{ 32 };
-
-    const std::tuple inputPair{ type, version };
-
-    if (cache.contains(inputPair)) return cache.lookup(inputPair);
-
-    const auto &&result = loadRegistry(type, version);
+    return *getRegistryHandle(type, version);
+}
 
-    cache.emplace(std::piecewise_construct,
-                  std::forward_as_tuple(type, version),
-                  std::forward_as_tuple(result));
-    return result;
+/*!
+ * \brief Returns a shared handle to the cached registry of the \a type,
+ * which avoids copying it.
+ */
+GameDataCache::RegistryHandle Game::getRegistryHandle(const QString &type,
+                                                      const QString &version) {
+    return GameDataCache::instance()->registry(type, version);
 }
 
 QVector<QString> Game::loadRegistry(const QString &type,
                                     const QString &version) {
+    if (const auto *bundle = GameDataBundle::forVersion(version);
+        bundle && bundle->contains(GameDataBundle::Kind::Registry, type)) {
+        return bundle->registry(type);
+    }
+
     const static QString &&filePathTemplate = QStringLiteral(
         ":minecraft/%1/registries/%2/data.min.json");
 
@@ -92,22 +94,26 @@ QVariantMap Game::getInfo(const QString &type) {
 
 QVariantMap Game::getInfo(const QString &type,
                           const QString &version) {
-    static LRU::Cache<std::tuple<QString, QString>, QVariantMap> cache{ 20 };
-
-    const std::tuple inputPair{ type, version };
-
-    if (cache.contains(inputPair)) return cache.lookup(inputPair);
-
-    const auto &&result = loadInfo(type, version);
+    return *getInfoHandle(type, version);
+}
 
-    cache.emplace(std::piecewise_construct,
-                  std::forward_as_tuple(type, version),
-                  std::forward_as_tuple(result));
-    return result;
+/*!
+ * \brief Returns a shared handle to the cached info map of the \a type,
+ * which avoids copying it.
+ */
+GameDataCache::InfoHandle Game::getInfoHandle(const QString &type,
+                                              const QString &version) {
+    return GameDataCache::instance()->info(type, version);
 }
 
 QVariantMap Game::loadInfo(const QString &type, const QString &version,
                            const int depth) {
+    // The precompiled bundle has the inheritance resolved already
+    if (const auto *bundle = GameDataBundle::forVersion(version);
+        bundle && bundle->contains(GameDataBundle::Kind::Info, type)) {
+        return bundle->info(type);
+    }
+
     QVariantMap retMap;
 
     const static QString &&filePathTemplate = QStringLiteral(
@@ -1,6 +1,8 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include "gamedatacache.h"
+
 #include <QVersionNumber>
 
 namespace Game {
@@ -25,10 +27,14 @@ namespace Game {
 
     QVariantMap getInfo(const QString &type);
     QVariantMap getInfo(const QString &type, const QString &version);
+    GameDataCache::InfoHandle getInfoHandle(
+        const QString &type, const QString &version = versionString());
     QVariantMap loadInfo(const QString &type, const QString &version,
                          const int depth = 0);
     QVector<QString> getRegistry(const QString &type);
     QVector<QString> getRegistry(const QString &type, const QString &version);
+    GameDataCache::RegistryHandle getRegistryHandle(
+        const QString &type, const QString &version = versionString());
     QVector<QString> loadRegistry(const QString &type, const QString &version);
 }
 
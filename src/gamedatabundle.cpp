@@ -0,0 +1,310 @@
+#include "gamedatabundle.h"
+
+#include <QDebug>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // "MCGB": Minecraft Game data Bundle
+    constexpr char    bundleMagic[4]      = { 'M', 'C', 'G', 'B' };
+    constexpr quint32 bundleFormatVersion = 1;
+    constexpr int     headerSize          = 12;
+    constexpr int     entrySize           = 20;
+
+    enum class ValueTag : uchar {
+        Null,
+        False,
+        True,
+        Double,
+        String,
+        Array,
+        Object,
+    };
+
+    /*!
+     * \internal
+     * \brief Reads values from a payload of a bundle with bounds checking.
+     */
+    class PayloadReader {
+public:
+        PayloadReader(const uchar *begin, const quint32 size)
+            : m_pos(begin), m_end(begin + size) {
+        }
+
+        bool hasError() const {
+            return m_hasError;
+        }
+
+        quint32 readUInt32() {
+            if (!canRead(4)) {
+                return 0;
+            }
+            const quint32 value = qFromLittleEndian<quint32>(m_pos);
+            m_pos += 4;
+            return value;
+        }
+
+        QString readString() {
+            const quint32 size = readUInt32();
+
+            if (!canRead(size)) {
+                return QString();
+            }
+            const auto *data = reinterpret_cast<const char *>(m_pos);
+            m_pos += size;
+            return QString::fromUtf8(data, size);
+        }
+
+        QVariant readValue(const int depth = 0) {
+            if (!canRead(1) || (depth > 64)) {
+                m_hasError = true;
+                return QVariant();
+            }
+
+            const auto tag = static_cast<ValueTag>(*m_pos++);
+            switch (tag) {
+                case ValueTag::Null:
+                    return QVariant();
+
+                case ValueTag::False:
+                    return false;
+
+                case ValueTag::True:
+                    return true;
+
+                case ValueTag::Double: {
+                    if (!canRead(8)) {
+                        return QVariant();
+                    }
+                    const quint64 bits  = qFromLittleEndian<quint64>(m_pos);
+                    double        value = 0;
+                    std::memcpy(&value, &bits, sizeof(value));
+                    m_pos += 8;
+                    return value;
+                }
+
+                case ValueTag::String:
+                    return readString();
+
+                case ValueTag::Array: {
+                    const quint32 count = readUInt32();
+                    QVariantList  list;
+                    list.reserve(qMin(count, quint32(m_end - m_pos)));
+                    for (quint32 i = 0; i < count && !m_hasError; ++i) {
+                        list << readValue(depth + 1);
+                    }
+                    return list;
+                }
+
+                case ValueTag::Object:
+                    return readMap(depth);
+
+                default: {
+                    m_hasError = true;
+                    return QVariant();
+                }
+            }
+        }
+
+        QVariantMap readMap(const int depth = 0) {
+            const quint32 count = readUInt32();
+            QVariantMap   map;
+
+            for (quint32 i = 0; i < count && !m_hasError; ++i) {
+                const QString &&key = readString();
+                map.insert(key, readValue(depth + 1));
+            }
+            return map;
+        }
+
+private:
+        const uchar *m_pos;
+        const uchar *m_end;
+        bool m_hasError = false;
+
+        bool canRead(const quint32 size) {
+            if (m_hasError || (quint32(m_end - m_pos) < size)) {
+                m_hasError = true;
+                return false;
+            }
+            return true;
+        }
+    };
+
+    QByteArray entryName(const GameDataBundle::Kind kind,
+                         const QString &name) {
+        switch (kind) {
+            case GameDataBundle::Kind::Info:
+                return QByteArrayLiteral("info/") + name.toUtf8();
+
+            case GameDataBundle::Kind::Registry:
+                return QByteArrayLiteral("registry/") + name.toUtf8();
+
+            case GameDataBundle::Kind::Schema:
+                return QByteArrayLiteral("schema/") + name.toUtf8();
+        }
+        return name.toUtf8();
+    }
+}
+
+/*!
+ * \brief Opens the bundle at \a filePath. The file can be a resource.
+ */
+GameDataBundle::GameDataBundle(const QString &filePath) : m_file(filePath) {
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    m_size = m_file.size();
+    // Uncompressed resources are mapped without copying
+    m_begin = m_file.map(0, m_size);
+    if (!m_begin) {
+        m_data  = m_file.readAll();
+        m_begin = reinterpret_cast<const uchar *>(m_data.constData());
+        m_size  = m_data.size();
+    }
+
+    if ((m_size < headerSize)
+        || (std::memcmp(m_begin, bundleMagic, sizeof(bundleMagic)) != 0)
+        || (qFromLittleEndian<quint32>(m_begin + 4) != bundleFormatVersion)) {
+        qWarning() << "Invalid game data bundle:" << filePath;
+        m_begin = nullptr;
+        return;
+    }
+
+    const quint32 entryCount = qFromLittleEndian<quint32>(m_begin + 8);
+    if (headerSize + qint64(entryCount) * entrySize > m_size) {
+        qWarning() << "Invalid game data bundle:" << filePath;
+        m_begin = nullptr;
+        return;
+    }
+
+    m_entries.reserve(entryCount);
+    for (quint32 i = 0; i < entryCount; ++i) {
+        const uchar  *entryData  = m_begin + headerSize + i * entrySize;
+        const quint32 nameOffset = qFromLittleEndian<quint32>(entryData);
+        const quint32 nameSize   = qFromLittleEndian<quint32>(entryData + 4);
+        Entry         entry;
+        entry.kind   = Kind(qFromLittleEndian<quint32>(entryData + 8));
+        entry.offset = qFromLittleEndian<quint32>(entryData + 12);
+        entry.size   = qFromLittleEndian<quint32>(entryData + 16);
+
+        if ((qint64(nameOffset) + nameSize > m_size)
+            || (qint64(entry.offset) + entry.size > m_size)) {
+            qWarning() << "Invalid game data bundle:" << filePath;
+            m_entries.clear();
+            m_begin = nullptr;
+            return;
+        }
+        entry.name = QByteArray::fromRawData(
+            reinterpret_cast<const char *>(m_begin + nameOffset), nameSize);
+        m_entries << entry;
+    }
+}
+
+/*!
+ * \brief Returns the bundle of the game \a version, or \c nullptr if
+ * the version has no valid bundle. Bundles are opened once and kept until
+ * the application exits.
+ */
+const GameDataBundle * GameDataBundle::forVersion(const QString &version) {
+    static QMutex mutex;
+    static QHash<QString, QSharedPointer<GameDataBundle> > bundles;
+    QMutexLocker locker(&mutex);
+
+    auto it = bundles.find(version);
+
+    if (it == bundles.end()) {
+        auto &&bundle = QSharedPointer<GameDataBundle>::create(
+            QStringLiteral(":/minecraft/%1/game.bundle").arg(version));
+        if (!bundle->isValid()) {
+            bundle.reset();
+        }
+        it = bundles.insert(version, bundle);
+    }
+    return it.value().get();
+}
+
+bool GameDataBundle::isValid() const {
+    return m_begin != nullptr;
+}
+
+bool GameDataBundle::contains(const Kind kind, const QString &name) const {
+    return find(kind, name) != nullptr;
+}
+
+/*!
+ * \brief Returns the info map of the \a type, whose inheritance has been
+ * resolved when the bundle was built.
+ */
+QVariantMap GameDataBundle::info(const QString &type) const {
+    const auto *entry = find(Kind::Info, type);
+
+    if (!entry) {
+        return {};
+    }
+
+    PayloadReader   reader(m_begin + entry->offset, entry->size);
+    const QVariant &&value = reader.readValue();
+    if (reader.hasError() || (value.type() != QVariant::Map)) {
+        qWarning() << "Invalid info in the game data bundle:" << type;
+        return {};
+    }
+    return value.toMap();
+}
+
+QVector<QString> GameDataBundle::registry(const QString &type) const {
+    const auto *entry = find(Kind::Registry, type);
+
+    if (!entry) {
+        return {};
+    }
+
+    PayloadReader    reader(m_begin + entry->offset, entry->size);
+    const quint32    count = reader.readUInt32();
+    QVector<QString> values;
+    values.reserve(qMin(count, entry->size / 4));
+    for (quint32 i = 0; i < count && !reader.hasError(); ++i) {
+        values << reader.readString();
+    }
+    if (reader.hasError()) {
+        qWarning() << "Invalid registry in the game data bundle:" << type;
+        return {};
+    }
+    return values;
+}
+
+/*!
+ * \brief Returns the command schema in MessagePack. The returned array refers
+ * to the mapped data of the bundle without copying.
+ */
+QByteArray GameDataBundle::schema() const {
+    const auto *entry = find(Kind::Schema, QStringLiteral("commands"));
+
+    if (!entry) {
+        return QByteArray();
+    }
+    return QByteArray::fromRawData(
+        reinterpret_cast<const char *>(m_begin + entry->offset), entry->size);
+}
+
+const GameDataBundle::Entry * GameDataBundle::find(
+    const Kind kind, const QString &name) const {
+    const QByteArray &&key = entryName(kind, name);
+
+    const auto it = std::lower_bound(
+        m_entries.cbegin(), m_entries.cend(), key,
+        [](const Entry &entry, const QByteArray &key) {
+        return entry.name < key;
+    });
+
+    if ((it != m_entries.cend()) && (it->name == key) && (it->kind == kind)) {
+        return &(*it);
+    }
+    return nullptr;
+}
@@ -0,0 +1,53 @@
+#ifndef GAMEDATABUNDLE_H
+#define GAMEDATABUNDLE_H
+
+#include <QFile>
+#include <QVariantMap>
+#include <QVector>
+
+/*!
+ * \brief A read-only view of the precompiled game data of a version.
+ *
+ * Bundles are generated at build time by \c tools/build_game_bundle.py, which
+ * flattens the info maps (with their inheritance resolved), registries and
+ * command schema of each version into a single file embedded in
+ * the resources. The file is mapped into memory, so lookups don't parse any
+ * JSON.
+ */
+class GameDataBundle {
+public:
+    enum class Kind : quint32 {
+        Info,
+        Registry,
+        Schema,
+    };
+
+    explicit GameDataBundle(const QString &filePath);
+
+    static const GameDataBundle * forVersion(const QString &version);
+
+    bool isValid() const;
+    bool contains(Kind kind, const QString &name) const;
+
+    QVariantMap info(const QString &type) const;
+    QVector<QString> registry(const QString &type) const;
+    QByteArray schema() const;
+
+private:
+    struct Entry {
+        QByteArray name;
+        Kind       kind = Kind::Info;
+        quint32    offset = 0;
+        quint32    size   = 0;
+    };
+
+    QFile m_file;
+    QByteArray m_data; // Only used if the file can't be mapped
+    const uchar *m_begin = nullptr;
+    qint64 m_size        = 0;
+    QVector<Entry> m_entries; // Sorted by name
+
+    const Entry * find(Kind kind, const QString &name) const;
+};
+
+#endif // GAMEDATABUNDLE_H
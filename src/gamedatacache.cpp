@@ -0,0 +1,207 @@
+#include "gamedatacache.h"
+
+#include "game.h"
+
+#include <QDebug>
+
+namespace {
+    // Rough per-object overheads of the Qt containers
+    constexpr size_t mapNodeBytes = 48;
+    constexpr size_t entryBytes   = 128;
+
+    size_t estimateBytes(const QString &str) {
+        return sizeof(QString) + str.size() * sizeof(QChar);
+    }
+
+    size_t estimateBytes(const QVariant &value) {
+        switch (value.type()) {
+            case QVariant::String:
+                return sizeof(QVariant) + estimateBytes(value.toString());
+
+            case QVariant::List: {
+                size_t      bytes = sizeof(QVariant) + sizeof(QVariantList);
+                const auto &list  = value.toList();
+                for (const auto &item: list) {
+                    bytes += estimateBytes(item);
+                }
+                return bytes;
+            }
+
+            case QVariant::Map: {
+                size_t      bytes = sizeof(QVariant) + sizeof(QVariantMap);
+                const auto &map   = value.toMap();
+                for (auto it = map.cbegin(); it != map.cend(); ++it) {
+                    bytes += mapNodeBytes + estimateBytes(it.key())
+                             + estimateBytes(it.value());
+                }
+                return bytes;
+            }
+
+            default:
+                return sizeof(QVariant);
+        }
+    }
+}
+
+uint qHash(const GameDataCache::Key &key, uint seed) {
+    return qHash(key.type, qHash(key.version, seed ^ uint(key.kind)));
+}
+
+GameDataCache * GameDataCache::instance() {
+    static GameDataCache cache;
+
+    return &cache;
+}
+
+/*!
+ * \brief Returns the info map of the \a type in the game \a version.
+ */
+GameDataCache::InfoHandle GameDataCache::info(const QString &type,
+                                              const QString &version) {
+    const Key key{ type, version, Kind::Info };
+
+    if (const auto &&entry = find(key)) {
+        return entry->info;
+    }
+
+    // Load without holding the lock, so other readers aren't blocked
+    auto &&entry = EntryPtr::create();
+    entry->info  = InfoHandle::create(Game::loadInfo(type, version));
+    entry->bytes = entryBytes + estimateBytes(QVariant(*entry->info));
+    return insert(key, std::move(entry))->info;
+}
+
+/*!
+ * \brief Returns the registry of the \a type in the game \a version.
+ */
+GameDataCache::RegistryHandle GameDataCache::registry(const QString &type,
+                                                      const QString &version) {
+    const Key key{ type, version, Kind::Registry };
+
+    if (const auto &&entry = find(key)) {
+        return entry->registry;
+    }
+
+    auto &&entry = EntryPtr::create();
+    entry->registry = RegistryHandle::create(Game::loadRegistry(type, version));
+    entry->bytes    = entryBytes + sizeof(QVector<QString>);
+    for (const auto &id: qAsConst(*entry->registry)) {
+        entry->bytes += estimateBytes(id);
+    }
+    return insert(key, std::move(entry))->registry;
+}
+
+/*!
+ * \brief Returns the estimated memory usage of the cached entries.
+ */
+size_t GameDataCache::byteSize() const {
+    QReadLocker locker(&m_lock);
+
+    return m_byteSize;
+}
+
+size_t GameDataCache::byteBudget() const {
+    QReadLocker locker(&m_lock);
+
+    return m_byteBudget;
+}
+
+/*!
+ * \brief Sets the estimated memory usage above which entries are evicted.
+ * The most recently used entry is always kept.
+ */
+void GameDataCache::setByteBudget(const size_t budget) {
+    QWriteLocker locker(&m_lock);
+
+    m_byteBudget = budget;
+    evict();
+}
+
+void GameDataCache::clear() {
+    QWriteLocker locker(&m_lock);
+
+    m_entries.clear();
+    m_byteSize = 0;
+}
+
+/*!
+ * \brief Returns the number of lookups which have found cached data.
+ */
+quint64 GameDataCache::hits() const {
+    return m_hits.loadRelaxed();
+}
+
+/*!
+ * \brief Returns the number of lookups which have loaded the data.
+ */
+quint64 GameDataCache::misses() const {
+    return m_misses.loadRelaxed();
+}
+
+/*!
+ * \brief Logs the hits, misses and memory usage of the cache, so the byte
+ * budget can be tuned.
+ */
+void GameDataCache::logStatistics() const {
+    const quint64 hitCount  = hits();
+    const quint64 missCount = misses();
+    const quint64 total     = hitCount + missCount;
+
+    qInfo() << "Game data cache:" << hitCount << "hits," << missCount
+            << "misses, hit rate"
+            << ((total > 0) ? 100.0 * hitCount / total : 0.0) << "%,"
+            << byteSize() << '/' << byteBudget() << "bytes";
+}
+
+GameDataCache::EntryPtr GameDataCache::find(const Key &key) {
+    QReadLocker locker(&m_lock);
+
+    if (const auto &&entry = m_entries.value(key)) {
+        entry->lastUsed.storeRelaxed(m_clock.fetchAndAddRelaxed(1));
+        m_hits.fetchAndAddRelaxed(1);
+        return entry;
+    }
+    m_misses.fetchAndAddRelaxed(1);
+    return nullptr;
+}
+
+/*!
+ * \brief Inserts the \a entry unless another thread has inserted one with
+ * the same \a key meanwhile. Returns the entry in the cache.
+ */
+GameDataCache::EntryPtr GameDataCache::insert(const Key &key,
+                                              EntryPtr entry) {
+    QWriteLocker locker(&m_lock);
+
+    if (const auto &&existing = m_entries.value(key)) {
+        return existing;
+    }
+
+    entry->lastUsed.storeRelaxed(m_clock.fetchAndAddRelaxed(1));
+    m_byteSize += entry->bytes;
+    m_entries.insert(key, entry);
+    evict();
+    return entry;
+}
+
+/*!
+ * \brief Removes the least recently used entries until the estimated memory
+ * usage is within the budget. Handles held by readers stay valid.
+ *
+ * The cache holds at most a few hundreds of entries, so the oldest entry is
+ * found by a linear scan rather than maintaining an ordered list, which would
+ * need a write lock for every lookup.
+ */
+void GameDataCache::evict() {
+    while ((m_byteSize > m_byteBudget) && (m_entries.size() > 1)) {
+        auto oldest = m_entries.begin();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (it.value()->lastUsed.loadRelaxed()
+                < oldest.value()->lastUsed.loadRelaxed()) {
+                oldest = it;
+            }
+        }
+        m_byteSize -= oldest.value()->bytes;
+        m_entries.erase(oldest);
+    }
+}
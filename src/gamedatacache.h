@@ -0,0 +1,81 @@
+#ifndef GAMEDATACACHE_H
+#define GAMEDATACACHE_H
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QSharedPointer>
+#include <QVariantMap>
+#include <QVector>
+
+/*!
+ * \brief A cache of the game info maps and registries shared by all threads.
+ *
+ * Cached data is immutable and handed out as shared handles, so readers don't
+ * copy it and can keep it after it has been evicted. Lookups of cached data
+ * only take a read lock. The least recently used entries are evicted when
+ * the estimated memory usage exceeds the byte budget.
+ */
+class GameDataCache {
+public:
+    using InfoHandle     = QSharedPointer<const QVariantMap>;
+    using RegistryHandle = QSharedPointer<const QVector<QString> >;
+
+    static constexpr size_t defaultByteBudget = 32 * 1024 * 1024;
+
+    static GameDataCache * instance();
+
+    InfoHandle info(const QString &type, const QString &version);
+    RegistryHandle registry(const QString &type, const QString &version);
+
+    size_t byteSize() const;
+    size_t byteBudget() const;
+    void setByteBudget(const size_t budget);
+    void clear();
+
+    quint64 hits() const;
+    quint64 misses() const;
+    void logStatistics() const;
+
+private:
+    enum class Kind : quint8 {
+        Info,
+        Registry,
+    };
+
+    struct Key {
+        QString type;
+        QString version;
+        Kind    kind = Kind::Info;
+
+        bool operator==(const Key &other) const {
+            return (kind == other.kind) && (type == other.type)
+                   && (version == other.version);
+        }
+    };
+
+    struct Entry {
+        InfoHandle                      info;
+        RegistryHandle                  registry;
+        size_t                          bytes = 0;
+        mutable QAtomicInteger<quint64> lastUsed;
+    };
+    using EntryPtr = QSharedPointer<Entry>;
+
+    friend uint qHash(const Key &key, uint seed);
+
+    mutable QReadWriteLock m_lock;
+    QHash<Key, EntryPtr> m_entries;
+    size_t m_byteSize   = 0;
+    size_t m_byteBudget = defaultByteBudget;
+    QAtomicInteger<quint64> m_clock;
+    QAtomicInteger<quint64> m_hits;
+    QAtomicInteger<quint64> m_misses;
+
+    GameDataCache() = default;
+
+    EntryPtr find(const Key &key);
+    EntryPtr insert(const Key &key, EntryPtr entry);
+    void evict();
+};
+
+#endif // GAMEDATACACHE_H
@@ -2,12 +2,11 @@
 
 #include "game.h"
 #include "globalhelpers.h"
+#include "datapackidlist.h"
 
 #include <QDebug>
 #include <QIcon>
 #include <QCoreApplication>
-#include <QDir>
-#include <QFileSystemWatcher>
 #include <QCompleter>
 #include <QListView>
 
@@ -40,42 +39,19 @@ void GameInfoModel::setRegistry(const QString &key, Options options) {
     setSource(key, LoadFrom::Registry, options);
 }
 
+/*!
+ * \brief Appends the IDs in the \a cat directory of the datapack to the
+ * model. If \a autoWatch is true, they are updated when the datapack changes.
+ *
+ * The IDs are shared by all the models of the same category.
+ */
 void GameInfoModel::setDatapackCategory(const QString &cat, bool autoWatch) {
-    m_dtpCategory = cat;
-
+    disconnect(m_idListConnection);
+    m_datapackIdList = DatapackIdList::forCategory(cat);
     if (autoWatch) {
-        if (m_watcher) {
-            const auto &oldDirs = m_watcher->directories();
-
-            if (!oldDirs.isEmpty()) {
-                m_watcher->removePaths(oldDirs);
-            }
-        } else {
-            m_watcher = new QFileSystemWatcher(this);
-        }
-        Q_ASSERT(m_watcher != nullptr);
-
-        const QString &dataPath = QDir::currentPath() +
-                                  QStringLiteral("/data/");
-        QDir         dir(dataPath);
-        const auto &&nspaceDirs = dir.entryList(
-            QDir::Dirs | QDir::NoDotAndDotDot);
-
-        for (const auto &nspaceDir : nspaceDirs) {
-            const QString &&watchPath = dataPath +
-                                        nspaceDir.section('.', 0,
-                                                          0) + "/" + cat;
-            if (QFile::exists(watchPath)) {
-                qDebug() << watchPath;
-                m_watcher->addPath(watchPath);
-            }
-        }
-
-        connect(m_watcher, &QFileSystemWatcher::directoryChanged,
-                this, &GameInfoModel::updateDatapackIds);
-    } else if (m_watcher) {
-        m_watcher->deleteLater();
-        m_watcher = nullptr;
+        m_idListConnection = connect(m_datapackIdList.get(),
+                                     &DatapackIdList::idsChanged,
+                                     this, &GameInfoModel::updateDatapackIds);
     }
 
     updateDatapackIds();
@@ -86,7 +62,8 @@ void GameInfoModel::setOptionalItem(bool value) {
 }
 
 void GameInfoModel::updateDatapackIds() {
-    const auto      &ids = Glhp::fileIdList(QDir::currentPath(), m_dtpCategory);
+    const auto     &&ids = m_datapackIdList
+                           ? m_datapackIdList->ids() : QVector<QString>();
     QVector<QString> filteredIds;
 
     if (!m_data.isEmpty()) {
@@ -94,19 +71,19 @@ void GameInfoModel::updateDatapackIds() {
             QString noMinecraftPrefixId = newId;
             Glhp::removePrefix(noMinecraftPrefixId);
             if (!m_data.contains(noMinecraftPrefixId)) {
-                filteredIds << std::move(newId);
+                filteredIds << newId;
             }
         }
     } else {
         filteredIds = ids;
     }
-    if (rowCount() - 1 >= staticRowCount()) {
+    if (!m_datapackIds.isEmpty()) {
         beginResetModel();
         m_datapackIds = filteredIds;
         endResetModel();
-    } else {
-        beginInsertRows({}, GameInfoModel::rowCount(),
-                        GameInfoModel::rowCount() + filteredIds.size());
+    } else if (!filteredIds.isEmpty()) {
+        const int first = GameInfoModel::rowCount();
+        beginInsertRows({}, first, first + filteredIds.size() - 1);
         m_datapackIds = filteredIds;
         endInsertRows();
     }
@@ -2,12 +2,14 @@
 #define GAMEINFOMODEL_H
 
 #include <QAbstractListModel>
+#include <QSharedPointer>
 
 QT_BEGIN_NAMESPACE
-class QFileSystemWatcher;
 class QCompleter;
 QT_END_NAMESPACE
 
+class DatapackIdList;
+
 /*!
  * \class GameInfoModel
  * \brief An item model whose underlying data is a list of a type of game
@@ -60,9 +62,9 @@ public slots:
     void updateDatapackIds();
 
 private:
-    QFileSystemWatcher *m_watcher = nullptr;
+    QSharedPointer<DatapackIdList> m_datapackIdList;
+    QMetaObject::Connection m_idListConnection;
     QString m_key;
-    QString m_dtpCategory;
     QVariantMap m_data;
     QVector<QString> m_dataIds;
     QVector<QString> m_datapackIds;
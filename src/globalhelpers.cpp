@@ -1,5 +1,6 @@
 #include "globalhelpers.h"
 
+#include "datapackindex.h"
 #include "uberswitch.hpp"
 
 #include <QCoreApplication>
@@ -296,6 +297,11 @@ QString Glhp::variantToStr(const QVariant &vari) {
 
 QVector<QString> Glhp::fileIdList(const QString &dirpath, const QString &catDir,
                                   const QString &nspace, bool noTagForm) {
+    if (const auto *index = DatapackIndex::instance();
+        index->isLoaded(dirpath)) {
+        return index->ids(catDir, nspace, noTagForm);
+    }
+
     QVector<QString> idList;
     const QString  &&dataPath = dirpath + QStringLiteral("/data/");
 
@@ -1,19 +1,12 @@
 #include "highlighter.h"
 
 #include "globalhelpers.h"
-
-#include "lru/lru.hpp"
+#include "datapackindex.h"
 
 #include <QDebug>
 #include <QDir>
 #include <QTextDocument>
 
-#include <chrono>
-// #include <mutex>
-// #include <thread>
-
-using namespace std::chrono_literals;
-
 TextBlockData::~TextBlockData() {
     clear();
 }
@@ -84,16 +77,35 @@ bool Highlighter::hasAdvancedHighlighting() const {
 }
 
 void Highlighter::ensureDelayedRehighlightAll() {
-    if (m_changedBlocks.size() < document()->blockCount()) {
-        m_changedBlocks.clear();
-        m_changedBlocks.reserve(document()->blockCount());
-        for (auto &&block = document()->begin(); block != document()->end();
-             block = block.next()) {
-            m_changedBlocks << block;
-        }
+    m_changedBlocks.clear();
+    m_changedBlocks.reserve(document()->blockCount());
+    for (auto &&block = document()->begin(); block != document()->end();
+         block = block.next()) {
+        m_changedBlocks << block;
     }
 }
 
+/*!
+ * \brief Sets the numbers of the first and the last blocks shown by the editor,
+ * which advanced highlighters format before the other changed blocks.
+ */
+void Highlighter::setVisibleBlockRange(const int first, const int last) {
+    m_firstVisibleBlock = first;
+    m_lastVisibleBlock  = last;
+}
+
+int Highlighter::firstVisibleBlockNumber() const {
+    return m_firstVisibleBlock;
+}
+
+int Highlighter::lastVisibleBlockNumber() const {
+    return m_lastVisibleBlock;
+}
+
+const CodePalette &Highlighter::palette() const {
+    return m_palette;
+}
+
 void Highlighter::setPalette(const CodePalette &newPalette) {
     m_palette = newPalette;
 }
@@ -119,7 +131,11 @@ void Highlighter::highlightBlock(const QString &text) {
     bool hasCurData = false;
     if (!highlightManually) {
         if (m_highlightingFirstBlock) {
-            m_changedBlocks.clear();
+            // Advanced highlighters consume the changed blocks only when
+            // the analysis of the document has finished.
+            if (!m_hasAdvancedHighlighting) {
+                m_changedBlocks.clear();
+            }
             m_highlightingFirstBlock = false;
         }
         m_changedBlocks << currentBlock();
@@ -300,56 +316,7 @@ void Highlighter::collectNamespacedIds(QStringView sv, TextBlockData *data) {
     }
 }
 
-// std::once_flag flag;
-
-/// Naive algorithm to find a file path from a namespaced ID
-QString Highlighter::locateNamespacedId(QString id) {
-    static LRU::TimedCache<QString, QStringList> dirListCache(200ms, 8);
-
-    // std::call_once(flag, [](){
-    //     dirListCache.hit_callback([](const auto& key, const auto& value) {
-    //         qDebug() << "Hit for entry ("
-    //                  << key << ", " << value << ")";
-    //     });
-
-    //     dirListCache.miss_callback([](const auto& key) {
-    //         qDebug() << "Miss for " << key;
-    //     });
-    // });
-
-    bool isTag = false;
-
-    if (Glhp::removePrefix(id, "#"_QL1))
-        isTag = true;
-    auto      dir       = QDir::current();
-    QString &&nspaceKey = id.section(":", 0, 0);
-
-    if (!dir.cd(QStringLiteral("data/") + nspaceKey)) {
-        return QString();
-    }
-    if (isTag) {
-        if (!dir.cd(QStringLiteral("tags"))) {
-            return QString();
-        }
-        nspaceKey += QStringLiteral("/tags");
-    }
-
-    QStringList dirList;
-    if (dirListCache.contains(nspaceKey)) {
-        dirList = dirListCache.lookup(nspaceKey);
-    } else {
-        dirList = dir.entryList(QDir::AllDirs | QDir::NoDotAndDotDot);
-        dirListCache.emplace(nspaceKey, dirList);
-    }
-    for (const auto &catDir: qAsConst(dirList)) {
-        const QString &&path = dir.path() + "/"_QL1 + catDir + "/"
-                               + id.section(":", 1, 1);
-        if (catDir == QStringLiteral("functions")
-            && QFile::exists(path + QStringLiteral(".mcfunction"))) {
-            return path + QStringLiteral(".mcfunction");
-        } else if (QFile::exists(path + QStringLiteral(".json"))) {
-            return path + QStringLiteral(".json");
-        }
-    }
-    return QString();
+/// Finds the file path of a namespaced ID in the index of the datapack
+QString Highlighter::locateNamespacedId(QStringView id) const {
+    return DatapackIndex::instance()->locate(id);
 }
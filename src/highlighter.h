@@ -80,7 +80,9 @@ public:
     bool isManualHighlight() const;
     bool hasAdvancedHighlighting() const;
     void ensureDelayedRehighlightAll();
+    void setVisibleBlockRange(const int first, const int last);
 
+    const CodePalette &palette() const;
     void setPalette(const CodePalette &newPalette);
 
     friend class CodeEditor;
@@ -102,6 +104,8 @@ protected:
     QVector<QTextBlock> &changedBlocks();
     virtual void rehighlightDelayed() {
     };
+    int firstVisibleBlockNumber() const;
+    int lastVisibleBlockNumber() const;
     void initBracketCharset();
     void formatNamespacedIds(TextBlockData *data,
                              const QTextCharFormat &baseFmt = {});
@@ -109,6 +113,8 @@ protected:
 private:
     QVector<QTextBlock> m_changedBlocks;
     QTextCharFormat m_invisSpaceFmt;
+    int m_firstVisibleBlock        = 0;
+    int m_lastVisibleBlock         = -1;
     bool m_highlightManually       = false;
     bool m_highlightingFirstBlock  = false;
     bool m_curDirExists            = false;
@@ -116,7 +122,7 @@ private:
 
     void collectBracket(int i, QChar ch, TextBlockData *data);
     void collectNamespacedIds(QStringView sv, TextBlockData *data);
-    QString locateNamespacedId(QString id);
+    QString locateNamespacedId(QStringView id) const;
 };
 
 #endif /* HIGHLIGHTER_H */
@@ -2,8 +2,10 @@
 
 #include "game.h"
 #include "globalhelpers.h"
+#include "textureatlas.h"
 
 #include <QPainter>
+#include <QPixmapCache>
 #include <QApplication>
 #include <QGraphicsColorizeEffect>
 
@@ -57,20 +59,20 @@ void InventoryItem::setupItem(QString id) {
     }
 }
 
-QPixmap InventoryItem::loadPixmap(QString id) const {
+QPixmap InventoryItem::loadPixmap(QString id, const int size) {
     if (id.isEmpty()) {
         return {};
     }
 
-    if (isTag()) {
-        QPixmap iconpix(32, 32);
+    if (id.startsWith('#')) {
+        QPixmap iconpix(size, size);
         iconpix.fill(Qt::transparent);
         {
             QPainter painter(&iconpix);
             QFont    font = painter.font();
-            font.setPixelSize(32);
+            font.setPixelSize(size);
             painter.setFont(font);
-            painter.drawText(QRect(0, 0, 32, 32), Qt::AlignCenter,
+            painter.drawText(QRect(0, 0, size, size), Qt::AlignCenter,
                              QStringLiteral("#"));
             painter.end();
         }
@@ -82,6 +84,13 @@ QPixmap InventoryItem::loadPixmap(QString id) const {
     QString iconpath;
 
     Glhp::removePrefix(id, "minecraft:"_QL1);
+    if (const auto *atlas = TextureAtlas::forVersion(Game::versionString())) {
+        iconpix = atlas->pixmap(id, size);
+        if (!iconpix.isNull()) {
+            return iconpix;
+        }
+    }
+
     const auto &&MCRItemInfo = Game::getInfo(QStringLiteral("item"));
 
     if (id.endsWith(QLatin1String("banner_pattern"))) {
@@ -115,16 +124,14 @@ QPixmap InventoryItem::loadPixmap(QString id) const {
             painter.end();
         }
     }
-    static const int   pixmapLength = 32;
-    static const QSize pixmapSize(pixmapLength, pixmapLength);
-    iconpix = iconpix.scaled(pixmapLength, pixmapLength, Qt::KeepAspectRatio);
-    if (iconpix.size() != pixmapSize) {
-        QPixmap centeredPix(pixmapLength, pixmapLength);
+    iconpix = iconpix.scaled(size, size, Qt::KeepAspectRatio);
+    if (iconpix.size() != QSize(size, size)) {
+        QPixmap centeredPix(size, size);
         centeredPix.fill(Qt::transparent);
         {
             QPainter painter(&centeredPix);
-            painter.drawPixmap((pixmapLength - iconpix.width()) / 2,
-                               (pixmapLength - iconpix.height()) / 2, iconpix);
+            painter.drawPixmap((size - iconpix.width()) / 2,
+                               (size - iconpix.height()) / 2, iconpix);
             painter.end();
         }
         iconpix = centeredPix;
@@ -235,11 +242,33 @@ bool InventoryItem::isTag() const {
 
 QPixmap InventoryItem::getPixmap() const {
     if (!m_pixmap) {
-        m_pixmap = loadPixmap(m_namespacedId);
+        m_pixmap = cachedPixmap(m_namespacedId);
     }
     return m_pixmap;
 }
 
+/*!
+ * \brief Returns the icon of the item or tag \a id scaled to \a size.
+ *
+ * Icons are decoded once and kept in the process-wide QPixmapCache, keyed
+ * by the ID and the size, so every slot, list and dock showing the same item
+ * shares its pixmap. It must be called from the GUI thread.
+ */
+QPixmap InventoryItem::cachedPixmap(const QString &id, const int size) {
+    if (id.isEmpty()) {
+        return {};
+    }
+
+    const QString &&key = QStringLiteral("InventoryItem:%1@%2").arg(
+        id, QString::number(size));
+    QPixmap pixmap;
+    if (!QPixmapCache::find(key, &pixmap)) {
+        pixmap = loadPixmap(id, size);
+        QPixmapCache::insert(key, pixmap);
+    }
+    return pixmap;
+}
+
 void InventoryItem::setPixmap(const QPixmap &newPixmap) {
     m_pixmap = newPixmap;
 }
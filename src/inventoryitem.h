@@ -53,6 +53,8 @@ public:
     QPixmap getPixmap() const;
     void setPixmap(const QPixmap &newPixmap);
 
+    static QPixmap cachedPixmap(const QString &id, const int size = 32);
+
     QString toolTip() const;
 
     bool isNull() const;
@@ -71,7 +73,7 @@ private:
     Flags m_flags = Flag::Null;
 
     void setupItem(QString id);
-    QPixmap loadPixmap(QString id) const;
+    static QPixmap loadPixmap(QString id, const int size);
 };
 
 Q_DECLARE_METATYPE(InventoryItem);
@@ -1,6 +1,6 @@
 #include "inventoryitemfiltermodel.h"
 
-#include "inventoryitem.h"
+#include "inventoryitemmodel.h"
 
 #include <QTimer>
 
@@ -19,30 +19,38 @@ void InventoryItemFilterModel::setFilterRegularExpression(
     }
 }
 
+/*!
+ * \brief Filters the rows by the IDs, names and kinds provided by
+ * the InventoryItemModel, so that the items of the rows aren't created.
+ */
 bool InventoryItemFilterModel::filterAcceptsRow(int sourceRow,
                                                 const QModelIndex &sourceParent)
 const {
+    using Role = InventoryItemModel::Role;
+
     const QModelIndex &index =
         sourceModel()->index(sourceRow, 0, sourceParent);
-    auto &&invItem = sourceModel()->data(index, Qt::UserRole +
-                                         1).value<InventoryItem>();
+    const InventoryItem::Flags flags(
+        QFlag(index.data(Role::FlagsRole).toInt()));
 
-    if (invItem.isBlock()) {
-        if (invItem.isItem()) {
+    if (flags.testFlag(InventoryItem::Block)) {
+        if (flags.testFlag(InventoryItem::Item)) {
             if (!(m_filters & BlockItems)) {
                 return false;
             }
         } else if (!(m_filters & UnobtainableBlocks)) {
             return false;
         }
-    } else if (invItem.isItem()) {
+    } else if (flags.testFlag(InventoryItem::Item)) {
         if (!(m_filters & NonblockItem)) {
             return false;
         }
     }
 
-    return invItem.getNamespacedID().contains(filterRegularExpression()) ||
-           invItem.getName().toCaseFolded().contains(filterRegularExpression());
+    const auto &&regex = filterRegularExpression();
+    return index.data(Role::IdRole).toString().contains(regex) ||
+           index.data(Role::NameRole).toString().toCaseFolded().contains(
+        regex);
 }
 
 InventoryItemFilterModel::Filters InventoryItemFilterModel::filters() const {
@@ -0,0 +1,73 @@
+#include "inventoryitemmodel.h"
+
+InventoryItemModel::InventoryItemModel(QObject *parent)
+    : QAbstractListModel{parent} {
+}
+
+int InventoryItemModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : m_entries.size();
+}
+
+QVariant InventoryItemModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= m_entries.size()) {
+        return {};
+    }
+
+    switch (role) {
+        case Qt::DecorationRole: {
+            return InventoryItem::cachedPixmap(m_entries.at(index.row()).id);
+        }
+
+        case Qt::SizeHintRole: {
+            constexpr int itemPixmapSize = 32 + (3 * 2);
+            return QSize(itemPixmapSize, itemPixmapSize);
+        }
+
+        case Qt::ToolTipRole: {
+            return itemAt(index.row()).toolTip();
+        }
+
+        case ItemRole: {
+            return QVariant::fromValue(itemAt(index.row()));
+        }
+
+        case IdRole: {
+            return m_entries.at(index.row()).id;
+        }
+
+        case NameRole: {
+            return m_entries.at(index.row()).name;
+        }
+
+        case FlagsRole: {
+            return int(m_entries.at(index.row()).flags);
+        }
+
+        default:
+            return {};
+    }
+}
+
+QVector<InventoryItemModel::Entry> InventoryItemModel::entries() const {
+    return m_entries;
+}
+
+void InventoryItemModel::setEntries(const QVector<Entry> &entries) {
+    beginResetModel();
+    m_entries = entries;
+    m_items.clear();
+    m_items.resize(m_entries.size());
+    endResetModel();
+}
+
+/*!
+ * \brief Returns the item of the \a row, which is created on first access.
+ */
+InventoryItem InventoryItemModel::itemAt(const int row) const {
+    auto &item = m_items[row];
+
+    if (item.getNamespacedID().isEmpty()) {
+        item = InventoryItem(m_entries.at(row).id);
+    }
+    return item;
+}
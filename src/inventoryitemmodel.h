@@ -0,0 +1,52 @@
+#ifndef INVENTORYITEMMODEL_H
+#define INVENTORYITEMMODEL_H
+
+#include "inventoryitem.h"
+
+#include <QAbstractListModel>
+
+/*!
+ * \brief A list model of the given blocks and items.
+ *
+ * Only the IDs, names and kinds are stored up front, which is enough to
+ * filter the rows. The InventoryItem of a row is created the first time it's
+ * queried, and its icon is only fetched when the view asks for the decoration
+ * of the row, i.e. when the row is painted.
+ */
+class InventoryItemModel : public QAbstractListModel {
+    Q_OBJECT
+public:
+    enum Role {
+        ItemRole = Qt::UserRole + 1,
+        IdRole,
+        NameRole,
+        FlagsRole,
+    };
+
+    /*!
+     * \brief The data of a row which can be filtered by without creating
+     * the InventoryItem of the row.
+     */
+    struct Entry {
+        QString              id;
+        QString              name;
+        InventoryItem::Flags flags;
+    };
+
+    explicit InventoryItemModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index,
+                  int role = Qt::DisplayRole) const override;
+
+    QVector<Entry> entries() const;
+    void setEntries(const QVector<Entry> &entries);
+
+    InventoryItem itemAt(const int row) const;
+
+private:
+    QVector<Entry> m_entries;
+    mutable QVector<InventoryItem> m_items;
+};
+
+#endif // INVENTORYITEMMODEL_H
@@ -9,6 +9,7 @@
 
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QJsonArray>
 
 
 ItemModifierDock::ItemModifierDock(QWidget *parent) :
@@ -50,18 +51,17 @@ void ItemModifierDock::changeEvent(QEvent *event) {
 }
 
 void ItemModifierDock::onReadBtn() {
-    QString &&input =
-        qobject_cast<MainWindow *>(parent())->getCodeEditorText();
-    QJsonDocument &&json_doc = QJsonDocument::fromJson(input.toUtf8());
-
-    if (json_doc.isNull() || json_doc.isEmpty())
-        return;
+    const QJsonValue &&json =
+        qobject_cast<MainWindow *>(parent())->getCodeEditorJson();
 
     if (Game::version() >= Game::v1_16
-        && json_doc.isArray()) {
-        ui->dataInterface->setJson(json_doc.array());
+        && json.isArray()) {
+        if (json.toArray().isEmpty())
+            return;
+
+        ui->dataInterface->setJson(json.toArray());
     } else {
-        QJsonObject root = json_doc.object();
+        QJsonObject root = json.toObject();
         if (root.isEmpty())
             return;
 
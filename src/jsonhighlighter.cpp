@@ -1,12 +1,25 @@
 #include "jsonhighlighter.h"
 
 #include <QRegularExpression>
+#include <QTextDocument>
+#include <QAbstractTextDocumentLayout>
 
 JsonHighlighter::JsonHighlighter(QTextDocument *parent)
     : Highlighter(parent) {
+    setHasAdvancedHighlighting(true);
     setupRules();
 }
 
+/*!
+ * \brief Sets the format ranges of the lines of the document, which are made
+ * from its syntax tree and used by the next rehighlightDelayed() call.
+ */
+void JsonHighlighter::setAnalysisResult(
+    const QVector<FormatRanges> &lineFormats) {
+    m_lineFormats       = lineFormats;
+    m_hasAnalysisResult = true;
+}
+
 void JsonHighlighter::setupRules() {
     highlightingRules.append({
         QRegularExpression("\\b(?:true|false|null)\\b"),
@@ -20,6 +33,57 @@ void JsonHighlighter::setupRules() {
 void JsonHighlighter::highlightBlock(const QString &text) {
     Highlighter::highlightBlock(text);
     if (this->document()) {
-        highlightUsingRules(text, highlightingRules);
+        if (!isManualHighlight()) {
+            // Used until the syntax tree of the new text is ready
+            highlightUsingRules(text, highlightingRules);
+        } else if (m_curChangedBlockIndex < m_formats.size()) {
+            for (const auto &range:
+                 qAsConst(m_formats.at(m_curChangedBlockIndex))) {
+                mergeFormat(range.start, range.length, range.format);
+            }
+            ++m_curChangedBlockIndex;
+        }
+    }
+}
+
+void JsonHighlighter::rehighlightDelayed() {
+    auto &blocks = changedBlocks();
+
+    blocks.erase(std::remove_if(blocks.begin(), blocks.end(),
+                                [](const QTextBlock &block) {
+        return !block.isValid();
+    }), blocks.end());
+    std::sort(blocks.begin(), blocks.end(),
+              [](const QTextBlock &a, const QTextBlock &b) {
+        return a.blockNumber() < b.blockNumber();
+    });
+    blocks.erase(std::unique(blocks.begin(), blocks.end(),
+                             [](const QTextBlock &a, const QTextBlock &b) {
+        return a.blockNumber() == b.blockNumber();
+    }), blocks.end());
+    if (!m_hasAnalysisResult || blocks.isEmpty()) {
+        return;
     }
+
+    // Lines of JSON documents are the blocks of the text document
+    m_formats.resize(blocks.size());
+    for (int i = 0; i < blocks.size(); ++i) {
+        m_formats[i] = m_lineFormats.value(blocks.at(i).blockNumber());
+    }
+
+    document()->blockSignals(true);
+    document()->documentLayout()->blockSignals(true);
+    if (blocks.size() == document()->blockCount()) {
+        Highlighter::rehighlight();
+    } else {
+        for (const auto &block: qAsConst(blocks)) {
+            Highlighter::rehighlightBlock(block);
+        }
+    }
+    document()->documentLayout()->blockSignals(false);
+    document()->blockSignals(false);
+
+    m_formats.clear();
+    m_curChangedBlockIndex = 0;
+    blocks.clear();
 }
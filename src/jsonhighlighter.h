@@ -5,13 +5,23 @@
 
 class JsonHighlighter : public Highlighter {
 public:
+    using FormatRanges = QVector<QTextLayout::FormatRange>;
+
     explicit JsonHighlighter(QTextDocument *parent);
 
+    void setAnalysisResult(const QVector<FormatRanges> &lineFormats);
+
 protected:
     void highlightBlock(const QString &text) final;
 
+    void rehighlightDelayed() final;
+
 private:
     HighlightingRules highlightingRules;
+    QVector<FormatRanges> m_formats;
+    QVector<FormatRanges> m_lineFormats;
+    int m_curChangedBlockIndex = 0;
+    bool m_hasAnalysisResult   = false;
 
     void setupRules();
 };
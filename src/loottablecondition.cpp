@@ -20,6 +20,7 @@
 LootTableCondition::LootTableCondition(QWidget *parent) :
     QTabWidget(parent), ui(new Ui::LootTableCondition) {
     ui->setupUi(this);
+    m_initializedPages.resize(ui->stackedWidget->count());
 }
 
 LootTableCondition::~LootTableCondition() {
@@ -42,39 +43,95 @@ void LootTableCondition::init() {
             this, &LootTableCondition::onTabChanged);
     connect(ui->nested_dataInterface, &DataWidgetInterface::entriesCountChanged,
             this, &LootTableCondition::updateConditionsTab);
-    MainWindow  *mainWin = nullptr;
-    const auto &&widgets = qApp->topLevelWidgets();
-    for (auto *wid : widgets) {
-        if (wid->objectName() == QStringLiteral("MainWindow")) {
-            mainWin = qobject_cast<MainWindow *>(wid);
+
+    initPage(ui->conditionTypeCombo->currentIndex());
+}
+
+/*!
+ * \brief Sets up the page of the condition type at \a index when it's first
+ * activated. Most conditions only ever show one page, so setting up the
+ * others would only cost time and memory.
+ */
+void LootTableCondition::initPage(const int index) {
+    if ((index < 0) || (index >= m_initializedPages.size())
+        || m_initializedPages.testBit(index)) {
+        return;
+    }
+    m_initializedPages.setBit(index);
+
+    switch (index) {
+        case 0: { /*Block states */
+            initBlockStatesPage();
             break;
         }
-    }
-    if (mainWin) {
-        connect(mainWin, &MainWindow::curDirChanged,
-                this, &LootTableCondition::onCurDirChanged);
-    }
 
-    initBlockStatesPage();
-    initDamageSrcPage();
-    ui->entity_propBtn->assignDialogClass<EntityConditionDialog>();
-    initEntityScoresPage();
-    ui->matchTool_propBtn->assignDialogClass<ItemConditionDialog>();
-    ui->location_propBtn->assignDialogClass<LocationConditionDialog>();
-    connect(ui->nested_linkLabel, &QLabel::linkActivated, this, [this]() {
-        setCurrentIndex(1);
-    });
-    initRandChancePage();
-    m_conditionModel.setOptionalItem(false);
-    m_conditionModel.setDatapackCategory("predicates", true);
-    auto *completer = new QCompleter(&m_conditionModel, this);
-    completer->setCaseSensitivity(Qt::CaseInsensitive);
-    ui->ref_nameEdit->setCompleter(completer);
-    initTableBonusPage();
-    ui->time_valueInput->setModes(NumberProvider::ExactAndRange);
-    m_timeCtrl.addMapping("value", ui->time_valueInput);
-    m_timeCtrl.addMapping("period", ui->time_periodSpinBox);
-    initToolEnchantPage();
+        case 1: { /*Damage sources */
+            initDamageSrcPage();
+            break;
+        }
+
+        case 2: { /*Entity properites */
+            ui->entity_propBtn->assignDialogClass<EntityConditionDialog>();
+            break;
+        }
+
+        case 3: { /*Entity scores */
+            initEntityScoresPage();
+            break;
+        }
+
+        case 5: { /*Location */
+            ui->location_propBtn->assignDialogClass<LocationConditionDialog>();
+            break;
+        }
+
+        case 6: { /*Nested conditions */
+            connect(ui->nested_linkLabel, &QLabel::linkActivated,
+                    this, [this]() {
+                setCurrentIndex(1);
+            });
+            break;
+        }
+
+        case 7: { /*Match tool */
+            ui->matchTool_propBtn->assignDialogClass<ItemConditionDialog>();
+            break;
+        }
+
+        case 8: { /*Random chance (with looting) */
+            initRandChancePage();
+            break;
+        }
+
+        case 9: { /*Reference */
+            m_conditionModel.setOptionalItem(false);
+            m_conditionModel.setDatapackCategory("predicates", true);
+            auto *completer = new QCompleter(&m_conditionModel, this);
+            completer->setCaseSensitivity(Qt::CaseInsensitive);
+            ui->ref_nameEdit->setCompleter(completer);
+            break;
+        }
+
+        case 11: { /*Table bonus */
+            initTableBonusPage();
+            break;
+        }
+
+        case 12: { /*Time */
+            ui->time_valueInput->setModes(NumberProvider::ExactAndRange);
+            m_timeCtrl.addMapping("value", ui->time_valueInput);
+            m_timeCtrl.addMapping("period", ui->time_periodSpinBox);
+            break;
+        }
+
+        case 13: { /*Tool enchantment */
+            initToolEnchantPage();
+            break;
+        }
+
+        default:
+            break;
+    }
 }
 
 QJsonObject LootTableCondition::toJson() const {
@@ -339,6 +396,7 @@ void LootTableCondition::fromJson(const QJsonObject &root, bool redirected) {
         return;
 
     ui->conditionTypeCombo->setCurrentIndex(condIndex);
+    initPage(condIndex);
     reset(condIndex);
     switch (condIndex) {
         case 0: { /*Block states */
@@ -599,6 +657,7 @@ void LootTableCondition::fromJson(const QJsonObject &root, bool redirected) {
 }
 
 void LootTableCondition::onTypeChanged(const int i) {
+    initPage(i);
     ui->stackedWidget->setCurrentIndex(i);
     const int nestedConditionIndex = 6;
     setTabEnabled(1, i == nestedConditionIndex);
@@ -609,16 +668,15 @@ void LootTableCondition::onTabChanged(const int i) {
         initNestedCondPage();
 }
 
-void LootTableCondition::onCurDirChanged(const QDir &dir) {
-    Q_UNUSED(dir)
-    m_conditionModel.setDatapackCategory("predicates", true);
-}
-
 void LootTableCondition::updateConditionsTab(int size) {
     setTabText(1, tr("Conditions (%1)").arg(size));
 }
 
 void LootTableCondition::reset(int index) {
+    if (!m_initializedPages.testBit(index)) {
+        return; // The page hasn't been used since its construction
+    }
+
     switch (index) {
         case 0: { /*Block states */
             ui->blockState_slot->clearItems();
@@ -888,11 +946,16 @@ void LootTableCondition::initRandChancePage() {
     });
 }
 
+void LootTableCondition::initEnchantmentModel() {
+    if (m_enchantmentModel.rowCount() == 0) {
+        m_enchantmentModel.setInfo(QStringLiteral("enchantment"),
+                                   GameInfoModel::PrependPrefix);
+    }
+}
+
 void LootTableCondition::initTableBonusPage() {
-    m_enchantmentModel.setInfo(QStringLiteral("enchantment"),
-                               GameInfoModel::PrependPrefix);
+    initEnchantmentModel();
     ui->tableBonus_enchantCombo->setModel(&m_enchantmentModel);
-    ui->toolEnchant_enchantCombo->setModel(&m_enchantmentModel);
 
     ui->tableBonus_listView->setModel(&tableBonusModel);
     ui->tableBonus_listView->installEventFilter(&viewFilter);
@@ -911,6 +974,8 @@ void LootTableCondition::initTableBonusPage() {
 }
 
 void LootTableCondition::initToolEnchantPage() {
+    initEnchantmentModel();
+    ui->toolEnchant_enchantCombo->setModel(&m_enchantmentModel);
     ui->toolEnchant_levelsInput->setModes(NumberProvider::Range);
 
     auto *delegate = new NumberProviderDelegate(this);
@@ -5,6 +5,7 @@
 #include "datawidgetcontroller.h"
 #include "gameinfomodel.h"
 
+#include <QBitArray>
 #include <QFrame>
 #include <QVBoxLayout>
 #include <QDir>
@@ -44,7 +45,6 @@ private slots:
     void toolEnchant_onAdded();
     void onTypeChanged(const int i);
     void onTabChanged(const int i);
-    void onCurDirChanged(const QDir &dir);
     void updateConditionsTab(int size);
 
 private:
@@ -73,13 +73,16 @@ private:
 
     DataWidgetControllerRecord m_timeCtrl;
     std::once_flag m_fullyInitialized;
+    QBitArray m_initializedPages;
 
     void reset(int index);
     void clearModelExceptHeaders(QStandardItemModel &model);
 
     void init();
+    void initPage(const int index);
     void initBlockStatesPage();
     void initDamageSrcPage();
+    void initEnchantmentModel();
     void initEntityScoresPage();
     void initNestedCondPage();
     void initRandChancePage();
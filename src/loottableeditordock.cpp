@@ -37,9 +37,9 @@ void LootTableEditorDock::writeJson() {
 }
 
 void LootTableEditorDock::readJson() {
-    QString &&input = m_mainWin->getCodeEditorText();
+    const QJsonValue &&input = m_mainWin->getCodeEditorJson();
 
-    ui->lootTable->fromJson(QJsonDocument::fromJson(input.toUtf8()).object());
+    ui->lootTable->fromJson(input.toObject());
 }
 
 void LootTableEditorDock::changeEvent(QEvent *event) {
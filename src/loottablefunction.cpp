@@ -18,6 +18,7 @@
 LootTableFunction::LootTableFunction(QWidget *parent) :
     QTabWidget(parent), ui(new Ui::LootTableFunction) {
     ui->setupUi(this);
+    m_initializedPages.resize(functTypes.size());
 }
 
 void LootTableFunction::init() {
@@ -41,11 +42,6 @@ void LootTableFunction::init() {
         ui->setContents_typeCombo->hide();
         ui->lootTable_typeLabel->hide();
         ui->lootTable_typeCombo->hide();
-    } else {
-        m_blockEntityTypeModel.setRegistry(QStringLiteral("block_entity_type"),
-                                           GameInfoModel::PrependPrefix);
-        ui->setContents_typeCombo->setModel(&m_blockEntityTypeModel);
-        ui->lootTable_typeCombo->setModel(&m_blockEntityTypeModel);
     }
     if (Game::version() < Game::v1_19) {
         hideComboRow(ui->functionTypeCombo, SetInstrument);
@@ -70,111 +66,192 @@ void LootTableFunction::init() {
     connect(ui->entryInterface, &DataWidgetInterface::entriesCountChanged,
             this, &LootTableFunction::updateEntriesTab);
 
-    m_enchantmentModel.setInfo(QStringLiteral("enchantment"),
-                               GameInfoModel::PrependPrefix);
-    ui->bonus_enchantCombo->setModel(&m_enchantmentModel);
+    initPage(ui->functionTypeCombo->currentIndex());
+}
 
-    ui->copyNBT_table->installEventFilter(&viewFilter);
-    connect(ui->copyNBT_addBtn, &QPushButton::clicked,
-            this, &LootTableFunction::copyNBT_onAdded);
+/*!
+ * \brief Sets up the page of the function type at \a index when it's first
+ * activated, so that the models of the other pages aren't loaded.
+ */
+void LootTableFunction::initPage(const int index) {
+    if ((index < 0) || (index >= m_initializedPages.size())
+        || m_initializedPages.testBit(index)) {
+        return;
+    }
+    m_initializedPages.setBit(index);
 
-    initBlocksModel();
+    switch (index) {
+        case ApplyBonus: {
+            initEnchantmentModel();
+            ui->bonus_enchantCombo->setModel(&m_enchantmentModel);
+            break;
+        }
 
-    ui->copyState_blockSlot->setAcceptMultiple(false);
-    ui->copyState_blockSlot->setAcceptTag(false);
-    ui->copyState_blockSlot->setSelectCategory(
-        InventorySlot::SelectCategory::Blocks);
-    ui->copyState_list->installEventFilter(&viewFilter);
-    connect(ui->copyState_addBtn, &QPushButton::clicked,
-            this, &LootTableFunction::copyState_onAdded);
+        case CopyNbt: {
+            ui->copyNBT_table->installEventFilter(&viewFilter);
+            connect(ui->copyNBT_addBtn, &QPushButton::clicked,
+                    this, &LootTableFunction::copyNBT_onAdded);
 
-    if (Game::version() < Game::v1_17) {
-        hideComboRow(ui->copyNBT_entityCombo, 4);
-        ui->copyNBT_storageLabel->hide();
-        ui->copyNBT_storageEdit->hide();
-    }
-    connect(ui->copyNBT_entityCombo,
-            qOverload<int>(&QComboBox::currentIndexChanged),
-            this, [this](int index){
-        ui->copyNBT_storageLabel->setEnabled(index == 4);
-        ui->copyNBT_storageEdit->setEnabled(index == 4);
-    });
+            if (Game::version() < Game::v1_17) {
+                hideComboRow(ui->copyNBT_entityCombo, 4);
+                ui->copyNBT_storageLabel->hide();
+                ui->copyNBT_storageEdit->hide();
+            }
+            connect(ui->copyNBT_entityCombo,
+                    qOverload<int>(&QComboBox::currentIndexChanged),
+                    this, [this](int entityIndex){
+                ui->copyNBT_storageLabel->setEnabled(entityIndex == 4);
+                ui->copyNBT_storageEdit->setEnabled(entityIndex == 4);
+            });
+            break;
+        }
 
+        case CopyState: {
+            ui->copyState_blockSlot->setAcceptMultiple(false);
+            ui->copyState_blockSlot->setAcceptTag(false);
+            ui->copyState_blockSlot->setSelectCategory(
+                InventorySlot::SelectCategory::Blocks);
+            ui->copyState_list->installEventFilter(&viewFilter);
+            connect(ui->copyState_addBtn, &QPushButton::clicked,
+                    this, &LootTableFunction::copyState_onAdded);
+            break;
+        }
 
-    ui->enchantRand_enchantCombo->setModel(&m_enchantmentModel);
-    ui->enchantRand_list->installEventFilter(&viewFilter);
-    connect(ui->enchantRand_addBtn, &QPushButton::clicked,
-            this, &LootTableFunction::enchantRand_onAdded);
-
-    if (Game::version() >= Game::v1_19) {
-        initComboModelView(QStringLiteral("tag/structure"),
-                           featuresModel, ui->map_destCombo,
-                           true, true, false, true);
-    } else if (Game::version() == Game::v1_18_2) {
-        initComboModelView(QStringLiteral("tag/configured_structure_feature"),
-                           featuresModel, ui->map_destCombo, true, true, true);
-        initComboModelViewFromRegistry(
-            QStringLiteral("worldgen/configured_structure_feature"),
-            featuresModel, ui->map_destCombo, false);
-    } else {
-        initComboModelView(QStringLiteral("feature"), featuresModel,
-                           ui->map_destCombo);
-    }
-    m_mapIconModel.setInfo(QStringLiteral("map_icon"));
-    ui->map_decoCombo->setModel(&m_mapIconModel);
+        case EnchantRandomly: {
+            initEnchantmentModel();
+            ui->enchantRand_enchantCombo->setModel(&m_enchantmentModel);
+            ui->enchantRand_list->installEventFilter(&viewFilter);
+            connect(ui->enchantRand_addBtn, &QPushButton::clicked,
+                    this, &LootTableFunction::enchantRand_onAdded);
+            break;
+        }
+
+        case ExplorationMap: {
+            if (Game::version() >= Game::v1_19) {
+                initComboModelView(QStringLiteral("tag/structure"),
+                                   featuresModel, ui->map_destCombo,
+                                   true, true, false, true);
+            } else if (Game::version() == Game::v1_18_2) {
+                initComboModelView(
+                    QStringLiteral("tag/configured_structure_feature"),
+                    featuresModel, ui->map_destCombo, true, true, true);
+                initComboModelViewFromRegistry(
+                    QStringLiteral("worldgen/configured_structure_feature"),
+                    featuresModel, ui->map_destCombo, false);
+            } else {
+                initComboModelView(QStringLiteral("feature"), featuresModel,
+                                   ui->map_destCombo);
+            }
+            m_mapIconModel.setInfo(QStringLiteral("map_icon"));
+            ui->map_decoCombo->setModel(&m_mapIconModel);
+            break;
+        }
 
-    ui->limitCount_limitInput->setModes(NumberProvider::ExactAndRange);
+        case LimitCount: {
+            ui->limitCount_limitInput->setModes(NumberProvider::ExactAndRange);
+            break;
+        }
 
-    ui->lootEnchant_countInput->setModes(NumberProvider::ExactAndRange);
+        case LootingEnchant: {
+            ui->lootEnchant_countInput->setModes(NumberProvider::ExactAndRange);
+            break;
+        }
 
-    m_functionModel.setOptionalItem(false);
-    m_functionModel.setDatapackCategory("item_modifiers");
-    ui->ref_nameEdit->setCompleter(m_functionModel.createCompleter());
+        case Reference: {
+            m_functionModel.setOptionalItem(false);
+            m_functionModel.setDatapackCategory("item_modifiers");
+            ui->ref_nameEdit->setCompleter(m_functionModel.createCompleter());
+            break;
+        }
 
-    connect(ui->seq_linkLabel, &QLabel::linkActivated, this, [this](){
-        setCurrentIndex(1);
-    });
+        case Sequence: {
+            connect(ui->seq_linkLabel, &QLabel::linkActivated, this, [this](){
+                setCurrentIndex(1);
+            });
+            break;
+        }
 
-    ui->setAttr_amountInput->setModes(NumberProvider::Range);
-    m_attributeModel.setInfo(QStringLiteral("attribute"),
-                             GameInfoModel::PrependPrefix);
-    ui->setAttr_attrCombo->setModel(&m_attributeModel);
+        case SetAttributes: {
+            ui->setAttr_amountInput->setModes(NumberProvider::Range);
+            m_attributeModel.setInfo(QStringLiteral("attribute"),
+                                     GameInfoModel::PrependPrefix);
+            ui->setAttr_attrCombo->setModel(&m_attributeModel);
 
-    NumberProviderDelegate *delegate = new NumberProviderDelegate(this);
-    delegate->setInputModes(NumberProvider::ExactAndRange);
+            auto *delegate = new NumberProviderDelegate(this);
+            delegate->setInputModes(NumberProvider::ExactAndRange);
 
-    ui->setAttr_table->setItemDelegate(delegate);
-    ui->setAttr_table->installEventFilter(&viewFilter);
+            ui->setAttr_table->setItemDelegate(delegate);
+            ui->setAttr_table->installEventFilter(&viewFilter);
 
-    connect(ui->setAttr_addBtn, &QPushButton::clicked,
-            this, &LootTableFunction::setAttr_onAdded);
+            connect(ui->setAttr_addBtn, &QPushButton::clicked,
+                    this, &LootTableFunction::setAttr_onAdded);
+            break;
+        }
 
-    initBannerPatterns();
+        case SetBannerPattern: {
+            initBannerPatterns();
+            break;
+        }
 
-    connect(ui->setContents_linkLabel, &QLabel::linkActivated, this, [this](){
-        setCurrentIndex(2);
-    });
+        case SetContents: {
+            connect(ui->setContents_linkLabel, &QLabel::linkActivated,
+                    this, [this](){
+                setCurrentIndex(2);
+            });
+            if (Game::version() >= Game::v1_18) {
+                initBlockEntityTypeModel();
+                ui->setContents_typeCombo->setModel(&m_blockEntityTypeModel);
+            }
+            break;
+        }
+
+        case SetEnchantments: {
+            initEnchantmentModel();
+            ui->setEnchant_combo->setModel(&m_enchantmentModel);
+            ui->setEnchant_table->appendColumnMapping(QString(),
+                                                      ui->setEnchant_combo);
+            ui->setEnchant_table->appendColumnMapping(
+                QString(), ui->setEnchant_numberProvider);
+            break;
+        }
+
+        case SetLootTable: {
+            m_lootTableModel.setOptionalItem(false);
+            m_lootTableModel.setDatapackCategory("loot_tables", true);
+            ui->lootTable_idEdit->setCompleter(
+                m_lootTableModel.createCompleter());
+            if (Game::version() >= Game::v1_18) {
+                initBlockEntityTypeModel();
+                ui->lootTable_typeCombo->setModel(&m_blockEntityTypeModel);
+            }
+            break;
+        }
 
-    ui->setEnchant_combo->setModel(&m_enchantmentModel);
-    ui->setEnchant_table->appendColumnMapping(QString(), ui->setEnchant_combo);
-    ui->setEnchant_table->appendColumnMapping(QString(),
-                                              ui->setEnchant_numberProvider);
-
-    m_lootTableModel.setOptionalItem(false);
-    m_lootTableModel.setDatapackCategory("loot_tables", true);
-    ui->lootTable_idEdit->setCompleter(m_lootTableModel.createCompleter());
-
-    ui->setName_textEdit->setOneLine(true);
-    ui->setName_textEdit->setDarkMode(true);
-
-    m_effectModel.setInfo(QStringLiteral("effect"),
-                          GameInfoModel::PrependPrefix);
-    ui->stewEffect_effectCombo->setModel(&m_effectModel);
-    connect(ui->stewEffect_addBtn, &QPushButton::clicked,
-            this, &LootTableFunction::effectStew_onAdded);
-    m_potionModel.setInfo(QStringLiteral("potion"),
-                          GameInfoModel::PrependPrefix);
-    ui->setPotion_potionCombo->setModel(&m_potionModel);
+        case SetName: {
+            ui->setName_textEdit->setOneLine(true);
+            ui->setName_textEdit->setDarkMode(true);
+            break;
+        }
+
+        case SetPotion: {
+            m_potionModel.setInfo(QStringLiteral("potion"),
+                                  GameInfoModel::PrependPrefix);
+            ui->setPotion_potionCombo->setModel(&m_potionModel);
+            break;
+        }
+
+        case SetStewEffect: {
+            m_effectModel.setInfo(QStringLiteral("effect"),
+                                  GameInfoModel::PrependPrefix);
+            ui->stewEffect_effectCombo->setModel(&m_effectModel);
+            connect(ui->stewEffect_addBtn, &QPushButton::clicked,
+                    this, &LootTableFunction::effectStew_onAdded);
+            break;
+        }
+
+        default:
+            break;
+    }
 }
 
 LootTableFunction::~LootTableFunction() {
@@ -486,6 +563,7 @@ void LootTableFunction::fromJson(const QJsonObject &root) {
         return;
 
     ui->functionTypeCombo->setCurrentIndex(index);
+    initPage(index);
 
     switch (index) {
         case ApplyBonus: { /*Apply bonus */
@@ -962,6 +1040,8 @@ void LootTableFunction::showEvent(QShowEvent *event) {
 void LootTableFunction::onTypeChanged(int index) {
     const int maxIndex = ui->stackedWidget->count() - 1;
 
+    initPage(index);
+
     if (index > maxIndex)
         ui->stackedWidget->setCurrentIndex(maxIndex);
     else
@@ -1106,25 +1186,17 @@ void LootTableFunction::updateEntriesTab(int size) {
     setTabText(2, tr("Entries (%1)").arg(size));
 }
 
-void LootTableFunction::initBlocksModel() {
-    const auto &blocksInfo = Game::getInfo("block");
-
-    blocksModel.appendRow(new QStandardItem(tr("(not set)")));
-    const auto &blockKeys = blocksInfo.keys();
-    for (const auto &key : blockKeys) {
-        InventoryItem invItem(key);
-        auto         *item = new QStandardItem();
-        item->setIcon(QIcon(invItem.getPixmap()));
-        if (invItem.getName().isEmpty()) {
-            auto name = blocksInfo.value(key).toMap().value("name").toString();
-            item->setText(name);
-        } else {
-            item->setText(invItem.getName());
-        }
-        QVariant vari;
-        vari.setValue(invItem);
-        item->setData(vari, Qt::UserRole + 1);
-        blocksModel.appendRow(item);
+void LootTableFunction::initEnchantmentModel() {
+    if (m_enchantmentModel.rowCount() == 0) {
+        m_enchantmentModel.setInfo(QStringLiteral("enchantment"),
+                                   GameInfoModel::PrependPrefix);
+    }
+}
+
+void LootTableFunction::initBlockEntityTypeModel() {
+    if (m_blockEntityTypeModel.rowCount() == 0) {
+        m_blockEntityTypeModel.setRegistry(
+            QStringLiteral("block_entity_type"), GameInfoModel::PrependPrefix);
     }
 }
 
@@ -4,6 +4,7 @@
 #include "vieweventfilter.h"
 #include "gameinfomodel.h"
 
+#include <QBitArray>
 #include <QTabWidget>
 #include <QStandardItemModel>
 
@@ -72,7 +73,6 @@ private:
     };
 
     GameInfoModel m_attributeModel;
-    QStandardItemModel blocksModel;
     GameInfoModel m_blockEntityTypeModel;
     GameInfoModel m_enchantmentModel;
     GameInfoModel m_effectModel;
@@ -105,9 +105,12 @@ private:
     Ui::LootTableFunction *ui;
 
     std::once_flag m_fullyInitialized;
+    QBitArray m_initializedPages;
 
     void init();
-    void initBlocksModel();
+    void initPage(const int index);
+    void initEnchantmentModel();
+    void initBlockEntityTypeModel();
     void initCondInterface();
     void initFuncInterface();
     void initEntryInterface();
@@ -1,4 +1,5 @@
 #include "mainwindow.h"
+#include "gamedatacache.h"
 
 #include <QApplication>
 #include <QCommandLineParser>
@@ -52,5 +53,7 @@ int main(int argc, char *argv[]) {
 
     qInfo() << "Appication startup completed.";
 
-    return QApplication::exec();
+    const int exitCode = QApplication::exec();
+    GameDataCache::instance()->logStatistics();
+    return exitCode;
 }
@@ -15,11 +15,14 @@
 #include "itemmodifierdock.h"
 #include "advancementtabdock.h"
 #include "statisticsdialog.h"
+#include "datapackindex.h"
+#include "symbolindex.h"
 #include "rawjsontexteditor.h"
 #include "darkfusionstyle.h"
 #include "norwegianwoodstyle.h"
 
 #include "game.h"
+#include "mappedfile.h"
 #include "platforms/windows_specific.h"
 
 #include "QSimpleUpdater.h"
@@ -49,6 +52,8 @@ static const QString updateDefUrl = QStringLiteral(
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), ui(new Ui::MainWindow),
     m_systemThemeHelper{new libqdark::SystemThemeHelper(this)} {
+    // The symbol index creates the datapack index, so it's destroyed first
+    SymbolIndex::instance();
     ui->setupUi(this);
 
     m_initialStyleId = style()->objectName();
@@ -73,6 +78,9 @@ MainWindow::MainWindow(QWidget *parent)
             this, &MainWindow::onCurFileChanged);
     connect(ui->datapackTreeView, &DatapackTreeView::openFileRequested,
             ui->tabbedInterface, &TabbedDocumentInterface::onOpenFile);
+    connect(ui->datapackTreeView,
+            &DatapackTreeView::openFileWithLineRequested,
+            ui->tabbedInterface, &TabbedDocumentInterface::onOpenFileWithLine);
     connect(ui->tabbedInterface,
             &TabbedDocumentInterface::updateStatusBarRequest,
             m_statusBar, &StatusBar::updateStatusFrom);
@@ -521,20 +529,32 @@ void MainWindow::readPrefSettings(QSettings &settings, bool fromDialog) {
             emit gameVersionChanged(gameVer);
         }
     }
+    // In MiB, not exposed in the settings dialog
+    const int cacheBudget = settings.value(
+        QStringLiteral("dataCacheBudget"), 0).toInt();
+    GameDataCache::instance()->setByteBudget(
+        (cacheBudget > 0) ? size_t(cacheBudget) * 1024 * 1024
+                          : GameDataCache::defaultByteBudget);
     const auto &&syntaxPath =
         settings.value("customCommandSyntaxFilePath").toString();
-    if (!syntaxPath.isEmpty()) {
-        Command::Schema::SchemaLoader loader{ syntaxPath };
-        if (loader.lastError().isEmpty()) {
-            Command::MinecraftParser::setGameVer(Game::version(), false);
-            Command::MinecraftParser::setSchema(loader.tree());
-            qInfo() << "Command syntax tree has been overriden by" <<
-                syntaxPath;
+    // The schema is only reloaded if its game version or file has changed
+    const QString &&schemaSource = Game::versionString() + '\n' + syntaxPath;
+    if (schemaSource != m_schemaSource) {
+        m_schemaSource = schemaSource;
+        if (!syntaxPath.isEmpty()) {
+            Command::Schema::SchemaLoader loader{ syntaxPath };
+            if (loader.lastError().isEmpty()) {
+                Command::MinecraftParser::setSchema(loader.tree(),
+                                                    loader.checksum(),
+                                                    Game::version());
+                qInfo() << "Command syntax tree has been overriden by" <<
+                    syntaxPath;
+            } else {
+                Command::MinecraftParser::setGameVer(Game::version());
+            }
         } else {
             Command::MinecraftParser::setGameVer(Game::version());
         }
-    } else {
-        Command::MinecraftParser::setGameVer(Game::version());
     }
     settings.endGroup();
 
@@ -624,6 +644,13 @@ void MainWindow::loadFolder(const QString &dirPath,
 
     QDir dir(dirPath);
     QDir::setCurrent(dir.absolutePath());
+    auto *index = DatapackIndex::instance();
+    if (!index->dirPath().isEmpty()
+        && !index->isLoaded(QDir::currentPath())) {
+        // Drop the IDs and symbols of the previous datapack first
+        index->clear();
+    }
+    index->load(QDir::currentPath());
     ui->datapackTreeView->load(dir);
 
     if (!curDir.path().isEmpty()) {
@@ -670,20 +697,14 @@ bool MainWindow::folderIsVaild(const QDir &dir, bool reportError) {
 
 PackMetaInfo MainWindow::readPackMcmeta(const QString &filepath,
                                         QString &errorMsg) const {
-    QFile        file(filepath);
-    PackMetaInfo ret;
+    const MappedFile file(filepath);
+    PackMetaInfo     ret;
 
-    if (!file.open(QIODevice::ReadOnly)) {
+    if (!file.isOpen()) {
         errorMsg = file.errorString();
         return ret;
     } else {
-        QTextStream in(&file);
-        in.setCodec("UTF-8");
-        const QString &&json_string = in.readAll();
-        file.close();
-
-        QJsonDocument &&json_doc = QJsonDocument::fromJson(
-            json_string.toUtf8());
+        QJsonDocument &&json_doc = QJsonDocument::fromJson(file.bytes());
 
         if (json_doc.isNull()) {
             errorMsg = QT_TR_NOOP("The file is not a vaild JSON file.");
@@ -1082,6 +1103,17 @@ QString MainWindow::getCodeEditorText() {
         return QString();
 }
 
+/*!
+ * \brief Returns the JSON value of the current editor, or a null value if
+ * there's no editor or its document has syntax errors.
+ */
+QJsonValue MainWindow::getCodeEditorJson() const {
+    if (auto *editor = ui->tabbedInterface->getCodeEditor())
+        return editor->jsonValue();
+    else
+        return QJsonValue();
+}
+
 MainWindow::~MainWindow() {
     delete ui;
 }
@@ -43,6 +43,7 @@ public:
 
     void setCodeEditorText(const QString &text);
     QString getCodeEditorText();
+    QJsonValue getCodeEditorJson() const;
     void readPrefSettings(QSettings &settings, bool fromDialog = false);
 
     PackMetaInfo getPackInfo() const;
@@ -108,6 +109,7 @@ private:
     libqdark::SystemThemeHelper *m_systemThemeHelper = nullptr;
     QVector<QAction *> recentFoldersActions;
     QString tempGameVerStr;
+    QString m_schemaSource;
     QString m_initialStyleId;
     const int maxRecentFoldersActions = 10;
 
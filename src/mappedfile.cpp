@@ -0,0 +1,219 @@
+#include "mappedfile.h"
+
+#include <QCoreApplication>
+#include <QtAlgorithms>
+
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define MAPPEDFILE_USE_SSE2
+#endif
+
+namespace {
+    constexpr char16_t replacementChar = QChar::ReplacementCharacter;
+
+    /*!
+     * \internal
+     * \brief Decodes the multi-byte UTF-8 sequence at \a src into \a dst and
+     * returns the start of the next sequence. Invalid bytes are decoded as
+     * replacement characters one by one.
+     */
+    const uchar * decodeSequence(const uchar *src, const uchar *end,
+                                 char16_t * &dst) {
+        const uchar lead  = *src;
+        int         count = 0;
+        char32_t    code  = 0;
+        char32_t    min   = 0;
+
+        if ((lead & 0xE0) == 0xC0) {
+            count = 1;
+            code  = lead & 0x1F;
+            min   = 0x80;
+        } else if ((lead & 0xF0) == 0xE0) {
+            count = 2;
+            code  = lead & 0x0F;
+            min   = 0x800;
+        } else if ((lead & 0xF8) == 0xF0) {
+            count = 3;
+            code  = lead & 0x07;
+            min   = 0x10000;
+        } else {
+            *dst++ = replacementChar;
+            return src + 1;
+        }
+
+        if (end - src <= count) {
+            *dst++ = replacementChar;
+            return src + 1;
+        }
+        for (int i = 1; i <= count; ++i) {
+            if ((src[i] & 0xC0) != 0x80) {
+                *dst++ = replacementChar;
+                return src + 1;
+            }
+            code = (code << 6) | (src[i] & 0x3F);
+        }
+        if ((code < min) || (code > 0x10FFFF)
+            || ((code >= 0xD800) && (code <= 0xDFFF))) {
+            *dst++ = replacementChar;
+            return src + 1;
+        }
+
+        if (QChar::requiresSurrogates(code)) {
+            *dst++ = QChar::highSurrogate(code);
+            *dst++ = QChar::lowSurrogate(code);
+        } else {
+            *dst++ = char16_t(code);
+        }
+        return src + count + 1;
+    }
+}
+
+/*!
+ * \brief Opens and maps the file at \a path.
+ */
+MappedFile::MappedFile(const QString &path) : m_file(path) {
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_errorString = m_file.errorString();
+        return;
+    }
+
+    m_size = m_file.size();
+    if (m_size > std::numeric_limits<int>::max()) {
+        m_errorString = QCoreApplication::translate("MappedFile",
+                                                    "The file is too large.");
+        return;
+    }
+
+    m_begin = (m_size > 0) ? m_file.map(0, m_size) : nullptr;
+    if (!m_begin) {
+        m_data  = m_file.readAll();
+        m_begin = reinterpret_cast<const uchar *>(m_data.constData());
+        m_size  = m_data.size();
+    }
+    m_isOpen = true;
+}
+
+bool MappedFile::isOpen() const {
+    return m_isOpen;
+}
+
+QString MappedFile::errorString() const {
+    return m_errorString;
+}
+
+/*!
+ * \brief Returns the contents of the file without copying them. The returned
+ * array must not outlive this object.
+ */
+QByteArray MappedFile::bytes() const {
+    if (!m_isOpen) {
+        return QByteArray();
+    }
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(m_begin),
+                                   m_size);
+}
+
+/*!
+ * \brief Returns the contents of the file decoded from UTF-8, or a null
+ * string if the file isn't open.
+ *
+ * \sa decodeText()
+ */
+QString MappedFile::text() const {
+    if (!m_isOpen) {
+        return QString();
+    }
+    return decodeText(reinterpret_cast<const char *>(m_begin), m_size);
+}
+
+/*!
+ * \brief Returns the text of the file at \a path, or a null string if it
+ * can't be read, in which case the reason is stored in \a errorString.
+ */
+QString MappedFile::readText(const QString &path, QString *errorString) {
+    const MappedFile file(path);
+
+    if (!file.isOpen()) {
+        if (errorString) {
+            *errorString = file.errorString();
+        }
+        return QString();
+    }
+    return file.text();
+}
+
+/*!
+ * \brief Decodes \a size bytes of UTF-8 \a data into a string in a single
+ * pass, skipping the byte order mark and converting \c "\r\n" and \c "\r"
+ * line endings to \c "\n".
+ *
+ * A UTF-8 sequence never has more bytes than the UTF-16 code units it's
+ * decoded to, so the string is allocated once with the size of the data.
+ * Runs of ASCII characters are widened 16 bytes at a time where SSE2 is
+ * available.
+ */
+QString MappedFile::decodeText(const char *data, const qint64 size) {
+    const auto *src = reinterpret_cast<const uchar *>(data);
+    const auto *end = src + size;
+
+    if ((size >= 3) && (src[0] == 0xEF) && (src[1] == 0xBB)
+        && (src[2] == 0xBF)) {
+        src += 3;
+    }
+
+    QString text(int(end - src), Qt::Uninitialized);
+    auto   *dst   = reinterpret_cast<char16_t *>(text.data());
+    auto   *begin = dst;
+
+    while (src < end) {
+#ifdef MAPPEDFILE_USE_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i cr   = _mm_set1_epi8('\r');
+        while (end - src >= 16) {
+            const __m128i chunk =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+            // Bytes which are either non-ASCII or carriage returns
+            const int special = _mm_movemask_epi8(chunk)
+                                | _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, cr));
+            if (special != 0) {
+                for (int i = qCountTrailingZeroBits(uint(special)); i > 0;
+                     --i) {
+                    *dst++ = *src++;
+                }
+                break;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                             _mm_unpacklo_epi8(chunk, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 8),
+                             _mm_unpackhi_epi8(chunk, zero));
+            src += 16;
+            dst += 16;
+        }
+        if (src == end) {
+            break;
+        }
+#endif
+        const uchar ch = *src;
+        if (ch == '\r') {
+            *dst++ = u'\n';
+            ++src;
+            if ((src < end) && (*src == '\n')) {
+                ++src;
+            }
+        } else if (ch < 0x80) {
+            *dst++ = ch;
+            ++src;
+        } else {
+            src = decodeSequence(src, end, dst);
+        }
+    }
+
+    text.resize(int(dst - begin));
+    if (text.size() < text.capacity() * 3 / 4) {
+        // Mostly non-ASCII text, e.g. CJK, takes less space than its bytes
+        text.squeeze();
+    }
+    return text;
+}
@@ -0,0 +1,37 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <QFile>
+
+/*!
+ * \brief A read-only file which is mapped into memory.
+ *
+ * Files which can't be mapped (e.g. compressed resources) are read at once
+ * instead. The bytes of the file are valid while the object exists, so they
+ * can be passed to parsers such as QJsonDocument::fromJson() without being
+ * copied.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const QString &path);
+
+    bool isOpen() const;
+    QString errorString() const;
+
+    QByteArray bytes() const;
+    QString text() const;
+
+    static QString readText(const QString &path,
+                            QString *errorString = nullptr);
+    static QString decodeText(const char *data, qint64 size);
+
+private:
+    QFile m_file;
+    QByteArray m_data; // Only used if the file can't be mapped
+    const uchar *m_begin = nullptr;
+    qint64 m_size        = 0;
+    QString m_errorString;
+    bool m_isOpen = false;
+};
+
+#endif // MAPPEDFILE_H
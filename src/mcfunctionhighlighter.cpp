@@ -1,12 +1,17 @@
 #include "mcfunctionhighlighter.h"
 
-#include "parsers/command/mcfunctionparser.h"
-#include "parsers/command/visitors/nodeformatter.h"
-#include "parsers/command/visitors/sourceprinter.h"
+#include "parsers/command/nodes/filenode.h"
 
 #include <QTextDocument>
 #include <QAbstractTextDocumentLayout>
 #include <QDebug>
+#include <QElapsedTimer>
+
+namespace {
+    // Time spent formatting off-screen blocks before yielding to the event
+    // loop, in milliseconds
+    constexpr int batchDuration = 8;
+}
 
 
 QDebug operator<<(QDebug debug, const QTextLayout::FormatRange &value) {
@@ -17,11 +22,39 @@ QDebug operator<<(QDebug debug, const QTextLayout::FormatRange &value) {
     return debug;
 }
 
-McfunctionHighlighter::McfunctionHighlighter(QTextDocument *parent,
-                                             Command::McfunctionParser *parser)
-    : Highlighter(parent), m_parser(parser) {
+McfunctionHighlighter::McfunctionHighlighter(QTextDocument *parent)
+    : Highlighter(parent) {
     setHasAdvancedHighlighting(true);
     setupRules();
+
+    m_batchTimer.setInterval(0);
+    connect(&m_batchTimer, &QTimer::timeout,
+            this, &McfunctionHighlighter::formatNextBatch);
+}
+
+/*!
+ * \brief Sets the syntax tree of the document and the format ranges of
+ * its logical lines, which are used by the next rehighlightDelayed() call.
+ */
+void McfunctionHighlighter::setAnalysisResult(
+    const QSharedPointer<Command::FileNode> &tree,
+    const QVector<FormatRanges> &lineFormats) {
+    m_syntaxTree  = tree;
+    m_lineFormats = lineFormats;
+
+    // Drop the split lines whose nodes are no longer in the tree
+    if (!m_splitLines.isEmpty()) {
+        QHash<const Command::ParseNode *, SplitLine> splitLines;
+        if (tree) {
+            for (const auto &line: tree->lines()) {
+                if (const auto &&it = m_splitLines.constFind(line.get());
+                    it != m_splitLines.cend()) {
+                    splitLines.insert(it.key(), *it);
+                }
+            }
+        }
+        m_splitLines = std::move(splitLines);
+    }
 }
 
 void McfunctionHighlighter::setupRules() {
@@ -60,35 +93,14 @@ void McfunctionHighlighter::highlightBlock(const QString &text) {
                                 m_palette[rule.formatRole]);
                 }
             }
-        } else {
-            for (const auto &range:
-                 qAsConst(m_formats.at(m_curChangedBlockIndex))) {
+        } else if (m_currentRanges) {
+            for (const auto &range: qAsConst(*m_currentRanges)) {
                 mergeFormat(range.start, range.length, range.format);
             }
-            ++m_curChangedBlockIndex;
         }
     }
 }
 
-void McfunctionHighlighter::rehighlightChangedBlocks() {
-    const auto &blocks = changedBlocks();
-
-    if (blocks.isEmpty()) {
-        return;
-    } else if (blocks.size() == 1) {
-        Highlighter::rehighlightBlock(blocks.at(0));
-    } else if (blocks.size() == document()->blockCount()) {
-        Highlighter::rehighlight();
-    } else {
-        for (const auto &block: blocks) {
-            Highlighter::rehighlightBlock(block);
-        }
-    }
-
-    m_formats.clear();
-    m_curChangedBlockIndex = 0;
-}
-
 QVector<Command::FormatRanges> McfunctionHighlighter::splitRangesToLines(
     const FormatRanges &ranges, QVector<int> &breakPositions,
     const int offset) {
@@ -126,126 +138,246 @@ QVector<Command::FormatRanges> McfunctionHighlighter::splitRangesToLines(
     return lines;
 }
 
-void McfunctionHighlighter::rehighlightDelayed() {
-    Q_ASSERT(m_parser != nullptr);
-
-    const auto &&result      = m_parser->syntaxTree();
-    const auto &&resultLines = result->lines();
-    auto        &blocks      = changedBlocks();
-    Q_ASSERT(!blocks.isEmpty());
-
-//    qDebug() << "Initial range:" << blocks.first().blockNumber() << '-' <<
-//        blocks.last().blockNumber();
-
-    auto block = blocks.front();
-    while (block.isValid()
-           && (result->sourceMapper().logicalLinesIndexOf(block.blockNumber())
-               == -1)) {
-        block = block.previous();
-        blocks.prepend(std::move(block));
-    }
-    block = blocks.back();
-    while (block.isValid() && canConcatenate(block.text().trimmed())) {
-        block = block.next();
-        blocks << std::move(block);
-    }
-
-//    qDebug() << "Final range:" << blocks.first().blockNumber() << '-' <<
-//        blocks.last().blockNumber();
-
-    m_formats.resize(blocks.size());
-    Command::NodeFormatter formatter(m_palette);
-
-    int          i              = -1;
-    const auto  &backslashMap   = result->sourceMapper().backslashMap;
-    const auto &&breakPosList   = backslashMap.keys();
-    auto       &&breakPositions = breakPosList.toVector();
-    for (auto iter = blocks.cbegin(); iter != blocks.cend(); ++iter) {
-//        qDebug() << "Block" << iter->blockNumber() << "at pos" <<
-//            iter->position() << "text:" << iter->text();
-        const int lineNumber = result->sourceMapper().logicalLinesIndexOf(
-            iter->blockNumber());
-        if (lineNumber == -1) {
+/*!
+ * \brief Returns the format ranges of each physical line of the logical
+ * \a line which starts at the physical position \a physPos.
+ *
+ * Splitting the ranges of a line continued with backslashes requires
+ * the source mapping, so the result is cached by the node of the line.
+ * Lines with the same logical text share a node even if they are split
+ * differently, so the cached ranges are only reused if the line has the same
+ * line breaks and indentation, and the analyzer hasn't formatted the line
+ * again, which it only does if the node or the palette has changed.
+ */
+QVector<McfunctionHighlighter::FormatRanges> McfunctionHighlighter::splitLine(
+    const int line, const int physPos) {
+    if (!m_syntaxTree || (line >= m_lineFormats.size())
+        || (line >= m_syntaxTree->size())
+        || (m_syntaxTree->at(line)->kind() != Command::ParseNode::Kind::Root)) {
+        return {};
+    }
+
+    const auto &ranges       = m_lineFormats.at(line);
+    const auto &mapper       = m_syntaxTree->sourceMapper();
+    const auto &backslashMap = mapper.backslashMap;
+    if (backslashMap.isEmpty() || ranges.isEmpty()) {
+        return { ranges };
+    }
+
+    // Only the backslashes before the end of the last range split the ranges.
+    // The layout holds the relative position and the trivia length of each.
+    const int    blockPos   = mapper.logicalPosOf(physPos);
+    const int    lineLength = ranges.constLast().start
+                              + ranges.constLast().length;
+    QVector<int> breakPositions;
+    QVector<int> layout;
+    for (auto it = backslashMap.lowerBound(blockPos);
+         (it != backslashMap.cend()) && (it.key() - blockPos < lineLength);
+         ++it) {
+        breakPositions << it.key();
+        layout << it.key() - blockPos << it->trivia.length();
+    }
+    if (breakPositions.isEmpty()) {
+        return { ranges };
+    }
+
+    const auto &node = m_syntaxTree->at(line);
+    if (const auto &&it = m_splitLines.constFind(node.get());
+        (it != m_splitLines.cend())
+        && (it->source.constData() == ranges.constData())
+        && (it->layout == layout)) {
+        return it->lines;
+    }
+
+    auto &&lines = splitRangesToLines(ranges, breakPositions, -blockPos);
+    if (lines.size() <= 1) {
+        return { ranges };
+    }
+
+    for (int i = 0; i < lines.size(); ++i) {
+        auto &lineRanges = lines[i];
+        if (lineRanges.isEmpty()) {
             continue;
         }
-        ++i;
-        const QString &&lineText   = iter->text();
-        auto           *lineResult = resultLines[lineNumber].get();
-        if (lineResult->kind() == Command::ParseNode::Kind::Root) {
-            Command::SourcePrinter printer;
-            printer.startVisiting(lineResult);
-            if (printer.source() != lineText) {
-//                qDebug() << lineText;
-//                qDebug() << printer.source();
-            }
-
-            formatter.startVisiting(lineResult);
-            const auto &ranges = formatter.formatRanges();
-            if (!backslashMap.empty()) {
-                const auto &posMapping =
-                    result->sourceMapper().logicalPositions;
-
-                int blockPos = iter->position();
-                if (!posMapping.isEmpty()
-                    && blockPos >= posMapping.cbegin().key()) {
-                    auto &&nearest = posMapping.upperBound(iter->position());
-                    if (nearest != posMapping.begin()) {
-                        nearest--;
-                    }
-                    blockPos += nearest.value() - nearest.key();
-                }
 
-                auto &&splitedRanges = splitRangesToLines(
-                    ranges, breakPositions, -blockPos);
-
-                const bool hasSingleLine = splitedRanges.size() == 1;
-                if (hasSingleLine) {
-                    m_formats[i] = ranges;
-                } else {
-                    bool isFirstLine = true;
-
-                    int wsOffset = 0;
-                    for (auto &line: splitedRanges) {
-                        if (!isFirstLine && (iter != blocks.cend())) {
-                            ++iter;
-
-                            auto it = backslashMap.find(
-                                result->sourceMapper().logicalPositions.value(
-                                    iter->position()));
-                            if (it != backslashMap.end()) {
-                                wsOffset = it->trivia.length() - 2;
-                            }
-                        }
-                        int firstPos = line.first().start;
-
-                        for (auto &range: line) {
-                            if (!isFirstLine) {
-                                range.start -= firstPos;
-                                range.start += wsOffset;
-                            }
-                            if (range != line.last()) {
-                                range.length += 1;
-                            }
-                        }
-                        if (isFirstLine) {
-                            isFirstLine = false;
-                        }
-                    }
-                    for (int j = 0; j < splitedRanges.size(); ++j) {
-                        m_formats[i + j] = splitedRanges.at(j);
-                    }
-                    i += splitedRanges.size() - 1;
-                }
-            } else {
-                m_formats[i] = ranges;
+        // The trivia of a break is the backslash, the line feed and
+        // the indentation of the next physical line
+        const int wsOffset = (i > 0) ? layout.value(2 * i - 1) - 2 : 0;
+        const int firstPos = lineRanges.constFirst().start;
+        for (int j = 0; j < lineRanges.size(); ++j) {
+            auto &range = lineRanges[j];
+            if (i > 0) {
+                range.start += wsOffset - firstPos;
+            }
+            if (j < lineRanges.size() - 1) {
+                range.length += 1;
             }
-            formatter.reset();
         }
     }
 
+    m_splitLines.insert(node.get(), { node, ranges, layout, lines });
+    return lines;
+}
+
+/*!
+ * \brief Moves the pending blocks which are visible in the editor before
+ * the other ones and returns their count.
+ */
+int McfunctionHighlighter::prioritizeVisibleBlocks() {
+    const int first = firstVisibleBlockNumber();
+    const int last  = lastVisibleBlockNumber();
+
+    m_prioritizedFirstBlock = first;
+    m_prioritizedLastBlock  = last;
+
+    const auto isVisible = [first, last](const PendingBlock &pending) {
+        const int number = pending.block.blockNumber();
+        return (first <= number) && (number <= last);
+    };
+    const auto &&begin = m_pendingBlocks.begin() + m_nextPendingBlock;
+    const auto &&mid   = std::stable_partition(begin, m_pendingBlocks.end(),
+                                               isVisible);
+    return mid - begin;
+}
+
+/*!
+ * \brief Applies the format ranges of the next \a count pending blocks,
+ * or of as many of them as possible within \a timeLimit milliseconds if it
+ * isn't negative.
+ *
+ * Blocks which have been edited since they were queued are skipped, since
+ * they are queued again when the analysis of the edit finishes.
+ */
+void McfunctionHighlighter::formatPendingBlocks(const int count,
+                                                const int timeLimit) {
+    const int end = qMin(m_nextPendingBlock + count, m_pendingBlocks.size());
+
+    QElapsedTimer timer;
+    timer.start();
+
     document()->blockSignals(true);
     document()->documentLayout()->blockSignals(true);
-    rehighlightChangedBlocks();
+    int i = m_nextPendingBlock;
+    for (; i < end; ++i) {
+        if ((timeLimit >= 0) && timer.hasExpired(timeLimit)) {
+            break;
+        }
+
+        const auto &pending = m_pendingBlocks.at(i);
+        if (pending.block.isValid()
+            && (pending.block.revision() == pending.revision)) {
+            m_currentRanges = &pending.ranges;
+            Highlighter::rehighlightBlock(pending.block);
+        }
+    }
+    m_currentRanges = nullptr;
     document()->documentLayout()->blockSignals(false);
     document()->blockSignals(false);
+
+    m_nextPendingBlock = i;
+    if (m_nextPendingBlock >= m_pendingBlocks.size()) {
+        m_pendingBlocks.clear();
+        m_nextPendingBlock = 0;
+        m_batchTimer.stop();
+    }
+}
+
+/*!
+ * \brief Formats the pending blocks in the idle time of the event loop.
+ * Blocks which have been scrolled into view since the last batch are
+ * formatted first and repainted.
+ */
+void McfunctionHighlighter::formatNextBatch() {
+    if ((m_prioritizedFirstBlock != firstVisibleBlockNumber())
+        || (m_prioritizedLastBlock != lastVisibleBlockNumber())) {
+        if (const int visibleCount = prioritizeVisibleBlocks();
+            visibleCount > 0) {
+            formatPendingBlocks(visibleCount);
+            emit document()->documentLayout()->update();
+        }
+    }
+    formatPendingBlocks(m_pendingBlocks.size(), batchDuration);
+}
+
+/*!
+ * \brief Applies the last analysis result to the changed blocks.
+ *
+ * The blocks visible in the editor are formatted immediately, and the other
+ * ones are formatted in batches while the event loop is idle. Every block of
+ * a logical line is formatted along with a changed one, since the ranges of
+ * a line continued with backslashes are split across its blocks.
+ */
+void McfunctionHighlighter::rehighlightDelayed() {
+    auto &blocks = changedBlocks();
+
+    // Blocks which haven't been formatted yet are formatted with the new result
+    for (int i = m_nextPendingBlock; i < m_pendingBlocks.size(); ++i) {
+        blocks << m_pendingBlocks.at(i).block;
+    }
+    m_pendingBlocks.clear();
+    m_nextPendingBlock = 0;
+    m_batchTimer.stop();
+
+    // Blocks are collected since the last analysis result has been applied
+    blocks.erase(std::remove_if(blocks.begin(), blocks.end(),
+                                [](const QTextBlock &block) {
+        return !block.isValid();
+    }), blocks.end());
+    std::sort(blocks.begin(), blocks.end(),
+              [](const QTextBlock &a, const QTextBlock &b) {
+        return a.blockNumber() < b.blockNumber();
+    });
+    blocks.erase(std::unique(blocks.begin(), blocks.end(),
+                             [](const QTextBlock &a, const QTextBlock &b) {
+        return a.blockNumber() == b.blockNumber();
+    }), blocks.end());
+    if (!m_syntaxTree || blocks.isEmpty()) {
+        return;
+    }
+
+    const auto &logicalLines = m_syntaxTree->sourceMapper().logicalLines;
+    const int   blockCount   = document()->blockCount();
+    int         queuedEnd    = 0; // Number of the block after the queued ones
+
+    m_pendingBlocks.reserve(blocks.size());
+    for (const auto &block: qAsConst(blocks)) {
+        const int number = block.blockNumber();
+        if (number < queuedEnd) {
+            continue;
+        }
+
+        const auto &&lineIt = std::upper_bound(logicalLines.cbegin(),
+                                               logicalLines.cend(), number);
+        if (lineIt == logicalLines.cbegin()) {
+            m_pendingBlocks << PendingBlock{ block, {}, block.revision() };
+            queuedEnd = number + 1;
+            continue;
+        }
+
+        const int   line      = lineIt - logicalLines.cbegin() - 1;
+        const int   lineStart = *(lineIt - 1);
+        const int   lineEnd   = (lineIt != logicalLines.cend())
+                                    ? *lineIt : blockCount;
+        const auto &&first    = (lineStart == number)
+                                    ? block
+                                    : document()->findBlockByNumber(lineStart);
+        const auto &&lineFormats = splitLine(line, first.position());
+
+        auto curBlock = first;
+        for (int n = lineStart; (n < lineEnd) && curBlock.isValid();
+             ++n, curBlock = curBlock.next()) {
+            if (n >= queuedEnd) {
+                m_pendingBlocks << PendingBlock{
+                    curBlock, lineFormats.value(n - lineStart),
+                    curBlock.revision() };
+            }
+        }
+        queuedEnd = lineEnd;
+    }
+    blocks.clear();
+
+    formatPendingBlocks(prioritizeVisibleBlocks());
+    if (!m_pendingBlocks.isEmpty()) {
+        m_batchTimer.start();
+    }
 }
@@ -2,37 +2,61 @@
 #define MCFUNCTIONHIGHLIGHTER_H
 
 #include <QRegularExpression>
+#include <QTimer>
 
 #include "highlighter.h"
 
 namespace Command {
-    class McfunctionParser;
+    class FileNode;
+    class ParseNode;
 }
 
 class McfunctionHighlighter : public Highlighter {
 public:
     using FormatRanges = QVector<QTextLayout::FormatRange>;
 
-    explicit McfunctionHighlighter(QTextDocument *parent,
-                                   Command::McfunctionParser *parser = nullptr);
+    explicit McfunctionHighlighter(QTextDocument *parent);
+
+    void setAnalysisResult(const QSharedPointer<Command::FileNode> &tree,
+                           const QVector<FormatRanges> &lineFormats);
+    QVector<FormatRanges> splitLine(const int line, const int physPos);
 
 protected slots:
     void highlightBlock(const QString &text) final;
-    void rehighlightChangedBlocks();
 
     void rehighlightDelayed() final;
 
 private:
-    QVector<HighlightingRule> highlightingRules;
-    QVector<FormatRanges> m_formats;
+    /// A changed block and the format ranges to be applied to it
+    struct PendingBlock {
+        QTextBlock   block;
+        FormatRanges ranges;
+        int          revision = 0;
+    };
 
-    Command::McfunctionParser *m_parser = nullptr;
-    int m_curChangedBlockIndex          = 0;
+    /// The format ranges of the physical lines of a continued logical line
+    struct SplitLine {
+        QSharedPointer<Command::ParseNode> node;
+        FormatRanges                       source;
+        QVector<int>                       layout;
+        QVector<FormatRanges>              lines;
+    };
+
+    QVector<HighlightingRule> highlightingRules;
+    QVector<FormatRanges> m_lineFormats;
+    QSharedPointer<Command::FileNode> m_syntaxTree;
+    QHash<const Command::ParseNode *, SplitLine> m_splitLines;
+    QVector<PendingBlock> m_pendingBlocks;
+    QTimer m_batchTimer;
+    const FormatRanges *m_currentRanges = nullptr;
+    int m_nextPendingBlock              = 0;
+    int m_prioritizedFirstBlock         = 0;
+    int m_prioritizedLastBlock          = -1;
 
     void setupRules();
-    static bool canConcatenate(const QString &line) {
-        return !line.isEmpty() && line.back() == QLatin1Char('\\');
-    };
+    int prioritizeVisibleBlocks();
+    void formatPendingBlocks(const int count, const int timeLimit = -1);
+    void formatNextBatch();
     static QVector<FormatRanges> splitRangesToLines(
         const FormatRanges &ranges, QVector<int> &breakPositions,
         const int offset = 0);
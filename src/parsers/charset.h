@@ -0,0 +1,190 @@
+#ifndef CHARSET_H
+#define CHARSET_H
+
+#include <QHash>
+#include <QMutex>
+#include <QStringView>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define CHARSET_USE_SSE2
+#endif
+
+/*!
+ * \brief A set of characters for scanning spans of text.
+ *
+ * A charset is built from the body of a regular expression character class,
+ * such as \c "a-z0-9_", which can contain ranges and backslash-escaped
+ * characters. ASCII characters are looked up in a 128-bit bitmap and other
+ * characters in a short list of ranges. Charsets of ASCII literals can be
+ * built at compile time.
+ *
+ * \sa Parser::getWithCharset()
+ */
+class Charset {
+public:
+    constexpr Charset() = default;
+    constexpr explicit Charset(const char *pattern) {
+        int size = 0;
+
+        while (pattern[size] != '\0') {
+            ++size;
+        }
+        addPattern(pattern, size);
+        finalize();
+    }
+    explicit Charset(QStringView pattern) {
+        addPattern(pattern.utf16(), pattern.size());
+        finalize();
+    }
+
+    /*!
+     * \brief Returns the charset of the \a pattern, which is only built once.
+     */
+    static Charset cached(QStringView pattern) {
+        static QMutex                   mutex;
+        static QHash<QString, Charset> charsets;
+        QMutexLocker                    locker(&mutex);
+
+        const QString &&key = pattern.toString();
+        auto            it  = charsets.constFind(key);
+
+        if (it == charsets.cend()) {
+            it = charsets.insert(key, Charset(pattern));
+        }
+        return *it;
+    }
+
+    constexpr bool contains(const char16_t ch) const {
+        if (ch < 128) {
+            return m_ascii[ch >> 6] & (quint64(1) << (ch & 63));
+        }
+        for (int i = 0; i < m_wideRangeCount; ++i) {
+            if ((ch >= m_wideRanges[i][0]) && (ch <= m_wideRanges[i][1])) {
+                return true;
+            }
+        }
+        return false;
+    }
+    bool contains(const QChar ch) const {
+        return contains(char16_t(ch.unicode()));
+    }
+
+    void remove(const QChar ch) {
+        const char16_t code = ch.unicode();
+
+        if (code < 128) {
+            m_ascii[code >> 6] &= ~(quint64(1) << (code & 63));
+            m_asciiRangeCount   = 0;
+            finalize();
+        }
+    }
+
+    /*!
+     * \brief Returns the length of the longest prefix of the \a text whose
+     * characters are all in the charset.
+     */
+    int span(QStringView text) const {
+        const auto *data = reinterpret_cast<const char16_t *>(text.utf16());
+        const int   size = text.size();
+        int         i    = 0;
+
+#ifdef CHARSET_USE_SSE2
+        if (m_asciiRangeCount > 0) {
+            // Test 8 characters at once against the ASCII ranges
+            const __m128i bias = _mm_set1_epi16(short(0x8000));
+            for (; i + 8 <= size; i += 8) {
+                const __m128i chars = _mm_xor_si128(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)),
+                    bias);
+                __m128i inSet = _mm_setzero_si128();
+                for (int r = 0; r < m_asciiRangeCount; ++r) {
+                    const __m128i lo = _mm_set1_epi16(
+                        short(m_asciiRanges[r][0] ^ 0x8000));
+                    const __m128i hi = _mm_set1_epi16(
+                        short(m_asciiRanges[r][1] ^ 0x8000));
+                    inSet = _mm_or_si128(
+                        inSet, _mm_andnot_si128(
+                            _mm_or_si128(_mm_cmplt_epi16(chars, lo),
+                                         _mm_cmpgt_epi16(chars, hi)),
+                            _mm_set1_epi16(-1)));
+                }
+                const int mask = _mm_movemask_epi8(inSet);
+                if (mask != 0xFFFF) {
+                    // Non-ASCII characters may still be in the charset
+                    break;
+                }
+            }
+        }
+#endif
+        while ((i < size) && contains(data[i])) {
+            ++i;
+        }
+        return i;
+    }
+
+private:
+    static constexpr int maxWideRanges  = 16;
+    static constexpr int maxAsciiRanges = 8;
+
+    quint64 m_ascii[2] = {};
+    char16_t m_wideRanges[maxWideRanges][2] = {};
+    int m_wideRangeCount = 0;
+    // Maximal runs of the ASCII bitmap, used by the vectorized scan
+    char16_t m_asciiRanges[maxAsciiRanges][2] = {};
+    int m_asciiRangeCount = 0;
+
+    template<typename Char>
+    constexpr void addPattern(const Char *pattern, const int size) {
+        for (int i = 0; i < size; ++i) {
+            char16_t first = pattern[i];
+            if ((first == u'\\') && (i + 1 < size)) {
+                first = pattern[++i];
+            }
+            char16_t last = first;
+            if ((i + 2 < size) && (pattern[i + 1] == u'-')) {
+                i   += 2;
+                last = pattern[i];
+                if ((last == u'\\') && (i + 1 < size)) {
+                    last = pattern[++i];
+                }
+            }
+            addRange(first, last);
+        }
+    }
+
+    constexpr void addRange(char16_t first, const char16_t last) {
+        for (; first <= last && first < 128; ++first) {
+            m_ascii[first >> 6] |= quint64(1) << (first & 63);
+        }
+        if (first <= last) {
+            Q_ASSERT(m_wideRangeCount < maxWideRanges);
+            if (m_wideRangeCount < maxWideRanges) {
+                m_wideRanges[m_wideRangeCount][0] = first;
+                m_wideRanges[m_wideRangeCount][1] = last;
+                ++m_wideRangeCount;
+            }
+        }
+    }
+
+    constexpr void finalize() {
+        for (char16_t ch = 0; ch < 128; ++ch) {
+            if (!contains(ch)) {
+                continue;
+            }
+            if ((ch > 0) && contains(char16_t(ch - 1))) {
+                m_asciiRanges[m_asciiRangeCount - 1][1] = ch;
+            } else if (m_asciiRangeCount < maxAsciiRanges) {
+                m_asciiRanges[m_asciiRangeCount][0] = ch;
+                m_asciiRanges[m_asciiRangeCount][1] = ch;
+                ++m_asciiRangeCount;
+            } else {
+                // Too many ranges to be tested at once
+                m_asciiRangeCount = 0;
+                return;
+            }
+        }
+    }
+};
+
+#endif // CHARSET_H
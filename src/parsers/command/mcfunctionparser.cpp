@@ -8,158 +8,322 @@
 #include <QElapsedTimer>
 
 namespace Command {
-    McfunctionParser::McfunctionParser() {
+    McfunctionParser::McfunctionParser()
+        : m_cache(QSharedPointer<ParseNodeCache>::create()) {
     }
 
     QSharedPointer<FileNode> McfunctionParser::syntaxTree() const {
         return m_tree;
     }
 
+/*!
+ * \brief Sets the cache of parsed lines, which can be shared by parsers
+ * in multiple threads.
+ */
+    void McfunctionParser::setNodeCache(QSharedPointer<ParseNodeCache> cache) {
+        Q_ASSERT(cache != nullptr);
+        m_cache = std::move(cache);
+    }
+
+/*!
+ * \brief Returns the schema which the current syntax tree has been parsed
+ * with.
+ */
+    SchemaPtr McfunctionParser::schema() const {
+        return m_schema;
+    }
+
+/*!
+ * \brief Sets the \a schema to parse with instead of the current schema,
+ * which is used again if \a schema is null.
+ */
+    void McfunctionParser::setSchema(SchemaPtr schema) {
+        m_fixedSchema = std::move(schema);
+    }
+
+    SchemaPtr McfunctionParser::nextSchema() const {
+        return m_fixedSchema ? m_fixedSchema : SchemaParser::currentSchema();
+    }
+
     bool McfunctionParser::parseImpl() {
+        // All lines are parsed with the same schema
+        m_schema = nextSchema();
+
+        const auto &&tree = QSharedPointer<FileNode>::create();
+        const auto &&txt  = text(); // This prevent crash in release build
+
+        State        state = State::Command;
+        LineSplitter splitter{ txt };
+        while (splitter.hasNextLine()) {
+            if (checkCancelled()) {
+                m_tree.reset();
+                return false;
+            }
+            tree->append(parseLine(splitter, state));
+        }
+
+        auto &&srcMapper = splitter.sourceMapper();
+        mapErrorsToPhysical(m_errors, srcMapper);
+
+        m_tree = tree;
+        m_tree->setSourceMapper(std::move(srcMapper));
+        return m_tree->isValid();
+    }
+
+    static bool continuesComment(const NodePtr &line) {
+        if (line->kind() != ParseNode::Kind::Span) {
+            return false;
+        }
+        const QString &&text = line->text();
+        return QStringView(text).trimmed().endsWith(u'\\');
+    }
+
+    /*!
+     * \brief Reparses \a text after \a charsRemoved characters at \a position
+     * of the previously parsed text have been replaced by \a charsAdded
+     * characters, as reported by QTextDocument::contentsChange().
+     *
+     * Only the logical lines touched by the edit (including the lines joined
+     * to them by line continuations) are split and parsed again. The other
+     * lines of the syntax tree are kept, and their source mappings and errors
+     * are shifted in place. If there is no previous syntax tree or the edit
+     * doesn't match the previous text, the whole text is parsed instead.
+     * If the parse is cancelled, the previous text and syntax tree are kept,
+     * so the edit can be merged with the next one.
+     */
+    bool McfunctionParser::reparse(const QString &text, const int position,
+                                   const int charsRemoved,
+                                   const int charsAdded) {
+        const QString &&oldText = this->text();
+        const QStringView oldView{ oldText };
+        const QStringView newView{ text };
+
+        if (!m_tree || m_tree->isEmpty() || m_schema != nextSchema()
+            || position < 0
+            || position + charsRemoved > oldText.length()
+            || text.length() != oldText.length() - charsRemoved + charsAdded
+            || oldView.left(position) != newView.left(position)
+            || oldView.mid(position + charsRemoved)
+            != newView.mid(position + charsAdded)) {
+            return parse(text);
+        }
+
+        m_cancelled = false;
+
+        auto       &srcMapper    = m_tree->sourceMapper();
+        const auto &logicalLines = srcMapper.logicalLines;
+        const auto &&removedView = oldView.mid(position, charsRemoved);
+        const auto &&addedView   = newView.mid(position, charsAdded);
+        const int    firstPhysLine
+            = std::count(oldView.cbegin(), oldView.cbegin() + position, u'\n');
+        const int removedLines
+            = std::count(removedView.cbegin(), removedView.cend(), u'\n');
+        const int physDelta = charsAdded - charsRemoved;
+
+        SourceMapper::Splice range;
+        range.lineDelta = std::count(addedView.cbegin(), addedView.cend(),
+                                     u'\n') - removedLines;
+        range.firstLine = std::upper_bound(logicalLines.cbegin(),
+                                           logicalLines.cend(),
+                                           firstPhysLine)
+                          - logicalLines.cbegin() - 1;
+
+        // Find the start of the first affected logical line
+        range.physStart = (position > 0)
+                              ? oldText.lastIndexOf('\n', position - 1) + 1 : 0;
+        for (int i = logicalLines[range.firstLine]; i < firstPhysLine; ++i) {
+            range.physStart = (range.physStart > 1)
+                ? oldText.lastIndexOf('\n', range.physStart - 2) + 1 : 0;
+        }
+        range.logiStart = srcMapper.logicalPosOf(range.physStart);
+
+        // Returns the start of the given logical line in the old text.
+        // Lines are only looked up in increasing order.
+        int        oldPhysLine = firstPhysLine + removedLines;
+        int        oldPhysPos  = position + charsRemoved;
+        const auto oldLineStart = [&](const int lineIndex) -> int {
+            if (lineIndex >= logicalLines.size()) {
+                return oldText.length() + 1;
+            }
+            for (; oldPhysLine < logicalLines[lineIndex]; ++oldPhysLine) {
+                oldPhysPos = oldText.indexOf('\n', oldPhysPos) + 1;
+            }
+            return oldPhysPos;
+        };
+        int endLine = std::upper_bound(logicalLines.cbegin(),
+                                       logicalLines.cend(),
+                                       oldPhysLine) - logicalLines.cbegin();
+        int endPos = oldLineStart(endLine);
+
+        setText(text);
+        setPos(range.logiStart);
+
+        Errors oldErrors = std::move(m_errors);
+        m_errors.clear();
+
+        State state = (range.firstLine > 0
+                       && continuesComment(m_tree->at(range.firstLine - 1)))
+                          ? State::Comment : State::Command;
+        FileNode::Lines newLines;
+        LineSplitter    splitter{ text, range.physStart,
+                                  logicalLines[range.firstLine],
+                                  range.logiStart };
+        while (splitter.hasNextLine()) {
+            if (checkCancelled()) {
+                // Leave the previous result untouched
+                setText(oldText);
+                m_errors = std::move(oldErrors);
+                return false;
+            }
+            newLines << parseLine(splitter, state);
+
+            // Stop at the first unchanged line whose state also stays the same
+            const int physPos = splitter.physicalPos();
+            while (endLine < logicalLines.size()
+                   && endPos + physDelta < physPos) {
+                endPos = oldLineStart(++endLine);
+            }
+            if (endLine < logicalLines.size() && endPos + physDelta == physPos
+                && (state == State::Comment)
+                == continuesComment(m_tree->at(endLine - 1))) {
+                break;
+            }
+        }
+        endPos = oldLineStart(endLine);
+
+        range.lineCount  = endLine - range.firstLine;
+        range.oldPhysEnd = endPos;
+        range.oldLogiEnd = srcMapper.logicalPosOf(endPos);
+        range.newPhysEnd = endPos + physDelta;
+        range.newLogiEnd = pos();
+
+        auto &&patch = splitter.sourceMapper();
+        if (splitter.lastLineIsContinuation() && splitter.hasNextLine()) {
+            patch.physicalPositions[range.newLogiEnd] = range.newPhysEnd;
+            patch.logicalPositions[range.newPhysEnd]  = range.newLogiEnd;
+        }
+        mapErrorsToPhysical(m_errors, patch);
+
+        Errors newErrors;
+        newErrors.reserve(oldErrors.size() + m_errors.size());
+        for (const auto &error: qAsConst(oldErrors)) {
+            if (error.pos < range.physStart) {
+                newErrors << error;
+            }
+        }
+        newErrors << m_errors;
+        for (auto &error: oldErrors) {
+            if (error.pos >= range.oldPhysEnd) {
+                error.pos += physDelta;
+                newErrors << std::move(error);
+            }
+        }
+        m_errors = std::move(newErrors);
+
+        srcMapper.splice(range, patch);
+        m_tree->replace(range.firstLine, range.lineCount, std::move(newLines));
+
+        return m_tree->isValid();
+    }
+
+    NodePtr McfunctionParser::parseLine(LineSplitter &splitter, State &state) {
         constexpr static int cmdTypeId =
             MinecraftParser::getTypeEnumId<RootNode>();
         constexpr static int macroTypeId
             = static_cast<int>(nodeTypeEnum<MacroNode, ParseNode::Kind>);
 
-        const auto &&tree           = QSharedPointer<FileNode>::create();
-        const auto &&txt            = text(); // This prevent crash in release build
-        int          validLineCount = 0;
-
-        m_commandParser.m_spans = std::move(m_spans);
+        const int linePos = pos();
+        const auto line    = splitter.peekCurrLineView();
+        const auto trimmed = line.trimmed();
 
-//        QElapsedTimer timer;
-//        timer.start();
+        if (trimmed.isEmpty() || trimmed[0] == u'#' ||
+            state == State::Comment) {
+            advance(line.length() + 1);
+            state =
+                trimmed.endsWith(u'\\') ? State::Comment : State::Command;
+            return SpanPtr::create(spanText(splitter.getCurrLine()), true);
+        }
 
-        State        state = State::Command;
-        LineSplitter splitter{ txt };
-        while (splitter.hasNextLine()) {
-            const int linePos = pos();
-//            qDebug() << "linePos" << linePos << splitter.peekCurrLineView();
-            const auto line    = splitter.peekCurrLineView();
-            const auto trimmed = line.trimmed();
-            if (trimmed.isEmpty() || trimmed[0] == u'#' ||
-                state == State::Comment) {
-                tree->append(SpanPtr::create(spanText(splitter.getCurrLine()),
-                                             true));
-                validLineCount++;
-                advance(line.length() + 1);
-                state =
-                    trimmed.endsWith(u'\\') ? State::Comment : State::Command;
-            } else {
-                const auto &logicalLine =
-                    (m_commandParser.gameVer >= Game::v1_20_2)
-                        ? splitter.nextLogicalLine()
-                        : splitter.getCurrLine();
-                if (trimmed[0] == u'$'
-                    && m_commandParser.gameVer >= Game::v1_20_2) {
-                    NodePtr macro;
-#ifdef MCFUNCTIONPARSER_USE_CACHE
-                    CacheKey key{ macroTypeId, logicalLine };
-                    if (!m_cache.contains(key)
-                        || !(macro = m_cache[key].lock())) {
-#endif
-                    macro = parseMacroLine(logicalLine, linePos);
+        const bool hasMacros = m_schema
+                               && (m_schema->gameVersion() >= Game::v1_20_2);
+        const auto &logicalLine =
+            hasMacros ? splitter.nextLogicalLine() : splitter.getCurrLine();
+        if (trimmed[0] == u'$' && hasMacros) {
+            NodePtr macro;
 #ifdef MCFUNCTIONPARSER_USE_CACHE
-                    if (macro->isValid()) {
-                        m_cache.emplace(macroTypeId, std::move(logicalLine),
-                                        WeakNodePtr(macro));
-                        validLineCount++;
-                    }
-                } else {
-                    validLineCount++;
+            if (!(macro = m_cache->lookup(m_schema, macroTypeId,
+                                          logicalLine))) {
+                macro = parseMacroLine(logicalLine, linePos);
+                if (macro->isValid()) {
+                    m_cache->insert(m_schema, macroTypeId, logicalLine, macro);
                 }
+            }
+#else
+            macro = parseMacroLine(logicalLine, linePos);
 #endif
-                    tree->append(macro);
-                    advance(logicalLine.length() + 1);
-                    state = State::Command;
-                } else {
-                    Q_ASSERT(state == State::Command);
-                    NodePtr command;
+            advance(logicalLine.length() + 1);
+            state = State::Command;
+            return macro;
+        }
 
-#ifdef MCFUNCTIONPARSER_USE_CACHE
-                    CacheKey key{ cmdTypeId, logicalLine };
-                    if (!m_cache.contains(key)
-                        || !(command = m_cache[key].lock())) {
-#endif
-                    m_commandParser.setText(logicalLine);
-                    command = m_commandParser.parse();
-#ifdef MCFUNCTIONPARSER_USE_CACHE
-                    if (command->isValid()) {
-                        m_cache.emplace(cmdTypeId, std::move(logicalLine),
-                                        WeakNodePtr(command));
-                        validLineCount++;
-                    }
-                } else {
-                    validLineCount++;
-                }
-#endif
+        Q_ASSERT(state == State::Command);
+        NodePtr command;
 
-                    if (!command->isValid()) {
-                        auto errors = m_commandParser.errors();
-                        for (int i = 0; i < errors.length(); ++i) {
-                            errors[i].pos += linePos;
-                            const auto &error = errors[i];
-                            if (!m_errors.contains(error)) {
-                                m_errors << error;
-                            }
-                        }
-                    }
-                    tree->append(std::move(command));
-                    advance(logicalLine.length() + 1);
-                }
+#ifdef MCFUNCTIONPARSER_USE_CACHE
+        if (!(command = m_cache->lookup(m_schema, cmdTypeId, logicalLine))) {
+            m_commandParser.setText(logicalLine);
+            command = m_commandParser.parse(m_schema);
+            if (command->isValid()) {
+                m_cache->insert(m_schema, cmdTypeId, logicalLine, command);
             }
         }
+#else
+        m_commandParser.setText(logicalLine);
+        command = m_commandParser.parse(m_schema);
+#endif
 
-        const auto &&posMapping = splitter.sourceMapper().physicalPositions;
-//        qDebug() << posMapping << splitter.sourceMapper().backslashMap;
-
-        if (!posMapping.empty()) {
-            for (auto &error: m_errors) {
-                const int pos = error.pos;
-//                qDebug() << pos << posMapping.cbegin().key();
-                if (pos >= posMapping.cbegin().key()) {
-                    auto &&nearest = posMapping.upperBound(pos);
-                    if (nearest != posMapping.cbegin()) {
-                        nearest--;
-                    }
-//                    qDebug() << "nearest" << nearest.key() << nearest.value();
-                    error.pos += nearest.value() - nearest.key();
-//                    qDebug() << "error.pos =" << pos << '+' <<
-//                        (nearest.value() - nearest.key()) << '=' << error.pos;
-                }
-                const int   endPos       = pos + error.length - 1;
-                const auto &backslashMap = splitter.sourceMapper().backslashMap;
-                for (auto it = backslashMap.lowerBound(pos);
-                     it != backslashMap.upperBound(endPos); ++it) {
-//                    qDebug() << "backslash" << it.key() << it.value();
-                    error.length += it.value().trivia.length();
+        if (!command->isValid()) {
+            auto errors = m_commandParser.errors();
+            for (int i = 0; i < errors.length(); ++i) {
+                errors[i].pos += linePos;
+                const auto &error = errors[i];
+                if (!m_errors.contains(error)) {
+                    m_errors << error;
                 }
             }
         }
+        advance(logicalLine.length() + 1);
+        return command;
+    }
 
-//        const auto &cache = m_commandParser.cache();
-//        qInfo() << "Size:" << cache.size() << '/' << cache.capacity()
-//                << "Total access:" << cache.stats().total_accesses()
-//                << ". Total hit:" << cache.stats().total_hits()
-//                << ". Total miss:" << cache.stats().total_misses()
-//                << ". Hit rate:" << cache.stats().hit_rate();
-
-//        qDebug() << "Size:" << m_cache.size() << '/' << m_cache.capacity()
-//                 << "Total access:" << m_cache.stats().total_accesses()
-//                 << "(hit:" << m_cache.stats().total_hits()
-//                 << ", miss:" << m_cache.stats().total_misses()
-//                 << "). Hit rate:" << m_cache.stats().hit_rate();
-//                 << ". Time elapsed:" << timer.nsecsElapsed() / 1e6 << "ms.";
-
-        //        qDebug() << "Time elapsed:" << timer.nsecsElapsed() / 1e6 << "ms.";
+    /*!
+     * \brief Maps the logical positions of \a errors to physical positions
+     * using \a srcMapper, and extends their lengths over line continuations.
+     */
+    void McfunctionParser::mapErrorsToPhysical(Errors &errors,
+                                               const SourceMapper &srcMapper) {
+        const auto &posMapping = srcMapper.physicalPositions;
 
-//        m_cache.print();
+        if (posMapping.empty()) {
+            return;
+        }
 
-        m_tree = tree;
-        m_tree->setSourceMapper(splitter.sourceMapper());
-        m_spans = m_commandParser.spans();
-        m_cache.setCapacity(validLineCount + 1);
-        return m_tree->isValid();
+        const auto &backslashMap = srcMapper.backslashMap;
+        for (auto &error: errors) {
+            const int pos = error.pos;
+            if (pos >= posMapping.cbegin().key()) {
+                auto &&nearest = posMapping.upperBound(pos);
+                if (nearest != posMapping.cbegin()) {
+                    nearest--;
+                }
+                error.pos += nearest.value() - nearest.key();
+            }
+            const int endPos = pos + error.length - 1;
+            for (auto it = backslashMap.lowerBound(pos);
+                 it != backslashMap.upperBound(endPos); ++it) {
+                error.length += it.value().trivia.length();
+            }
+        }
     }
 
     QSharedPointer<MacroNode> McfunctionParser::parseMacroLine(
@@ -179,7 +343,8 @@ namespace Command {
         while (varStart != -1) {
             varCount++;
             if (const auto span = macroParser.getUntil('$'); !span.isEmpty()) {
-                subLine->append(SpanPtr::create(spanText(span), true));
+                subLine->append(SpanPtr::create(macroParser.spanText(span),
+                                                true));
             }
             macroParser.advance(2);
             int varEnd = line.indexOf(')', varStart);
@@ -193,24 +358,28 @@ namespace Command {
                 const auto actualVarKey = re2c::realPlayerName(varKey);
                 if (actualVarKey.length() == varKey.length()) {
                     var = QSharedPointer<MacroVariableNode>::create(
-                        spanText(varKey), varKey.length() + 3, true);
+                        macroParser.spanText(varKey), varKey.length() + 3,
+                        true);
                 } else {
                     var = QSharedPointer<MacroVariableNode>::create(
-                        spanText(varKey), varKey.length() + 3, false);
+                        macroParser.spanText(varKey), varKey.length() + 3,
+                        false);
                     reportError(QT_TR_NOOP("Invalid macro variable name '%1'"),
                                 { varKey.toString() }, linePos + varStart + 2,
                                 varEnd - varStart - 1);
                 }
-                var->setLeftText(spanText("$("_QL1));
+                var->setLeftText(
+                    macroParser.spanText(lineView.mid(varStart, 2)));
                 macroParser.advance(varKey.length());
-                var->setRightText(spanText(macroParser.curChar()));
+                var->setRightText(macroParser.spanText(macroParser.peek(1)));
                 macroParser.advance();
                 subLine->append(std::move(var));
             } else {
                 const auto rest = macroParser.getRest();
                 var = QSharedPointer<MacroVariableNode>::create(
-                    spanText(rest), false);
-                var->setLeftText(spanText("$("_QL1));
+                    macroParser.spanText(rest), false);
+                var->setLeftText(
+                    macroParser.spanText(lineView.mid(varStart, 2)));
                 macroParser.advance(rest.length());
                 reportError(QT_TR_NOOP("Unterminated macro variable"),
                             {}, linePos + varStart, rest.length());
@@ -220,7 +389,8 @@ namespace Command {
             varStart = matcher.indexIn(line, varEnd + 1);
         }
         if (const auto rest = macroParser.getRest(); !rest.isEmpty()) {
-            subLine->append(SpanPtr::create(spanText(rest), true));
+            subLine->append(SpanPtr::create(macroParser.spanText(rest),
+                                            true));
         }
 
         if (varCount == 0) {
@@ -2,8 +2,11 @@
 #define MCFUNCTIONPARSER_H
 
 #include "minecraftparser.h"
+#include "parsenodecache.h"
 #include "nodes/filenode.h"
 
+class LineSplitter;
+
 namespace Command {
     class MacroNode;
 
@@ -20,15 +23,29 @@ public:
         };
 
         QSharedPointer<FileNode> syntaxTree() const;
+        void setNodeCache(QSharedPointer<ParseNodeCache> cache);
+        SchemaPtr schema() const;
+        void setSchema(SchemaPtr schema);
+
+        bool reparse(const QString &text, const int position,
+                     const int charsRemoved, const int charsAdded);
+
+        static void mapErrorsToPhysical(Errors &errors,
+                                        const SourceMapper &srcMapper);
 
 protected:
         bool parseImpl() final;
 
 private:
         MinecraftParser m_commandParser;
-        ParseNodeCache m_cache;
+        QSharedPointer<ParseNodeCache> m_cache;
         QSharedPointer<FileNode> m_tree;
+        SchemaPtr m_fixedSchema;
+        SchemaPtr m_schema;
+
+        SchemaPtr nextSchema() const;
 
+        NodePtr parseLine(LineSplitter &splitter, State &state);
         QSharedPointer<MacroNode> parseMacroLine(const QString &line,
                                                  const int linePos);
     };
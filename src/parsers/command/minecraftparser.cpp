@@ -1,10 +1,14 @@
 #include "minecraftparser.h"
 
 #include "re2c_generated_functions.h"
+#include "schema/schemaloader.h"
+#include "../../gamedatabundle.h"
 
 #include "nlohmann/json.hpp"
 #include "uberswitch.hpp"
 
+#include <QElapsedTimer>
+
 using json = nlohmann::json;
 
 namespace Command {
@@ -16,15 +20,18 @@ namespace Command {
          */
     }
 
-    QString MinecraftParser::eatListSep(QChar sepChr, QChar endChr) {
+    MinecraftParser::Result<TextSpan> MinecraftParser::eatListSep(QChar sepChr,
+                                                                  QChar endChr) {
         const int start = pos();
 
         while (curChar().isSpace()) {
             advance();
         }
         if (curChar() != endChr) {
-            expect(sepChr,
-                   "Unexpected %1, expecting separator %2 or closing character");
+            if (!tryExpect(sepChr,
+                           "Unexpected %1, expecting separator %2 or closing character")) {
+                return ParseFailure();
+            }
             advance();
             while (curChar().isSpace()) {
                 advance();
@@ -113,8 +120,10 @@ namespace Command {
         return axis;
     }
 
-    void MinecraftParser::parseAxes(ArgumentNode *node,
-                                    AxisParseOptions options) {
+    MinecraftParser::Result<> MinecraftParser::parseAxes(
+        ArgumentNode *node, AxisParseOptions options) {
+        static const char *axesSepErrMsg(
+            "Unexpected %1, expecting %2 to separate between axes");
         using PT = ArgumentNode::ParserType;
         bool      isLocal = false;
         const int start   = pos();
@@ -125,16 +134,13 @@ namespace Command {
             case PT::Rotation:
             case PT::Vec2: {
                 auto *axes = static_cast<TwoAxesNode *>(node);
-//                axes->setFirstAxis(
-//                    callWithCache<AngleNode>(&MinecraftParser::parseAxis, this,
-//                                             peekLiteral(), options, isLocal));
                 axes->setFirstAxis(
                     parseAxis(options | AxisParseOption::FirstAxis, isLocal));
-                axes->firstAxis()->setTrailingTrivia(eat(' ',
-                                                         "Unexpected %1, expecting %2 to separate between axes"));
-//                axes->setSecondAxis(
-//                    callWithCache<AngleNode>(&MinecraftParser::parseAxis, this,
-//                                             peekLiteral(), options, isLocal));
+                const auto &&sep = tryEat(' ', axesSepErrMsg);
+                if (!sep) {
+                    return ParseFailure();
+                }
+                axes->firstAxis()->setTrailingTrivia(*sep);
                 axes->setSecondAxis(parseAxis(options, isLocal));
                 break;
             }
@@ -142,22 +148,19 @@ namespace Command {
             case PT::BlockPos:
             case PT::Vec3: {
                 auto *axes = static_cast<XyzNode *>(node);
-//                axes->setX(
-//                    callWithCache<AngleNode>(&MinecraftParser::parseAxis, this,
-//                                             peekLiteral(), options, isLocal));
                 axes->setX(parseAxis(options | AxisParseOption::FirstAxis,
                                      isLocal));
-                axes->x()->setTrailingTrivia(eat(' ',
-                                                 "Unexpected %1, expecting %2 to separate between axes"));
-//                axes->setY(
-//                    callWithCache<AngleNode>(&MinecraftParser::parseAxis, this,
-//                                             peekLiteral(), options, isLocal));
+                const auto &&sepX = tryEat(' ', axesSepErrMsg);
+                if (!sepX) {
+                    return ParseFailure();
+                }
+                axes->x()->setTrailingTrivia(*sepX);
                 axes->setY(parseAxis(options, isLocal));
-                axes->y()->setTrailingTrivia(eat(' ',
-                                                 "Unexpected %1, expecting %2 to separate between axes"));
-//                axes->setZ(
-//                    callWithCache<AngleNode>(&MinecraftParser::parseAxis, this,
-//                                             peekLiteral(), options, isLocal));
+                const auto &&sepY = tryEat(' ', axesSepErrMsg);
+                if (!sepY) {
+                    return ParseFailure();
+                }
+                axes->y()->setTrailingTrivia(*sepY);
                 axes->setZ(parseAxis(options, isLocal));
                 break;
             }
@@ -167,6 +170,7 @@ namespace Command {
         }
 
         node->setLength(pos() - start);
+        return Result<>();
     }
 
     QSharedPointer<NbtCompoundNode> MinecraftParser::
@@ -215,9 +219,12 @@ namespace Command {
 
             case '"':
             case '\'': {
-                const QString &&quoted = getQuotedString();
+                const auto &&quoted = tryGetQuotedString();
+                if (!quoted) {
+                    return nullptr;
+                }
                 return QSharedPointer<NbtStringNode>::create(
-                    spanText(start), quoted, true);
+                    spanText(start), *quoted, true);
             }
 
             case '0':
@@ -279,8 +286,8 @@ namespace Command {
                     return QSharedPointer<NbtByteNode>::create(
                         spanText(start), value, true);
                 } else {
-                    throwError(QT_TR_NOOP("%1 is not a vaild SNBT byte tag"),
-                               { literal.toString() }, start, literal.length());
+                    fail(QT_TR_NOOP("%1 is not a vaild SNBT byte tag"),
+                         { literal.toString() }, start, literal.length());
                     break;
                 }
             }
@@ -292,8 +299,8 @@ namespace Command {
                     return QSharedPointer<NbtDoubleNode>::create(
                         spanText(start), value, true);
                 } else {
-                    throwError(QT_TR_NOOP("%1 is not a vaild SNBT double tag"),
-                               { literal.toString() }, start, literal.length());
+                    fail(QT_TR_NOOP("%1 is not a vaild SNBT double tag"),
+                         { literal.toString() }, start, literal.length());
                     break;
                 }
             }
@@ -305,8 +312,8 @@ namespace Command {
                     return QSharedPointer<NbtFloatNode>::create(
                         spanText(start), value, true);
                 } else {
-                    throwError(QT_TR_NOOP("%1 is not a vaild SNBT float tag"),
-                               { literal.toString() }, start, literal.length());
+                    fail(QT_TR_NOOP("%1 is not a vaild SNBT float tag"),
+                         { literal.toString() }, start, literal.length());
                     break;
                 }
             }
@@ -318,8 +325,8 @@ namespace Command {
                     return QSharedPointer<NbtLongNode>::create(
                         spanText(start), value, true);
                 } else {
-                    throwError(QT_TR_NOOP("%1 is not a vaild SNBT long tag"),
-                               { literal.toString() }, start, literal.length());
+                    fail(QT_TR_NOOP("%1 is not a vaild SNBT long tag"),
+                         { literal.toString() }, start, literal.length());
                     break;
                 }
             }
@@ -331,8 +338,8 @@ namespace Command {
                     return QSharedPointer<NbtShortNode>::create(
                         spanText(start), value, true);
                 } else {
-                    throwError(QT_TR_NOOP("%1 is not a vaild SNBT short tag"),
-                               { literal.toString() }, start, literal.length());
+                    fail(QT_TR_NOOP("%1 is not a vaild SNBT short tag"),
+                         { literal.toString() }, start, literal.length());
                     break;
                 }
             }
@@ -344,11 +351,11 @@ namespace Command {
                         return QSharedPointer<NbtDoubleNode>::create(
                             spanText(start), value, true);
                     } else {
-                        throwError(QT_TR_NOOP(
-                                       "%1 is not a vaild SNBT double tag"),
-                                   { literal.toString() },
-                                   start,
-                                   literal.length());
+                        fail(QT_TR_NOOP(
+                                 "%1 is not a vaild SNBT double tag"),
+                             { literal.toString() },
+                             start,
+                             literal.length());
                         break;
                     }
                 } else {
@@ -358,7 +365,7 @@ namespace Command {
                         return QSharedPointer<NbtIntNode>::create(
                             spanText(start), value, true);
                     } else {
-                        throwError(
+                        fail(
                             QT_TR_NOOP(
                                 "%1 is not a vaild SNBT integer tag"),
                             { literal.toString() }, start, literal.length());
@@ -379,8 +386,11 @@ namespace Command {
         bool first = true;
 
         while (curChar() != ']') {
-            const QString &&trivia = skipWs(false);
-            const auto    &&elem   = parseTagValue();
+            const auto &&trivia = skipWs(false);
+            const auto &&elem   = parseTagValue();
+            if (!elem) {
+                return nullptr;
+            }
             if (!trivia.isEmpty()) {
                 elem->setLeadingTrivia(trivia);
             }
@@ -390,16 +400,26 @@ namespace Command {
 //                reportError(QT_TR_NOOP(
 //                                "Type of elements in this list tag must be the same"));
             }
-            elem->setTrailingTrivia(eatListSep(',', ']'));
+            const auto &&sep = eatListSep(',', ']');
+            if (!sep) {
+                return nullptr;
+            }
+            elem->setTrailingTrivia(*sep);
             ret->append(elem);
         }
-        ret->setRightText(eat(']'));
+        const auto &&rightText = tryEat(']');
+        if (!rightText) {
+            return nullptr;
+        }
+        ret->setRightText(*rightText);
         ret->setLength(pos() - start);
         return ret;
     }
 
     QSharedPointer<MapNode> MinecraftParser::
     parseEntityAdvancements() {
+        constexpr static Charset keyChars{ R"(a-zA-z0-9-_:.+/)" };
+
         return parseMap<MapNode, ParseNode>('{', '}', '=',
                                             [this](const QString &) -> NodePtr {
             if (curChar() == '{') {
@@ -407,11 +427,11 @@ namespace Command {
                     '{', '}', '=', [this](const QString &) ->
                     QSharedPointer<BoolNode> {
                     return brigadier_bool();
-                }, false, R"(a-zA-z0-9-_:.+/)"_QL1);
+                }, false, &keyChars);
             } else {
                 return brigadier_bool();
             }
-        }, false, R"(a-zA-z0-9-_:.+/)"_QL1);
+        }, false, &keyChars);
     }
 
     QSharedPointer<MapNode> MinecraftParser::parseEntityArguments() {
@@ -465,7 +485,11 @@ namespace Command {
                     const auto &&ret = parseNegEntityArg();
                     QString literal;
                     if (curChar() == '"' || curChar() == '\'') {
-                        literal = getQuotedString();
+                        auto &&quoted = tryGetQuotedString();
+                        if (!quoted) {
+                            return nullptr;
+                        }
+                        literal = std::move(*quoted);
                     } else {
                         literal = getLiteralString().toString();
                     }
@@ -488,7 +512,11 @@ namespace Command {
                 }
                 ucase ("nbt"_QL1): {
                     const auto &&ret = parseNegEntityArg();
-                    ret->setNode(parseCompoundTag());
+                    const auto &&nbt = parseCompoundTag();
+                    if (!nbt) {
+                        return nullptr;
+                    }
+                    ret->setNode(nbt);
                     return ret;
                 }
                 ucase ("tag"_QL1):
@@ -509,7 +537,8 @@ namespace Command {
                     return parseEntityAdvancements();
                 }
             }
-            throwError(QT_TR_NOOP("Unknown entity argument name: %1"), { key });
+            fail(QT_TR_NOOP("Unknown entity argument name: %1"), { key });
+            return nullptr;
         });
     }
 
@@ -518,7 +547,9 @@ namespace Command {
         const auto &&ret   = QSharedPointer<TargetSelectorNode>::create(0);
         const int    start = pos();
 
-        eat('@');
+        if (!tryEat('@')) {
+            return nullptr;
+        }
         using Variable = TargetSelectorNode::Variable;
         switch (curChar().toLatin1()) {
             case 'a': {
@@ -553,8 +584,13 @@ namespace Command {
         }
         advance();
         ret->setLeftText(spanText(start));
-        if (curChar() == '[')
-            ret->setArgs(parseEntityArguments());
+        if (curChar() == '[') {
+            const auto &&args = parseEntityArguments();
+            if (!args) {
+                return nullptr;
+            }
+            ret->setArgs(args);
+        }
         ret->setLength(pos() - start);
         return ret;
     }
@@ -566,16 +602,23 @@ namespace Command {
 
         switch (curChar().toLatin1()) {
             case '"': {
+                const auto &&name = tryGetQuotedString();
+                if (!name) {
+                    return nullptr;
+                }
                 ret->setName(QSharedPointer<StringNode>::create(
-                                 spanText(start), getQuotedString(), true));
-                if (curChar() == '{')
-                    ret->setFilter(parseCompoundTag());
+                                 spanText(start), *name, true));
+                if ((curChar() == '{') && !parseNbtPathFilter(ret.get())) {
+                    return nullptr;
+                }
                 break;
             }
 
             case '{': {
                 ret->setType(StepType::Root);
-                ret->setFilter(parseCompoundTag());
+                if (!parseNbtPathFilter(ret.get())) {
+                    return nullptr;
+                }
                 break;
             }
 
@@ -584,14 +627,16 @@ namespace Command {
                 ret->setIsValid(true);
                 const int leftPos = pos();
                 advance();
-                const QString &&trivia = skipWs(false);
+                const auto &&trivia = skipWs(false);
                 if (curChar() == ']') {
                     /* Selects all. Continues. */
                     ret->setLeftText(spanText(leftPos));
                 } else {
-                    ret->setLeftText(spanText(QStringLiteral("[")));
+                    ret->setLeftText(spanText(textView().mid(leftPos, 1)));
                     if (curChar() == '{') {
-                        ret->setFilter(parseCompoundTag());
+                        if (!parseNbtPathFilter(ret.get())) {
+                            return nullptr;
+                        }
                         ret->filter()->setLeadingTrivia(trivia);
                         ret->filter()->setTrailingTrivia(skipWs());
                     } else {
@@ -600,16 +645,26 @@ namespace Command {
                         ret->index()->setTrailingTrivia(skipWs());
                     }
                 }
-                ret->setRightText(eat(']'));
+                const auto &&rightText = tryEat(']');
+                if (!rightText) {
+                    return nullptr;
+                }
+                ret->setRightText(*rightText);
                 break;
             }
 
             case '\'': {
-                if (gameVer >= QVersionNumber(1, 20)) {
+                if (gameVer() >= QVersionNumber(1, 20)) {
+                    const auto &&name = tryGetQuotedString();
+                    if (!name) {
+                        return nullptr;
+                    }
                     ret->setName(QSharedPointer<StringNode>::create(
-                                     spanText(start), getQuotedString(), true));
-                    if (curChar() == '{')
-                        ret->setFilter(parseCompoundTag());
+                                     spanText(start), *name, true));
+                    if ((curChar() == '{') &&
+                        !parseNbtPathFilter(ret.get())) {
+                        return nullptr;
+                    }
                     break;
                 } else {
                     [[fallthrough]];
@@ -623,8 +678,9 @@ namespace Command {
                         spanText(name),
                         errorIfNot(!name.isEmpty(),
                                    QT_TR_NOOP("Invalid empty NBT path key"))));
-                if (curChar() == '{')
-                    ret->setFilter(parseCompoundTag());
+                if ((curChar() == '{') && !parseNbtPathFilter(ret.get())) {
+                    return nullptr;
+                }
             };
         }
         /*qDebug() << "After step:" << curChar() << ret->hasTrailingDot(); */
@@ -638,17 +694,37 @@ namespace Command {
         return ret;
     }
 
+    MinecraftParser::Result<> MinecraftParser::parseNbtPathFilter(
+        NbtPathStepNode *step) {
+        const auto &&filter = parseCompoundTag();
+
+        if (!filter) {
+            return ParseFailure();
+        }
+        step->setFilter(filter);
+        return Result<>();
+    }
+
     QSharedPointer<ParticleColorNode> MinecraftParser::
     parseParticleColor() {
         const int start = pos();
         auto    &&color = QSharedPointer<ParticleColorNode>::create(0);
 
+        static const char *colorSepErrMsg(
+            "Unexpected %1, expecting %2 to separate between color values");
+
         color->setR(brigadier_float());
-        color->r()->setTrailingTrivia(eat(' ',
-                                          "Unexpected %1, expecting %2 to separate between color values"));
+        const auto &&sepR = tryEat(' ', colorSepErrMsg);
+        if (!sepR) {
+            return nullptr;
+        }
+        color->r()->setTrailingTrivia(*sepR);
         color->setG(brigadier_float());
-        color->g()->setTrailingTrivia(eat(' ',
-                                          "Unexpected %1, expecting %2 to separate between color values"));
+        const auto &&sepG = tryEat(' ', colorSepErrMsg);
+        if (!sepG) {
+            return nullptr;
+        }
+        color->g()->setTrailingTrivia(*sepG);
         color->setB(brigadier_float());
         color->setLength(pos() - start);
         return color;
@@ -691,11 +767,12 @@ namespace Command {
         const auto idStrView = advanceView(re2c::resLocPart(peekRest()));
         id = SpanPtr::create(spanText(idStrView));
         if (curChar() == ':') {
+            const int colonPos = pos();
             advance();
             nspace = std::move(id);
             id     = SpanPtr::create(
                 spanText(advanceView(re2c::resLocPart(peekRest()))));
-            id->setLeadingTrivia(spanText(QStringLiteral(":")));
+            id->setLeadingTrivia(spanText(textView().mid(colonPos, 1)));
         }
         if (nspace) {
             if (nspace->text().contains('/')) {
@@ -725,31 +802,46 @@ namespace Command {
         node->setIsValid(!hasError);
     }
 
-    void MinecraftParser::parseBlock(BlockStateNode *node, bool acceptTag) {
+    MinecraftParser::Result<> MinecraftParser::parseBlock(
+        BlockStateNode *node, bool acceptTag) {
         const auto &&resLoc = QSharedPointer<ResourceLocationNode>::create(0);
 
         parseResourceLocation(resLoc.get(), acceptTag);
         node->setResLoc(std::move(resLoc));
 
         if (curChar() == '[') {
-            node->setStates(
+            const auto &&states =
                 parseMap<MapNode, ParseNode>('[', ']', '=',
                                              [this](const QString &) {
                 const static QVariantMap props{ { "type", "word" } };
                 return brigadier_string(props);
-            }));
+            });
+            if (!states) {
+                return ParseFailure();
+            }
+            node->setStates(states);
+        }
+        if (curChar() == '{') {
+            const auto &&nbt = parseCompoundTag();
+            if (!nbt) {
+                return ParseFailure();
+            }
+            node->setNbt(nbt);
         }
-        if (curChar() == '{')
-            node->setNbt(parseCompoundTag());
+        return Result<>();
     }
 
-    void Command::MinecraftParser::parseEntity(Command::EntityNode *node,
-                                               bool allowFakePlayer) {
+    MinecraftParser::Result<> Command::MinecraftParser::parseEntity(
+        Command::EntityNode *node, bool allowFakePlayer) {
         const int curPos = pos();
 
         switch (curChar().toLower().toLatin1()) {
             case '@': {
-                node->setNode(parseTargetSelector());
+                const auto &&selector = parseTargetSelector();
+                if (!selector) {
+                    return ParseFailure();
+                }
+                node->setNode(selector);
                 break;
             }
             case '0':
@@ -790,6 +882,7 @@ namespace Command {
                                    QT_TR_NOOP("Invalid empty player name"))));
             }
         }
+        return Result<>();
     }
 
     NodePtr MinecraftParser::invokeMethod(ArgumentNode::ParserType parserType,
@@ -888,7 +981,9 @@ namespace Command {
     minecraft_blockPos() {
         const auto &&ret = QSharedPointer<BlockPosNode>::create(0);
 
-        parseAxes(ret.get(), AxisParseOption::CanBeLocal);
+        if (!parseAxes(ret.get(), AxisParseOption::CanBeLocal)) {
+            return nullptr;
+        }
         return ret;
     }
 
@@ -897,7 +992,9 @@ namespace Command {
         const int    start = pos();
         const auto &&ret   = QSharedPointer<BlockStateNode>::create(0);
 
-        parseBlock(ret.get(), false);
+        if (!parseBlock(ret.get(), false)) {
+            return nullptr;
+        }
         ret->setLength(pos() - start);
         return ret;
     }
@@ -907,7 +1004,9 @@ namespace Command {
         const int    start = pos();
         const auto &&ret   = QSharedPointer<BlockPredicateNode>::create(0);
 
-        parseBlock(ret.get(), true);
+        if (!parseBlock(ret.get(), true)) {
+            return nullptr;
+        }
         ret->setLength(pos() - start);
         return ret;
     }
@@ -927,8 +1026,10 @@ namespace Command {
     minecraft_columnPos() {
         const auto &&ret = QSharedPointer<ColumnPosNode>::create(0);
 
-        parseAxes(ret.get(), AxisParseOption::OnlyInteger |
-                  AxisParseOption::CanBeLocal);
+        if (!parseAxes(ret.get(), AxisParseOption::OnlyInteger |
+                       AxisParseOption::CanBeLocal)) {
+            return nullptr;
+        }
         return ret;
     }
 
@@ -967,7 +1068,9 @@ namespace Command {
         ret->setSingleOnly(props[QStringLiteral(
                                      "amount")].toString() == "single"_QL1);
 
-        parseEntity(ret.get(), false);
+        if (!parseEntity(ret.get(), false)) {
+            return nullptr;
+        }
         return ret;
     }
 
@@ -1009,7 +1112,7 @@ namespace Command {
             if (peek(2) == ".."_QL1) {
                 advance(2);
                 hasDoubleDot = true;
-            } else if (!num1->text().isEmpty() && num1->text().back() == '.'_QL1
+            } else if (num1->textSpan().view().endsWith(u'.')
                        && curChar() == '.'_QL1) {
                 advance();
                 num1->chopTrailingDot();
@@ -1079,7 +1182,9 @@ namespace Command {
 
         ret->setPlayerOnly(true);
 
-        parseEntity(ret.get(), false);
+        if (!parseEntity(ret.get(), false)) {
+            return nullptr;
+        }
         return ret;
     }
 
@@ -1151,7 +1256,11 @@ namespace Command {
         ret->setResLoc(std::move(resLoc));
 
         if (curChar() == '{') {
-            ret->setNbt(parseCompoundTag());
+            const auto &&nbt = parseCompoundTag();
+            if (!nbt) {
+                return nullptr;
+            }
+            ret->setNbt(nbt);
         }
         ret->setLength(pos() - start);
         return ret;
@@ -1167,7 +1276,11 @@ namespace Command {
         ret->setResLoc(std::move(resLoc));
 
         if (curChar() == '{') {
-            ret->setNbt(parseCompoundTag());
+            const auto &&nbt = parseCompoundTag();
+            if (!nbt) {
+                return nullptr;
+            }
+            ret->setNbt(nbt);
         }
         ret->setLength(pos() - start);
         return ret;
@@ -1195,13 +1308,20 @@ namespace Command {
         const auto &&ret   = QSharedPointer<NbtPathNode>::create(0);
         const int    start = pos();
 
-        ret->append(parseNbtPathStep());
+        const auto &&first = parseNbtPathStep();
+        if (!first) {
+            return nullptr;
+        }
+        ret->append(first);
         auto last = ret->last();
         while (last->trailingTrivia() == '.' || curChar() == '[' ||
                curChar() == '"' ||
-               ((gameVer >= QVersionNumber(1, 20)) && (curChar() == '\''))) {
+               ((gameVer() >= QVersionNumber(1, 20)) && (curChar() == '\''))) {
             const auto &&step = parseNbtPathStep();
 
+            if (!step) {
+                return nullptr;
+            }
             if ((step->type() == NbtPathStepNode::Type::Key)
                 && (!(last->trailingTrivia() == '.'))) {
                 reportError(QT_TR_NOOP(
@@ -1232,7 +1352,7 @@ namespace Command {
             reportError(QT_TR_NOOP("Invalid empty objective"));
             valid = false;
         } else if ((objname.length() > 16) &&
-                   (gameVer < QVersionNumber(1, 18, 2))) {
+                   (gameVer() < QVersionNumber(1, 18, 2))) {
             reportError(QT_TR_NOOP(
                             "Objective '%1' must be less than 16 characters"),
                         { objname.toString() }, curPos, objname.length());
@@ -1284,58 +1404,95 @@ namespace Command {
         }
         ret->setResLoc(std::move(resLoc));
 
+        static const char *paramSepErrMsg(
+            "Unexpected %1, expecting %2 to separate between particle and parameters");
+        const auto eatSep = [this](ParseNode *node,
+                                   const char *errMsg = nullptr) {
+            const auto &&sep = tryEat(' ', errMsg);
+            if (sep) {
+                node->setTrailingTrivia(*sep);
+            }
+            return sep.ok();
+        };
+
         uswitch (fullId) {
             ucase ("block"_QL1):
             ucase ("block_marker"_QL1):
             ucase ("falling_dust"_QL1): {
-                resLoc->setTrailingTrivia(eat(' ',
-                                              "Unexpected %1, expecting %2 to separate between particle and parameters"));
-                ret->setParams(minecraft_blockState());
+                if (!eatSep(resLoc.get(), paramSepErrMsg)) {
+                    return nullptr;
+                }
+                const auto &&block = minecraft_blockState();
+                if (!block) {
+                    return nullptr;
+                }
+                ret->setParams(block);
                 break;
             }
             ucase ("dust"_QL1): {
-                resLoc->setTrailingTrivia(eat(' ',
-                                              "Unexpected %1, expecting %2 to separate between particle and parameters"));
+                if (!eatSep(resLoc.get(), paramSepErrMsg)) {
+                    return nullptr;
+                }
                 const auto &&color = parseParticleColor();
-                color->setTrailingTrivia(eat(' '));
+                if (!color || !eatSep(color.get())) {
+                    return nullptr;
+                }
                 ret->setParams(std::move(color), brigadier_float());
                 break;
             }
             ucase ("dust_color_transition"_QL1): {
-                resLoc->setTrailingTrivia(eat(' ',
-                                              "Unexpected %1, expecting %2 to separate between particle and parameters"));
+                if (!eatSep(resLoc.get(), paramSepErrMsg)) {
+                    return nullptr;
+                }
                 const auto &&startColor = parseParticleColor();
-                startColor->setTrailingTrivia(eat(' '));
+                if (!startColor || !eatSep(startColor.get())) {
+                    return nullptr;
+                }
                 const auto &&size = brigadier_float();
-                size->setTrailingTrivia(eat(' '));
+                if (!eatSep(size.get())) {
+                    return nullptr;
+                }
                 const auto &&endColor = parseParticleColor();
+                if (!endColor) {
+                    return nullptr;
+                }
                 ret->setParams(std::move(startColor), std::move(size),
                                std::move(endColor));
                 break;
             }
             ucase ("item"_QL1): {
-                resLoc->setTrailingTrivia(eat(' ',
-                                              "Unexpected %1, expecting %2 to separate between particle and parameters"));
-                ret->setParams(minecraft_itemStack());
+                if (!eatSep(resLoc.get(), paramSepErrMsg)) {
+                    return nullptr;
+                }
+                const auto &&item = minecraft_itemStack();
+                if (!item) {
+                    return nullptr;
+                }
+                ret->setParams(item);
                 break;
             }
             ucase ("sculk_charge"_QL1): {
-                resLoc->setTrailingTrivia(eat(' ',
-                                              "Unexpected %1, expecting %2 to separate between particle and parameters"));
+                if (!eatSep(resLoc.get(), paramSepErrMsg)) {
+                    return nullptr;
+                }
                 ret->setParams(brigadier_float());
                 break;
             }
             ucase ("shriek"_QL1): {
-                resLoc->setTrailingTrivia(eat(' ',
-                                              "Unexpected %1, expecting %2 to separate between particle and parameters"));
+                if (!eatSep(resLoc.get(), paramSepErrMsg)) {
+                    return nullptr;
+                }
                 ret->setParams(brigadier_integer());
                 break;
             }
             ucase ("vibration"_QL1): {
-                resLoc->setTrailingTrivia(eat(' ',
-                                              "Unexpected %1, expecting %2 to separate between particle and parameters"));
+                if (!eatSep(resLoc.get(), paramSepErrMsg)) {
+                    return nullptr;
+                }
                 const auto &&pos = minecraft_vec3();
-                pos->setTrailingTrivia(eat(' '));
+                if (!pos || !eatSep(pos.get())) {
+                    return nullptr;
+                }
                 ret->setParams(std::move(pos), brigadier_integer());
                 break;
             }
@@ -1388,7 +1545,9 @@ namespace Command {
     minecraft_rotation() {
         const auto &&ret = QSharedPointer<RotationNode>::create(0);
 
-        parseAxes(ret.get(), AxisParseOption::NoOption);
+        if (!parseAxes(ret.get(), AxisParseOption::NoOption)) {
+            return nullptr;
+        }
         return ret;
     }
 
@@ -1405,7 +1564,9 @@ namespace Command {
             const auto &&ret = QSharedPointer<ScoreHolderNode>::create(0);
             ret->setSingleOnly(props[QStringLiteral(
                                          "amount")].toString() == "single"_QL1);
-            parseEntity(ret.get(), true);
+            if (!parseEntity(ret.get(), true)) {
+                return nullptr;
+            }
             return ret;
         }
     }
@@ -1414,7 +1575,7 @@ namespace Command {
     minecraft_scoreboardSlot() {
         QString slot;
 
-        if (gameVer >= QVersionNumber(1, 20, 2)) {
+        if (gameVer() >= QVersionNumber(1, 20, 2)) {
             slot = oneOf(staticSuggestions_ScoreboardSlotNode_v1_20_2);
         } else {
             slot = oneOf(staticSuggestions<ScoreboardSlotNode>);
@@ -1447,9 +1608,11 @@ namespace Command {
 
     QSharedPointer<SwizzleNode> MinecraftParser::
     minecraft_swizzle() {
+        constexpr static Charset axisChars{ "xyz" };
+
         const int         start = pos();
         SwizzleNode::Axes axes;
-        QString           acceptedChars = QStringLiteral("xyz");
+        Charset           acceptedChars = axisChars;
 
         while (acceptedChars.contains(curChar())) {
             switch (curChar().toLatin1()) {
@@ -1468,7 +1631,7 @@ namespace Command {
                     break;
                 }
             }
-            acceptedChars = acceptedChars.replace(curChar(), QString());
+            acceptedChars.remove(curChar());
             advance();
         }
         return QSharedPointer<SwizzleNode>::create(spanText(start), axes);
@@ -1562,14 +1725,18 @@ namespace Command {
     QSharedPointer<Vec2Node> MinecraftParser::minecraft_vec2() {
         const auto &&ret = QSharedPointer<Vec2Node>::create(0);
 
-        parseAxes(ret.get(), AxisParseOption::CanBeLocal);
+        if (!parseAxes(ret.get(), AxisParseOption::CanBeLocal)) {
+            return nullptr;
+        }
         return ret;
     }
 
     QSharedPointer<Vec3Node> MinecraftParser::minecraft_vec3() {
         const auto &&ret = QSharedPointer<Vec3Node>::create(0);
 
-        parseAxes(ret.get(), AxisParseOption::CanBeLocal);
+        if (!parseAxes(ret.get(), AxisParseOption::CanBeLocal)) {
+            return nullptr;
+        }
         return ret;
     }
 
@@ -1606,13 +1773,30 @@ namespace Command {
         }
     }
 
-    void MinecraftParser::setGameVer(const QVersionNumber &newGameVer,
-                                     const bool autoLoadSchema) {
-        gameVer = newGameVer;
+/*!
+ * \brief Loads the command schema of \a newGameVer into the current schema.
+ */
+    void MinecraftParser::setGameVer(const QVersionNumber &newGameVer) {
+        const QString &&version = newGameVer.toString();
 
-        if (autoLoadSchema) {
-            loadSchema(QStringLiteral(":/minecraft/") + newGameVer.toString() +
-                       QStringLiteral("/summary/commands/data.min.json"));
+        if (const auto *bundle = GameDataBundle::forVersion(version);
+            bundle && bundle->contains(GameDataBundle::Kind::Schema,
+                                       QStringLiteral("commands"))) {
+            QElapsedTimer timer;
+            timer.start();
+
+            const Schema::SchemaLoader loader(
+                bundle->schema(), Schema::SchemaLoader::Format::MessagePack);
+            if (loader.tree()) {
+                setSchema(loader.tree(), loader.checksum(), newGameVer);
+                qInfo() << "Command schema loaded from the game data bundle"
+                        << "in" << timer.elapsed() << "ms (version:"
+                        << version << ")";
+                return;
+            }
         }
+        loadSchema(QStringLiteral(":/minecraft/") + version +
+                   QStringLiteral("/summary/commands/data.min.json"),
+                   newGameVer);
     }
 }
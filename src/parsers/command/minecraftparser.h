@@ -134,14 +134,11 @@ public:
         MinecraftParser();
         using SchemaParser::SchemaParser;
 
-        static void setGameVer(const QVersionNumber &newGameVer,
-                               const bool autoLoadSchema = true);
+        static void setGameVer(const QVersionNumber &newGameVer);
 
 private:
         friend class McfunctionParser;
 
-        static inline QVersionNumber gameVer = QVersionNumber();
-
         template<typename T, size_t N>
         QString oneOf(const std::array<T, N> &strArr) {
             const int         start   = pos();
@@ -173,38 +170,43 @@ private:
             return ret;
         }
 
-        QString eatListSep(QChar sepChr, QChar endChr);
+        Result<TextSpan> eatListSep(QChar sepChr, QChar endChr);
 
         template<class Container, class Type>
         QSharedPointer<Container> parseMap(QChar beginChar,
                                            QChar endChar,
                                            QChar sepChar,
                                            std::function<QSharedPointer<Type>(const QString &)> func,
-                                           bool acceptQuotation            = false,
-                                           const QLatin1String &keyCharset = QLatin1String())
+                                           bool acceptQuotation      = false,
+                                           const Charset *keyCharset = nullptr)
         {
             auto    &&obj   = QSharedPointer<Container>::create(0);
             const int start = pos();
 
-            obj->setLeftText(this->eat(beginChar));
+            const auto &&leftText = this->tryEat(beginChar);
+            if (!leftText) {
+                return nullptr;
+            }
+            obj->setLeftText(*leftText);
             while (this->curChar() != endChar) {
                 const auto &&trivia = this->skipWs(false);
                 const int    keyPos = pos();
                 QString      name;
                 if (acceptQuotation &&
                     (curChar() == '"' || curChar() == '\'')) {
-                    try {
-                        name = getQuotedString();
-                    } catch (const SchemaParser::Error &) {
+                    if (auto &&quoted = tryGetQuotedString()) {
+                        name = std::move(*quoted);
+                    } else {
+                        takeFailure();
                         qDebug() << "No quotation have been found. Continue.";
                     }
                 }
                 if (name.isEmpty()) {
                     setPos(keyPos);
-                    if (keyCharset.isNull()) {
-                        name = getLiteralString().toString();
+                    if (keyCharset) {
+                        name = getWithCharset(*keyCharset).toString();
                     } else {
-                        name = getWithCharset(keyCharset).toString();
+                        name = getLiteralString().toString();
                     }
                 }
                 if (name.isEmpty())
@@ -212,29 +214,43 @@ private:
                 const auto &&key = KeyPtr::create(spanText(keyPos), name,
                                                   !name.isEmpty());
                 key->setLeadingTrivia(trivia);
-                key->setTrailingTrivia(spanText(eat(sepChar,
-                                                    "Unexpected %1, expecting %2 separator between a key and a value",
-                                                    SkipLeftWs)));
+                const auto &&sep = tryEat(sepChar,
+                                          "Unexpected %1, expecting %2 separator between a key and a value",
+                                          SkipLeftWs);
+                if (!sep) {
+                    return nullptr;
+                }
+                key->setTrailingTrivia(*sep);
                 const auto &&valueTrivia = skipWs(false);
                 //const int    valueStart  = pos();
                 const auto &&value = func(name);
+                if (!value) {
+                    return nullptr;
+                }
                 //value->setLength(pos() - valueStart);
-                value->setLeadingTrivia(spanText(valueTrivia));
+                value->setLeadingTrivia(valueTrivia);
                 value->setTrailingTrivia(this->skipWs(false));
                 obj->insert(key, value);
                 if (this->curChar() != endChar) {
-                    obj->constLast()->setTrailingTrivia(eat(',', nullptr,
-                                                            SkipRightWs));
+                    const auto &&comma = tryEat(',', nullptr, SkipRightWs);
+                    if (!comma) {
+                        return nullptr;
+                    }
+                    obj->constLast()->setTrailingTrivia(*comma);
                 }
             }
-            obj->setRightText(this->eat(endChar));
+            const auto &&rightText = this->tryEat(endChar);
+            if (!rightText) {
+                return nullptr;
+            }
+            obj->setRightText(*rightText);
             obj->setLength(pos() - start);
             return obj;
         }
 
         QSharedPointer<AngleNode> parseAxis(AxisParseOptions options,
                                             bool &isLocal);
-        void parseAxes(ArgumentNode *node, AxisParseOptions options);
+        Result<> parseAxes(ArgumentNode *node, AxisParseOptions options);
         QSharedPointer<XyzNode> parseXyzAxes(AxisParseOptions options);
         QSharedPointer<NbtCompoundNode> parseCompoundTag();
         QSharedPointer<NbtNode> parseTagValue();
@@ -252,15 +268,26 @@ private:
             while (curChar() != ']') {
                 const auto &&trivia = skipWs(false);
                 const auto &&numTag = parseNumericTag();
-                const auto &&elem   = qSharedPointerCast<Type>(numTag);
+                if (!numTag) {
+                    return nullptr;
+                }
+                const auto &&elem = qSharedPointerCast<Type>(numTag);
                 if (!elem) {
                     reportError(errorMsg);
                 }
                 elem->setLeadingTrivia(trivia);
                 ret->append(elem);
-                elem->setTrailingTrivia(eatListSep(',', ']'));
+                const auto &&sep = eatListSep(',', ']');
+                if (!sep) {
+                    return nullptr;
+                }
+                elem->setTrailingTrivia(*sep);
+            }
+            const auto &&rightText = tryEat(']');
+            if (!rightText) {
+                return nullptr;
             }
-            ret->setRightText(eat(']'));
+            ret->setRightText(*rightText);
             return ret;
         }
         QSharedPointer<NbtListNode> parseListTag();
@@ -268,12 +295,13 @@ private:
         QSharedPointer<MapNode> parseEntityArguments();
         QSharedPointer<TargetSelectorNode> parseTargetSelector();
         QSharedPointer<NbtPathStepNode> parseNbtPathStep();
+        Result<> parseNbtPathFilter(NbtPathStepNode *step);
         QSharedPointer<ParticleColorNode> parseParticleColor();
         QSharedPointer<EntityArgumentValueNode> parseNegEntityArg();
         void parseResourceLocation(ResourceLocationNode *node,
                                    bool acceptTag = false);
-        void parseBlock(BlockStateNode *node, bool acceptTag);
-        void parseEntity(EntityNode *node, bool allowFakePlayer);
+        Result<> parseBlock(BlockStateNode *node, bool acceptTag);
+        Result<> parseEntity(EntityNode *node, bool allowFakePlayer);
 
         NodePtr invokeMethod(ArgumentNode::ParserType parserType,
                              const QVariantMap &props) final;
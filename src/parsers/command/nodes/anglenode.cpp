@@ -6,7 +6,7 @@ namespace Command {
         : ArgumentNode(ParserType::Angle, QString()), m_type{type} {
     }
 
-    AngleNode::AngleNode(const QString &text)
+    AngleNode::AngleNode(const TextSpan &text)
         : ArgumentNode(ParserType::Angle, text) {
         setValue(0);
     }
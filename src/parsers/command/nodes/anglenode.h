@@ -18,7 +18,7 @@ public:
         };
 
         explicit AngleNode(AxisType type = AxisType::Absolute);
-        explicit AngleNode(const QString &text);
+        explicit AngleNode(const TextSpan &text);
 
         void accept(NodeVisitor *visitor, VisitOrder order) final;
 
@@ -95,7 +95,7 @@ protected:
         explicit ArgumentNode(ParserType parserType, int length)
             : ParseNode(Kind::Argument, length), m_parserType(parserType) {
         };
-        explicit ArgumentNode(ParserType parserType, const QString &text)
+        explicit ArgumentNode(ParserType parserType, const TextSpan &text)
             : ParseNode(Kind::Argument, text), m_parserType(parserType) {
         };
     };
@@ -2,7 +2,7 @@
 #include "../visitors/nodevisitor.h"
 
 namespace Command {
-    ComponentNode::ComponentNode(const QString &text)
+    ComponentNode::ComponentNode(const TextSpan &text)
         : ArgumentNode(ParserType::Component, text) {
     }
 
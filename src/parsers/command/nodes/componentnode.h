@@ -8,7 +8,7 @@
 namespace Command {
     class ComponentNode final : public ArgumentNode {
 public:
-        explicit ComponentNode(const QString &text);
+        explicit ComponentNode(const TextSpan &text);
 
         void accept(NodeVisitor *visitor, VisitOrder) final;
 
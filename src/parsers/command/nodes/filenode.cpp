@@ -1,6 +1,74 @@
 #include "filenode.h"
 
 namespace Command {
+    /*!
+     * \brief Returns the logical position of the physical position \a physPos.
+     */
+    int SourceMapper::logicalPosOf(const int physPos) const {
+        auto &&nearest = logicalPositions.upperBound(physPos);
+
+        if (nearest == logicalPositions.cbegin()) {
+            return physPos;
+        }
+        --nearest;
+        return physPos + nearest.value() - nearest.key();
+    }
+
+    template<class Map, typename Shift>
+    static void shiftTail(Map &map, const int removeFrom, const int oldEnd,
+                          Shift shift) {
+        Map tail;
+
+        for (auto it = map.lowerBound(oldEnd); it != map.end();) {
+            shift(tail, it.key(), it.value());
+            it = map.erase(it);
+        }
+        for (auto it = map.lowerBound(removeFrom); it != map.end();) {
+            it = map.erase(it);
+        }
+        map.insert(tail);
+    }
+
+    /*!
+     * \brief Replaces the mappings of the lines in \a range with the
+     * mappings from \a patch, then shifts the mappings of the following lines
+     * in place.
+     */
+    void SourceMapper::splice(const Splice &range,
+                              const SourceMapper &patch) {
+        const int physDelta = range.newPhysEnd - range.oldPhysEnd;
+        const int logiDelta = range.newLogiEnd - range.oldLogiEnd;
+
+        shiftTail(backslashMap, range.logiStart, range.oldLogiEnd,
+                  [physDelta, logiDelta](QMap<int, Info> &tail, int key,
+                                         const Info &info) {
+            tail.insert(key + logiDelta, { info.pos + physDelta,
+                                           info.trivia });
+        });
+        shiftTail(physicalPositions, range.logiStart, range.oldLogiEnd,
+                  [physDelta, logiDelta](QMap<int, int> &tail, int key,
+                                         int value) {
+            tail.insert(key + logiDelta, value + physDelta);
+        });
+        shiftTail(logicalPositions, range.physStart, range.oldPhysEnd,
+                  [physDelta, logiDelta](QMap<int, int> &tail, int key,
+                                         int value) {
+            tail.insert(key + physDelta, value + logiDelta);
+        });
+        backslashMap.insert(patch.backslashMap);
+        physicalPositions.insert(patch.physicalPositions);
+        logicalPositions.insert(patch.logicalPositions);
+
+        const int oldEndLine = range.firstLine + range.lineCount;
+        for (int i = oldEndLine; i < logicalLines.size(); ++i) {
+            logicalLines[i] += range.lineDelta;
+        }
+        logicalLines.remove(range.firstLine, range.lineCount);
+        for (int i = 0; i < patch.logicalLines.size(); ++i) {
+            logicalLines.insert(range.firstLine + i, patch.logicalLines.at(i));
+        }
+    }
+
     FileNode::FileNode() : ParseNode(ParseNode::Kind::Container) {
         m_isValid = true;
     }
@@ -9,6 +77,23 @@ namespace Command {
         return m_lines;
     }
 
+    /*!
+     * \brief Replaces \a count lines starting at \a index with \a lines.
+     */
+    void FileNode::replace(const int index, const int count, Lines &&lines) {
+        if (lines.size() > count) {
+            m_lines.insert(index + count, lines.size() - count, NodePtr());
+        } else if (lines.size() < count) {
+            m_lines.remove(index + lines.size(), count - lines.size());
+        }
+        std::move(lines.begin(), lines.end(), m_lines.begin() + index);
+
+        m_isValid = std::all_of(m_lines.cbegin(), m_lines.cend(),
+                                [](const NodePtr &line) {
+            return line->isValid();
+        });
+    }
+
     SourceMapper &FileNode::sourceMapper() {
         return m_srcMapper;
     }
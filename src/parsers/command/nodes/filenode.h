@@ -29,6 +29,27 @@ namespace Command {
         int logicalLinesIndexOf(const int pos) const {
             return binarySearchIndexOf(logicalLines, pos);
         }
+
+        int logicalPosOf(const int physPos) const;
+
+        /*!
+         * \brief Describes a range of logical lines that has been split again
+         * after an edit. Positions are the starts of the first line and of
+         * the line right after the range, before and after the edit.
+         */
+        struct Splice {
+            int firstLine  = 0; // Index of the first replaced logical line
+            int lineCount  = 0; // Number of replaced logical lines
+            int lineDelta  = 0; // Change in the number of physical lines
+            int physStart  = 0;
+            int logiStart  = 0;
+            int oldPhysEnd = 0;
+            int oldLogiEnd = 0;
+            int newPhysEnd = 0;
+            int newLogiEnd = 0;
+        };
+
+        void splice(const Splice &range, const SourceMapper &patch);
     };
 
     class FileNode : public ParseNode {
@@ -54,6 +75,8 @@ public:
             return m_lines.at(i);
         }
 
+        void replace(const int index, const int count, Lines &&lines);
+
         Lines lines() const;
 
         SourceMapper &sourceMapper();
@@ -3,7 +3,7 @@
 #include "../visitors/nodevisitor.h"
 
 namespace Command {
-    GamemodeNode::GamemodeNode(const QString &text, const Mode &value,
+    GamemodeNode::GamemodeNode(const TextSpan &text, const Mode &value,
                                const bool isValid)
         : ArgumentNode(ParserType::Gamemode, text), m_value(value) {
         this->m_isValid = isValid;
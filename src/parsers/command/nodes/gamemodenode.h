@@ -15,7 +15,7 @@ public:
             Spectator,
         };
 
-        GamemodeNode(const QString &text, const Mode &value,
+        GamemodeNode(const TextSpan &text, const Mode &value,
                      const bool isValid = false);
 
         void accept(NodeVisitor *visitor, VisitOrder) final;
@@ -2,7 +2,7 @@
 #include "../visitors/nodevisitor.h"
 
 namespace Command {
-    LiteralNode::LiteralNode(const QString &txt)
+    LiteralNode::LiteralNode(const TextSpan &txt)
         : ParseNode(Kind::Literal, txt) {
         m_isValid = true;
     }
@@ -7,7 +7,7 @@ namespace Command {
     class LiteralNode : public ParseNode
     {
 public:
-        explicit LiteralNode(const QString &txt);
+        explicit LiteralNode(const TextSpan &txt);
 
         void accept(NodeVisitor *visitor, VisitOrder) final;
 
@@ -25,14 +25,14 @@ private:
 
     class MacroVariableNode : public ParseNode {
 public:
-        explicit MacroVariableNode(const QString &key, const int length,
+        explicit MacroVariableNode(const TextSpan &key, const int length,
                                    const bool valid = false)
             : ParseNode{Kind::MacroVariable, length}, m_key{key} {
             m_isValid = valid;
         }
 
 private:
-        QString m_key;
+        TextSpan m_key;
     };
 
     DECLARE_TYPE_ENUM(ParseNode::Kind, Macro)
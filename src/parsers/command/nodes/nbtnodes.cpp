@@ -10,7 +10,7 @@ namespace Command {
         : ArgumentNode(parserType, length) {
     }
 
-    NbtNode::NbtNode(ParserType parserType, const QString &text)
+    NbtNode::NbtNode(ParserType parserType, const TextSpan &text)
         : ArgumentNode(parserType, text) {
     }
 
@@ -33,7 +33,7 @@ protected:
 
         explicit NbtNode(TagType tagType, int length);
         explicit NbtNode(ParserType parserType, int length);
-        explicit NbtNode(ParserType parserType, const QString &text);
+        explicit NbtNode(ParserType parserType, const TextSpan &text);
         explicit NbtNode(ParserType parserType, TagType tagType, int length);
     };
 
@@ -44,8 +44,8 @@ protected:
                                                            ArgumentNode::ParserType::NbtTag> \
         {                                                                                    \
 public:                                                                                      \
-            Nbt ## Name ## Node(const QString &text, const T &value,                         \
-                                const bool isValid)                                          \
+            Nbt ## Name ## Node(const TextSpan &text, const T &value,                        \
+                                 const bool isValid)                                         \
                 : SingleValueNode(text, value, isValid) {                                    \
                 m_tagType = TagType::Name;                                                   \
             };                                                                               \
@@ -66,13 +66,13 @@ public:
                                                  ArgumentNode::ParserType::NbtTag>
     {
 public:
-        NbtStringNode(const QString &text, const QString &value,
+        NbtStringNode(const TextSpan &text, const QString &value,
                       const bool isValid)
             : SingleValueNode(text, value, isValid) {
             m_tagType = TagType::String;
         };
-        explicit NbtStringNode(const QString &text, const bool isValid)
-            : SingleValueNode(text, text, isValid) {
+        explicit NbtStringNode(const TextSpan &text, const bool isValid)
+            : SingleValueNode(text, text.toString(), isValid) {
             m_tagType = TagType::String;
         };
         void accept(NodeVisitor *visitor, VisitOrder) final;
@@ -13,19 +13,27 @@ namespace Command {
     }
 
     bool ParseNode::hasText() const {
-        return std::holds_alternative<QString>(m_span);
+        return std::holds_alternative<TextSpan>(m_span);
     }
 
     QString ParseNode::text() const {
-        return (hasText()) ? std::get<QString>(m_span) : QString();
+        return (hasText()) ? std::get<TextSpan>(m_span).toString() : QString();
+    }
+
+    /*!
+     * \brief Returns the span of the text in the source, which is empty if
+     * the node only has a length.
+     */
+    TextSpan ParseNode::textSpan() const {
+        return (hasText()) ? std::get<TextSpan>(m_span) : TextSpan();
     }
 
     int ParseNode::length() const {
-        return (hasText()) ? std::get<QString>(m_span).length() : std::get<int>(
+        return (hasText()) ? std::get<TextSpan>(m_span).length() : std::get<int>(
             m_span);
     }
 
-    void ParseNode::setText(const QString &text) {
+    void ParseNode::setText(const TextSpan &text) {
         m_span = text;
     }
 
@@ -45,35 +53,35 @@ namespace Command {
         m_isValid = newIsValid;
     }
 
-    QString ParseNode::leadingTrivia() const {
+    const TextSpan &ParseNode::leadingTrivia() const {
         return m_leadingTrivia;
     }
 
-    void ParseNode::setLeadingTrivia(const QString &newLeadingTrivia) {
+    void ParseNode::setLeadingTrivia(const TextSpan &newLeadingTrivia) {
         m_leadingTrivia = newLeadingTrivia;
     }
 
-    QString ParseNode::trailingTrivia() const {
+    const TextSpan &ParseNode::trailingTrivia() const {
         return m_trailingTrivia;
     }
 
-    void ParseNode::setTrailingTrivia(const QString &newTrailingTrivia) {
+    void ParseNode::setTrailingTrivia(const TextSpan &newTrailingTrivia) {
         m_trailingTrivia = newTrailingTrivia;
     }
 
-    QString ParseNode::leftText() const {
+    const TextSpan &ParseNode::leftText() const {
         return m_left;
     }
 
-    void ParseNode::setLeftText(const QString &newLeft) {
+    void ParseNode::setLeftText(const TextSpan &newLeft) {
         m_left = newLeft;
     }
 
-    QString ParseNode::rightText() const {
+    const TextSpan &ParseNode::rightText() const {
         return m_right;
     }
 
-    void ParseNode::setRightText(const QString &newRight) {
+    void ParseNode::setRightText(const TextSpan &newRight) {
         m_right = newRight;
     }
 
@@ -84,7 +92,7 @@ namespace Command {
         m_span{length} {
     }
 
-    ParseNode::ParseNode(Kind kind, const QString &text) : m_kind(kind),
+    ParseNode::ParseNode(Kind kind, const TextSpan &text) : m_kind(kind),
         m_span{text} {
     }
 
@@ -1,7 +1,10 @@
 #ifndef PARSENODE_H
 #define PARSENODE_H
 
+#include "../../textspan.h"
+
 #include <QDebug>
+#include <QSharedPointer>
 
 namespace Command {
     class NodeVisitor;
@@ -25,7 +28,7 @@ public:
             Argument,
         };
 
-        using Span = std::variant<int, QString>;
+        using Span = std::variant<int, TextSpan>;
 
         bool isValid() const;
         virtual void accept(NodeVisitor *visitor, VisitOrder order);
@@ -34,39 +37,40 @@ public:
 
         bool hasText() const;
         QString text() const;
+        TextSpan textSpan() const;
         int length() const;
 
         void setLength(int length);
         void setIsValid(bool newIsValid);
 
-        QString leadingTrivia() const;
-        void setLeadingTrivia(const QString &newLeadingTrivia);
+        const TextSpan &leadingTrivia() const;
+        void setLeadingTrivia(const TextSpan &newLeadingTrivia);
 
-        QString trailingTrivia() const;
-        void setTrailingTrivia(const QString &newTrailingTrivia);
+        const TextSpan &trailingTrivia() const;
+        void setTrailingTrivia(const TextSpan &newTrailingTrivia);
 
-        QString leftText() const;
-        void setLeftText(const QString &newLeft);
+        const TextSpan &leftText() const;
+        void setLeftText(const TextSpan &newLeft);
 
-        QString rightText() const;
-        void setRightText(const QString &newRight);
+        const TextSpan &rightText() const;
+        void setRightText(const TextSpan &newRight);
 
         const Schema::Node * schemaNode() const;
         void setSchemaNode(const Schema::Node *newSchemaNode);
 
 protected:
-        QString m_left;
-        QString m_right;
-        QString m_leadingTrivia;
-        QString m_trailingTrivia;
+        TextSpan m_left;
+        TextSpan m_right;
+        TextSpan m_leadingTrivia;
+        TextSpan m_trailingTrivia;
         Kind m_kind    = Kind::Span;
         bool m_isValid = false;
 
         explicit ParseNode(Kind kind);
         explicit ParseNode(Kind kind, int length);
-        explicit ParseNode(Kind kind, const QString &text);
+        explicit ParseNode(Kind kind, const TextSpan &text);
 
-        void setText(const QString &text);
+        void setText(const TextSpan &text);
 
 private:
         Span m_span                      = 0;
@@ -77,7 +81,7 @@ private:
 
     class ErrorNode : public ParseNode {
 public:
-        explicit ErrorNode(const QString &text) : ParseNode(Kind::Error, text) {
+        explicit ErrorNode(const TextSpan &text) : ParseNode(Kind::Error, text) {
         };
 
         void accept(NodeVisitor *visitor, VisitOrder) final;
@@ -85,7 +89,7 @@ public:
 
     class SpanNode : public ParseNode {
 public:
-        explicit SpanNode(const QString &text, const bool valid = false)
+        explicit SpanNode(const TextSpan &text, const bool valid = false)
             : ParseNode(Kind::Span, text) {
             m_isValid = valid;
         };
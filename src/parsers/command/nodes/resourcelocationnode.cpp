@@ -55,6 +55,41 @@ namespace Command {
         m_isTag = isTag;
     }
 
+    /*!
+     * \brief Returns the ID with its namespace, which defaults to
+     * \c minecraft, and without the leading \c # of a tag.
+     */
+    QString ResourceLocationNode::fullId() const {
+        QString &&ret = m_namespace ? m_namespace->textSpan().toString()
+                                    : QStringLiteral("minecraft");
+
+        ret += ':';
+        if (m_id) {
+            ret += m_id->textSpan();
+        }
+        return std::move(ret);
+    }
+
+    /*!
+     * \brief Returns the span of the parsed text from the leading \c # of
+     * a tag or the namespace to the end of the ID.
+     */
+    TextSpan ResourceLocationNode::sourceSpan() const {
+        if (!m_id) {
+            return TextSpan();
+        }
+
+        const TextSpan &&idSpan = m_id->textSpan();
+        int              start  = m_namespace
+                                      ? m_namespace->textSpan().offset()
+                                      : idSpan.offset();
+        if (m_isTag && (start > 0)) {
+            --start;
+        }
+        return TextSpan(idSpan.buffer(), start,
+                        idSpan.offset() + idSpan.length() - start);
+    }
+
     DEFINE_ACCEPT_METHOD(DimensionNode)
     DEFINE_ACCEPT_METHOD(EntitySummonNode)
     DEFINE_ACCEPT_METHOD(FunctionNode)
@@ -23,6 +23,9 @@ public:
         bool isTag() const;
         void setIsTag(bool isTag);
 
+        QString fullId() const;
+        TextSpan sourceSpan() const;
+
 protected:
         SpanPtr m_namespace = nullptr;
         SpanPtr m_id        = nullptr;
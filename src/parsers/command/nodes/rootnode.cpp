@@ -46,4 +46,11 @@ namespace Command {
     RootNode::Nodes RootNode::children() const {
         return m_children;
     }
+
+/*!
+ * \brief Sets the \a schema which the command has been parsed with.
+ */
+    void RootNode::setSchema(QSharedPointer<const SchemaSnapshot> schema) {
+        m_schema = std::move(schema);
+    }
 }
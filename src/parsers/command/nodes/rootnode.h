@@ -6,6 +6,8 @@
 #include <deque>
 
 namespace Command {
+    class SchemaSnapshot;
+
     class RootNode : public ParseNode
     {
 public:
@@ -25,8 +27,12 @@ public:
 
         Nodes children() const;
 
+        void setSchema(QSharedPointer<const SchemaSnapshot> schema);
+
 private:
         Nodes m_children;
+        // Keeps the schema graph which the nodes point into alive
+        QSharedPointer<const SchemaSnapshot> m_schema;
     };
 
     DECLARE_TYPE_ENUM(ParseNode::Kind, Root)
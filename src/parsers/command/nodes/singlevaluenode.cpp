@@ -3,8 +3,10 @@
 
 namespace Command {
     void FloatNode::chopTrailingDot() {
-        if (text().back() == '.') {
-            setText(text().chopped(1));
+        const TextSpan &&span = textSpan();
+
+        if (!span.isEmpty() && (span.view().back() == u'.')) {
+            setText(span.chopped(1));
         }
     }
 
@@ -10,7 +10,7 @@ namespace Command {
     template <class Base, typename T, ArgumentNode::ParserType PT>
     class SingleValueNode : public Base {
 public:
-        SingleValueNode(const QString &text, const T &value,
+        SingleValueNode(const TextSpan &text, const T &value,
                         const bool isValid = false)
             : Base(PT, text), m_value(value) {
             this->m_isValid = isValid;
@@ -18,9 +18,9 @@ public:
         template <typename _T = T,
                   typename = typename std::enable_if_t<std::is_same<_T,
                                                                     QString>::value> >
-        explicit SingleValueNode(const QString &text,
+        explicit SingleValueNode(const TextSpan &text,
                                  const bool isValid = false)
-            : Base(PT, text), m_value(text) {
+            : Base(PT, text), m_value(text.toString()) {
             this->m_isValid = isValid;
         };
 
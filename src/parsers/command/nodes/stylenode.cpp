@@ -2,7 +2,7 @@
 #include "../visitors/nodevisitor.h"
 
 namespace Command {
-    StyleNode::StyleNode(const QString &text)
+    StyleNode::StyleNode(const TextSpan &text)
         : ArgumentNode(ParserType::Component, text) {
     }
 
@@ -8,7 +8,7 @@
 namespace Command {
     class StyleNode final : public ArgumentNode {
 public:
-        explicit StyleNode(const QString &text);
+        explicit StyleNode(const TextSpan &text);
 
         void accept(NodeVisitor *visitor, VisitOrder) final;
 
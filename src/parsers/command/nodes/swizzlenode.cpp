@@ -2,7 +2,7 @@
 #include "../visitors/nodevisitor.h"
 
 namespace Command {
-    SwizzleNode::SwizzleNode(const QString &text, bool hasX, bool hasY,
+    SwizzleNode::SwizzleNode(const TextSpan &text, bool hasX, bool hasY,
                              bool hasZ)
         : ArgumentNode(ParserType::Swizzle, text) {
         m_axes.setFlag(Axis::X, hasX);
@@ -12,7 +12,7 @@ namespace Command {
         m_isValid = int(m_axes) != 0;
     }
 
-    SwizzleNode::SwizzleNode(const QString &text, Axes axes)
+    SwizzleNode::SwizzleNode(const TextSpan &text, Axes axes)
         : ArgumentNode(ParserType::Swizzle, text), m_axes(axes) {
         m_isValid = int(m_axes) != 0;
     }
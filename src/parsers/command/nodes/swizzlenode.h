@@ -14,8 +14,8 @@ public:
         };
         Q_DECLARE_FLAGS(Axes, Axis);
 
-        SwizzleNode(const QString &text, bool hasX, bool hasY, bool hasZ);
-        SwizzleNode(const QString &text, Axes axes);
+        SwizzleNode(const TextSpan &text, bool hasX, bool hasY, bool hasZ);
+        SwizzleNode(const TextSpan &text, Axes axes);
 
         void accept(NodeVisitor *visitor, VisitOrder) final;
 
@@ -2,7 +2,7 @@
 #include "../visitors/nodevisitor.h"
 
 namespace Command {
-    TimeNode::TimeNode(const QString &text, int v, Unit unit)
+    TimeNode::TimeNode(const TextSpan &text, int v, Unit unit)
         : ArgumentNode(ParserType::Time, text), m_value(v), m_unit(unit) {
         m_isValid = true;
     }
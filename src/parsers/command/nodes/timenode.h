@@ -13,7 +13,7 @@ public:
             Second,
             Day,
         };
-        TimeNode(const QString &text,
+        TimeNode(const TextSpan &text,
                  int v, Unit unit = Unit::ImplicitTick);
         void accept(NodeVisitor *visitor, VisitOrder order) final;
 
@@ -1,71 +1,137 @@
 #include "parsenodecache.h"
 
+#include <QHash>
+
 namespace Command {
-    bool CacheKey::operator==(const CacheKey &rhs) const {
-        return (typeId == rhs.typeId) && (literalStr == rhs.literalStr)
-               && (props == rhs.props);
-    }
+    // Estimated memory usage of the nodes parsed from each character
+    constexpr size_t nodeBytesPerChar = 24;
+    constexpr size_t entryOverhead    = sizeof(ParseNode) * 2 + 64;
 
-    ParseNodeCache::ParseNodeCache(int capacity)  : m_cache(capacity) {
-        m_cache.monitor();
+    ParseNodeCache::ParseNodeCache(size_t byteBudget)
+        : m_byteBudget(byteBudget) {
     }
 
     bool ParseNodeCache::isEmpty() const {
-        return m_cache.is_empty();
+        QMutexLocker locker(&m_mutex);
+
+        return m_entries.empty();
     }
 
     int ParseNodeCache::size() const {
-        return m_cache.size();
+        QMutexLocker locker(&m_mutex);
+
+        return m_index.size();
     }
 
-    int ParseNodeCache::capacity() const {
-        return m_cache.capacity();
+    /*!
+     * \brief Returns the estimated memory usage of the cached entries.
+     */
+    size_t ParseNodeCache::byteSize() const {
+        QMutexLocker locker(&m_mutex);
+
+        return m_byteSize;
     }
 
-    void ParseNodeCache::setCapacity(const size_t capacity) {
-        m_cache.capacity(capacity);
+    size_t ParseNodeCache::byteBudget() const {
+        QMutexLocker locker(&m_mutex);
+
+        return m_byteBudget;
     }
 
     void ParseNodeCache::clear() {
-        m_cache.clear();
+        QMutexLocker locker(&m_mutex);
+
+        clearUnlocked();
     }
 
-    bool ParseNodeCache::contains(const CacheKey &key) const {
-        return m_cache.contains(key);
+    /*!
+     * \brief Returns the cached node of the \a typeId type parsed from
+     * the \a text with the \a schema, or a null pointer if it isn't cached.
+     */
+    NodePtr ParseNodeCache::lookup(const SchemaPtr &schema, const int typeId,
+                                   QStringView text) {
+        const uint   hash = hashOf(typeId, text);
+        QMutexLocker locker(&m_mutex);
+
+        useSchema(schema);
+        const auto &&it = find(hash, typeId, text);
+        if (it == m_entries.end()) {
+            return nullptr;
+        }
+        m_entries.splice(m_entries.begin(), m_entries, it);
+        return it->node;
     }
 
-    const WeakNodePtr &ParseNodeCache::lookup(
-        const CacheKey &key) const {
-        return m_cache.lookup(key);
+    void ParseNodeCache::insert(const SchemaPtr &schema, const int typeId,
+                                const QString &text, NodePtr node) {
+        const uint   hash = hashOf(typeId, text);
+        QMutexLocker locker(&m_mutex);
+
+        useSchema(schema);
+        if (const auto &&it = find(hash, typeId, text);
+            it != m_entries.end()) {
+            it->node = std::move(node);
+            m_entries.splice(m_entries.begin(), m_entries, it);
+            return;
+        }
+
+        Entry entry;
+        entry.text   = text;
+        entry.node   = std::move(node);
+        entry.bytes  = entryOverhead + text.size() * nodeBytesPerChar;
+        entry.hash   = hash;
+        entry.typeId = typeId;
+
+        m_byteSize += entry.bytes;
+        m_entries.push_front(std::move(entry));
+        m_index.insert(hash, m_entries.begin());
+        evict();
     }
 
-    void ParseNodeCache::emplace(const int typeId, const QString &literalStr,
-                                 WeakNodePtr node) {
-        m_cache.emplace(std::piecewise_construct,
-                        std::forward_as_tuple(typeId, literalStr),
-                        std::forward_as_tuple(node));
+    uint ParseNodeCache::hashOf(const int typeId, QStringView text) {
+        return qHash(text, uint(typeId));
     }
 
-    void ParseNodeCache::emplace(const int typeId, QString &&literalStr,
-                                 WeakNodePtr node) {
-        m_cache.emplace(std::piecewise_construct,
-                        std::forward_as_tuple(typeId, literalStr),
-                        std::forward_as_tuple(node));
+    ParseNodeCache::EntryList::iterator ParseNodeCache::find(
+        const uint hash, const int typeId, QStringView text) {
+        for (auto it = m_index.constFind(hash);
+             it != m_index.cend() && it.key() == hash; ++it) {
+            const auto &entry = *it.value();
+            if ((entry.typeId == typeId)
+                && (QStringView(entry.text) == text)) {
+                return it.value();
+            }
+        }
+        return m_entries.end();
     }
 
-    void ParseNodeCache::emplace(const int typeId, const QString &literalStr,
-                                 const QVariantMap &props, WeakNodePtr node) {
-        m_cache.emplace(std::piecewise_construct,
-                        std::forward_as_tuple(typeId, literalStr, props),
-                        std::forward_as_tuple(node));
+    /*!
+     * \brief Removes the least recently used entries until the estimated memory
+     * usage is within the budget.
+     */
+    void ParseNodeCache::evict() {
+        while ((m_byteSize > m_byteBudget) && !m_entries.empty()) {
+            const auto &&last = std::prev(m_entries.end());
+            m_index.remove(last->hash, last);
+            m_byteSize -= last->bytes;
+            m_entries.erase(last);
+        }
     }
 
-    WeakNodePtr &ParseNodeCache::operator [](const CacheKey &key) {
-        return m_cache.lookup(key);
+    void ParseNodeCache::clearUnlocked() {
+        m_index.clear();
+        m_entries.clear();
+        m_byteSize = 0;
     }
 
-    const WeakNodePtr &ParseNodeCache::operator[](
-        const CacheKey &key) const {
-        return m_cache.lookup(key);
+    /*!
+     * \brief Clears the cache if its entries haven't been parsed with
+     * the \a schema, since their nodes point into the schema graph.
+     */
+    void ParseNodeCache::useSchema(const SchemaPtr &schema) {
+        if (schema != m_schema) {
+            clearUnlocked();
+            m_schema = schema;
+        }
     }
 }
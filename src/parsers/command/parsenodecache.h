@@ -2,111 +2,66 @@
 #define PARSENODECACHE_H
 
 #include "nodes/parsenode.h"
-#include "lru/lru.hpp"
 
-#include <QBuffer>
-#include <QDataStream>
+#include <QMutex>
+#include <QMultiHash>
 
-namespace Command {
-    struct CacheKey {
-        int         typeId = 0;
-        QString     literalStr;
-        QVariantMap props;
-        CacheKey(const int id, const QString &str,
-                 const QVariantMap &p = QVariantMap()) : typeId(id),
-            literalStr(str), props(p) {
-        }
-        bool operator==(const CacheKey &rhs) const;
-    };
-}
-
-// Adapted from: https://stackoverflow.com/a/41145546/12682038
-class QVariantMapHasher {
-public:
-    QVariantMapHasher() : buff(&bb), ds(&buff) {
-        bb.reserve(1000);
-        buff.open(QIODevice::WriteOnly);
-    }
-    uint hash(const QVariantMap & v) {
-        buff.seek(0);
-        ds << v;
-        return qHashBits(bb.constData(), buff.pos());
-    }
-
-private:
-    QByteArray bb;
-    QBuffer buff;
-    QDataStream ds;
-};
-
-namespace std {
-    template<> struct hash<Command::CacheKey> {
-        using argument_type = Command::CacheKey;
-        using result_type   = std::size_t;
-
-        result_type operator()(argument_type const& key) const {
-            static argument_type lastKey{ -1, {} };
-            static result_type   lastHash = 0;
-
-            if (key == lastKey) {
-                return lastHash;
-            }
-
-            result_type const h1(std::hash<int>()(key.typeId));
-            result_type const h2(std::hash<QString>()(key.literalStr));
-
-            if (key.props.isEmpty()) {
-                lastHash = h1 ^ (h2 << 1);
-            } else {
-                static QVariantMapHasher variantMapHash;
-
-                result_type const h3(variantMapHash.hash(key.props));
-                lastHash = ((h1 ^ (h2 << 1)) >> 1) ^ (h3 << 1);
-            }
-
-            lastKey = key;
-            return lastHash;
-        }
-    };
-}
+#include <list>
 
 namespace Command {
-    using WeakNodePtr = QWeakPointer<ParseNode>;
-
+    class SchemaSnapshot;
+
+    /*!
+     * \brief A parse node cache keyed by node type and source text.
+     *
+     * Cached nodes are owned by the cache until they are evicted by
+     * the least recently used policy when the estimated memory usage exceeds
+     * the byte budget, or until nodes of another schema are looked up or
+     * inserted. A cache can be shared by parsers in multiple threads.
+     */
     class ParseNodeCache
     {
 public:
-        explicit ParseNodeCache(int capacity = 64);
+        using SchemaPtr = QSharedPointer<const SchemaSnapshot>;
 
-        using Cache = LRU::Cache<CacheKey, WeakNodePtr>;
+        explicit ParseNodeCache(size_t byteBudget = defaultByteBudget);
+
+        static constexpr size_t defaultByteBudget = 8 * 1024 * 1024;
 
         bool isEmpty() const;
         int size() const;
-        int capacity() const;
-        void setCapacity(const size_t capacity);
+        size_t byteSize() const;
+        size_t byteBudget() const;
         void clear();
-        bool contains(const CacheKey &key) const;
-        const WeakNodePtr &lookup(const CacheKey &key) const;
-        void emplace(const int typeId, const QString &literalStr,
-                     WeakNodePtr node);
-        void emplace(const int typeId, QString &&literalStr, WeakNodePtr node);
-        void emplace(const int typeId, const QString &literalStr,
-                     const QVariantMap &props, WeakNodePtr node);
-        WeakNodePtr &operator[](const CacheKey &key);
-        const WeakNodePtr &operator[](const CacheKey &key) const;
-
-        const LRU::Statistics<CacheKey> &stats() const {
-            return m_cache.stats();
-        }
 
-        void print() {
-            for (const auto entry: m_cache) {
-                qDebug() << entry.key().literalStr << entry.value();
-            }
-        }
+        NodePtr lookup(const SchemaPtr &schema, const int typeId,
+                       QStringView text);
+        void insert(const SchemaPtr &schema, const int typeId,
+                    const QString &text, NodePtr node);
 
 private:
-        Cache m_cache;
+        struct Entry {
+            QString text;
+            NodePtr node;
+            size_t  bytes  = 0;
+            uint    hash   = 0;
+            int     typeId = 0;
+        };
+        using EntryList = std::list<Entry>;
+
+        mutable QMutex m_mutex;
+        EntryList m_entries; // The most recently used entry is at the front
+        QMultiHash<uint, EntryList::iterator> m_index;
+        SchemaPtr m_schema; // The schema which the entries are parsed with
+        size_t m_byteSize   = 0;
+        size_t m_byteBudget = defaultByteBudget;
+
+        static uint hashOf(const int typeId, QStringView text);
+        EntryList::iterator find(const uint hash, const int typeId,
+                                 QStringView text);
+        void evict();
+        void clearUnlocked();
+        void useSchema(const SchemaPtr &schema);
     };
 }
 
@@ -0,0 +1,238 @@
+#include "parseresultcache.h"
+
+#include "mcfunctionparser.h"
+#include "globalhelpers.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+namespace Command {
+    // "MCPC": MCfunction Parse Cache
+    constexpr quint32 cacheMagic         = 0x4D435043;
+    constexpr quint32 cacheFormatVersion = 1;
+
+    /*!
+     * \brief Collects the results of the last parse of the \a parser, whose
+     * source is \a text.
+     */
+    ParseResultCache::Entry ParseResultCache::Entry::fromParser(
+        const McfunctionParser &parser, QStringView text) {
+        Entry entry;
+
+        if (parser.errors().isEmpty()) {
+            if (parser.syntaxTree()->isValid()) {
+                const auto &lines = parser.syntaxTree()->lines();
+                for (const auto &logiLine: lines) {
+                    switch (logiLine->kind()) {
+                        case ParseNode::Kind::Span: {
+                            // Blank lines aren't counted
+                            const auto span =
+                                static_cast<SpanNode *>(logiLine.get());
+                            const auto &trimmed = span->text().trimmed();
+                            if (!trimmed.isEmpty()
+                                && (trimmed.front() == '#'_QL1)) {
+                                ++entry.commentLines;
+                            }
+                            break;
+                        }
+                        case ParseNode::Kind::Macro: {
+                            if (logiLine->isValid()) {
+                                ++entry.macroLines;
+                            }
+                            break;
+                        }
+                        case ParseNode::Kind::Root: {
+                            const auto root =
+                                static_cast<RootNode *>(logiLine.get());
+                            if (root->isValid()) {
+                                entry.nodeCounter.startVisiting(root);
+                                ++entry.commandLines;
+                            }
+                            break;
+                        }
+                        default: {
+                        }
+                    }
+                }
+            } else {
+                entry.isValid = false;
+            }
+        } else {
+            entry.errors = parser.errors();
+            entry.errorLines.reserve(entry.errors.size());
+
+            int line    = 1;
+            int linePos = 0;
+            for (const auto &error: qAsConst(entry.errors)) {
+                if (error.pos < linePos) {
+                    line    = 1;
+                    linePos = 0;
+                }
+                const int errorPos = qBound(0, error.pos, int(text.size()));
+                line += std::count(text.cbegin() + linePos,
+                                   text.cbegin() + errorPos, u'\n');
+                linePos = errorPos;
+                entry.errorLines << line;
+            }
+        }
+        return entry;
+    }
+
+    /*!
+     * \brief Opens the cache of the datapack in \a dirPath.
+     */
+    ParseResultCache::ParseResultCache(const QString &dirPath)
+        : m_filePath(cachePath(dirPath)) {
+        load();
+    }
+
+    /*!
+     * \brief Returns the path of the cache file of the datapack in \a dirPath.
+     */
+    QString ParseResultCache::cachePath(const QString &dirPath) {
+        const auto &&dirHash = QCryptographicHash::hash(
+            QDir::cleanPath(dirPath).toUtf8(), QCryptographicHash::Md5);
+
+        return QStandardPaths::writableLocation(
+            QStandardPaths::CacheLocation)
+               + QStringLiteral("/parse/") + dirHash.toHex()
+               + QStringLiteral("/mcfunction.cache");
+    }
+
+    /*!
+     * \brief Returns the cache key of the \a text parsed with the \a schema,
+     * which also depends on its game version and checksum.
+     */
+    QByteArray ParseResultCache::keyOf(
+        QStringView text, const QSharedPointer<const SchemaSnapshot> &schema) {
+        QCryptographicHash hash(QCryptographicHash::Md5);
+
+        hash.addData(reinterpret_cast<const char *>(text.utf16()),
+                     text.size() * sizeof(QChar));
+        if (schema) {
+            hash.addData(schema->gameVersion().toString().toUtf8());
+            hash.addData(schema->checksum());
+        }
+        return hash.result();
+    }
+
+    bool ParseResultCache::lookup(const QByteArray &key, Entry &entry) {
+        QMutexLocker locker(&m_mutex);
+
+        if (const auto it = m_entries.constFind(key);
+            it != m_entries.cend()) {
+            entry = *it;
+            m_usedKeys << key;
+            return true;
+        }
+        return false;
+    }
+
+    void ParseResultCache::insert(const QByteArray &key, const Entry &entry) {
+        QMutexLocker locker(&m_mutex);
+
+        m_entries.insert(key, entry);
+        m_usedKeys << key;
+        m_isModified = true;
+    }
+
+    /*!
+     * \brief Writes the entries which have been used since the cache was
+     * opened into the cache file. Other entries are dropped as their files
+     * have been changed or removed.
+     */
+    bool ParseResultCache::save() {
+        QMutexLocker locker(&m_mutex);
+
+        if (!m_isModified && (m_usedKeys.size() == m_entries.size())) {
+            return true;
+        }
+
+        QDir().mkpath(QFileInfo(m_filePath).path());
+        QSaveFile file(m_filePath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            qWarning() << "Cannot write parse cache:" << file.errorString();
+            return false;
+        }
+
+        QDataStream out(&file);
+        out.setVersion(QDataStream::Qt_5_15);
+        out << cacheMagic << cacheFormatVersion << quint32(m_usedKeys.size());
+        for (const auto &key: qAsConst(m_usedKeys)) {
+            out << key << m_entries.value(key);
+        }
+        if (!file.commit()) {
+            return false;
+        }
+        m_isModified = false;
+        return true;
+    }
+
+    void ParseResultCache::load() {
+        QFile file(m_filePath);
+
+        if (!file.open(QIODevice::ReadOnly)) {
+            return;
+        }
+
+        QDataStream in(&file);
+        in.setVersion(QDataStream::Qt_5_15);
+
+        quint32 magic      = 0;
+        quint32 version    = 0;
+        quint32 entryCount = 0;
+        in >> magic >> version >> entryCount;
+        if ((magic != cacheMagic) || (version != cacheFormatVersion)) {
+            return;
+        }
+
+        m_entries.reserve(entryCount);
+        for (quint32 i = 0; i < entryCount; ++i) {
+            QByteArray key;
+            Entry      entry;
+            in >> key >> entry;
+            if (in.status() != QDataStream::Ok) {
+                qWarning() << "The parse cache is corrupted:" << m_filePath;
+                m_entries.clear();
+                return;
+            }
+            m_entries.insert(key, entry);
+        }
+    }
+
+    QDataStream &operator<<(QDataStream &out,
+                            const ParseResultCache::Entry &entry) {
+        out << quint32(entry.errors.size());
+        for (const auto &error: entry.errors) {
+            out << QByteArray(error.what()) << qint32(error.pos)
+                << qint32(error.length) << error.args;
+        }
+        out << entry.errorLines << entry.nodeCounter << entry.commandLines
+            << entry.commentLines << entry.macroLines << entry.isValid;
+        return out;
+    }
+
+    QDataStream &operator>>(QDataStream &in, ParseResultCache::Entry &entry) {
+        quint32 errorCount = 0;
+
+        in >> errorCount;
+        entry.errors.clear();
+        for (quint32 i = 0; i < errorCount && in.status() == QDataStream::Ok;
+             ++i) {
+            QByteArray   what;
+            qint32       pos    = 0;
+            qint32       length = 0;
+            QVariantList args;
+            in >> what >> pos >> length >> args;
+            entry.errors << Parser::Error(what.constData(), pos, length, args);
+        }
+        in >> entry.errorLines >> entry.nodeCounter >> entry.commandLines
+        >> entry.commentLines >> entry.macroLines >> entry.isValid;
+        return in;
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef PARSERESULTCACHE_H
+#define PARSERESULTCACHE_H
+
+#include "parsers/parser.h"
+#include "visitors/nodecounter.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+
+namespace Command {
+    class McfunctionParser;
+    class SchemaSnapshot;
+
+    /*!
+     * \brief A persistent cache of the parse results of mcfunction files
+     * in a datapack, keyed by the hash of their content, the game version and
+     * the version of the command schema.
+     *
+     * Only the statistics of the files are stored, not their syntax trees,
+     * so the cache only serves the statistics scan. Files opened in editors,
+     * including by the "open all functions" shortcut, are still parsed
+     * in full, since their highlighting and completion need the trees.
+     */
+    class ParseResultCache {
+public:
+        struct Entry {
+            Parser::Errors errors;
+            QVector<int>   errorLines;
+            NodeCounter    nodeCounter;
+            uint           commandLines = 0;
+            uint           commentLines = 0;
+            uint           macroLines   = 0;
+            bool           isValid      = true;
+
+            static Entry fromParser(const McfunctionParser &parser,
+                                    QStringView text);
+        };
+
+        explicit ParseResultCache(const QString &dirPath);
+
+        static QByteArray keyOf(
+            QStringView text,
+            const QSharedPointer<const SchemaSnapshot> &schema);
+
+        bool lookup(const QByteArray &key, Entry &entry);
+        void insert(const QByteArray &key, const Entry &entry);
+        bool save();
+
+        static QString cachePath(const QString &dirPath);
+
+private:
+        mutable QMutex m_mutex;
+        QHash<QByteArray, Entry> m_entries;
+        QSet<QByteArray> m_usedKeys;
+        QString m_filePath;
+        bool m_isModified = false;
+
+        void load();
+    };
+
+    QDataStream &operator<<(QDataStream &out,
+                            const ParseResultCache::Entry &entry);
+    QDataStream &operator>>(QDataStream &in, ParseResultCache::Entry &entry);
+}
+
+#endif // PARSERESULTCACHE_H
@@ -0,0 +1,108 @@
+#include "compiledschema.h"
+
+#include "schemarootnode.h"
+#include "schemaargumentnode.h"
+#include "schemaliteralnode.h"
+
+#include <QHash>
+
+#include <algorithm>
+
+namespace Command::Schema {
+    CompiledSchema::CompiledSchema(const RootNode *root) {
+        if (!root) {
+            return;
+        }
+
+        QHash<const Schema::Node *, int> indexes;
+        QVector<const Schema::Node *>    sources;
+
+        const auto indexOf = [&indexes, &sources](const Schema::Node *node) {
+            if (!node) {
+                return -1;
+            }
+            if (const auto it = indexes.constFind(node);
+                it != indexes.cend()) {
+                return *it;
+            }
+            const int index = sources.size();
+            indexes.insert(node, index);
+            sources << node;
+            return index;
+        };
+
+        indexOf(root);
+        // Nodes are numbered in breadth-first order as they are discovered
+        for (int i = 0; i < sources.size(); ++i) {
+            const auto *source = sources.at(i);
+            Node        node;
+
+            node.source       = source;
+            node.kind         = source->kind();
+            node.isExecutable = source->isExecutable();
+            node.isEmpty      = source->isEmpty();
+
+            // The children maps are returned by value
+            const auto &&literalChildren = source->literalChildren();
+            node.literalBegin = m_literals.size();
+            for (auto it = literalChildren.cbegin();
+                 it != literalChildren.cend(); ++it) {
+                m_literals << Literal{ it.key(), indexOf(it.value()) };
+            }
+            node.literalEnd = m_literals.size();
+
+            const auto &&argumentChildren = source->argumentChildren();
+            node.argumentBegin = m_arguments.size();
+            for (const auto *child: argumentChildren) {
+                m_arguments << indexOf(child);
+            }
+            node.argumentEnd = m_arguments.size();
+
+            if (node.kind == Schema::Node::Kind::Argument) {
+                const auto *argNode =
+                    static_cast<const Schema::ArgumentNode *>(source);
+                node.parserType = argNode->parserType();
+                node.propsIndex = m_props.size();
+                m_props << argNode->properties();
+            }
+
+            const int redirect = indexOf(source->redirect());
+            node.hasRedirect = redirect != -1;
+            node.next        = (node.isEmpty && node.hasRedirect) ? redirect : i;
+
+            m_nodes << node;
+        }
+    }
+
+    bool CompiledSchema::isEmpty() const {
+        return m_nodes.isEmpty() || m_nodes.constFirst().isEmpty;
+    }
+
+    int CompiledSchema::size() const {
+        return m_nodes.size();
+    }
+
+    const QVariantMap &CompiledSchema::properties(const Node &node) const {
+        static const QVariantMap emptyProps;
+
+        return (node.propsIndex != -1) ? m_props[node.propsIndex] : emptyProps;
+    }
+
+    /*!
+     * \brief Returns the index of the literal child of the \a node named
+     * \a name, or -1 if there is none.
+     */
+    int CompiledSchema::findLiteral(const Node &node, QStringView name) const {
+        const auto *begin = literalsBegin(node);
+        const auto *end   = literalsEnd(node);
+        const auto *it    = std::lower_bound(
+            begin, end, name, [](const Literal &literal, QStringView name) {
+            return QStringView(literal.name).compare(name) < 0;
+        });
+
+        if ((it != end) && (QStringView(it->name) == name)) {
+            return it->node;
+        }
+        return -1;
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef SCHEMA_COMPILEDSCHEMA_H
+#define SCHEMA_COMPILEDSCHEMA_H
+
+#include "schemanode.h"
+#include "../nodes/argumentnode.h"
+
+#include <QVariantMap>
+#include <QVector>
+
+namespace Command::Schema {
+    class RootNode;
+
+    /*!
+     * \brief A flat form of a schema graph for dispatching commands.
+     *
+     * Nodes are stored in a contiguous array with the root at index 0.
+     * The literal children of each node are a span of a name-sorted table,
+     * argument children are a span of an index table, and the node to continue
+     * from after an empty redirecting node is resolved ahead of time.
+     */
+    class CompiledSchema {
+public:
+        using ParserType = Command::ArgumentNode::ParserType;
+
+        struct Node {
+            const Schema::Node *source = nullptr;
+            int                 next   = 0; // Redirect target if it's empty
+            int                 literalBegin  = 0;
+            int                 literalEnd    = 0;
+            int                 argumentBegin = 0;
+            int                 argumentEnd   = 0;
+            int                 propsIndex    = -1;
+            ParserType          parserType    = ParserType::Unknown;
+            Schema::Node::Kind  kind          = Schema::Node::Kind::Unknown;
+            bool                isExecutable  = false;
+            bool                isEmpty       = true;
+            bool                hasRedirect   = false;
+
+            bool hasArguments() const {
+                return argumentBegin != argumentEnd;
+            }
+        };
+
+        struct Literal {
+            QString name;
+            int     node = -1;
+        };
+
+        CompiledSchema() = default;
+        explicit CompiledSchema(const Schema::RootNode *root);
+
+        bool isEmpty() const;
+        int size() const;
+
+        const Node &node(const int index) const {
+            return m_nodes[index];
+        }
+        const Literal *literalsBegin(const Node &node) const {
+            return m_literals.constData() + node.literalBegin;
+        }
+        const Literal *literalsEnd(const Node &node) const {
+            return m_literals.constData() + node.literalEnd;
+        }
+        int argumentAt(const int index) const {
+            return m_arguments[index];
+        }
+        const QVariantMap &properties(const Node &node) const;
+
+        int findLiteral(const Node &node, QStringView name) const;
+
+private:
+        QVector<Node> m_nodes;
+        QVector<Literal> m_literals;
+        QVector<int> m_arguments;
+        QVector<QVariantMap> m_props;
+    };
+}
+
+#endif // SCHEMA_COMPILEDSCHEMA_H
@@ -6,6 +6,7 @@
 
 #include <QFileInfo>
 #include <QDebug>
+#include <QCryptographicHash>
 
 
 namespace Command::Schema {
@@ -29,16 +30,33 @@ namespace Command::Schema {
             return;
         }
 
-        QByteArray &&data = f.readAll();
+        const QByteArray &&data = f.readAll();
         f.close();
+        load(data, isJson ? Format::Json : Format::MessagePack);
+    }
+
+/*!
+ * \brief Loads the schema from the \a data in the \a format.
+ */
+    SchemaLoader::SchemaLoader(const QByteArray &data, const Format format) {
+        load(data, format);
+    }
+
+    void SchemaLoader::load(const QByteArray &data, const Format format) {
+        m_checksum = QCryptographicHash::hash(data, QCryptographicHash::Md5);
 
         json j;
 
         try {
-            if (isJson) {
-                j = json::parse(data);
-            } else if (finfo.suffix() == QLatin1String("msgpack")) {
-                j = json::from_msgpack(data);
+            switch (format) {
+                case Format::Json: {
+                    j = json::parse(data.cbegin(), data.cend());
+                    break;
+                }
+                case Format::MessagePack: {
+                    j = json::from_msgpack(data.cbegin(), data.cend());
+                    break;
+                }
             }
 
             m_tree = j.get<Schema::RootNode *>();
@@ -54,6 +72,14 @@ namespace Command::Schema {
         return m_tree;
     }
 
+/*!
+ * \brief Returns the checksum of the loaded schema file, which identifies
+ * the version of the schema.
+ */
+    QByteArray SchemaLoader::checksum() const {
+        return m_checksum;
+    }
+
     void SchemaLoader::resolveRedirects(const json &j, Schema::Node *node) {
         Q_ASSERT(m_tree != nullptr);
 
@@ -2,6 +2,7 @@
 #define SCHEMALOADER_H
 
 #include <QString>
+#include <QByteArray>
 
 #include "nlohmann/json.hpp"
 
@@ -15,18 +16,27 @@ namespace Command::Schema {
 
     class SchemaLoader {
 public:
+        enum class Format {
+            Json,
+            MessagePack,
+        };
+
         SchemaLoader(const QString &filepath);
+        SchemaLoader(const QByteArray &data, const Format format);
 
         QString lastError() const {
             return m_error;
         };
 
         Schema::RootNode * tree() const;
+        QByteArray checksum() const;
 
 private:
         QString m_error;
+        QByteArray m_checksum;
         Schema::RootNode *m_tree = nullptr;
 
+        void load(const QByteArray &data, const Format format);
         void resolveRedirects(const json &j, Node *node);
     };
 }
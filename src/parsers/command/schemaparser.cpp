@@ -374,30 +374,81 @@ namespace Command {
         }
     }
 
-    void SchemaParser::setSchema(Schema::RootNode *schema) {
+    SchemaSnapshot::SchemaSnapshot(Schema::RootNode *graph,
+                                   const QByteArray &checksum,
+                                   const QVersionNumber &gameVersion)
+        : m_graph(graph), m_checksum(checksum), m_gameVersion(gameVersion),
+        m_compiled(graph) {
+        Q_ASSERT(graph != nullptr);
+    }
+
+    SchemaSnapshot::~SchemaSnapshot() {
+        delete m_graph;
+    }
+
+    const Schema::RootNode * SchemaSnapshot::graph() const {
+        return m_graph;
+    }
+
+    const Schema::CompiledSchema &SchemaSnapshot::compiled() const {
+        return m_compiled;
+    }
+
+/*!
+ * \brief Returns the checksum which identifies the schema for caches of
+ * parse results.
+ */
+    QByteArray SchemaSnapshot::checksum() const {
+        return m_checksum;
+    }
+
+    QVersionNumber SchemaSnapshot::gameVersion() const {
+        return m_gameVersion;
+    }
+
+/*!
+ * \brief Replaces the current schema with the \a schema graph of
+ * \a gameVersion, which is taken ownership of. The \a checksum identifies
+ * the schema for caches of parse results.
+ *
+ * The previous schema is kept alive by the parses and syntax trees which
+ * still use it, so it's safe to call this while other threads are parsing.
+ */
+    void SchemaParser::setSchema(Schema::RootNode *schema,
+                                 const QByteArray &checksum,
+                                 const QVersionNumber &gameVersion) {
         Q_ASSERT(schema != nullptr);
-        if (m_schemaGraph) {
-            delete m_schemaGraph;
-        }
-        m_schemaGraph = schema;
+        const SchemaPtr &&snapshot = QSharedPointer<SchemaSnapshot>::create(
+            schema, checksum, gameVersion);
+
+        QWriteLocker locker(&m_currentSchemaLock);
+        m_currentSchema = snapshot;
     }
 
 /*!
- * \brief Opens a JSON file and loads it into the static schema.
+ * \brief Opens a JSON file and loads it into the current schema.
  */
-    void SchemaParser::loadSchema(const QString &filepath) {
+    void SchemaParser::loadSchema(const QString &filepath,
+                                  const QVersionNumber &gameVersion) {
         QElapsedTimer timer;
 
         timer.start();
 
-        setSchema(Schema::SchemaLoader(filepath).tree());
+        const Schema::SchemaLoader loader(filepath);
+        setSchema(loader.tree(), loader.checksum(), gameVersion);
 
         qInfo() << "Command schema loaded in" << timer.elapsed() <<
             "ms (path:" << filepath << ")";
     }
 
-    Schema::RootNode * SchemaParser::schema() {
-        return m_schemaGraph;
+/*!
+ * \brief Returns the current schema, which stays valid even if it's
+ * replaced afterwards.
+ */
+    SchemaPtr SchemaParser::currentSchema() {
+        QReadLocker locker(&m_currentSchemaLock);
+
+        return m_currentSchema;
     }
 
 /*!
@@ -408,95 +459,23 @@ namespace Command {
     }
 
     QStringView SchemaParser::getLiteralString() {
+        constexpr static Charset literalChars{ "0-9A-Za-z_.+-" };
+
         const int start = pos();
 
-        while (true) {
-            switch (curChar().toLatin1()) {
-                case 'e':
-                case '_':
-                case 'a':
-                case 't':
-                case 'r':
-                case 'n':
-                case 'c':
-                case 'l':
-                case 'm':
-                case 'i':
-                case 'h':
-                case 's':
-                case 'o':
-                case 'd':
-                case 'p':
-                case 'b':
-                case 'u':
-                case 'g':
-                case 'j':
-                case 'k':
-                case 'y':
-                case '1':
-                case 'f':
-                case 'v':
-                case 'w':
-                case '2':
-                case 'z':
-                case 'C':
-                case '3':
-                case 'q':
-                case 'x':
-                case '4':
-                case 'T':
-                case '5':
-                case 'L':
-                case '0':
-                case 'N':
-                case '.':
-                case 'H':
-                case 'E':
-                case '7':
-                case '6':
-                case '9':
-                case '8':
-                case 'S':
-                case 'I':
-                case 'G':
-                case 'O':
-                case 'A':
-                case 'D':
-                case 'W':
-                case 'P':
-                case 'M':
-                case 'F':
-                case 'B':
-                case 'R':
-                case 'K':
-                case '-':
-                case 'Z':
-                case 'V':
-                case 'Q':
-                case '+':
-                case 'J':
-                case 'U':
-                case 'X':
-                case 'Y': {
-                    advance();
-                    break;
-                }
-                default: {
-                    return textView().mid(start, pos() - start);
-                }
-            }
-        }
+        advance(literalChars.span(peekRest()));
+        return textView().mid(start, pos() - start);
     }
 
     QStringView SchemaParser::getDigits() {
+        constexpr static Charset digits{ "0-9" };
+
         const int start = pos();
 
         if (curChar() == '-' || curChar() == '+') {
             advance();
         }
-        while (curChar().isDigit()) {
-            advance();
-        }
+        advance(digits.span(peekRest()));
         return textView().mid(start, pos() - start);
     }
 
@@ -637,9 +616,11 @@ namespace Command {
 
     QSharedPointer<StringNode> SchemaParser::brigadier_string(
         const QVariantMap &props) {
-        if (!props.contains(QStringLiteral("type")))
-            throwError(QT_TR_NOOP(
-                           "The required paramenter 'type' of the 'brigadier:string' argument parser is missing."));
+        if (!props.contains(QStringLiteral("type"))) {
+            fail(QT_TR_NOOP(
+                     "The required paramenter 'type' of the 'brigadier:string' argument parser is missing."));
+            return nullptr;
+        }
 
         const QString &&type = props[QStringLiteral("type")].toString();
         uswitch (type) {
@@ -650,9 +631,12 @@ namespace Command {
             ucase ("phrase"_QL1): {
                 if (curChar() == '"' || curChar() == '\'') {
                     const int    start = pos();
-                    const auto &&str   = getQuotedString();
+                    const auto &&str   = tryGetQuotedString();
+                    if (!str) {
+                        return nullptr;
+                    }
                     return QSharedPointer<StringNode>::create(
-                        spanText(start), str, true);
+                        spanText(start), *str, true);
                 } else {
                     /*
                      * Using goto here make the code clearer than
@@ -674,148 +658,134 @@ namespace Command {
     }
 
 /*!
- * \brief Parses the current text using the static schema.
+ * \brief Parses the current text using the current schema.
  * Returns the \c parsingResult or an invalid \c ParseNode if an error occured.
  */
     QSharedPointer<ParseNode> SchemaParser::parse() {
-        m_tree = QSharedPointer<RootNode>::create();
+        return parse(currentSchema());
+    }
+
+/*!
+ * \brief Parses the current text using the \a schema, which is kept alive
+ * by the returned tree.
+ */
+    QSharedPointer<ParseNode> SchemaParser::parse(SchemaPtr schema) {
+        m_schema = std::move(schema);
+        m_tree   = QSharedPointer<RootNode>::create();
         m_errors.clear();
-        if (!m_schemaGraph || m_schemaGraph->isEmpty()) {
+        if (!m_schema || m_schema->compiled().isEmpty()) {
             qWarning() << "The parser schema hasn't been initialized yet.";
             return m_tree;
         }
+        m_tree->setSchema(m_schema);
 
         setPos(0);
-        try {
-            m_tree->setLeadingTrivia(skipWs(false));
-            parseBySchema(m_schemaGraph);
-
-            m_tree->setLength(pos() - 1);
-            m_tree->setTrailingTrivia(skipWs(false));
-//                const auto &treeChildren = m_tree->children();
-//                for (auto it = treeChildren.cbegin();
-//                     it != treeChildren.cend(); ++it) {
-//                    if (!(*it)->isValid()) {
-//                        SourcePrinter printer;
-//                        printer.startVisiting((*it).get());
-//                        qDebug() << printer.source();
-//                        break;
-//                    }
-//                }
-        } catch (const SchemaParser::Error &err) {
-            qDebug() << "Command::Parser::parse: errors detected";
-            qDebug() << textView();
-            m_errors << err;
-            for (const auto &error: qAsConst(m_errors)) {
-                qDebug() << error.toLocalizedMessage();
-            }
-        }
+        m_tree->setLeadingTrivia(skipWs(false));
+        parseBySchema(0);
 
-//        qDebug() << "Size:" << m_cache.size() << '/' << m_cache.capacity()
-//                 << "Total access:" << m_cache.stats().total_accesses()
-//                 << ". Total hit:" << m_cache.stats().total_hits()
-//                 << ". Total miss:" << m_cache.stats().total_misses()
-//                 << ". Hit rate:" << m_cache.stats().hit_rate();
+        m_tree->setLength(pos() - 1);
+        m_tree->setTrailingTrivia(skipWs(false));
 
         return m_tree;
     }
 
-    const ParseNodeCache &SchemaParser::cache() const {
-        return m_cache;
+/*!
+ * \brief Returns the game version of the schema used by the current parse.
+ */
+    QVersionNumber SchemaParser::gameVer() const {
+        return m_schema ? m_schema->gameVersion() : QVersionNumber();
     }
 
     void SchemaParser::setTestMode(bool value) {
         SchemaParser::m_testMode = value;
     }
 
-    bool SchemaParser::canContinue(Schema::Node **schemaNode, int depth) {
+/*!
+ * \brief Returns whether the parsing can continue after the node at
+ * \a nodeIndex and updates it to the next node, or fails if the command
+ * is incomplete or no space follows.
+ */
+    SchemaParser::Result<bool> SchemaParser::canContinue(int *nodeIndex,
+                                                         int depth) {
         if (depth > 256)
             qWarning() << "The parsing stack depth is too large:" << depth;
 
-        const bool canEndParsing = curChar().isNull()
-                                   || (peek(2) == " "_QL1);
-        if ((*schemaNode)->isExecutable() && canEndParsing) {
+        const auto &schemaNode    = m_schema->compiled().node(*nodeIndex);
+        const bool  canEndParsing = curChar().isNull()
+                                    || (peek(2) == " "_QL1);
+        if (schemaNode.isExecutable && canEndParsing) {
             return false;
-        } else if ((*schemaNode)->isEmpty() && (*schemaNode)->redirect()) {
-            *schemaNode = (*schemaNode)->redirect();
         }
+        *nodeIndex = schemaNode.next;
         if (curChar().isNull()) {
-            throwError(QT_TR_NOOP("Incompleted command"));
+            return fail(QT_TR_NOOP("Incompleted command"));
+        }
+        if (!tryEat(QChar::Space,
+                    "Unexpected %1, expecting %2 to separate between commands and arguments")) {
+            return ParseFailure();
         }
-        eat(QChar::Space,
-            "Unexpected %1, expecting %2 to separate between commands and arguments");
 
         return true;
     }
-    void SchemaParser::parseBySchema(const Schema::Node *schemaNode,
-                                     int depth) {
-        Q_ASSERT(schemaNode != nullptr);
-        NodePtr ret;
 
-        const bool isRoot = schemaNode->kind() == Schema::Node::Kind::Root;
+/*!
+ * \brief Parses the text from the current position by the node at
+ * \a nodeIndex of the compiled schema.
+ */
+    void SchemaParser::parseBySchema(const int nodeIndex, int depth) {
+        const auto &compiled = m_schema->compiled();
+
+        Q_ASSERT(nodeIndex >= 0 && nodeIndex < compiled.size());
+        const auto &schemaNode = compiled.node(nodeIndex);
+        NodePtr     ret;
 
-        const int       start                = pos();
-        const QString &&literal              = peekLiteral();
-        Schema::Node   *litNode              = nullptr;
-        bool            reportInvalidCommand = false;
+        const bool isRoot = schemaNode.kind == Schema::Node::Kind::Root;
 
-        const auto &literalChildren = schemaNode->literalChildren();
+        const int         start                = pos();
+        const QStringView literal              = peekUntil(QChar::Space);
+        int               litNode              = -1;
+        bool              reportInvalidCommand = false;
 
-        if (const auto &literalNode = literalChildren.constFind(literal);
-            literalNode != literalChildren.end()) {
-            litNode = literalNode.value();
+        if (const int literalNode = compiled.findLiteral(schemaNode,
+                                                         literal);
+            literalNode != -1) {
+            litNode = literalNode;
 
             const auto &&command = brigadier_literal();
             if (isRoot)
                 command->setIsCommand(true);
             ret = command;
-        } else if (!schemaNode->argumentChildren().isEmpty()) {
-            const auto &argumentChildren = schemaNode->argumentChildren();
-            const auto *lastArgNode      = argumentChildren.constLast();
-            for (const auto *argNode: argumentChildren) {
-                const auto parserType = argNode->parserType();
-                if (parserType == ArgumentNode::ParserType::Unknown) {
+        } else if (schemaNode.hasArguments()) {
+            const int lastArgIndex = schemaNode.argumentEnd - 1;
+            for (int i = schemaNode.argumentBegin;
+                 i < schemaNode.argumentEnd; ++i) {
+                const int   argIndex = compiled.argumentAt(i);
+                const auto &argNode  = compiled.node(argIndex);
+                if (argNode.parserType == ArgumentNode::ParserType::Unknown) {
                     reportError(QT_TR_NOOP(
                                     "Cannot parse unsupported argument type"),
                                 {}, pos(),
                                 literal.length());
                     continue;
                 }
-                const bool  canBacktrack = argNode != lastArgNode;
-                const auto &props        = argNode->properties();
-                ret.reset();
-
-                try {
-                    ret = invokeMethod(parserType, props);
-                    Q_ASSERT(ret != nullptr);
-                } catch (const SchemaParser::Error &err) {
-//                    err.length = pos() - start + 1;
-                    m_errors << err;
+                const bool canBacktrack = i != lastArgIndex;
+
+                // A failed argument parser returns a null node
+                ret = invokeMethod(argNode.parserType,
+                                   compiled.properties(argNode));
+                if (!ret) {
+                    Q_ASSERT(hasFailure());
+                    m_errors << takeFailure();
                 }
                 if (!ret || (!ret->isValid() && canBacktrack)) {
                     setPos(start);
                     continue;
                 }
 
-                Schema::Node *node =
-                    const_cast<Schema::ArgumentNode *>(argNode);
-                try {
-                    if (canContinue(&node, depth)) {
-                        if (argNode->isEmpty() && !argNode->redirect() &&
-                            canBacktrack) {
-                            setPos(start);
-                            continue;
-                        }
-
-//                        ret->setTrailingTrivia(QStringLiteral(" "));
-                        parseBySchema(node, depth + 1);
-                        m_tree->prepend(ret);
-                    } else {
-                        m_tree->append(ret);
-                    }
-                } catch (SchemaParser::Error &err) {
-//                    err.length = pos() - start + 1;
-                    m_errors << err;
+                int          node = argIndex;
+                const auto &&next = canContinue(&node, depth);
+                if (!next) {
+                    m_errors << takeFailure();
                     if (!canBacktrack) {
                         m_tree->append(ret);
                         m_tree->append(QSharedPointer<ErrorNode>::create(
@@ -823,30 +793,54 @@ namespace Command {
                     } else {
                         setPos(start);
                     }
+                } else if (*next) {
+                    if (argNode.isEmpty && !argNode.hasRedirect &&
+                        canBacktrack) {
+                        setPos(start);
+                        continue;
+                    }
+
+//                    ret->setTrailingTrivia(QStringLiteral(" "));
+                    parseBySchema(node, depth + 1);
+                    m_tree->prepend(ret);
+                } else {
+                    m_tree->append(ret);
                 }
-                ret->setSchemaNode(argNode);
+                ret->setSchemaNode(argNode.source);
                 break;
             }
         } else {
             reportInvalidCommand = true;
             if (literal.length() > 2) {
-                const QStringList &&literals = literalChildren.keys();
-                const auto        &&filtered = literals.filter(literal,
-                                                               Qt::CaseInsensitive);
-                if (!filtered.isEmpty()) {
-                    litNode = literalChildren[filtered[0]];
-                } else if (misspellings.contains(literal)) {
-                    litNode = literalChildren[misspellings[literal]];
-                } else {
-                    for (const QString &lit: literals) {
-                        if (literal.contains(lit)) {
-                            litNode = literalChildren[lit];
-                            break;
+                const auto *literalsBegin =
+                    compiled.literalsBegin(schemaNode);
+                const auto *literalsEnd =
+                    compiled.literalsEnd(schemaNode);
+                for (const auto *it = literalsBegin; it != literalsEnd; ++it) {
+                    if (QStringView(it->name).contains(literal,
+                                                       Qt::CaseInsensitive)) {
+                        litNode = it->node;
+                        break;
+                    }
+                }
+                if (litNode == -1) {
+                    const QString &&correction =
+                        misspellings.value(literal.toString());
+                    if (!correction.isNull()) {
+                        litNode = compiled.findLiteral(schemaNode,
+                                                       correction);
+                    } else {
+                        for (const auto *it = literalsBegin;
+                             it != literalsEnd; ++it) {
+                            if (literal.contains(it->name)) {
+                                litNode = it->node;
+                                break;
+                            }
                         }
                     }
                 }
 
-                if (litNode) {
+                if (litNode != -1) {
                     const auto &&command = brigadier_literal();
                     command->setIsValid(false);
                     if (isRoot)
@@ -856,20 +850,18 @@ namespace Command {
             }
         }
 
-        if (litNode) {
-            try {
-                if (canContinue(&litNode, depth)) {
-//                ret->setTrailingTrivia(QStringLiteral(" "));
-                    parseBySchema(litNode, depth + 1);
-                    m_tree->prepend(ret);
-                } else {
-                    m_tree->append(ret);
-                }
-            } catch (SchemaParser::Error &err) {
-                //err.length = pos() - start + 1;
-                m_errors << err;
+        if (litNode != -1) {
+            const auto &&next = canContinue(&litNode, depth);
+            if (!next) {
+                m_errors << takeFailure();
                 ret->setIsValid(false);
                 m_tree->append(ret);
+            } else if (*next) {
+//                ret->setTrailingTrivia(QStringLiteral(" "));
+                parseBySchema(litNode, depth + 1);
+                m_tree->prepend(ret);
+            } else {
+                m_tree->append(ret);
             }
         }
 
@@ -878,25 +870,27 @@ namespace Command {
 
             ret = QSharedPointer<ErrorNode>::create(spanText(getRest()));
             if (depth > 0) {
-                ret->setLeadingTrivia(" ");
+                ret->setLeadingTrivia(QStringLiteral(" "));
             }
             m_tree->append(ret);
         } else if (depth > 0) {
             ret->setLeadingTrivia(QStringLiteral(" "));
         }
 
-        if (litNode && ret) {
-            ret->setSchemaNode(litNode);
+        if ((litNode != -1) && ret) {
+            ret->setSchemaNode(compiled.node(litNode).source);
         }
 
         if (reportInvalidCommand) {
+            const bool hasSubcommands = !schemaNode.isEmpty &&
+                                        !schemaNode.hasRedirect;
             if (literal.isEmpty()) {
                 if (isRoot) {
                     const QString &cmdGuide = commandGuideStr(schemaNode);
                     reportError(QT_TR_NOOP("Available commands: %1"),
                                 { cmdGuide }, start, literal.length());
                 } else {
-                    if (!schemaNode->isEmpty() && !schemaNode->redirect()) {
+                    if (hasSubcommands) {
                         const QString &cmdGuide = commandGuideStr(schemaNode);
                         reportError(QT_TR_NOOP("Available sub-commands: %1"),
                                     { cmdGuide }, start,
@@ -908,29 +902,31 @@ namespace Command {
                 }
             } else {
                 if (isRoot) {
-                    if (!schemaNode->isEmpty() && !schemaNode->redirect()) {
+                    if (hasSubcommands) {
                         const QString &cmdGuide = commandGuideStr(schemaNode);
                         reportError(QT_TR_NOOP(
                                         "Unknown command '%1'. Available commands: %2"),
-                                    { literal, cmdGuide },
+                                    { literal.toString(), cmdGuide },
                                     start,
                                     literal.length());
                     } else {
                         reportError(QT_TR_NOOP(
-                                        "Unknown command '%1'"), { literal },
+                                        "Unknown command '%1'"),
+                                    { literal.toString() },
                                     start, literal.length());
                     }
                 } else {
-                    if (!schemaNode->isEmpty() && !schemaNode->redirect()) {
+                    if (hasSubcommands) {
                         const QString &cmdGuide = commandGuideStr(schemaNode);
                         reportError(QT_TR_NOOP(
                                         "Unknown sub-command '%1'. Available sub-commands: %2"),
-                                    { literal, cmdGuide },
+                                    { literal.toString(), cmdGuide },
                                     start,
                                     literal.length());
                     } else {
                         reportError(QT_TR_NOOP("Unknown sub-command '%1'"),
-                                    { literal }, start, literal.length());
+                                    { literal.toString() }, start,
+                                    literal.length());
                     }
                 }
             }
@@ -938,14 +934,15 @@ namespace Command {
     }
 
     const QString Command::SchemaParser::commandGuideStr(
-        const Schema::Node *schemaNode) {
+        const Schema::CompiledSchema::Node &schemaNode) const {
         QStringList subcommands;
 
-        const auto &literalChildren = schemaNode->literalChildren();
+        const auto &compiled    = m_schema->compiled();
+        const auto *literalsEnd = compiled.literalsEnd(schemaNode);
 
-        for (auto it = literalChildren.cbegin();
-             it != literalChildren.cend(); ++it) {
-            subcommands << it.key();
+        for (const auto *it = compiled.literalsBegin(schemaNode);
+             it != literalsEnd; ++it) {
+            subcommands << it->name;
         }
 
         return subcommands.join(", ");
@@ -6,11 +6,13 @@
 #include "nodes/stringnode.h"
 #include "nodes/rootnode.h"
 #include "nodes/literalnode.h"
-#include "parsenodecache.h"
 #include "schema/schemarootnode.h"
+#include "schema/compiledschema.h"
 
 #include <QJsonObject>
 #include <QObject>
+#include <QReadWriteLock>
+#include <QVersionNumber>
 
 #include <stdexcept>
 
@@ -76,6 +78,34 @@ T strToDec(QStringView v, bool &ok) {
 }
 
 namespace Command {
+    /*!
+     * \brief An immutable command schema, which owns its schema graph.
+     *
+     * Syntax trees point into the schema graph, so they keep the snapshot
+     * which they have been parsed with alive.
+     */
+    class SchemaSnapshot {
+public:
+        SchemaSnapshot(Schema::RootNode *graph, const QByteArray &checksum,
+                       const QVersionNumber &gameVersion);
+        ~SchemaSnapshot();
+
+        const Schema::RootNode * graph() const;
+        const Schema::CompiledSchema &compiled() const;
+        QByteArray checksum() const;
+        QVersionNumber gameVersion() const;
+
+private:
+        Q_DISABLE_COPY(SchemaSnapshot)
+
+        Schema::RootNode *m_graph = nullptr;
+        QByteArray m_checksum;
+        QVersionNumber m_gameVersion;
+        Schema::CompiledSchema m_compiled;
+    };
+
+    using SchemaPtr = QSharedPointer<const SchemaSnapshot>;
+
     class SchemaParser : public Parser {
         Q_DECLARE_TR_FUNCTIONS(Parser)
 
@@ -83,9 +113,13 @@ public:
         SchemaParser();
         using Parser::Parser;
 
-        static void setSchema(Schema::RootNode *schema);
-        static void loadSchema(const QString &filepath);
-        static Schema::RootNode * schema();
+        static void setSchema(
+            Schema::RootNode *schema, const QByteArray &checksum = QByteArray(),
+            const QVersionNumber &gameVersion = QVersionNumber());
+        static void loadSchema(
+            const QString &filepath,
+            const QVersionNumber &gameVersion = QVersionNumber());
+        static SchemaPtr currentSchema();
 
         QSharedPointer<Command::BoolNode> brigadier_bool();
         QSharedPointer<Command::DoubleNode> brigadier_double(
@@ -101,8 +135,8 @@ public:
             const QVariantMap &props = {});
 
         NodePtr parse();
+        NodePtr parse(SchemaPtr schema);
 
-        const ParseNodeCache &cache() const;
         static void setTestMode(bool value);
 
 
@@ -120,11 +154,13 @@ protected:
         QStringView getLiteralString();
         QStringView getDigits();
 
+        QVersionNumber gameVer() const;
+
         QPair<QStringView, int> parseInteger(bool &ok);
         QPair<QStringView, float> parseFloat(bool &ok);
 
-        bool canContinue(Schema::Node **schemaNode, int depth);
-        void parseBySchema(const Schema::Node *schemaNode, int depth = 0);
+        Result<bool> canContinue(int *nodeIndex, int depth);
+        void parseBySchema(const int nodeIndex, int depth = 0);
 
         template<typename T>
         void checkMin(T value, T min) {
@@ -158,45 +194,19 @@ protected:
             }
         };
 
-        template<typename Type, typename Class, typename ... Args1,
-                 typename ... Args2>
-        auto callWithCache(QSharedPointer<Type> (Class::*funcPtr)(Args1 ...),
-                           Class *that, const QString &literal,
-                           Args2 &&... args) {
-            //if (m_testMode) {
-            return (that->*funcPtr)(std::forward<Args1>(args)...);
-            //}
-
-            /*
-               constexpr int retTypeId = getTypeEnumId<Type>();
-               CacheKey      key{ retTypeId, literal };
-
-               if (m_cache.contains(key)) {
-                const auto value = qSharedPointerCast<Type>(m_cache[key]);
-                Q_ASSERT(value != nullptr);
-                advance(value->length());
-                return value;
-               }
-               auto value =
-                (that->*funcPtr)(std::forward<decltype(args)>(args)...);
-               Q_ASSERT(value != nullptr);
-               m_cache.emplace(retTypeId, literal, value);
-
-               return value;
-             */
-        }
-
         virtual NodePtr invokeMethod(ArgumentNode::ParserType parserType,
                                      const QVariantMap &props);
 
 private:
-        ParseNodeCache m_cache;
         QSharedPointer<Command::RootNode> m_tree;
 //        static inline const QRegularExpression m_decimalNumRegex{
 //            QStringLiteral(R"([+-]?(?:\d+\.\d+|\.\d+|\d+\.|\d+))") };
-        static inline Schema::RootNode *m_schemaGraph = nullptr;
+        static inline QReadWriteLock m_currentSchemaLock;
+        static inline SchemaPtr m_currentSchema;
+        SchemaPtr m_schema;
 
-        const QString commandGuideStr(const Schema::Node *schemaNode);
+        const QString commandGuideStr(
+            const Schema::CompiledSchema::Node &schemaNode) const;
     };
 }
 
@@ -4,6 +4,48 @@
 #include "../schema/schemaargumentnode.h"
 #include "game.h"
 #include "globalhelpers.h"
+#include "datapackindex.h"
+
+#include <QMutex>
+
+namespace {
+    QMutex                             indexCacheMutex;
+    QHash<QString, CompletionIndexPtr> gameIndexes;
+    // The revision of the datapack index and the completion index
+    QHash<QString, QPair<int, CompletionIndexPtr> > datapackIndexes;
+
+    QVector<QString> toTagForm(const QVector<QString> &ids) {
+        QVector<QString> tags;
+
+        tags.reserve(ids.size());
+        for (const auto &id: ids) {
+            tags << '#' + id;
+        }
+        return tags;
+    }
+
+    /*!
+     * \internal
+     * \brief Returns the completion index of the IDs of a game data \a type
+     * of the current game version, which is built on the first call.
+     */
+    template<typename GetIds>
+    CompletionIndexPtr gameIndex(const QString &type, const bool useTagForm,
+                                 GetIds &&getIds) {
+        const QString &&key = QStringLiteral("%1%2@%3").arg(
+            useTagForm ? QStringLiteral("#") : QString(), type,
+            Game::versionString());
+        QMutexLocker locker(&indexCacheMutex);
+
+        auto &index = gameIndexes[key];
+        if (!index) {
+            const QVector<QString> &&ids = getIds();
+            index = CompletionIndexPtr::create(useTagForm ? toTagForm(ids)
+                                                          : ids);
+        }
+        return index;
+    }
+}
 
 namespace Command {
     CompletionProvider::CompletionProvider(const int row) : OverloadNodeVisitor(
@@ -97,11 +139,8 @@ namespace Command {
     }
 
     void CompletionProvider::visit(FunctionNode *) {
-        m_suggestions += Glhp::fileIdList(
-            QDir::currentPath(), QStringLiteral("functions"));
-        m_suggestions += Glhp::fileIdList(
-            QDir::currentPath(), QStringLiteral("tags/functions"),
-            QString(), false);
+        addSuggestionsFromDatapack(QStringLiteral("functions"));
+        addSuggestionsFromDatapack(QStringLiteral("tags/functions"), false);
     }
 
     void CompletionProvider::visit(ItemEnchantmentNode *) {
@@ -113,25 +152,15 @@ namespace Command {
     }
 
     void CompletionProvider::visit(ResourceLocationNode *node) {
-        m_suggestions += Glhp::fileIdList(
-            QDir::currentPath(), QStringLiteral("advancements"),
-            QString(), false);
-        m_suggestions += Game::getRegistry(QStringLiteral("advancement"));
-        m_suggestions += Glhp::fileIdList(
-            QDir::currentPath(), QStringLiteral("item_modifiers"),
-            QString(), false);
-        m_suggestions += Glhp::fileIdList(
-            QDir::currentPath(), QStringLiteral("loot_tables"),
-            QString(), false);
-        m_suggestions += Glhp::fileIdList(
-            QDir::currentPath(), QStringLiteral("predicates"),
-            QString(), false);
-        m_suggestions += Game::getRegistry(QStringLiteral("loot_table"));
-        m_suggestions += Glhp::fileIdList(
-            QDir::currentPath(), QStringLiteral("recipes"),
-            QString(), false);
-        m_suggestions += Game::getRegistry(QStringLiteral("recipe"));
-        m_suggestions += Game::getRegistry(QStringLiteral("sound_event"));
+        addSuggestionsFromDatapack(QStringLiteral("advancements"), false);
+        addSuggestionsFromRegistry(QStringLiteral("advancement"));
+        addSuggestionsFromDatapack(QStringLiteral("item_modifiers"), false);
+        addSuggestionsFromDatapack(QStringLiteral("loot_tables"), false);
+        addSuggestionsFromDatapack(QStringLiteral("predicates"), false);
+        addSuggestionsFromRegistry(QStringLiteral("loot_table"));
+        addSuggestionsFromDatapack(QStringLiteral("recipes"), false);
+        addSuggestionsFromRegistry(QStringLiteral("recipe"));
+        addSuggestionsFromRegistry(QStringLiteral("sound_event"));
     }
 
     void CompletionProvider::visit(ResourceNode *node) {
@@ -162,9 +191,7 @@ namespace Command {
             (m_cursorRow <= (m_pos + node->resLoc()->length()))) {
             addSuggestionsFromInfo(QStringLiteral("block"));
             addSuggestionsFromInfo(QStringLiteral("tag/block"), true);
-            m_suggestions += Glhp::fileIdList(
-                QDir::currentPath(), QStringLiteral("tags/blocks"),
-                QString(), false);
+            addSuggestionsFromDatapack(QStringLiteral("tags/blocks"), false);
         }
     }
 
@@ -180,16 +207,14 @@ namespace Command {
             (m_cursorRow <= (m_pos + node->resLoc()->length()))) {
             addSuggestionsFromInfo(QStringLiteral("item"));
             addSuggestionsFromInfo(QStringLiteral("tag/item"), true);
-            m_suggestions += Glhp::fileIdList(
-                QDir::currentPath(), QStringLiteral("tags/items"),
-                QString(), false);
+            addSuggestionsFromDatapack(QStringLiteral("tags/items"), false);
         }
     }
 
     void CompletionProvider::visit(ParticleNode *node) {
         if ((m_cursorRow >= m_pos) &&
             (m_cursorRow <= (m_pos + node->resLoc()->length()))) {
-            m_suggestions += Game::getRegistry(QStringLiteral("particle_type"));
+            addSuggestionsFromRegistry(QStringLiteral("particle_type"));
         }
     }
 
@@ -197,8 +222,17 @@ namespace Command {
         m_suggestions += QUuid::createUuid().toString(QUuid::WithoutBraces);
     }
 
-    QVector<QString> CompletionProvider::suggestions() const {
-        return m_suggestions;
+    /*!
+     * \brief Returns a query over the suggestions collected for the cursor.
+     */
+    CompletionQuery CompletionProvider::query() const {
+        CompletionQuery query;
+
+        query.addWords(m_suggestions);
+        for (const auto &index: m_indexes) {
+            query.addIndex(index);
+        }
+        return query;
     }
 
     void CompletionProvider::addSuggestionsFromRegistry(ArgumentNode *node,
@@ -211,35 +245,52 @@ namespace Command {
             Glhp::removePrefix(registry, QLatin1String("minecraft:"));
 
             if (!registry.isEmpty()) {
-                m_suggestions += Game::getRegistry(registry);
+                addSuggestionsFromRegistry(registry);
                 if (getTag) {
-                    registry += "tag/"_QL1;
-                    const auto &&tags = Game::getRegistry(registry);
-                    std::transform(tags.cbegin(), tags.cend(),
-                                   std::back_inserter(m_suggestions),
-                                   [](auto &&str) {
-                        const static QChar hashtag = '#';
-                        return hashtag + str;
-                    });
+                    addSuggestionsFromRegistry(registry + "tag/"_QL1, true);
                 }
             }
         }
     }
 
+    void CompletionProvider::addSuggestionsFromRegistry(
+        const QString &registry, const bool useTagForm) {
+        m_indexes += gameIndex(registry, useTagForm, [&registry]() {
+            return *Game::getRegistryHandle(registry);
+        });
+    }
+
     void CompletionProvider::addSuggestionsFromInfo(const QString &key,
                                                     const bool &useTagForm) {
-        const QVariantMap &&infoMap = Game::getInfo(key);
-        const auto        &&keys    = infoMap.keys();
-
-        if (useTagForm) {
-            std::transform(keys.cbegin(), keys.cend(),
-                           std::back_inserter(m_suggestions),
-                           [](auto &&str) {
-                const static QChar hashtag = '#';
-                return hashtag + str;
-            });
-        } else {
-            m_suggestions += keys.toVector();
+        m_indexes += gameIndex(key, useTagForm, [&key]() {
+            return Game::getInfoHandle(key)->keys().toVector();
+        });
+    }
+
+    /*!
+     * \brief Adds the IDs of the files in the \a catDir directory of
+     * the current datapack. The index of a directory is kept until
+     * the datapack changes.
+     */
+    void CompletionProvider::addSuggestionsFromDatapack(const QString &catDir,
+                                                        const bool noTagForm) {
+        const QString &&dirPath = QDir::currentPath();
+        const auto     *index   = DatapackIndex::instance();
+
+        if (!index->isLoaded(dirPath)) {
+            m_indexes += CompletionIndexPtr::create(
+                Glhp::fileIdList(dirPath, catDir, QString(), noTagForm));
+            return;
+        }
+
+        const QString &&key      = noTagForm ? catDir : '#' + catDir;
+        const int       revision = index->revision();
+        QMutexLocker    locker(&indexCacheMutex);
+        auto           &cached = datapackIndexes[key];
+        if (!cached.second || (cached.first != revision)) {
+            cached = { revision, CompletionIndexPtr::create(
+                           index->ids(catDir, QString(), noTagForm)) };
         }
+        m_indexes += cached.second;
     }
 }
@@ -3,6 +3,8 @@
 
 #include "overloadnodevisitor.h"
 
+#include "completionindex.h"
+
 namespace Command {
     class CompletionProvider : public OverloadNodeVisitor {
 public:
@@ -37,17 +39,22 @@ public:
         void visit(UuidNode *node) final;
 
 
-        QVector<QString> suggestions() const;
+        CompletionQuery query() const;
 
 private:
         QVector<QString> m_suggestions;
+        QVector<CompletionIndexPtr> m_indexes;
         int m_pos       = 0;
         int m_cursorRow = 0;
 
         void addSuggestionsFromRegistry(ArgumentNode *node,
                                         const bool getTag = false);
+        void addSuggestionsFromRegistry(const QString &registry,
+                                        const bool useTagForm = false);
         void addSuggestionsFromInfo(const QString &key,
                                     const bool &useTagForm = false);
+        void addSuggestionsFromDatapack(const QString &catDir,
+                                        const bool noTagForm = true);
     };
 }
 
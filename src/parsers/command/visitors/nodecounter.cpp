@@ -43,4 +43,46 @@ namespace Command {
     int NodeCounter::nbtAccessCount() const {
         return m_nbtAccessCount;
     }
+
+    /*!
+     * \brief Adds the counts of the \a other counter to this counter.
+     */
+    void NodeCounter::merge(const NodeCounter &other) {
+        m_nbtAccessCount += other.m_nbtAccessCount;
+        for (auto it = other.m_commandCounts.cbegin();
+             it != other.m_commandCounts.cend(); ++it) {
+            m_commandCounts[it.key()] += it.value();
+        }
+        for (auto it = other.m_targetSelectorCounts.cbegin();
+             it != other.m_targetSelectorCounts.cend(); ++it) {
+            m_targetSelectorCounts[it.key()] += it.value();
+        }
+    }
+
+    QDataStream &operator<<(QDataStream &out, const NodeCounter &counter) {
+        out << counter.m_nbtAccessCount << counter.m_commandCounts;
+        out << quint32(counter.m_targetSelectorCounts.size());
+        for (auto it = counter.m_targetSelectorCounts.cbegin();
+             it != counter.m_targetSelectorCounts.cend(); ++it) {
+            out << qint8(it.key()) << it.value();
+        }
+        return out;
+    }
+
+    QDataStream &operator>>(QDataStream &in, NodeCounter &counter) {
+        quint32 selectorCount = 0;
+
+        in >> counter.m_nbtAccessCount >> counter.m_commandCounts;
+        in >> selectorCount;
+        counter.m_targetSelectorCounts.clear();
+        for (quint32 i = 0; i < selectorCount && in.status() == QDataStream::Ok;
+             ++i) {
+            qint8 variable = 0;
+            uint  count    = 0;
+            in >> variable >> count;
+            counter.m_targetSelectorCounts.insert(
+                static_cast<TargetSelectorNode::Variable>(variable), count);
+        }
+        return in;
+    }
 }
@@ -6,6 +6,7 @@
 
 #include <QString>
 #include <QHash>
+#include <QDataStream>
 
 using UintHash     = QHash<QString, uint>;
 using SelectorHash = QMap<Command::TargetSelectorNode::Variable, uint>;
@@ -24,6 +25,12 @@ public:
         SelectorHash targetSelectorCounts() const;
         int nbtAccessCount() const;
 
+        void merge(const NodeCounter &other);
+
+        friend QDataStream &operator<<(QDataStream &out,
+                                       const NodeCounter &counter);
+        friend QDataStream &operator>>(QDataStream &in, NodeCounter &counter);
+
 private:
         uint m_nbtAccessCount = 0;
         UintHash m_commandCounts;
@@ -0,0 +1,361 @@
+#include "semanticvalidator.h"
+
+#include "../schema/schemanode.h"
+#include "../schema/schemaargumentnode.h"
+#include "game.h"
+#include "globalhelpers.h"
+#include "datapackindex.h"
+
+#include <QDir>
+#include <QMutex>
+
+#include <algorithm>
+
+namespace {
+    QMutex                             idSetCacheMutex;
+    QHash<QString, Command::IdSetPtr> gameIdSets;
+    // The revision of the datapack index and the set of IDs
+    QHash<QString, QPair<int, Command::IdSetPtr> > datapackIdSets;
+
+    /*!
+     * \internal
+     * \brief Returns the set of game IDs cached by the \a key, which is built
+     * by \a getIds on the first call.
+     */
+    template<typename GetIds>
+    Command::IdSetPtr gameIds(const QString &key, GetIds &&getIds) {
+        QMutexLocker locker(&idSetCacheMutex);
+
+        auto &ids = gameIdSets[key];
+
+        if (!ids) {
+            ids = Command::IdSetPtr::create(getIds());
+        }
+        return ids;
+    }
+
+    /*!
+     * \internal
+     * \brief Returns the IDs of the files in the \a catDir directory of
+     * the current datapack, or null if the datapack hasn't been indexed.
+     */
+    Command::IdSetPtr datapackIds(const QString &catDir) {
+        const auto *index = DatapackIndex::instance();
+
+        if (!index->isLoaded(QDir::currentPath())) {
+            return nullptr;
+        }
+
+        const int    revision = index->revision();
+        QMutexLocker locker(&idSetCacheMutex);
+        auto        &cached = datapackIdSets[catDir];
+        if (!cached.second || (cached.first != revision)) {
+            cached = { revision,
+                       Command::IdSetPtr::create(index->ids(catDir)) };
+        }
+        return cached.second;
+    }
+
+    bool isVanilla(const Command::ResourceLocationNode *node) {
+        return !node->nspace() || (node->nspace()->textSpan() == u"minecraft");
+    }
+
+    bool isCheckable(const Command::ResourceLocationNode *node) {
+        return node->isValid() && node->id();
+    }
+}
+
+namespace Command {
+    /*!
+     * \brief Constructs a set of the \a ids. Duplicated IDs are removed.
+     */
+    IdSet::IdSet(QVector<QString> ids) : m_ids(std::move(ids)) {
+        std::sort(m_ids.begin(), m_ids.end());
+        m_ids.erase(std::unique(m_ids.begin(), m_ids.end()), m_ids.end());
+        m_ids.squeeze();
+    }
+
+    bool IdSet::isEmpty() const {
+        return m_ids.isEmpty();
+    }
+
+    int IdSet::size() const {
+        return m_ids.size();
+    }
+
+    bool IdSet::contains(QStringView id) const {
+        const auto &&it = std::lower_bound(
+            m_ids.cbegin(), m_ids.cend(), id,
+            [](const QString &a, QStringView b) {
+            return a.compare(b) < 0;
+        });
+
+        return (it != m_ids.cend()) && (*it == id);
+    }
+
+    /*!
+     * \brief Returns whether any ID in the set starts with \a prefix.
+     */
+    bool IdSet::containsPrefix(QStringView prefix) const {
+        const auto &&it = std::lower_bound(
+            m_ids.cbegin(), m_ids.cend(), prefix,
+            [](const QString &a, QStringView b) {
+            return a.compare(b) < 0;
+        });
+
+        return (it != m_ids.cend()) && it->startsWith(prefix);
+    }
+
+    SemanticValidator::SemanticValidator()
+        : OverloadNodeVisitor(Preorder), m_version(Game::versionString()) {
+    }
+
+    void SemanticValidator::visit(DimensionNode *node) {
+        checkGameId(node, infoIds(QStringLiteral("dimension")),
+                    QT_TRANSLATE_NOOP("Parser", "Unknown dimension: %1"));
+    }
+
+    void SemanticValidator::visit(EntitySummonNode *node) {
+        checkGameId(node, infoIds(QStringLiteral("entity")),
+                    QT_TRANSLATE_NOOP("Parser", "Unknown entity type: %1"));
+    }
+
+    void SemanticValidator::visit(FunctionNode *node) {
+        if (node->isTag()) {
+            checkDatapackId(node, nullptr, QStringLiteral("tags/functions"),
+                            QT_TRANSLATE_NOOP("Parser",
+                                              "Unknown function tag: %1"));
+        } else {
+            checkDatapackId(node, nullptr, QStringLiteral("functions"),
+                            QT_TRANSLATE_NOOP("Parser",
+                                              "Unknown function: %1"));
+        }
+    }
+
+    void SemanticValidator::visit(ItemEnchantmentNode *node) {
+        checkGameId(node, infoIds(QStringLiteral("enchantment")),
+                    QT_TRANSLATE_NOOP("Parser", "Unknown enchantment: %1"));
+    }
+
+    void SemanticValidator::visit(MobEffectNode *node) {
+        checkGameId(node, infoIds(QStringLiteral("effect")),
+                    QT_TRANSLATE_NOOP("Parser", "Unknown effect: %1"));
+    }
+
+    void SemanticValidator::visit(ResourceNode *node) {
+        checkRegistryId(node);
+    }
+
+    void SemanticValidator::visit(ResourceKeyNode *node) {
+        checkRegistryId(node);
+    }
+
+    void SemanticValidator::visit(ResourceOrTagNode *node) {
+        checkRegistryId(node);
+    }
+
+    void SemanticValidator::visit(ResourceOrTagKeyNode *node) {
+        checkRegistryId(node);
+    }
+
+    void SemanticValidator::visit(BlockStateNode *node) {
+        const auto *resLoc = node->resLoc().get();
+
+        if (!resLoc) {
+            return;
+        }
+        if (resLoc->isTag()) {
+            checkDatapackId(resLoc, infoIds(QStringLiteral("tag/block")),
+                            QStringLiteral("tags/blocks"),
+                            QT_TRANSLATE_NOOP("Parser",
+                                              "Unknown block tag: %1"));
+        } else {
+            checkGameId(resLoc, infoIds(QStringLiteral("block")),
+                        QT_TRANSLATE_NOOP("Parser", "Unknown block: %1"));
+        }
+    }
+
+    void SemanticValidator::visit(ItemStackNode *node) {
+        const auto *resLoc = node->resLoc().get();
+
+        if (!resLoc) {
+            return;
+        }
+        if (resLoc->isTag()) {
+            checkDatapackId(resLoc, infoIds(QStringLiteral("tag/item")),
+                            QStringLiteral("tags/items"),
+                            QT_TRANSLATE_NOOP("Parser",
+                                              "Unknown item tag: %1"));
+        } else {
+            checkGameId(resLoc, itemIds(),
+                        QT_TRANSLATE_NOOP("Parser", "Unknown item: %1"));
+        }
+    }
+
+    /*!
+     * \brief Returns the problems found since the last reset(). Positions are
+     * relative to the start of the visited line.
+     */
+    Parser::Errors SemanticValidator::problems() const {
+        return m_problems;
+    }
+
+    void SemanticValidator::reset() {
+        m_problems.clear();
+    }
+
+    /*!
+     * \brief Returns a key which changes whenever the data that IDs are
+     * checked against may have changed, so cached results can be discarded.
+     */
+    QString SemanticValidator::dataKey() {
+        return Game::versionString() + '@'
+               + QString::number(DatapackIndex::instance()->revision());
+    }
+
+    /*!
+     * \brief Reports the \a node if it's in the \c minecraft namespace but
+     * isn't one of the \a ids.
+     */
+    void SemanticValidator::checkGameId(const ResourceLocationNode *node,
+                                        const IdSetPtr &ids,
+                                        const char *message) {
+        if (!isCheckable(node) || node->isTag() || ids->isEmpty()
+            || !isVanilla(node)) {
+            return;
+        }
+        if (!ids->contains(node->id()->textSpan().view())) {
+            report(node, message);
+        }
+    }
+
+    /*!
+     * \brief Reports the \a node if it's neither one of the \a gameIds nor
+     * the ID of a file in the \a catDir directory of the datapack.
+     *
+     * A namespace which the datapack has no files of may be provided by
+     * another datapack, so its IDs are only checked against the game IDs.
+     */
+    void SemanticValidator::checkDatapackId(const ResourceLocationNode *node,
+                                            const IdSetPtr &gameIds,
+                                            const QString &catDir,
+                                            const char *message) {
+        if (!isCheckable(node)) {
+            return;
+        }
+
+        const bool hasGameIds = isVanilla(node) && gameIds
+                                && !gameIds->isEmpty();
+        if (hasGameIds && gameIds->contains(node->id()->textSpan().view())) {
+            return;
+        }
+
+        const auto &&packIds = datapackIds(catDir);
+        bool         hasPackIds = false;
+        if (packIds) {
+            const QString &&id = node->fullId();
+            if (packIds->contains(id)) {
+                return;
+            }
+            hasPackIds = packIds->containsPrefix(
+                QStringView(id).left(id.indexOf(':') + 1));
+        }
+
+        if (hasGameIds || hasPackIds) {
+            report(node, message);
+        }
+    }
+
+    /*!
+     * \brief Checks the \a node against the registry in the properties of
+     * its schema node.
+     */
+    void SemanticValidator::checkRegistryId(ArgumentNode *node) {
+        if (!node->schemaNode()
+            || (node->schemaNode()->kind() != Schema::Node::Kind::Argument)) {
+            return;
+        }
+
+        const auto *schemaNode =
+            static_cast<const Schema::ArgumentNode *>(node->schemaNode());
+        QString &&registry =
+            schemaNode->properties().value("registry").toString();
+        Glhp::removePrefix(registry, QLatin1String("minecraft:"));
+        if (registry.isEmpty()) {
+            return;
+        }
+
+        const auto *resLoc = static_cast<ResourceLocationNode *>(node);
+        if (resLoc->isTag()) {
+            checkDatapackId(resLoc, nullptr, "tags/"_QL1 + registry,
+                            QT_TRANSLATE_NOOP("Parser",
+                                              "Unknown tag of %2: %1"));
+            return;
+        }
+
+        const auto &&ids = registryIds(registry);
+        if (!isCheckable(resLoc) || ids->isEmpty() || !isVanilla(resLoc)) {
+            return;
+        }
+        if (!ids->contains(resLoc->id()->textSpan().view())) {
+            report(resLoc, QT_TRANSLATE_NOOP("Parser", "Unknown ID of %2: %1"),
+                   { registry });
+        }
+    }
+
+    /*!
+     * \brief Reports the ID of the \a node with the \a message, whose first
+     * argument is the ID as written.
+     */
+    void SemanticValidator::report(const ResourceLocationNode *node,
+                                   const char *message, QVariantList args) {
+        const TextSpan &&span = node->sourceSpan();
+
+        args.prepend(span.toString());
+        m_problems << Parser::Error(message, span.offset(), span.length(),
+                                    args);
+    }
+
+    IdSetPtr SemanticValidator::infoIds(const QString &type) const {
+        auto &ids = m_infoIds[type];
+
+        if (!ids) {
+            ids = gameIds(QStringLiteral("info:%1@%2").arg(type, m_version),
+                          [this, &type]() {
+                return Game::getInfoHandle(type, m_version)->keys().toVector();
+            });
+        }
+        return ids;
+    }
+
+    /*!
+     * \brief Returns the IDs of the items, which include the blocks since
+     * the item info only lists the items which aren't blocks.
+     */
+    IdSetPtr SemanticValidator::itemIds() const {
+        if (!m_itemIds) {
+            m_itemIds = gameIds(QStringLiteral("items@%1").arg(m_version),
+                                [this]() {
+                auto &&ids = Game::getInfoHandle(QStringLiteral("item"),
+                                                 m_version)->keys().toVector();
+                ids += Game::getInfoHandle(QStringLiteral("block"),
+                                           m_version)->keys().toVector();
+                return ids;
+            });
+        }
+        return m_itemIds;
+    }
+
+    IdSetPtr SemanticValidator::registryIds(const QString &registry) const {
+        auto &ids = m_registryIds[registry];
+
+        if (!ids) {
+            ids = gameIds(
+                QStringLiteral("registry:%1@%2").arg(registry, m_version),
+                [this, &registry]() {
+                return *Game::getRegistryHandle(registry, m_version);
+            });
+        }
+        return ids;
+    }
+}
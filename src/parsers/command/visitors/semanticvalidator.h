@@ -0,0 +1,85 @@
+#ifndef SEMANTICVALIDATOR_H
+#define SEMANTICVALIDATOR_H
+
+#include "overloadnodevisitor.h"
+
+#include "parsers/parser.h"
+
+namespace Command {
+    /*!
+     * \brief An immutable set of IDs stored as a sorted array.
+     *
+     * Lookups are binary searches, so an ID can be looked up by a view of
+     * the parsed text without allocating a string, and the set takes no more
+     * memory than the IDs themselves.
+     */
+    class IdSet {
+public:
+        IdSet() = default;
+        explicit IdSet(QVector<QString> ids);
+
+        bool isEmpty() const;
+        int size() const;
+        bool contains(QStringView id) const;
+        bool containsPrefix(QStringView prefix) const;
+
+private:
+        QVector<QString> m_ids;
+    };
+
+    using IdSetPtr = QSharedPointer<const IdSet>;
+
+    /*!
+     * \brief Reports the resource locations of a command which don't refer
+     * to anything in the game or in the current datapack.
+     *
+     * Only the IDs which can be known are checked: IDs in the \c minecraft
+     * namespace against the game data of the current version, and functions
+     * and tags against the datapack if it has been indexed. A check is
+     * skipped if there is no data to check against.
+     */
+    class SemanticValidator : public OverloadNodeVisitor {
+public:
+        SemanticValidator();
+
+        void visit(DimensionNode *node) final;
+        void visit(EntitySummonNode *node) final;
+        void visit(FunctionNode *node) final;
+        void visit(ItemEnchantmentNode *node) final;
+        void visit(MobEffectNode *node) final;
+        void visit(ResourceNode *node) final;
+        void visit(ResourceKeyNode *node) final;
+        void visit(ResourceOrTagNode *node) final;
+        void visit(ResourceOrTagKeyNode *node) final;
+        void visit(BlockStateNode *node) final;
+        void visit(ItemStackNode *node) final;
+
+        Parser::Errors problems() const;
+        void reset();
+
+        static QString dataKey();
+
+private:
+        Parser::Errors m_problems;
+        QString m_version;
+        // Sets of this validator, so that they're looked up once
+        mutable QHash<QString, IdSetPtr> m_infoIds;
+        mutable QHash<QString, IdSetPtr> m_registryIds;
+        mutable IdSetPtr m_itemIds;
+
+        void checkGameId(const ResourceLocationNode *node,
+                         const IdSetPtr &ids, const char *message);
+        void checkDatapackId(const ResourceLocationNode *node,
+                             const IdSetPtr &gameIds, const QString &catDir,
+                             const char *message);
+        void checkRegistryId(ArgumentNode *node);
+        void report(const ResourceLocationNode *node, const char *message,
+                    QVariantList args = {});
+
+        IdSetPtr infoIds(const QString &type) const;
+        IdSetPtr itemIds() const;
+        IdSetPtr registryIds(const QString &registry) const;
+    };
+}
+
+#endif // SEMANTICVALIDATOR_H
@@ -11,7 +11,7 @@ public:
         void visit(ParseNode *node) override {
             m_text += node->leadingTrivia();
             m_text += node->leftText();
-            m_text += node->text();
+            m_text += node->textSpan();
             m_text += node->rightText();
             m_text += node->trailingTrivia();
         };
@@ -194,13 +194,13 @@ public:
             if (node->nspace()) {
                 m_text += node->nspace()->leadingTrivia();
                 m_text += node->nspace()->leftText();
-                m_text += node->nspace()->text();
+                m_text += node->nspace()->textSpan();
                 m_text += node->nspace()->rightText();
                 m_text += node->nspace()->trailingTrivia();
             }
             m_text += node->id()->leadingTrivia();
             m_text += node->id()->leftText();
-            m_text += node->id()->text();
+            m_text += node->id()->textSpan();
             m_text += node->id()->rightText();
             m_text += node->id()->trailingTrivia();
 
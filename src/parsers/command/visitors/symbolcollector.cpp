@@ -0,0 +1,165 @@
+#include "symbolcollector.h"
+
+#include <QVarLengthArray>
+
+namespace {
+    using Literals = QVarLengthArray<QStringView, 16>;
+
+    /*!
+     * \internal
+     * \brief Returns whether the last literals are \a first and \a second.
+     */
+    bool endsWith(const Literals &literals, QStringView first,
+                  QStringView second) {
+        const int size = literals.size();
+
+        return (size >= 2) && (literals.at(size - 2) == first)
+               && (literals.at(size - 1) == second);
+    }
+}
+
+namespace Command {
+    /*!
+     * \brief Collects the symbols which depend on the literals before them,
+     * such as the objective of \c {scoreboard objectives add}.
+     */
+    void SymbolCollector::visit(RootNode *node) {
+        using ParserType = ArgumentNode::ParserType;
+
+        Literals literals;
+        bool     afterLiteral = false;
+
+        for (const auto &child: node->children()) {
+            if (child->kind() == ParseNode::Kind::Literal) {
+                // The views refer to the text shared by the nodes
+                literals.append(child->textSpan().view());
+                afterLiteral = true;
+                continue;
+            }
+
+            const bool isFirstArgument = std::exchange(afterLiteral, false);
+            if (child->kind() != ParseNode::Kind::Argument) {
+                continue;
+            }
+
+            const auto *arg = static_cast<const ArgumentNode *>(child.get());
+            switch (arg->parserType()) {
+                case ParserType::Objective: {
+                    add(Kind::Objective, Role::Use, arg);
+                    break;
+                }
+                case ParserType::Team: {
+                    add(Kind::Team, Role::Use, arg);
+                    break;
+                }
+                case ParserType::String: {
+                    if (!isFirstArgument) {
+                        break;
+                    }
+                    if (endsWith(literals, u"objectives", u"add")) {
+                        add(Kind::Objective, Role::Definition, arg);
+                    } else if (endsWith(literals, u"team", u"add")) {
+                        add(Kind::Team, Role::Definition, arg);
+                    }
+                    break;
+                }
+                case ParserType::ResourceLocation: {
+                    if (!isFirstArgument) {
+                        break;
+                    }
+
+                    const auto *resLoc =
+                        static_cast<const ResourceLocationNode *>(arg);
+                    const int  size = literals.size();
+                    if (literals.back() == u"storage") {
+                        const QStringView prev = (size >= 2)
+                                ? literals.at(size - 2) : QStringView();
+                        // Writing to a storage creates it
+                        const bool writes = (prev == u"modify")
+                                            || (prev == u"merge")
+                                            || (prev == u"remove")
+                                            || (prev == u"result")
+                                            || (prev == u"success");
+                        add(Kind::Storage,
+                            writes ? Role::Definition : Role::Use, resLoc);
+                    } else if ((literals.back() == u"bossbar")
+                               || ((size >= 2)
+                                   && (literals.at(size - 2) == u"bossbar"))) {
+                        add(Kind::Bossbar,
+                            (literals.back() == u"add")
+                                ? Role::Definition : Role::Use, resLoc);
+                    }
+                    break;
+                }
+                default: {
+                    break;
+                }
+            }
+        }
+    }
+
+    void SymbolCollector::visit(FunctionNode *node) {
+        add(node->isTag() ? Kind::FunctionTag : Kind::Function, Role::Use,
+            node);
+    }
+
+    /*!
+     * \brief Collects the teams and objectives in the \c team and \c scores
+     * arguments of the selector.
+     */
+    void SymbolCollector::visit(TargetSelectorNode *node) {
+        if (!node->args()) {
+            return;
+        }
+
+        for (const auto &pair: node->args()->pairs()) {
+            const QString &&key = pair->first->value();
+            if (key == QLatin1String("team")) {
+                const auto *value =
+                    static_cast<const EntityArgumentValueNode *>(
+                        pair->second.get());
+                if (value->getNode() && (value->getNode()->length() > 0)) {
+                    add(Kind::Team, Role::Use, value->getNode().get());
+                }
+            } else if ((key == QLatin1String("scores"))
+                       && (pair->second->kind() ==
+                           ParseNode::Kind::Container)) {
+                const auto *scores =
+                    static_cast<const MapNode *>(pair->second.get());
+                for (const auto &score: scores->pairs()) {
+                    add(Kind::Objective, Role::Use, score->first.get());
+                }
+            }
+        }
+    }
+
+    QVector<SymbolCollector::Symbol> SymbolCollector::symbols() const {
+        return m_symbols;
+    }
+
+    void SymbolCollector::reset() {
+        m_symbols.clear();
+    }
+
+    void SymbolCollector::add(const Kind kind, const Role role,
+                              const ParseNode *node) {
+        const TextSpan &&span = node->textSpan();
+
+        if (span.isEmpty()) {
+            return;
+        }
+        m_symbols << Symbol{ span.toString(), kind, role,
+                             span.offset(), span.length() };
+    }
+
+    void SymbolCollector::add(const Kind kind, const Role role,
+                              const ResourceLocationNode *node) {
+        const TextSpan &&span = node->sourceSpan();
+
+        if (!node->isValid() || span.isEmpty()) {
+            return;
+        }
+        m_symbols << Symbol{ node->fullId(), kind, role,
+                             span.offset(), span.length() };
+    }
+}
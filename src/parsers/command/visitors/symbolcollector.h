@@ -0,0 +1,59 @@
+#ifndef SYMBOLCOLLECTOR_H
+#define SYMBOLCOLLECTOR_H
+
+#include "overloadnodevisitor.h"
+
+namespace Command {
+    /*!
+     * \brief Collects the symbols which a command defines or refers to, such
+     * as functions, scoreboard objectives and storages.
+     *
+     * A command line is visited at a time. Functions and function tags are
+     * named by their namespaced IDs without the leading \c #, while the other
+     * kinds of symbols are named as written.
+     */
+    class SymbolCollector : public OverloadNodeVisitor {
+public:
+        enum class Kind : quint8 {
+            Function,
+            FunctionTag,
+            Objective,
+            Storage,
+            Team,
+            Bossbar,
+        };
+        static constexpr int kindCount = 6;
+
+        enum class Role : quint8 {
+            Use,
+            Definition,
+        };
+
+        struct Symbol {
+            QString name;
+            Kind    kind;
+            Role    role;
+            int     pos; // Relative to the start of the line
+            int     length;
+        };
+
+        SymbolCollector() : OverloadNodeVisitor(Preorder) {
+        };
+
+        void visit(RootNode *node) final;
+        void visit(FunctionNode *node) final;
+        void visit(TargetSelectorNode *node) final;
+
+        QVector<Symbol> symbols() const;
+        void reset();
+
+private:
+        QVector<Symbol> m_symbols;
+
+        void add(const Kind kind, const Role role, const ParseNode *node);
+        void add(const Kind kind, const Role role,
+                 const ResourceLocationNode *node);
+    };
+}
+
+#endif // SYMBOLCOLLECTOR_H
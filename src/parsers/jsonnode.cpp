@@ -0,0 +1,227 @@
+#include "jsonnode.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QLocale>
+
+#include <algorithm>
+
+namespace Json {
+    Node::Node(const Kind kind, const int length, Children &&children,
+               const bool hasErrors, const bool isClosed)
+        : m_children(std::move(children)), m_length(length), m_kind(kind),
+        m_hasErrors(hasErrors), m_isClosed(isClosed) {
+    }
+
+    bool Node::isValue() const {
+        switch (m_kind) {
+            case Kind::Object:
+            case Kind::Array:
+            case Kind::String:
+            case Kind::Number:
+            case Kind::True:
+            case Kind::False:
+            case Kind::Null:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    /*!
+     * \brief Returns the key of a member node, or null for other nodes.
+     */
+    NodePtr Node::key() const {
+        if ((m_kind != Kind::Member) || m_children.isEmpty()) {
+            return nullptr;
+        }
+        return m_children.constFirst().node;
+    }
+
+    /*!
+     * \brief Returns the value of a member node, or null if it's missing.
+     */
+    NodePtr Node::value() const {
+        if ((m_kind != Kind::Member) || (m_children.size() < 2)
+            || !m_children.constLast().node->isValue()) {
+            return nullptr;
+        }
+        return m_children.constLast().node;
+    }
+
+    /*!
+     * \brief Converts the node to a JSON value. The \a text must start at
+     * the node. Members without values and skipped characters are ignored.
+     */
+    QJsonValue Node::toJsonValue(QStringView text) const {
+        switch (m_kind) {
+            case Kind::Document: {
+                for (const auto &child: m_children) {
+                    if (child.node->isValue()) {
+                        return child.node->toJsonValue(
+                            text.mid(child.offset));
+                    }
+                }
+                return QJsonValue(QJsonValue::Undefined);
+            }
+
+            case Kind::Object: {
+                QJsonObject object;
+                for (const auto &child: m_children) {
+                    const auto &member = child.node;
+                    if (member->kind() != Kind::Member) {
+                        continue;
+                    }
+
+                    const auto &&value = member->value();
+                    if (!value) {
+                        continue;
+                    }
+
+                    const auto &keyChild   = member->children().constFirst();
+                    const auto &valueChild = member->children().constLast();
+                    object.insert(
+                        keyChild.node->toJsonValue(
+                            text.mid(child.offset + keyChild.offset))
+                        .toString(),
+                        value->toJsonValue(
+                            text.mid(child.offset + valueChild.offset)));
+                }
+                return object;
+            }
+
+            case Kind::Array: {
+                QJsonArray array;
+                for (const auto &child: m_children) {
+                    if (child.node->isValue()) {
+                        array.append(child.node->toJsonValue(
+                                         text.mid(child.offset)));
+                    }
+                }
+                return array;
+            }
+
+            case Kind::String:
+                return unescape(text.mid(1, m_length - (m_isClosed ? 2 : 1)));
+
+            case Kind::Number: {
+                bool         ok     = false;
+                const double number = QLocale::c().toDouble(
+                    text.left(m_length), &ok);
+                return ok ? QJsonValue(number) : QJsonValue();
+            }
+
+            case Kind::True:
+                return true;
+
+            case Kind::False:
+                return false;
+
+            default:
+                return QJsonValue();
+        }
+    }
+
+    /*!
+     * \brief Returns the nodes of the \a document which contain \a pos,
+     * from the outermost one to the innermost one.
+     */
+    QVector<Located> nodesAt(const NodePtr &document, const int pos) {
+        QVector<Located> ret;
+
+        if (!document || (pos < 0) || (pos >= document->length())) {
+            return ret;
+        }
+
+        const Node *node  = document.get();
+        int         start = 0;
+        while (node) {
+            ret << Located{ node, start };
+
+            // Find the last child which starts at or before the position
+            const auto &children = node->children();
+            const auto &&it      = std::upper_bound(
+                children.cbegin(), children.cend(), pos - start,
+                [](const int offset, const Node::Child &child) {
+                return offset < child.offset;
+            });
+            if (it == children.cbegin()) {
+                break;
+            }
+
+            const auto &child = *(it - 1);
+            if (pos - start >= child.offset + child.node->length()) {
+                break;
+            }
+            start += child.offset;
+            node   = child.node.get();
+        }
+        return ret;
+    }
+
+    /*!
+     * \brief Returns the value of a JSON string whose \a contents are
+     * between its quotes. Invalid escape sequences are kept as they are.
+     */
+    QString unescape(QStringView contents) {
+        QString ret;
+        ret.reserve(contents.size());
+        for (int i = 0; i < contents.size(); ++i) {
+            const QChar ch = contents[i];
+            if ((ch != u'\\') || (i + 1 >= contents.size())) {
+                ret += ch;
+                continue;
+            }
+
+            const QChar escaped = contents[++i];
+            switch (escaped.unicode()) {
+                case u'b': {
+                    ret += u'\b';
+                    break;
+                }
+                case u'f': {
+                    ret += u'\f';
+                    break;
+                }
+                case u'n': {
+                    ret += u'\n';
+                    break;
+                }
+                case u'r': {
+                    ret += u'\r';
+                    break;
+                }
+                case u't': {
+                    ret += u'\t';
+                    break;
+                }
+                case u'u': {
+                    bool         ok   = false;
+                    const ushort code = (i + 4 < contents.size())
+                        ? contents.mid(i + 1, 4).toString().toUShort(&ok, 16)
+                        : 0;
+                    if (ok) {
+                        ret += QChar(code);
+                        i   += 4;
+                    } else {
+                        ret += u'\\';
+                        ret += escaped;
+                    }
+                    break;
+                }
+                case u'"':
+                case u'\\':
+                case u'/': {
+                    ret += escaped;
+                    break;
+                }
+                default: {
+                    ret += u'\\';
+                    ret += escaped;
+                }
+            }
+        }
+        return ret;
+    }
+}
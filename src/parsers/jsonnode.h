@@ -0,0 +1,92 @@
+#ifndef JSONNODE_H
+#define JSONNODE_H
+
+#include <QJsonValue>
+#include <QSharedPointer>
+#include <QVector>
+
+namespace Json {
+    class Node;
+    using NodePtr = QSharedPointer<const Node>;
+
+    /*!
+     * \brief A node of the syntax tree of a JSON document.
+     *
+     * Nodes only know their lengths and the offsets of their children
+     * relative to themselves, so that a subtree whose text hasn't changed can
+     * be shared by the trees parsed before and after an edit. Absolute
+     * positions are computed while walking down from the document node.
+     * Nodes are immutable once constructed.
+     *
+     * The tree is lossless: the text of a node is the text of the document
+     * from its position with its length, including the whitespaces, comments
+     * and invalid characters inside it.
+     */
+    class Node {
+public:
+        enum class Kind : quint8 {
+            Document, // The whole text
+            Object,
+            Array,
+            Member, // A key and its value, excluding the comma after it
+            String,
+            Number,
+            True,
+            False,
+            Null,
+            Error, // Characters which were skipped
+        };
+
+        struct Child {
+            int     offset; // Relative to the start of the parent
+            NodePtr node;
+        };
+        using Children = QVector<Child>;
+
+        Node(const Kind kind, const int length, Children &&children = {},
+             const bool hasErrors = false, const bool isClosed = true);
+
+        Kind kind() const {
+            return m_kind;
+        }
+        int length() const {
+            return m_length;
+        }
+        const Children &children() const {
+            return m_children;
+        }
+
+        bool hasErrors() const {
+            return m_hasErrors;
+        }
+        bool isClosed() const {
+            return m_isClosed;
+        }
+        bool isValue() const;
+
+        NodePtr key() const;
+        NodePtr value() const;
+
+        QJsonValue toJsonValue(QStringView text) const;
+
+private:
+        Children m_children;
+        int m_length;
+        Kind m_kind;
+        bool m_hasErrors;
+        bool m_isClosed; // Whether the closing quote or bracket is present
+    };
+
+    /*!
+     * \brief A node and its absolute position in the document.
+     */
+    struct Located {
+        const Node *node = nullptr;
+        int         pos  = 0;
+    };
+
+    QVector<Located> nodesAt(const NodePtr &document, const int pos);
+    QString unescape(QStringView contents);
+}
+
+#endif // JSONNODE_H
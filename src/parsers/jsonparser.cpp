@@ -1,20 +1,610 @@
 #include "jsonparser.h"
 
-#include "nlohmann/json.hpp"
+#include <algorithm>
 
-using json = nlohmann::json;
+using Json::Node;
+using Json::NodePtr;
+
+namespace {
+    // Parsing goes on after that, but the other errors are dropped
+    constexpr int maxErrorCount = 100;
+    // The cancellation is checked once per this number of values
+    constexpr int cancellationInterval = 1024;
+
+    /*!
+     * \internal
+     * \brief Collects the children of a node and whether there are errors
+     * in them.
+     */
+    class ChildList {
+public:
+        explicit ChildList(const int start) : m_start(start) {
+        }
+
+        void add(const int pos, NodePtr &&node) {
+            m_hasErrors |= node->hasErrors();
+            m_children << Node::Child{ pos - m_start, std::move(node) };
+        }
+        void setHasErrors() {
+            m_hasErrors = true;
+        }
+
+        NodePtr makeNode(const Node::Kind kind, const int end,
+                         const bool isClosed = true) {
+            return NodePtr::create(kind, end - m_start, std::move(m_children),
+                                   m_hasErrors, isClosed);
+        }
+
+private:
+        Node::Children m_children;
+        int m_start;
+        bool m_hasErrors = false;
+    };
+
+    bool isDelimiter(const QChar ch) {
+        switch (ch.unicode()) {
+            case u',':
+            case u':':
+            case u'{':
+            case u'}':
+            case u'[':
+            case u']':
+            case u'"':
+                return true;
+
+            default:
+                return ch.isSpace();
+        }
+    }
+
+    bool isDigit(const QChar ch) {
+        return (ch >= u'0') && (ch <= u'9');
+    }
+}
+
+/*!
+ * \class JsonParser
+ * \brief Parses JSON documents into lossless syntax trees.
+ *
+ * The parser never stops at the first error. Missing punctuation is reported
+ * and assumed, and characters which can't be parsed are skipped into error
+ * nodes, so that the rest of the document still gets a meaningful tree.
+ * Comments are allowed, as in the data packs loaded by the game.
+ *
+ * After an edit, reparse() reuses the subtrees of the previous tree whose
+ * text hasn't been touched by the edit instead of parsing them again.
+ */
 
 JsonParser::JsonParser() {
 }
 
+/*!
+ * \brief Returns the document node of the last parsed text.
+ */
+NodePtr JsonParser::syntaxTree() const {
+    return m_tree;
+}
+
+/*!
+ * \brief Reparses \a text after \a charsRemoved characters at \a position
+ * of the previously parsed text have been replaced by \a charsAdded
+ * characters, as reported by QTextDocument::contentsChange().
+ *
+ * The values which lie entirely outside of the edited range are taken from
+ * the previous syntax tree. If the edit doesn't match the previous text,
+ * the whole text is parsed from scratch.
+ */
+bool JsonParser::reparse(const QString &text, const int position,
+                         const int charsRemoved, const int charsAdded) {
+    const QStringView oldView{ m_treeText };
+    const QStringView newView{ text };
+
+    if (m_tree && (position >= 0)
+        && (position + charsRemoved <= oldView.size())
+        && (newView.size() == oldView.size() - charsRemoved + charsAdded)
+        && (oldView.left(position) == newView.left(position))
+        && (oldView.mid(position + charsRemoved)
+            == newView.mid(position + charsAdded))) {
+        m_edit = Edit{ position, charsRemoved, charsAdded };
+    }
+    return parse(text);
+}
+
+/*!
+ * \brief Parses the text into a new syntax tree. If the parse is cancelled,
+ * the previous tree is kept.
+ */
 bool JsonParser::parseImpl() {
-    try {
-        const json &&j = json::parse(text().toStdString(),
-                                     nullptr, true, true);
-        return true;
-    }  catch (const json::parse_error &err) {
-        m_errors <<
-            Error(err.what(), qBound(0, (int)err.byte, text().length()));
+    if (checkCancelled()) {
+        m_edit.reset();
         return false;
     }
+
+    m_src       = textView();
+    m_index     = 0;
+    m_nodeCount = 0;
+
+    NodePtr &&document = parseDocument();
+    m_edit.reset();
+    if (wasCancelled()) {
+        return false;
+    }
+
+    m_tree     = std::move(document);
+    m_treeText = text();
+    return m_errors.isEmpty();
+}
+
+NodePtr JsonParser::parseDocument() {
+    ChildList children(0);
+    bool      hasValue = false;
+
+    while (true) {
+        skipTrivia();
+        if (atEnd()) {
+            break;
+        }
+
+        const int pos = m_index;
+        if (!hasValue) {
+            if (NodePtr &&value = parseValue()) {
+                hasValue = value->isValue();
+                children.add(pos, std::move(value));
+                continue;
+            }
+            report(QT_TR_NOOP("Unexpected %1, expecting a value"),
+                   { charText(pos) }, pos);
+            children.add(pos, skipInvalid());
+        } else {
+            // Only one value is allowed
+            report(QT_TR_NOOP("Unexpected %1 after the value"),
+                   { charText(pos) }, pos, m_src.size() - pos);
+            m_index = m_src.size();
+            children.add(pos, NodePtr::create(Node::Kind::Error,
+                                              m_index - pos,
+                                              Node::Children(), true));
+        }
+    }
+    if (!hasValue && m_src.trimmed().isEmpty()) {
+        report(QT_TR_NOOP("Unexpected %1, expecting a value"),
+               { charText(m_index) }, m_index, 0);
+        children.setHasErrors();
+    }
+    return children.makeNode(Node::Kind::Document, m_src.size());
+}
+
+/*!
+ * \brief Parses the value at the current position, or returns null without
+ * consuming anything if no value can start there.
+ */
+NodePtr JsonParser::parseValue() {
+    if ((++m_nodeCount % cancellationInterval == 0) && checkCancelled()) {
+        // Unwind by skipping the rest of the text
+        m_index = m_src.size();
+    }
+    if (atEnd()) {
+        return nullptr;
+    }
+    if (NodePtr &&node = reusableNode()) {
+        m_index += node->length();
+        return std::move(node);
+    }
+
+    const QChar ch = m_src[m_index];
+    switch (ch.unicode()) {
+        case u'{':
+            return parseObject();
+
+        case u'[':
+            return parseArray();
+
+        case u'"':
+            return parseString();
+
+        case u'-':
+            return parseNumber();
+
+        default: {
+            if (isDigit(ch)) {
+                return parseNumber();
+            } else if (ch.isLetter()) {
+                return parseWord();
+            }
+            return nullptr;
+        }
+    }
+}
+
+NodePtr JsonParser::parseObject() {
+    const int start = m_index;
+    ChildList children(start);
+    bool      expectsMember = true;
+    int       commaPos      = -1;
+
+    ++m_index;
+    while (true) {
+        skipTrivia();
+
+        const int pos = m_index;
+        if (atEnd() || (m_src[pos] == u']')) {
+            report(QT_TR_NOOP("Unexpected %1, expecting %2"),
+                   { charText(pos), QStringLiteral("'}'") }, pos);
+            children.setHasErrors();
+            return children.makeNode(Node::Kind::Object, pos, false);
+        }
+
+        const QChar ch = m_src[pos];
+        if (ch == u'}') {
+            if (commaPos != -1) {
+                report(QT_TR_NOOP("Trailing commas are not allowed"), {},
+                       commaPos);
+                children.setHasErrors();
+            }
+            ++m_index;
+            return children.makeNode(Node::Kind::Object, m_index);
+        } else if (ch == u',') {
+            if (expectsMember) {
+                report(QT_TR_NOOP("Unexpected %1, expecting a key"),
+                       { charText(pos) }, pos);
+                children.setHasErrors();
+            }
+            ++m_index;
+            expectsMember = true;
+            commaPos      = pos;
+            continue;
+        }
+
+        if (!expectsMember) {
+            report(QT_TR_NOOP("Unexpected %1, expecting %2"),
+                   { charText(pos), QStringLiteral("',' or '}'") }, pos);
+            children.setHasErrors();
+        }
+        if (ch == u'"') {
+            // Assume that a missing comma is before the key
+            children.add(pos, parseMember());
+        } else {
+            if (expectsMember) {
+                report(QT_TR_NOOP("Unexpected %1, expecting a key"),
+                       { charText(pos) }, pos);
+            }
+            children.add(pos, skipInvalid());
+        }
+        expectsMember = false;
+        commaPos      = -1;
+    }
+}
+
+NodePtr JsonParser::parseArray() {
+    const int start = m_index;
+    ChildList children(start);
+    bool      expectsValue = true;
+    int       commaPos     = -1;
+
+    ++m_index;
+    while (true) {
+        skipTrivia();
+
+        const int pos = m_index;
+        if (atEnd() || (m_src[pos] == u'}')) {
+            report(QT_TR_NOOP("Unexpected %1, expecting %2"),
+                   { charText(pos), QStringLiteral("']'") }, pos);
+            children.setHasErrors();
+            return children.makeNode(Node::Kind::Array, pos, false);
+        }
+
+        const QChar ch = m_src[pos];
+        if (ch == u']') {
+            if (commaPos != -1) {
+                report(QT_TR_NOOP("Trailing commas are not allowed"), {},
+                       commaPos);
+                children.setHasErrors();
+            }
+            ++m_index;
+            return children.makeNode(Node::Kind::Array, m_index);
+        } else if (ch == u',') {
+            if (expectsValue) {
+                report(QT_TR_NOOP("Unexpected %1, expecting a value"),
+                       { charText(pos) }, pos);
+                children.setHasErrors();
+            }
+            ++m_index;
+            expectsValue = true;
+            commaPos     = pos;
+            continue;
+        }
+
+        NodePtr &&value = parseValue();
+        if (!expectsValue) {
+            report(QT_TR_NOOP("Unexpected %1, expecting %2"),
+                   { charText(pos), QStringLiteral("',' or ']'") }, pos);
+            children.setHasErrors();
+        } else if (!value) {
+            report(QT_TR_NOOP("Unexpected %1, expecting a value"),
+                   { charText(pos) }, pos);
+        }
+        children.add(pos, value ? std::move(value) : skipInvalid());
+        expectsValue = false;
+        commaPos     = -1;
+    }
+}
+
+/*!
+ * \brief Parses a key, a colon and a value. The member ends after the last
+ * of them which is present.
+ */
+NodePtr JsonParser::parseMember() {
+    const int start = m_index;
+    ChildList children(start);
+
+    children.add(start, parseString());
+    int end = m_index;
+
+    skipTrivia();
+    if (peekChar() == u':') {
+        ++m_index;
+        end = m_index;
+        skipTrivia();
+    } else {
+        report(QT_TR_NOOP("Unexpected %1, expecting %2"),
+               { charText(m_index), QStringLiteral("':'") }, m_index);
+        children.setHasErrors();
+    }
+
+    const int valuePos = m_index;
+    if ((peekChar() != u',') && (peekChar() != u'}')) {
+        if (NodePtr &&value = parseValue()) {
+            children.add(valuePos, std::move(value));
+            return children.makeNode(Node::Kind::Member, m_index);
+        }
+    }
+    report(QT_TR_NOOP("Unexpected %1, expecting a value"),
+           { charText(valuePos) }, valuePos);
+    children.setHasErrors();
+    return children.makeNode(Node::Kind::Member, end);
+}
+
+/*!
+ * \brief Parses a quoted string. An unterminated string ends at the end of
+ * its line.
+ */
+NodePtr JsonParser::parseString() {
+    const int start     = m_index;
+    bool      hasErrors = false;
+
+    ++m_index;
+    while (!atEnd()) {
+        const QChar ch = m_src[m_index];
+        if (ch == u'"') {
+            ++m_index;
+            return NodePtr::create(Node::Kind::String, m_index - start,
+                                   Node::Children(), hasErrors);
+        } else if ((ch == u'\n') || (ch == u'\r')) {
+            break;
+        } else if (ch == u'\\') {
+            const QChar escaped = (m_index + 1 < m_src.size())
+                                      ? m_src[m_index + 1] : QChar();
+            int length = 2;
+            switch (escaped.unicode()) {
+                case u'"':
+                case u'\\':
+                case u'/':
+                case u'b':
+                case u'f':
+                case u'n':
+                case u'r':
+                case u't':
+                    break;
+
+                case u'u': {
+                    const auto &&hex = m_src.mid(m_index + 2, 4);
+                    bool         ok  = hex.size() == 4;
+                    for (const QChar digit: hex) {
+                        ok = ok && (isDigit(digit)
+                                    || ((digit.toLower() >= u'a')
+                                        && (digit.toLower() <= u'f')));
+                    }
+                    length = ok ? 6 : 2;
+                    if (ok) {
+                        break;
+                    }
+                    Q_FALLTHROUGH();
+                }
+
+                default: {
+                    report(QT_TR_NOOP("Invalid escape sequence: %1"),
+                           { m_src.mid(m_index, 2).toString() }, m_index, 2);
+                    hasErrors = true;
+                }
+            }
+            m_index = qMin(m_index + length, int(m_src.size()));
+            continue;
+        } else if (ch < u' ') {
+            report(QT_TR_NOOP("Control characters must be escaped"), {},
+                   m_index);
+            hasErrors = true;
+        }
+        ++m_index;
+    }
+
+    report(QT_TR_NOOP("Incomplete quoted string"), {}, start,
+           m_index - start);
+    return NodePtr::create(Node::Kind::String, m_index - start,
+                           Node::Children(), true, false);
+}
+
+NodePtr JsonParser::parseNumber() {
+    const int start = m_index;
+
+    auto &&skipDigits = [this]() {
+        const int digitsStart = m_index;
+        while (!atEnd() && isDigit(m_src[m_index])) {
+            ++m_index;
+        }
+        return m_index - digitsStart;
+    };
+
+    if (peekChar() == u'-') {
+        ++m_index;
+    }
+    bool ok = true;
+    if (peekChar() == u'0') {
+        ++m_index;
+    } else {
+        ok = skipDigits() > 0;
+    }
+    if (ok && (peekChar() == u'.')) {
+        ++m_index;
+        ok = skipDigits() > 0;
+    }
+    if (ok && ((peekChar() == u'e') || (peekChar() == u'E'))) {
+        ++m_index;
+        if ((peekChar() == u'+') || (peekChar() == u'-')) {
+            ++m_index;
+        }
+        ok = skipDigits() > 0;
+    }
+
+    // Take the rest of the token, such as the letters of "1st"
+    while (!atEnd() && !isDelimiter(m_src[m_index])) {
+        ok = false;
+        ++m_index;
+    }
+    if (!ok) {
+        report(QT_TR_NOOP("Invalid number: %1"),
+               { m_src.mid(start, m_index - start).toString() },
+               start, m_index - start);
+        return NodePtr::create(Node::Kind::Error, m_index - start,
+                               Node::Children(), true);
+    }
+    return NodePtr::create(Node::Kind::Number, m_index - start);
+}
+
+/*!
+ * \brief Parses \c true, \c false or \c null.
+ */
+NodePtr JsonParser::parseWord() {
+    const int start = m_index;
+
+    while (!atEnd() && !isDelimiter(m_src[m_index])) {
+        ++m_index;
+    }
+
+    const auto &&word = m_src.mid(start, m_index - start);
+    if (word == u"true") {
+        return NodePtr::create(Node::Kind::True, word.size());
+    } else if (word == u"false") {
+        return NodePtr::create(Node::Kind::False, word.size());
+    } else if (word == u"null") {
+        return NodePtr::create(Node::Kind::Null, word.size());
+    }
+    report(QT_TR_NOOP("Unexpected %1, expecting a value"),
+           { word.toString() }, start, word.size());
+    return NodePtr::create(Node::Kind::Error, word.size(), Node::Children(),
+                           true);
+}
+
+/*!
+ * \brief Skips the characters until the next delimiter, but at least one
+ * character, and returns them as an error node.
+ */
+NodePtr JsonParser::skipInvalid() {
+    const int start = m_index;
+
+    do {
+        ++m_index;
+    } while (!atEnd() && !isDelimiter(m_src[m_index]));
+    return NodePtr::create(Node::Kind::Error, m_index - start, Node::Children(),
+                           true);
+}
+
+/*!
+ * \brief Skips whitespaces and comments.
+ */
+void JsonParser::skipTrivia() {
+    while (!atEnd()) {
+        const QChar ch = m_src[m_index];
+        if (ch.isSpace()) {
+            ++m_index;
+        } else if ((ch == u'/') && (m_index + 1 < m_src.size())
+                   && (m_src[m_index + 1] == u'/')) {
+            const int lineEnd = m_src.indexOf(u'\n', m_index);
+            m_index = (lineEnd == -1) ? m_src.size() : lineEnd;
+        } else if ((ch == u'/') && (m_index + 1 < m_src.size())
+                   && (m_src[m_index + 1] == u'*')) {
+            const int commentEnd = m_src.indexOf(u"*/", m_index + 2);
+            if (commentEnd == -1) {
+                report(QT_TR_NOOP("Incomplete comment"), {}, m_index,
+                       m_src.size() - m_index);
+                m_index = m_src.size();
+            } else {
+                m_index = commentEnd + 2;
+            }
+        } else {
+            break;
+        }
+    }
+}
+
+/*!
+ * \brief Returns the largest value of the previous syntax tree which starts
+ * at the current position and whose text, with the character after it, is
+ * outside of the edited range. Values with errors aren't reused, since their
+ * errors would be lost.
+ */
+NodePtr JsonParser::reusableNode() const {
+    if (!m_edit || !m_tree) {
+        return nullptr;
+    }
+
+    const auto &edit         = *m_edit;
+    const bool  isBeforeEdit = m_index < edit.pos;
+    int         oldPos       = m_index;
+    if (!isBeforeEdit) {
+        if (m_index < edit.pos + edit.charsAdded) {
+            return nullptr;
+        }
+        oldPos += edit.charsRemoved - edit.charsAdded;
+    }
+
+    const NodePtr *node  = &m_tree;
+    int            start = 0;
+    while (true) {
+        const auto &children = (*node)->children();
+        const auto &&it      = std::upper_bound(
+            children.cbegin(), children.cend(), oldPos - start,
+            [](const int offset, const Node::Child &child) {
+            return offset < child.offset;
+        });
+        if (it == children.cbegin()) {
+            return nullptr;
+        }
+
+        const auto &child      = *(it - 1);
+        const int   childStart = start + child.offset;
+        const int   childEnd   = childStart + child.node->length();
+        if (oldPos >= childEnd) {
+            return nullptr;
+        }
+        if ((childStart == oldPos) && child.node->isValue()
+            && !child.node->hasErrors()
+            && (!isBeforeEdit || (childEnd < edit.pos))) {
+            return child.node;
+        }
+        node  = &child.node;
+        start = childStart;
+    }
+}
+
+QString JsonParser::charText(const int index) const {
+    if (index >= m_src.size()) {
+        return QStringLiteral("EOF");
+    }
+    return '\''_QL1 + m_src[index] + '\''_QL1;
+}
+
+void JsonParser::report(const char *msg, const QVariantList &args,
+                        const int pos, const int length) {
+    if (m_errors.size() < maxErrorCount) {
+        reportError(msg, args, pos, length);
+    }
 }
@@ -2,13 +2,59 @@
 #define JSONPARSER_H
 
 #include "parser.h"
+#include "jsonnode.h"
 
 class JsonParser : public Parser {
 public:
     JsonParser();
 
+    Json::NodePtr syntaxTree() const;
+
+    bool reparse(const QString &text, const int position,
+                 const int charsRemoved, const int charsAdded);
+
 protected:
     bool parseImpl() final;
+
+private:
+    /*!
+     * \brief An edit of the text of the previous syntax tree, in the same way
+     * as QTextDocument::contentsChange().
+     */
+    struct Edit {
+        int pos          = 0;
+        int charsRemoved = 0;
+        int charsAdded   = 0;
+    };
+
+    Json::NodePtr m_tree;
+    QString m_treeText;
+    std::optional<Edit> m_edit;
+    QStringView m_src;
+    int m_index     = 0;
+    int m_nodeCount = 0;
+
+    Json::NodePtr parseDocument();
+    Json::NodePtr parseValue();
+    Json::NodePtr parseObject();
+    Json::NodePtr parseArray();
+    Json::NodePtr parseMember();
+    Json::NodePtr parseString();
+    Json::NodePtr parseNumber();
+    Json::NodePtr parseWord();
+    Json::NodePtr skipInvalid();
+    void skipTrivia();
+    Json::NodePtr reusableNode() const;
+
+    bool atEnd() const {
+        return m_index >= m_src.size();
+    }
+    QChar peekChar() const {
+        return atEnd() ? QChar() : m_src[m_index];
+    }
+    QString charText(const int index) const;
+    void report(const char *msg, const QVariantList &args,
+                const int pos, const int length = 1);
 };
 
 #endif // JSONPARSER_H
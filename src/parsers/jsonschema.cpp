@@ -0,0 +1,966 @@
+#include "jsonschema.h"
+
+#include "game.h"
+
+#include <QMutex>
+
+#include <algorithm>
+
+namespace {
+    QMutex                                  schemaCacheMutex;
+    QHash<QString, QSharedPointer<Json::Schema> > schemaCache;
+
+    QStringView withoutVanillaNamespace(QStringView id) {
+        return id.startsWith(u"minecraft:") ? id.mid(10) : id;
+    }
+
+    template<typename T>
+    const T *findByName(const QVector<T> &table, const int begin,
+                        const int end, QStringView name) {
+        const auto *first = table.constData() + begin;
+        const auto *last  = table.constData() + end;
+        const auto *it    = std::lower_bound(
+            first, last, name, [](const T &a, QStringView b) {
+            return QStringView(a.name).compare(b) < 0;
+        });
+
+        return ((it != last) && (it->name == name)) ? it : nullptr;
+    }
+}
+
+namespace Json {
+    /*!
+     * \internal
+     * \brief Compiles the schema of a game version.
+     */
+    class SchemaBuilder {
+public:
+        using Type     = Schema::Type;
+        using Property = Schema::Property;
+        using Props    = QVector<Property>;
+        using Cases    = QVector<QPair<QString, Props> >;
+
+        SchemaBuilder(Schema *schema, const QVersionNumber &version);
+
+        void build();
+
+private:
+        Schema *m_schema;
+        QVersionNumber m_version;
+        int m_any            = 0;
+        int m_bool           = 0;
+        int m_number         = 0;
+        int m_integer        = 0;
+        int m_string         = 0;
+        int m_object         = 0;
+        int m_numberProvider = 0;
+        int m_intRange       = 0;
+        int m_entityTarget   = 0;
+        int m_condition      = 0;
+        int m_conditions     = 0;
+        int m_function       = 0;
+        int m_functions      = 0;
+        int m_entry          = 0;
+
+        static Property required(const QString &name, const int type) {
+            return { name, type, true };
+        }
+        static Property optional(const QString &name, const int type) {
+            return { name, type, false };
+        }
+
+        int add(const Schema::Node &node);
+        int simple(const Type type);
+        int number(const Type type, const double min = -qInf(),
+                   const double max = qInf());
+        int enumOf(QStringList values, const bool isId = false);
+        int arrayOf(const int items, const int minItems = 0);
+        int object(Props props, const bool isClosed = true,
+                   const int otherKeys = -1);
+        int mapOf(const int valueType);
+        int oneOf(const QVector<int> &types);
+        int dispatch(const QString &key, const Cases &cases,
+                     const Props &common = {}, const bool isClosed = true,
+                     const int defaultCase = -1);
+        int reserve();
+        void define(const int index, const int type);
+        void setRoot(const CodeFile::FileType fileType, const int type);
+
+        void buildLootTables();
+        void buildConditions();
+        void buildFunctions();
+        void buildRecipes();
+        void buildTags();
+        void buildWorldGen();
+        void buildMisc();
+    };
+
+    SchemaBuilder::SchemaBuilder(Schema *schema, const QVersionNumber &version)
+        : m_schema(schema), m_version(version) {
+    }
+
+    void SchemaBuilder::build() {
+        m_any     = simple(Type::Any);
+        m_bool    = simple(Type::Boolean);
+        m_number  = simple(Type::Number);
+        m_integer = simple(Type::Integer);
+        m_string  = simple(Type::String);
+        m_object  = object({}, false);
+
+        // Number providers, which were random ranges before 1.17
+        m_numberProvider = reserve();
+        Cases providers{
+            { QStringLiteral("constant"),
+              { required(QStringLiteral("value"), m_number) } },
+            { QStringLiteral("uniform"),
+              { required(QStringLiteral("min"), m_numberProvider),
+                required(QStringLiteral("max"), m_numberProvider) } },
+            { QStringLiteral("binomial"),
+              { required(QStringLiteral("n"), m_numberProvider),
+                required(QStringLiteral("p"), m_numberProvider) } },
+        };
+        if (m_version >= Game::v1_17) {
+            providers.append(
+                { QStringLiteral("score"),
+                  { required(QStringLiteral("target"), m_any),
+                    required(QStringLiteral("score"), m_string),
+                    optional(QStringLiteral("scale"), m_number) } });
+        }
+        // Objects without a type are uniform distributions
+        const int untypedRange = object({
+            required(QStringLiteral("min"), m_numberProvider),
+            required(QStringLiteral("max"), m_numberProvider) });
+        define(m_numberProvider, oneOf({
+            m_number, dispatch(QStringLiteral("type"), providers, {}, true,
+                               untypedRange) }));
+
+        m_intRange = oneOf({
+            m_number,
+            object({ optional(QStringLiteral("min"), m_numberProvider),
+                     optional(QStringLiteral("max"), m_numberProvider) }) });
+        m_entityTarget = enumOf({ QStringLiteral("this"),
+                                  QStringLiteral("killer"),
+                                  QStringLiteral("direct_killer"),
+                                  QStringLiteral("killer_player") });
+
+        buildConditions();
+        buildFunctions();
+        buildLootTables();
+        buildRecipes();
+        buildTags();
+        buildWorldGen();
+        buildMisc();
+
+        m_schema->m_nodes.squeeze();
+        m_schema->m_properties.squeeze();
+        m_schema->m_values.squeeze();
+        m_schema->m_alternatives.squeeze();
+    }
+
+    int SchemaBuilder::add(const Schema::Node &node) {
+        m_schema->m_nodes << node;
+        return m_schema->m_nodes.size() - 1;
+    }
+
+    int SchemaBuilder::simple(const Type type) {
+        Schema::Node node;
+
+        node.type = type;
+        return add(node);
+    }
+
+    int SchemaBuilder::number(const Type type, const double min,
+                              const double max) {
+        Schema::Node node;
+
+        node.type = type;
+        node.min  = min;
+        node.max  = max;
+        return add(node);
+    }
+
+    int SchemaBuilder::enumOf(QStringList values, const bool isId) {
+        Schema::Node node;
+
+        std::sort(values.begin(), values.end());
+        node.type  = Type::String;
+        node.isId  = isId;
+        node.begin = m_schema->m_values.size();
+        for (const auto &value: qAsConst(values)) {
+            m_schema->m_values << value;
+        }
+        node.end = m_schema->m_values.size();
+        return add(node);
+    }
+
+    int SchemaBuilder::arrayOf(const int items, const int minItems) {
+        Schema::Node node;
+
+        node.type     = Type::Array;
+        node.items    = items;
+        node.minItems = minItems;
+        return add(node);
+    }
+
+    /*!
+     * \brief Adds an object type with the \a props. Keys which aren't in
+     * the \a props are reported if the object \a isClosed, unless they have
+     * the type of \a otherKeys.
+     */
+    int SchemaBuilder::object(Props props, const bool isClosed,
+                              const int otherKeys) {
+        Schema::Node node;
+
+        std::sort(props.begin(), props.end(),
+                  [](const Property &a, const Property &b) {
+            return a.name < b.name;
+        });
+        node.type     = Type::Object;
+        node.isClosed = isClosed && (otherKeys == -1);
+        node.items    = otherKeys;
+        node.begin    = m_schema->m_properties.size();
+        m_schema->m_properties << props;
+        node.end = m_schema->m_properties.size();
+        return add(node);
+    }
+
+    int SchemaBuilder::mapOf(const int valueType) {
+        return object({}, false, valueType);
+    }
+
+    int SchemaBuilder::oneOf(const QVector<int> &types) {
+        Schema::Node node;
+
+        node.type  = Type::Union;
+        node.begin = m_schema->m_alternatives.size();
+        m_schema->m_alternatives << types;
+        node.end = m_schema->m_alternatives.size();
+        return add(node);
+    }
+
+    /*!
+     * \brief Adds an object type whose other keys depend on the value of
+     * the \a key, which names one of the \a cases. Each case also has the
+     * \a common properties, which are all that is checked if the value is
+     * unknown. Objects without the key have the type of \a defaultCase, or
+     * the key is required if it's -1.
+     */
+    int SchemaBuilder::dispatch(const QString &key, const Cases &cases,
+                                const Props &common, const bool isClosed,
+                                const int defaultCase) {
+        Props caseTypes;
+
+        caseTypes.reserve(cases.size());
+        for (const auto &pair: cases) {
+            const Props &&props = common + pair.second
+                                  + Props{ required(key, m_string) };
+            caseTypes << Property{ pair.first, object(props, isClosed) };
+        }
+        std::sort(caseTypes.begin(), caseTypes.end(),
+                  [](const Property &a, const Property &b) {
+            return a.name < b.name;
+        });
+
+        const int index = object(common + Props{ required(key, m_string) },
+                                 false);
+        auto     &node = m_schema->m_nodes[index];
+        node.isId        = true;
+        node.defaultCase = defaultCase;
+        node.dispatchKey = m_schema->m_values.size();
+        m_schema->m_values << key;
+        node.caseBegin = m_schema->m_properties.size();
+        m_schema->m_properties << caseTypes;
+        node.caseEnd = m_schema->m_properties.size();
+        return index;
+    }
+
+    /*!
+     * \brief Reserves a type which can be referred to before it's defined.
+     */
+    int SchemaBuilder::reserve() {
+        return simple(Type::Any);
+    }
+
+    void SchemaBuilder::define(const int index, const int type) {
+        m_schema->m_nodes[index] = m_schema->m_nodes.at(type);
+    }
+
+    void SchemaBuilder::setRoot(const CodeFile::FileType fileType,
+                                const int type) {
+        m_schema->m_roots.insert(fileType, type);
+    }
+
+    void SchemaBuilder::buildConditions() {
+        m_condition  = reserve();
+        m_conditions = arrayOf(m_condition);
+
+        const int terms = arrayOf(m_condition);
+        Cases     cases{
+            { QStringLiteral("block_state_property"),
+              { required(QStringLiteral("block"), m_string),
+                optional(QStringLiteral("properties"), m_object) } },
+            { QStringLiteral("damage_source_properties"),
+              { optional(QStringLiteral("predicate"), m_object) } },
+            { QStringLiteral("entity_properties"),
+              { required(QStringLiteral("entity"), m_entityTarget),
+                optional(QStringLiteral("predicate"), m_object) } },
+            { QStringLiteral("entity_scores"),
+              { required(QStringLiteral("entity"), m_entityTarget),
+                required(QStringLiteral("scores"), mapOf(m_intRange)) } },
+            { QStringLiteral("inverted"),
+              { required(QStringLiteral("term"), m_condition) } },
+            { QStringLiteral("killed_by_player"),
+              { optional(QStringLiteral("inverse"), m_bool) } },
+            { QStringLiteral("location_check"),
+              { optional(QStringLiteral("offsetX"), m_integer),
+                optional(QStringLiteral("offsetY"), m_integer),
+                optional(QStringLiteral("offsetZ"), m_integer),
+                optional(QStringLiteral("predicate"), m_object) } },
+            { QStringLiteral("match_tool"),
+              { optional(QStringLiteral("predicate"), m_object) } },
+            { QStringLiteral("random_chance"),
+              { required(QStringLiteral("chance"), m_number) } },
+            { QStringLiteral("random_chance_with_looting"),
+              { required(QStringLiteral("chance"), m_number),
+                required(QStringLiteral("looting_multiplier"), m_number) } },
+            { QStringLiteral("reference"),
+              { required(QStringLiteral("name"), m_string) } },
+            { QStringLiteral("survives_explosion"), {} },
+            { QStringLiteral("table_bonus"),
+              { required(QStringLiteral("enchantment"), m_string),
+                required(QStringLiteral("chances"), arrayOf(m_number, 1)) } },
+            { QStringLiteral("time_check"),
+              { required(QStringLiteral("value"), m_intRange),
+                optional(QStringLiteral("period"), m_integer) } },
+            { QStringLiteral("weather_check"),
+              { optional(QStringLiteral("raining"), m_bool),
+                optional(QStringLiteral("thundering"), m_bool) } },
+        };
+        if (m_version >= Game::v1_17) {
+            cases.append({ QStringLiteral("value_check"),
+                           { required(QStringLiteral("value"),
+                                      m_numberProvider),
+                             required(QStringLiteral("range"),
+                                      m_intRange) } });
+        }
+        if (m_version >= Game::v1_20) {
+            cases.append({ QStringLiteral("all_of"),
+                           { required(QStringLiteral("terms"), terms) } });
+            cases.append({ QStringLiteral("any_of"),
+                           { required(QStringLiteral("terms"), terms) } });
+        } else {
+            cases.append({ QStringLiteral("alternative"),
+                           { required(QStringLiteral("terms"), terms) } });
+        }
+        define(m_condition, dispatch(QStringLiteral("condition"), cases));
+
+        if (m_version >= Game::v1_16) {
+            setRoot(CodeFile::Predicate,
+                    oneOf({ m_condition, arrayOf(m_condition) }));
+        } else {
+            setRoot(CodeFile::Predicate, m_condition);
+        }
+    }
+
+    void SchemaBuilder::buildFunctions() {
+        m_function  = reserve();
+        m_functions = arrayOf(m_function);
+        m_entry     = reserve();
+
+        const int source = enumOf({ QStringLiteral("this"),
+                                    QStringLiteral("killer"),
+                                    QStringLiteral("killer_player"),
+                                    QStringLiteral("block_entity") });
+        const int nbtOperation = object({
+            required(QStringLiteral("source"), m_string),
+            required(QStringLiteral("target"), m_string),
+            required(QStringLiteral("op"),
+                     enumOf({ QStringLiteral("replace"),
+                              QStringLiteral("append"),
+                              QStringLiteral("merge") })) });
+        const int attributeModifier = object({
+            required(QStringLiteral("name"), m_string),
+            required(QStringLiteral("attribute"), m_string),
+            required(QStringLiteral("operation"),
+                     enumOf({ QStringLiteral("addition"),
+                              QStringLiteral("multiply_base"),
+                              QStringLiteral("multiply_total") })),
+            required(QStringLiteral("amount"), m_numberProvider),
+            optional(QStringLiteral("id"), m_string),
+            optional(QStringLiteral("slot"), m_any) });
+        const int bannerPattern = object({
+            required(QStringLiteral("pattern"), m_string),
+            required(QStringLiteral("color"), m_string) });
+        const int stewEffect = object({
+            required(QStringLiteral("type"), m_string),
+            required(QStringLiteral("duration"), m_numberProvider) });
+
+        Cases cases{
+            { QStringLiteral("apply_bonus"),
+              { required(QStringLiteral("enchantment"), m_string),
+                required(QStringLiteral("formula"),
+                         enumOf({ QStringLiteral("binomial_with_bonus_count"),
+                                  QStringLiteral("uniform_bonus_count"),
+                                  QStringLiteral("ore_drops") }, true)),
+                optional(QStringLiteral("parameters"), m_object) } },
+            { QStringLiteral("copy_name"),
+              { required(QStringLiteral("source"), source) } },
+            { QStringLiteral("copy_nbt"),
+              { required(QStringLiteral("source"), m_any),
+                required(QStringLiteral("ops"), arrayOf(nbtOperation)) } },
+            { QStringLiteral("copy_state"),
+              { required(QStringLiteral("block"), m_string),
+                required(QStringLiteral("properties"),
+                         arrayOf(m_string)) } },
+            { QStringLiteral("enchant_randomly"),
+              { optional(QStringLiteral("enchantments"),
+                         arrayOf(m_string)) } },
+            { QStringLiteral("enchant_with_levels"),
+              { required(QStringLiteral("levels"), m_numberProvider),
+                optional(QStringLiteral("treasure"), m_bool) } },
+            { QStringLiteral("exploration_map"),
+              { optional(QStringLiteral("destination"), m_string),
+                optional(QStringLiteral("decoration"), m_string),
+                optional(QStringLiteral("zoom"), m_integer),
+                optional(QStringLiteral("search_radius"), m_integer),
+                optional(QStringLiteral("skip_existing_chunks"), m_bool) } },
+            { QStringLiteral("explosion_decay"), {} },
+            { QStringLiteral("fill_player_head"),
+              { required(QStringLiteral("entity"), m_entityTarget) } },
+            { QStringLiteral("furnace_smelt"), {} },
+            { QStringLiteral("limit_count"),
+              { required(QStringLiteral("limit"), m_intRange) } },
+            { QStringLiteral("looting_enchant"),
+              { required(QStringLiteral("count"), m_numberProvider),
+                optional(QStringLiteral("limit"), m_integer) } },
+            { QStringLiteral("set_attributes"),
+              { required(QStringLiteral("modifiers"),
+                         arrayOf(attributeModifier)),
+                optional(QStringLiteral("replace"), m_bool) } },
+            { QStringLiteral("set_banner_pattern"),
+              { required(QStringLiteral("patterns"), arrayOf(bannerPattern)),
+                optional(QStringLiteral("append"), m_bool) } },
+            { QStringLiteral("set_contents"),
+              { required(QStringLiteral("entries"), arrayOf(m_entry)),
+                optional(QStringLiteral("type"), m_string) } },
+            { QStringLiteral("set_count"),
+              { required(QStringLiteral("count"), m_numberProvider),
+                optional(QStringLiteral("add"), m_bool) } },
+            { QStringLiteral("set_damage"),
+              { required(QStringLiteral("damage"), m_numberProvider),
+                optional(QStringLiteral("add"), m_bool) } },
+            { QStringLiteral("set_enchantments"),
+              { required(QStringLiteral("enchantments"),
+                         mapOf(m_numberProvider)),
+                optional(QStringLiteral("add"), m_bool) } },
+            { QStringLiteral("set_loot_table"),
+              { required(QStringLiteral("name"), m_string),
+                optional(QStringLiteral("seed"), m_integer),
+                optional(QStringLiteral("type"), m_string) } },
+            { QStringLiteral("set_lore"),
+              { required(QStringLiteral("lore"), arrayOf(m_any)),
+                optional(QStringLiteral("entity"), m_entityTarget),
+                optional(QStringLiteral("replace"), m_bool) } },
+            { QStringLiteral("set_name"),
+              { required(QStringLiteral("name"), m_any),
+                optional(QStringLiteral("entity"), m_entityTarget) } },
+            { QStringLiteral("set_nbt"),
+              { required(QStringLiteral("tag"), m_string) } },
+            { QStringLiteral("set_stew_effect"),
+              { optional(QStringLiteral("effects"), arrayOf(stewEffect)) } },
+        };
+        if (m_version >= Game::v1_19) {
+            cases.append({ QStringLiteral("set_instrument"),
+                           { required(QStringLiteral("options"),
+                                      m_string) } });
+        }
+        if (m_version >= Game::v1_20) {
+            cases.append({ QStringLiteral("set_potion"),
+                           { required(QStringLiteral("id"), m_string) } });
+        }
+        if (m_version >= Game::v1_20_2) {
+            cases.append({ QStringLiteral("reference"),
+                           { required(QStringLiteral("name"), m_string) } });
+            cases.append({ QStringLiteral("sequence"),
+                           { required(QStringLiteral("functions"),
+                                      m_functions) } });
+        }
+        define(m_function, dispatch(
+                   QStringLiteral("function"), cases,
+                   { optional(QStringLiteral("conditions"), m_conditions) }));
+
+        if (m_version >= Game::v1_17) {
+            setRoot(CodeFile::ItemModifier,
+                    oneOf({ m_function, arrayOf(m_function) }));
+        }
+    }
+
+    void SchemaBuilder::buildLootTables() {
+        const Props singleton{
+            optional(QStringLiteral("weight"), m_integer),
+            optional(QStringLiteral("quality"), m_integer),
+            optional(QStringLiteral("functions"), m_functions),
+        };
+        const Props composite{
+            required(QStringLiteral("children"), arrayOf(m_entry)),
+        };
+
+        define(m_entry, dispatch(
+                   QStringLiteral("type"), {
+            { QStringLiteral("item"),
+              singleton + Props{ required(QStringLiteral("name"),
+                                          m_string) } },
+            { QStringLiteral("tag"),
+              singleton + Props{ required(QStringLiteral("name"), m_string),
+                                 required(QStringLiteral("expand"),
+                                          m_bool) } },
+            { QStringLiteral("loot_table"),
+              singleton + Props{ required(QStringLiteral("name"),
+                                          m_string) } },
+            { QStringLiteral("dynamic"),
+              singleton + Props{ required(QStringLiteral("name"),
+                                          m_string) } },
+            { QStringLiteral("empty"), singleton },
+            { QStringLiteral("alternatives"), composite },
+            { QStringLiteral("group"), composite },
+            { QStringLiteral("sequence"), composite },
+        }, { optional(QStringLiteral("conditions"), m_conditions) }));
+
+        const int pool = object({
+            required(QStringLiteral("rolls"), m_numberProvider),
+            optional(QStringLiteral("bonus_rolls"), m_numberProvider),
+            required(QStringLiteral("entries"), arrayOf(m_entry)),
+            optional(QStringLiteral("conditions"), m_conditions),
+            optional(QStringLiteral("functions"), m_functions),
+            optional(QStringLiteral("name"), m_string) });
+
+        setRoot(CodeFile::LootTable, object({
+            optional(QStringLiteral("type"), m_string),
+            optional(QStringLiteral("pools"), arrayOf(pool)),
+            optional(QStringLiteral("functions"), m_functions),
+            optional(QStringLiteral("random_sequence"), m_string) }));
+    }
+
+    void SchemaBuilder::buildRecipes() {
+        const int ingredientObject = object({
+            optional(QStringLiteral("item"), m_string),
+            optional(QStringLiteral("tag"), m_string) });
+        const int ingredient = oneOf({ ingredientObject,
+                                       arrayOf(ingredientObject, 1) });
+        const int result = object({
+            required(QStringLiteral("item"), m_string),
+            optional(QStringLiteral("count"),
+                     number(Type::Integer, 1, 64)) });
+
+        Props common{ optional(QStringLiteral("group"), m_string) };
+        Props craftingCommon = common;
+        Props cookingCommon  = common;
+        if (m_version >= Game::v1_19_3) {
+            craftingCommon << optional(
+                QStringLiteral("category"),
+                enumOf({ QStringLiteral("building"),
+                         QStringLiteral("redstone"),
+                         QStringLiteral("equipment"),
+                         QStringLiteral("misc") }));
+            cookingCommon << optional(
+                QStringLiteral("category"),
+                enumOf({ QStringLiteral("food"),
+                         QStringLiteral("blocks"),
+                         QStringLiteral("misc") }));
+        }
+
+        const Props cooking = cookingCommon + Props{
+            required(QStringLiteral("ingredient"), ingredient),
+            required(QStringLiteral("result"), m_string),
+            optional(QStringLiteral("experience"), m_number),
+            optional(QStringLiteral("cookingtime"), m_integer),
+        };
+        Props shaped = craftingCommon + Props{
+            required(QStringLiteral("pattern"), arrayOf(m_string, 1)),
+            required(QStringLiteral("key"), mapOf(ingredient)),
+            required(QStringLiteral("result"), result),
+        };
+        if (m_version >= Game::v1_20) {
+            shaped << optional(QStringLiteral("show_notification"), m_bool);
+        }
+
+        Cases cases{
+            { QStringLiteral("crafting_shaped"), shaped },
+            { QStringLiteral("crafting_shapeless"),
+              craftingCommon + Props{
+                  required(QStringLiteral("ingredients"),
+                           arrayOf(ingredient, 1)),
+                  required(QStringLiteral("result"), result) } },
+            { QStringLiteral("smelting"), cooking },
+            { QStringLiteral("blasting"), cooking },
+            { QStringLiteral("smoking"), cooking },
+            { QStringLiteral("campfire_cooking"), cooking },
+            { QStringLiteral("stonecutting"),
+              common + Props{
+                  required(QStringLiteral("ingredient"), ingredient),
+                  required(QStringLiteral("result"), m_string),
+                  required(QStringLiteral("count"), m_integer) } },
+        };
+
+        const Props smithingCommon{
+            required(QStringLiteral("template"), ingredient),
+            required(QStringLiteral("base"), ingredient),
+            required(QStringLiteral("addition"), ingredient),
+        };
+        if (m_version < Game::v1_20) {
+            cases.append({ QStringLiteral("smithing"),
+                           { required(QStringLiteral("base"), ingredient),
+                             required(QStringLiteral("addition"), ingredient),
+                             required(QStringLiteral("result"), result) } });
+        }
+        if (m_version >= Game::v1_19_4) {
+            cases.append({ QStringLiteral("smithing_transform"),
+                           smithingCommon
+                           + Props{ required(QStringLiteral("result"),
+                                             result) } });
+            cases.append({ QStringLiteral("smithing_trim"), smithingCommon });
+        }
+
+        QStringList specialTypes{
+            QStringLiteral("crafting_special_armordye"),
+            QStringLiteral("crafting_special_banneraddpattern"),
+            QStringLiteral("crafting_special_bannerduplicate"),
+            QStringLiteral("crafting_special_bookcloning"),
+            QStringLiteral("crafting_special_firework_rocket"),
+            QStringLiteral("crafting_special_firework_star"),
+            QStringLiteral("crafting_special_firework_star_fade"),
+            QStringLiteral("crafting_special_mapcloning"),
+            QStringLiteral("crafting_special_mapextending"),
+            QStringLiteral("crafting_special_repairitem"),
+            QStringLiteral("crafting_special_shielddecoration"),
+            QStringLiteral("crafting_special_shulkerboxcoloring"),
+            QStringLiteral("crafting_special_suspiciousstew"),
+            QStringLiteral("crafting_special_tippedarrow"),
+        };
+        if (m_version >= Game::v1_20) {
+            specialTypes << QStringLiteral("crafting_decorated_pot");
+        }
+        for (const auto &type: qAsConst(specialTypes)) {
+            cases.append({ type, craftingCommon });
+        }
+
+        setRoot(CodeFile::Recipe, dispatch(QStringLiteral("type"), cases));
+    }
+
+    void SchemaBuilder::buildTags() {
+        const int tagEntry = oneOf({
+            m_string,
+            object({ required(QStringLiteral("id"), m_string),
+                     optional(QStringLiteral("required"), m_bool) }) });
+        const int tag = object({
+            optional(QStringLiteral("replace"), m_bool),
+            required(QStringLiteral("values"), arrayOf(tagEntry)) });
+
+        for (int type = CodeFile::Tag; type < CodeFile::Tag_end; ++type) {
+            setRoot(static_cast<CodeFile::FileType>(type), tag);
+        }
+    }
+
+    /*!
+     * \brief Builds the top-level structures of the world generation files.
+     * The configurations of the features and so on are only checked to be
+     * objects, since they vary too much between versions.
+     */
+    void SchemaBuilder::buildWorldGen() {
+        if (m_version < Game::v1_16) {
+            return;
+        }
+
+        const int typedConfig = object({
+            required(QStringLiteral("type"), m_string),
+            required(QStringLiteral("config"), m_object) });
+
+        const int generator = dispatch(QStringLiteral("type"), {
+            { QStringLiteral("noise"),
+              { required(QStringLiteral("settings"), m_any),
+                required(QStringLiteral("biome_source"), m_object) } },
+            { QStringLiteral("flat"),
+              { required(QStringLiteral("settings"), m_object) } },
+            { QStringLiteral("debug"), {} },
+        }, {}, false);
+        setRoot(CodeFile::Dimension, object({
+            required(QStringLiteral("type"), m_any),
+            required(QStringLiteral("generator"), generator) }, false));
+
+        Props dimensionType{
+            required(QStringLiteral("ultrawarm"), m_bool),
+            required(QStringLiteral("natural"), m_bool),
+            required(QStringLiteral("coordinate_scale"), m_number),
+            required(QStringLiteral("has_skylight"), m_bool),
+            required(QStringLiteral("has_ceiling"), m_bool),
+            required(QStringLiteral("ambient_light"), m_number),
+            optional(QStringLiteral("fixed_time"), m_integer),
+            required(QStringLiteral("piglin_safe"), m_bool),
+            required(QStringLiteral("bed_works"), m_bool),
+            required(QStringLiteral("respawn_anchor_works"), m_bool),
+            required(QStringLiteral("has_raids"), m_bool),
+            required(QStringLiteral("logical_height"), m_integer),
+            required(QStringLiteral("infiniburn"), m_string),
+            optional(QStringLiteral("effects"), m_string),
+        };
+        if (m_version >= Game::v1_17) {
+            dimensionType << required(QStringLiteral("min_y"), m_integer)
+                          << required(QStringLiteral("height"), m_integer);
+        }
+        if (m_version >= Game::v1_19) {
+            dimensionType
+                << required(QStringLiteral("monster_spawn_light_level"), m_any)
+                << required(QStringLiteral("monster_spawn_block_light_limit"),
+                            m_integer);
+        }
+        setRoot(CodeFile::DimensionType, object(dimensionType, false));
+
+        Props biome{
+            required(QStringLiteral("temperature"), m_number),
+            required(QStringLiteral("downfall"), m_number),
+            required(QStringLiteral("effects"), m_object),
+            optional(QStringLiteral("temperature_modifier"),
+                     enumOf({ QStringLiteral("none"),
+                              QStringLiteral("frozen") })),
+            required(QStringLiteral("spawners"), m_object),
+            required(QStringLiteral("spawn_costs"), m_object),
+            required(QStringLiteral("carvers"), m_any),
+            required(QStringLiteral("features"), arrayOf(m_any)),
+        };
+        if (m_version >= Game::v1_19_4) {
+            biome << required(QStringLiteral("has_precipitation"), m_bool);
+        } else {
+            biome << required(QStringLiteral("precipitation"),
+                              enumOf({ QStringLiteral("none"),
+                                       QStringLiteral("rain"),
+                                       QStringLiteral("snow") }));
+        }
+        setRoot(CodeFile::Biome, object(biome, false));
+
+        setRoot(CodeFile::ConfiguredCarver, typedConfig);
+        setRoot(CodeFile::ConfiguredFeature, typedConfig);
+        setRoot(CodeFile::ProcessorList, object({
+            required(QStringLiteral("processors"), arrayOf(m_object)) }));
+        setRoot(CodeFile::TemplatePool, object({
+            optional(QStringLiteral("name"), m_string),
+            required(QStringLiteral("fallback"), m_string),
+            required(QStringLiteral("elements"), arrayOf(object({
+                required(QStringLiteral("weight"),
+                         number(Type::Integer, 1, 150)),
+                required(QStringLiteral("element"), m_object) }))) }));
+
+        Props noiseSettings{
+            required(QStringLiteral("sea_level"), m_integer),
+            required(QStringLiteral("default_block"), m_object),
+            required(QStringLiteral("default_fluid"), m_object),
+            required(QStringLiteral("noise"), m_object),
+        };
+        if (m_version >= Game::v1_18) {
+            noiseSettings
+                << required(QStringLiteral("noise_router"), m_object)
+                << required(QStringLiteral("surface_rule"), m_object)
+                << required(QStringLiteral("aquifers_enabled"), m_bool)
+                << required(QStringLiteral("ore_veins_enabled"), m_bool)
+                << required(QStringLiteral("disable_mob_generation"), m_bool);
+        }
+        setRoot(CodeFile::NoiseSettings, object(noiseSettings, false));
+
+        if (m_version < Game::v1_18) {
+            setRoot(CodeFile::SurfaceBuilder, typedConfig);
+            setRoot(CodeFile::StructureFeature, typedConfig);
+            return;
+        }
+
+        setRoot(CodeFile::Noise, object({
+            required(QStringLiteral("firstOctave"), m_integer),
+            required(QStringLiteral("amplitudes"), arrayOf(m_number)) }));
+        setRoot(CodeFile::PlacedFeature, object({
+            required(QStringLiteral("feature"), m_any),
+            required(QStringLiteral("placement"), arrayOf(m_object)) }));
+        if (m_version < Game::v1_19) {
+            setRoot(CodeFile::StructureFeature, typedConfig);
+        } else {
+            setRoot(CodeFile::StructureFeature, object({
+                required(QStringLiteral("type"), m_string),
+                required(QStringLiteral("biomes"), m_any) }, false));
+            setRoot(CodeFile::FlatLevelGenPreset, object({
+                required(QStringLiteral("display"), m_string),
+                required(QStringLiteral("settings"), m_object) }));
+        }
+        if (m_version >= Game::v1_18_2) {
+            setRoot(CodeFile::StructureSet, object({
+                required(QStringLiteral("structures"), arrayOf(object({
+                    required(QStringLiteral("structure"), m_string),
+                    required(QStringLiteral("weight"),
+                             number(Type::Integer, 1)) }))),
+                required(QStringLiteral("placement"), m_object) }));
+        }
+    }
+
+    void SchemaBuilder::buildMisc() {
+        const int pack = object({
+            required(QStringLiteral("pack_format"), m_integer),
+            required(QStringLiteral("description"), m_any) }, false);
+        setRoot(CodeFile::Meta,
+                object({ required(QStringLiteral("pack"), pack) }, false));
+
+        if (m_version >= Game::v1_19) {
+            setRoot(CodeFile::ChatType, object({
+                required(QStringLiteral("chat"), m_object),
+                required(QStringLiteral("narration"), m_object) }, false));
+        }
+        if (m_version >= Game::v1_19_4) {
+            setRoot(CodeFile::DamageType, object({
+                required(QStringLiteral("message_id"), m_string),
+                required(QStringLiteral("exhaustion"), m_number),
+                required(QStringLiteral("scaling"),
+                         enumOf({ QStringLiteral("never"),
+                                  QStringLiteral(
+                                      "when_caused_by_living_non_player"),
+                                  QStringLiteral("always") })),
+                optional(QStringLiteral("effects"),
+                         enumOf({ QStringLiteral("hurt"),
+                                  QStringLiteral("thorns"),
+                                  QStringLiteral("drowning"),
+                                  QStringLiteral("burning"),
+                                  QStringLiteral("poking"),
+                                  QStringLiteral("freezing") })),
+                optional(QStringLiteral("death_message_type"),
+                         enumOf({ QStringLiteral("default"),
+                                  QStringLiteral("fall_variants"),
+                                  QStringLiteral(
+                                      "intentional_game_design") })) }));
+        }
+        if (m_version >= Game::v1_20) {
+            setRoot(CodeFile::TrimMaterial, object({
+                required(QStringLiteral("asset_name"), m_string),
+                required(QStringLiteral("ingredient"), m_string),
+                required(QStringLiteral("item_model_index"), m_number),
+                required(QStringLiteral("description"), m_any),
+                optional(QStringLiteral("override_armor_materials"),
+                         mapOf(m_string)) }));
+            setRoot(CodeFile::TrimPattern, object({
+                required(QStringLiteral("asset_id"), m_string),
+                required(QStringLiteral("template_item"), m_string),
+                required(QStringLiteral("description"), m_any),
+                optional(QStringLiteral("decal"), m_bool) }));
+        }
+    }
+
+    /*!
+     * \brief Returns the schema of the \a version, which is compiled on
+     * the first call.
+     *
+     * This function is thread-safe.
+     */
+    SchemaPtr Schema::forVersion(const QString &version) {
+        QMutexLocker locker(&schemaCacheMutex);
+
+        auto &schema = schemaCache[version];
+
+        if (!schema) {
+            schema = QSharedPointer<Schema>::create();
+            SchemaBuilder(schema.get(),
+                          QVersionNumber::fromString(version)).build();
+        }
+        return schema;
+    }
+
+    /*!
+     * \brief Returns the index of the type of the files of \a fileType, or -1
+     * if they aren't described by this schema.
+     */
+    int Schema::rootOf(const CodeFile::FileType fileType) const {
+        return m_roots.value(fileType, -1);
+    }
+
+    const Schema::Property *Schema::findProperty(const Node &node,
+                                                 QStringView name) const {
+        return findByName(m_properties, node.begin, node.end, name);
+    }
+
+    /*!
+     * \brief Returns the case of the dispatching \a node named \a value,
+     * whose type is the type of the object.
+     */
+    const Schema::Property *Schema::findCase(const Node &node,
+                                             QStringView value) const {
+        return findByName(m_properties, node.caseBegin, node.caseEnd,
+                          withoutVanillaNamespace(value));
+    }
+
+    const QString &Schema::dispatchKey(const Node &node) const {
+        return m_values[node.dispatchKey];
+    }
+
+    /*!
+     * \brief Returns whether the \a value is allowed by the string \a node.
+     * Any string is allowed if the node has no values.
+     */
+    bool Schema::hasValue(const Node &node, QStringView value) const {
+        if (node.begin == node.end) {
+            return true;
+        }
+        if (node.isId) {
+            value = withoutVanillaNamespace(value);
+        }
+
+        const auto *first = m_values.constData() + node.begin;
+        const auto *last  = m_values.constData() + node.end;
+        const auto *it    = std::lower_bound(
+            first, last, value, [](const QString &a, QStringView b) {
+            return QStringView(a).compare(b) < 0;
+        });
+
+        return (it != last) && (*it == value);
+    }
+
+    QStringList Schema::values(const Node &node) const {
+        QStringList ret;
+
+        for (int i = node.begin; i < node.end; ++i) {
+            ret << m_values.at(i);
+        }
+        return ret;
+    }
+
+    /*!
+     * \brief Returns the names of the JSON types accepted by the type at
+     * \a index, as they are written in messages.
+     */
+    QStringList Schema::typeNames(const int index) const {
+        const auto &node = m_nodes.at(index);
+
+        switch (node.type) {
+            case Type::Any:
+                return {};
+
+            case Type::Boolean:
+                return { QStringLiteral("boolean") };
+
+            case Type::Number:
+                return { QStringLiteral("number") };
+
+            case Type::Integer:
+                return { QStringLiteral("integer") };
+
+            case Type::String:
+                return { QStringLiteral("string") };
+
+            case Type::Array:
+                return { QStringLiteral("array") };
+
+            case Type::Object:
+                return { QStringLiteral("object") };
+
+            case Type::Union: {
+                QStringList ret;
+                for (int i = node.begin; i < node.end; ++i) {
+                    ret << typeNames(m_alternatives.at(i));
+                }
+                return ret;
+            }
+        }
+        return {};
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef JSONSCHEMA_H
+#define JSONSCHEMA_H
+
+#include "codefile.h"
+
+#include <QHash>
+#include <QSharedPointer>
+#include <QVector>
+
+namespace Json {
+    class SchemaBuilder;
+
+    /*!
+     * \brief A compiled schema of the JSON files of a game version.
+     *
+     * Types are stored in a contiguous array and refer to each other by
+     * index, so recursive types such as nested loot conditions need no
+     * ownership. The properties of each object type are a span of a table
+     * sorted by name, which is searched with a view of the key in the document
+     * without allocating a string. Schemas are immutable once compiled and
+     * shared by every thread.
+     */
+    class Schema {
+public:
+        enum class Type : quint8 {
+            Any,
+            Boolean,
+            Number,
+            Integer,
+            String,
+            Array,
+            Object,
+            Union, // The first alternative which accepts the kind of the value
+        };
+
+        struct Property {
+            QString name;
+            int     type       = 0;
+            bool    isRequired = false;
+        };
+
+        struct Node {
+            double min         = -qInf();
+            double max         = qInf();
+            int    begin       = 0; // Span of properties, values or types
+            int    end         = 0;
+            int    caseBegin   = 0; // Span of the object types of a dispatch
+            int    caseEnd     = 0;
+            int    dispatchKey = -1; // Index of the key in the values
+            int    defaultCase = -1; // Type of objects without the key
+            int    items       = -1; // Type of items, or of the other keys
+            int    minItems    = 0;
+            Type   type        = Type::Any;
+            bool   isClosed    = false; // Whether other keys are unknown
+            bool   isId        = false; // Values may omit "minecraft:"
+
+            bool isDispatch() const {
+                return dispatchKey != -1;
+            }
+        };
+
+        static QSharedPointer<const Schema> forVersion(const QString &version);
+
+        int rootOf(const CodeFile::FileType fileType) const;
+
+        const Node &node(const int index) const {
+            return m_nodes[index];
+        }
+        const Property *propertiesBegin(const Node &node) const {
+            return m_properties.constData() + node.begin;
+        }
+        const Property *propertiesEnd(const Node &node) const {
+            return m_properties.constData() + node.end;
+        }
+        int alternativeAt(const int index) const {
+            return m_alternatives[index];
+        }
+        const Property *findProperty(const Node &node, QStringView name) const;
+        const Property *findCase(const Node &node, QStringView value) const;
+        const QString &dispatchKey(const Node &node) const;
+        bool hasValue(const Node &node, QStringView value) const;
+        QStringList values(const Node &node) const;
+        QStringList typeNames(const int index) const;
+
+        friend class SchemaBuilder;
+
+private:
+        QVector<Node> m_nodes;
+        QVector<Property> m_properties;
+        QVector<QString> m_values;
+        QVector<int> m_alternatives;
+        QHash<CodeFile::FileType, int> m_roots;
+    };
+
+    using SchemaPtr = QSharedPointer<const Schema>;
+}
+
+#endif // JSONSCHEMA_H
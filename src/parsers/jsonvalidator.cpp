@@ -0,0 +1,321 @@
+#include "jsonvalidator.h"
+
+#include <QLocale>
+#include <QVarLengthArray>
+
+#include <cmath>
+
+namespace {
+    QString kindName(const Json::Node::Kind kind) {
+        using Kind = Json::Node::Kind;
+
+        switch (kind) {
+            case Kind::Object:
+                return QStringLiteral("object");
+
+            case Kind::Array:
+                return QStringLiteral("array");
+
+            case Kind::String:
+                return QStringLiteral("string");
+
+            case Kind::Number:
+                return QStringLiteral("number");
+
+            case Kind::True:
+            case Kind::False:
+                return QStringLiteral("boolean");
+
+            default:
+                return QStringLiteral("null");
+        }
+    }
+}
+
+namespace Json {
+    SchemaValidator::SchemaValidator(SchemaPtr schema)
+        : m_schema(std::move(schema)) {
+    }
+
+    /*!
+     * \brief Returns the problems of the \a document parsed from the \a text
+     * as a file of \a fileType. Nothing is reported if the schema doesn't
+     * describe the file type.
+     */
+    Parser::Errors SchemaValidator::validate(
+        const NodePtr &document, QStringView text,
+        const CodeFile::FileType fileType) {
+        m_problems.clear();
+        m_text = text;
+
+        const int root = m_schema ? m_schema->rootOf(fileType) : -1;
+        if (!document || (root == -1)) {
+            return m_problems;
+        }
+
+        for (const auto &child: document->children()) {
+            if (child.node->isValue()) {
+                check(child.node.get(), child.offset, root);
+                break;
+            }
+        }
+        return std::move(m_problems);
+    }
+
+    void SchemaValidator::check(const Node *node, const int pos,
+                                const int type) {
+        using Type = Schema::Type;
+
+        const auto &schemaNode = m_schema->node(type);
+
+        if (schemaNode.type == Type::Any) {
+            return;
+        } else if (!accepts(type, node->kind())) {
+            reportTypeMismatch(node, pos, type);
+            return;
+        }
+
+        switch (schemaNode.type) {
+            case Type::Number:
+            case Type::Integer: {
+                checkNumber(node, pos, type);
+                break;
+            }
+            case Type::String: {
+                QString           buffer;
+                const QStringView value = stringAt(node, pos, buffer);
+                if (!m_schema->hasValue(schemaNode, value)) {
+                    const auto &&values = m_schema->values(schemaNode);
+                    report(QT_TRANSLATE_NOOP("Parser",
+                                             "Unexpected %1, expecting %2"),
+                           { m_text.mid(pos, node->length()).toString(),
+                             values.join(QStringLiteral(", ")) },
+                           pos, node->length());
+                }
+                break;
+            }
+            case Type::Array: {
+                checkArray(node, pos, type);
+                break;
+            }
+            case Type::Object: {
+                checkObject(node, pos, type);
+                break;
+            }
+            case Type::Union: {
+                for (int i = schemaNode.begin; i < schemaNode.end; ++i) {
+                    const int alternative = m_schema->alternativeAt(i);
+                    if (accepts(alternative, node->kind())) {
+                        check(node, pos, alternative);
+                        break;
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void SchemaValidator::checkNumber(const Node *node, const int pos,
+                                      const int type) {
+        const auto  &schemaNode = m_schema->node(type);
+        bool         ok         = false;
+        const double value      = QLocale::c().toDouble(
+            m_text.mid(pos, node->length()), &ok);
+
+        if (!ok) {
+            return;
+        }
+        if ((schemaNode.type == Schema::Type::Integer)
+            && (std::floor(value) != value)) {
+            reportTypeMismatch(node, pos, type);
+        } else if ((value < schemaNode.min) || (value > schemaNode.max)) {
+            if (std::isinf(schemaNode.max)) {
+                report(QT_TRANSLATE_NOOP("Parser",
+                                         "Expected a number of at least %1"),
+                       { schemaNode.min }, pos, node->length());
+            } else {
+                report(QT_TRANSLATE_NOOP("Parser",
+                                         "Expected a number between %1 and %2"),
+                       { schemaNode.min, schemaNode.max },
+                       pos, node->length());
+            }
+        }
+    }
+
+    void SchemaValidator::checkArray(const Node *node, const int pos,
+                                     const int type) {
+        const auto &schemaNode = m_schema->node(type);
+        int         count      = 0;
+
+        for (const auto &child: node->children()) {
+            if (child.node->isValue()) {
+                ++count;
+                check(child.node.get(), pos + child.offset, schemaNode.items);
+            }
+        }
+        if (count < schemaNode.minItems) {
+            report(QT_TRANSLATE_NOOP("Parser", "Expected at least %1 items"),
+                   { schemaNode.minItems }, pos, node->length());
+        }
+    }
+
+    /*!
+     * \brief Checks the members of an object. If the type dispatches on
+     * a key, the value of that key is looked up first to select the type of
+     * the whole object.
+     */
+    void SchemaValidator::checkObject(const Node *node, const int pos,
+                                      int type) {
+        QString buffer;
+
+        if (const auto &dispatching = m_schema->node(type);
+            dispatching.isDispatch()) {
+            const QString &key   = m_schema->dispatchKey(dispatching);
+            bool           found = false;
+            for (const auto &child: node->children()) {
+                const auto &&keyNode = child.node->key();
+                if (!keyNode || (stringAt(keyNode.get(), pos + child.offset,
+                                          buffer) != key)) {
+                    continue;
+                }
+
+                found = true;
+
+                const auto &&value = child.node->value();
+                if (!value || (value->kind() != Node::Kind::String)) {
+                    // Reported as a member below
+                    break;
+                }
+
+                const int valuePos = pos + child.offset
+                                     + child.node->children().constLast()
+                                     .offset;
+                const auto &&id       = stringAt(value.get(), valuePos, buffer);
+                const auto  *typeCase = m_schema->findCase(dispatching, id);
+                if (typeCase) {
+                    type = typeCase->type;
+                } else {
+                    report(QT_TRANSLATE_NOOP("Parser", "Unknown %2: %1"),
+                           { id.toString(), key }, valuePos, value->length());
+                }
+                break;
+            }
+            if (!found && (dispatching.defaultCase != -1)) {
+                type = dispatching.defaultCase;
+            }
+        }
+
+        const auto &schemaNode = m_schema->node(type);
+        const auto *propsBegin = m_schema->propertiesBegin(schemaNode);
+        const auto *propsEnd   = m_schema->propertiesEnd(schemaNode);
+        QVarLengthArray<bool, 32> foundProps(propsEnd - propsBegin);
+
+        std::fill(foundProps.begin(), foundProps.end(), false);
+        for (const auto &child: node->children()) {
+            if (child.node->kind() != Node::Kind::Member) {
+                continue;
+            }
+
+            const int   memberPos = pos + child.offset;
+            const auto &children  = child.node->children();
+            const auto &&name     = stringAt(children.constFirst().node.get(),
+                                             memberPos, buffer);
+            const auto &&value    = child.node->value();
+            const int    valuePos = memberPos + children.constLast().offset;
+
+            if (const auto *prop = m_schema->findProperty(schemaNode, name)) {
+                foundProps[prop - propsBegin] = true;
+                if (value) {
+                    check(value.get(), valuePos, prop->type);
+                }
+            } else if (schemaNode.items != -1) {
+                if (value) {
+                    check(value.get(), valuePos, schemaNode.items);
+                }
+            } else if (schemaNode.isClosed) {
+                report(QT_TRANSLATE_NOOP("Parser", "Unknown key: %1"),
+                       { name.toString() }, memberPos,
+                       children.constFirst().node->length());
+            }
+        }
+        for (const auto *prop = propsBegin; prop != propsEnd; ++prop) {
+            if (prop->isRequired && !foundProps[prop - propsBegin]) {
+                report(QT_TRANSLATE_NOOP("Parser", "Missing key: %1"),
+                       { prop->name }, pos, 1);
+            }
+        }
+    }
+
+    /*!
+     * \brief Returns whether a value of \a kind can have the \a type,
+     * regardless of its contents.
+     */
+    bool SchemaValidator::accepts(const int type, const Node::Kind kind) const {
+        using Type = Schema::Type;
+
+        const auto &schemaNode = m_schema->node(type);
+
+        switch (schemaNode.type) {
+            case Type::Any:
+                return true;
+
+            case Type::Boolean:
+                return (kind == Node::Kind::True)
+                       || (kind == Node::Kind::False);
+
+            case Type::Number:
+            case Type::Integer:
+                return kind == Node::Kind::Number;
+
+            case Type::String:
+                return kind == Node::Kind::String;
+
+            case Type::Array:
+                return kind == Node::Kind::Array;
+
+            case Type::Object:
+                return kind == Node::Kind::Object;
+
+            case Type::Union: {
+                for (int i = schemaNode.begin; i < schemaNode.end; ++i) {
+                    if (accepts(m_schema->alternativeAt(i), kind)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+        }
+        return false;
+    }
+
+    /*!
+     * \brief Returns the value of the string \a node at \a pos. The \a buffer
+     * is only used if the string has escape sequences.
+     */
+    QStringView SchemaValidator::stringAt(const Node *node, const int pos,
+                                          QString &buffer) const {
+        const auto &&contents = m_text.mid(
+            pos + 1, node->length() - (node->isClosed() ? 2 : 1));
+
+        if (!contents.contains(u'\\')) {
+            return contents;
+        }
+        buffer = unescape(contents);
+        return buffer;
+    }
+
+    void SchemaValidator::reportTypeMismatch(const Node *node, const int pos,
+                                             const int type) {
+        report(QT_TRANSLATE_NOOP("Parser", "Expected %1, got %2"),
+               { m_schema->typeNames(type).join(QStringLiteral(" or ")),
+                 kindName(node->kind()) },
+               pos, node->length());
+    }
+
+    void SchemaValidator::report(const char *msg, const QVariantList &args,
+                                 const int pos, const int length) {
+        m_problems << Parser::Error(msg, pos, length, args);
+    }
+}
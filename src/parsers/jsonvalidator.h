@@ -0,0 +1,44 @@
+#ifndef JSONVALIDATOR_H
+#define JSONVALIDATOR_H
+
+#include "jsonnode.h"
+#include "jsonschema.h"
+#include "parser.h"
+
+namespace Json {
+    /*!
+     * \brief Checks the syntax tree of a JSON document against the schema of
+     * its file type in a single pass.
+     *
+     * Values are read from the text of the document through views instead of
+     * being converted to QJsonValue, so the cost is linear in the size of
+     * the document. A validator can be reused for many documents, and
+     * validators in different threads can share a schema.
+     */
+    class SchemaValidator {
+public:
+        explicit SchemaValidator(SchemaPtr schema);
+
+        Parser::Errors validate(const NodePtr &document, QStringView text,
+                                const CodeFile::FileType fileType);
+
+private:
+        SchemaPtr m_schema;
+        Parser::Errors m_problems;
+        QStringView m_text;
+
+        void check(const Node *node, const int pos, const int type);
+        void checkNumber(const Node *node, const int pos, const int type);
+        void checkArray(const Node *node, const int pos, const int type);
+        void checkObject(const Node *node, const int pos, int type);
+        bool accepts(const int type, const Node::Kind kind) const;
+        QStringView stringAt(const Node *node, const int pos,
+                             QString &buffer) const;
+        void reportTypeMismatch(const Node *node, const int pos,
+                                const int type);
+        void report(const char *msg, const QVariantList &args,
+                    const int pos, const int length);
+    };
+}
+
+#endif // JSONVALIDATOR_H
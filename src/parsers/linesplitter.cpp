@@ -3,6 +3,24 @@
 LineSplitter::LineSplitter(const QString &text) : m_text{text} {
 }
 
+/*!
+ * \brief Constructs a splitter which starts at the physical position \a physPos
+ * of \a text instead of the beginning of it.
+ *
+ * \a lineNo is the physical line number of the line starting at \a physPos,
+ * and \a logiPos is its logical position. Used to split a part of a text
+ * whose preceding lines have been split before.
+ */
+LineSplitter::LineSplitter(const QString &text, const int physPos,
+                           const int lineNo, const int logiPos)
+    : m_text{text}, m_physPos{physPos}, m_logiPos{logiPos},
+    m_lineNo{lineNo - 1} {
+    if (physPos != logiPos) {
+        m_srcMapper.physicalPositions[logiPos] = physPos;
+        m_srcMapper.logicalPositions[physPos]  = logiPos;
+    }
+}
+
 QStringView LineSplitter::getCurrLineView() {
     const int pos = m_physPos;
 
@@ -26,6 +44,7 @@ QStringView LineSplitter::getCurrLineView() {
 }
 
 QString LineSplitter::getCurrLine() {
+    mapLineStart();
     const auto line = getCurrLineView();
 
     m_srcMapper.logicalLines += m_lineNo;
@@ -53,11 +72,7 @@ bool LineSplitter::hasNextLine() const {
 
 QString LineSplitter::nextLogicalLine() {
     if (hasNextLine()) {
-        if (m_physPos > 0 && m_lastLineIsContinuation) {
-            m_srcMapper.physicalPositions[m_logiPos] = m_physPos;
-            m_srcMapper.logicalPositions[m_physPos]  = m_logiPos;
-            m_lastLineIsContinuation                 = false;
-        }
+        mapLineStart();
         QStringView line = getCurrLineView();
         m_srcMapper.logicalLines += m_lineNo;
         QString logicalLine;
@@ -94,6 +109,31 @@ bool LineSplitter::canConcatenate(QStringView line) {
     return !line.isEmpty() && line.back() == QLatin1Char('\\');
 }
 
+int LineSplitter::physicalPos() const {
+    return m_physPos;
+}
+
+int LineSplitter::logicalPos() const {
+    return m_logiPos;
+}
+
+bool LineSplitter::lastLineIsContinuation() const {
+    return m_lastLineIsContinuation;
+}
+
 Command::SourceMapper LineSplitter::sourceMapper() const {
     return m_srcMapper;
 }
+
+/*!
+ * \brief Maps the start of the current line if the previous logical line
+ * spans multiple physical lines, so that every logical line which follows
+ * a line continuation has an exact position mapping.
+ */
+void LineSplitter::mapLineStart() {
+    if (m_physPos > 0 && m_lastLineIsContinuation) {
+        m_srcMapper.physicalPositions[m_logiPos] = m_physPos;
+        m_srcMapper.logicalPositions[m_physPos]  = m_logiPos;
+        m_lastLineIsContinuation                 = false;
+    }
+}
@@ -12,6 +12,8 @@
 class LineSplitter {
 public:
     LineSplitter(const QString &text);
+    LineSplitter(const QString &text, const int physPos, const int lineNo,
+                 const int logiPos);
 
     QStringView getCurrLineView();
     QString getCurrLine();
@@ -20,6 +22,10 @@ public:
     QString nextLogicalLine();
     bool canConcatenate(QStringView line);
 
+    int physicalPos() const;
+    int logicalPos() const;
+    bool lastLineIsContinuation() const;
+
     Command::SourceMapper sourceMapper() const;
 
 private:
@@ -29,6 +35,8 @@ private:
     int m_logiPos                 = 0;
     int m_lineNo                  = -1;
     bool m_lastLineIsContinuation = false;
+
+    void mapLineStart();
 };
 
 #endif // LINESPLITTER_H
@@ -14,15 +14,21 @@ Parser::Error::Error(const char *whatArg, int pos, int length,
     : std::runtime_error(whatArg), pos(pos), length(length), args(args) {
 }
 
-QString Parser::Error::toLocalizedMessage() const {
+/*!
+ * \brief Returns the translated message of the error with its arguments.
+ */
+QString Parser::Error::localizedDescription() const {
     QString &&errMsg = tr(what());
 
     for (int i = 0; i < args.size(); ++i) {
         errMsg = errMsg.arg(args.at(i).toString());
     }
+    return std::move(errMsg);
+}
 
+QString Parser::Error::toLocalizedMessage() const {
     const QString &&ret = tr("Syntax error at position %1: %2")
-                          .arg(pos).arg(errMsg);
+                          .arg(pos).arg(localizedDescription());
     return std::move(ret);
 }
 
@@ -96,7 +102,8 @@ void Parser::setText(QString &&newText) {
 }
 
 void Parser::setText(QStringView text) {
-    m_text = text;
+    m_srcText = QString();
+    m_text    = text;
 }
 
 Parser::Errors Parser::errors() const {
@@ -106,42 +113,30 @@ Parser::Errors &Parser::errors() {
     return m_errors;
 }
 
-StringHash Parser::spans() const {
-    return m_spans;
-}
-
 /*!
- * \brief Throws a \c Command::Parser::ParsingError with a formatted message.
+ * \brief Sets the function which is polled while parsing to know whether
+ * the current parse should be abandoned, e.g. because the text has changed.
  */
-void Parser::throwError(const QString &msg, const QVariantList &args) {
-    throwError(msg, args, m_pos);
-}
-
-void Parser::throwError(const char *msg, const QVariantList &args) {
-    throwError(msg, args, m_pos);
+void Parser::setCancellationCheck(CancellationCheck check) {
+    m_cancellationCheck = std::move(check);
 }
 
 /*!
- * \brief Throws a \c Command::Parser::ParsingError with a formatted message,
- * a absoulte position and a length.
+ * \brief Returns whether the last parse has been abandoned.
  */
-void Parser::throwError(const QString &msg, const QVariantList &args,
-                        int pos, int length) {
-    /*qWarning() << "Command::Parser::error" << msg << pos << length; */
-/*
-      QString errorIndicatorText = QString("\"%1«%2»%3\" (%4 chars)").arg(
-          m_text.mid(pos - 10, 10),
-          m_text.mid(pos, length),
-          m_text.mid(pos + length, 10),
-          QString::number(m_text.length()));
- */
-
-    throw Parser::Error(msg, pos, length, args);
+bool Parser::wasCancelled() const {
+    return m_cancelled;
 }
 
-void Parser::throwError(const char *msg, const QVariantList &args,
-                        int pos, int length) {
-    throw Parser::Error(msg, pos, length, args);
+/*!
+ * \brief Polls the cancellation check and returns true if the current parse
+ * should be abandoned.
+ */
+bool Parser::checkCancelled() {
+    if (!m_cancelled && m_cancellationCheck) {
+        m_cancelled = m_cancellationCheck();
+    }
+    return m_cancelled;
 }
 
 /*!
@@ -161,6 +156,40 @@ void Parser::reportError(const char *msg, const QVariantList &args,
     m_errors << Parser::Error(msg, pos, length, args);
 }
 
+/*!
+ * \brief Stores an error with a formatted message in the failure slot and
+ * returns a failure tag, which converts to a failed \c Parser::Result.
+ *
+ * The caller must take the failure by takeFailure() to report or discard it.
+ */
+ParseFailure Parser::fail(const char *msg, const QVariantList &args) {
+    return fail(msg, args, m_pos);
+}
+
+ParseFailure Parser::fail(const char *msg, const QVariantList &args,
+                          int pos, int length) {
+    m_failure.emplace(msg, pos, length, args);
+    return ParseFailure();
+}
+
+/*!
+ * \brief Returns whether there is a failure which hasn't been taken.
+ */
+bool Parser::hasFailure() const {
+    return m_failure.has_value();
+}
+
+/*!
+ * \brief Returns the error of the last failure and clears the failure slot.
+ */
+Parser::Error Parser::takeFailure() {
+    Q_ASSERT(m_failure.has_value());
+    Error error = std::move(m_failure).value_or(Error());
+
+    m_failure.reset();
+    return error;
+}
+
 /*!
  * \brief Advances \a n characters, then updates the current character.
  */
@@ -180,15 +209,13 @@ QStringView Parser::advanceView(QStringView sv) {
 }
 
 /*!
- * \brief Throws a \c error if the char \a chr isn't equal to the current character.
+ * \brief Fails if the char \a chr isn't equal to the current character.
  * If \c errMsg is not specified, the error message will have the form
  * "Unexpected %1, expecting %2".
- *
- * \sa eat()
  */
-bool Parser::expect(QChar chr, const char *errMsg) {
+Parser::Result<> Parser::tryExpect(QChar chr, const char *errMsg) {
     if (m_curChar == chr) {
-        return true;
+        return Result<>();
     } else {
         const QString &&curCharTxt =
             (m_curChar.isNull()) ? QStringLiteral("EOL") : '\''_QL1
@@ -196,19 +223,19 @@ bool Parser::expect(QChar chr, const char *errMsg) {
         const QString &&charTxt =
             (chr.isNull()) ? QStringLiteral("EOL") : '\''_QL1 +
             chr + '\''_QL1;
-        throwError((errMsg) ? errMsg : QT_TR_NOOP(
-                       "Unexpected %1, expecting %2"),
-                   { curCharTxt, charTxt }, m_pos, 1);
-        return false;
+        return fail((errMsg) ? errMsg : QT_TR_NOOP(
+                        "Unexpected %1, expecting %2"),
+                    { curCharTxt, charTxt }, m_pos, 1);
     }
 }
 
 /*!
  * \brief Consumes the character \a chr and optionaly skips whitespaces.
  *
- * \sa expect()
+ * \sa tryExpect()
  */
-QString Parser::eat(QChar chr, const char *errMsg, EatOptions options) {
+Parser::Result<TextSpan> Parser::tryEat(QChar chr, const char *errMsg,
+                                        EatOptions options) {
     const int start = m_pos;
 
     if (options.testFlag(SkipLeftWs)) {
@@ -216,7 +243,9 @@ QString Parser::eat(QChar chr, const char *errMsg, EatOptions options) {
             advance();
     }
 
-    expect(chr, errMsg);
+    if (!tryExpect(chr, errMsg)) {
+        return ParseFailure();
+    }
     advance();
 
     if (options.testFlag(SkipRightWs)) {
@@ -247,15 +276,30 @@ QStringView Parser::getRest() {
     return rest;
 }
 
+/*!
+ * \brief Returns the substring from the current character whose characters
+ * are in the \a charset.
+ */
+QStringView Parser::getWithCharset(const Charset &charset) {
+    const int start  = m_pos;
+    const int length = charset.span(m_text.mid(m_pos));
+
+    if (length == 0) {
+        return QStringView();
+    }
+    advance(length);
+    return m_text.mid(start, length);
+}
+
 /*!
  * \brief Returns the substring from the current character with the given (regex) \a charset.
  */
 QStringView Parser::getWithCharset(const QString &charset) {
-    return getWithRegex(QLatin1String("[") + charset + QLatin1String("]+"));
+    return getWithCharset(Charset::cached(charset));
 }
 
 QStringView Parser::getWithCharset(const QLatin1String &charset) {
-    return getWithRegex(QLatin1String("[") + charset + QLatin1String("]+"));
+    return getWithCharset(Charset::cached(QString(charset)));
 }
 
 /*!
@@ -319,7 +363,7 @@ QStringView Parser::peekRest() const {
  * \brief Skips and returns subsequent whitespaces.
  * If \a once is true, only one whitespace is skipped.
  */
-QString Parser::skipWs(bool once) {
+TextSpan Parser::skipWs(bool once) {
     const int start = m_pos;
 
     while (m_curChar.isSpace()) {
@@ -333,19 +377,21 @@ QString Parser::skipWs(bool once) {
 /*!
  * \brief Returns the next quoted string.
  */
-QString Parser::getQuotedString() {
+Parser::Result<QString> Parser::tryGetQuotedString() {
     const static QVector<QChar> delimiters{ '"', '\'' };
 
     QChar curQuoteChar;
 
     if (delimiters.contains(m_curChar))
         curQuoteChar = m_curChar;
-    eat(curQuoteChar);
+    if (!tryEat(curQuoteChar)) {
+        return ParseFailure();
+    }
     QString value;
     bool    backslash = false;
     while ((m_curChar != curQuoteChar) || backslash) {
         if (m_pos >= m_text.length())
-            throwError(QT_TR_NOOP("Incomplete quoted string"));
+            return fail(QT_TR_NOOP("Incomplete quoted string"));
         if (backslash) {
             if (m_curChar == curQuoteChar) {
                 value += curQuoteChar;
@@ -385,10 +431,9 @@ QString Parser::getQuotedString() {
                             value += QChar(codepoint);
                             advance(3);
                         } else {
-                            throwError(QT_TR_NOOP("Invalid Unicode code point"),
-                                       {},
-                                       pos() - 2,
-                                       6);
+                            return fail(QT_TR_NOOP(
+                                            "Invalid Unicode code point"),
+                                        {}, pos() - 2, 6);
                         }
                         break;
                     }
@@ -415,62 +460,45 @@ QString Parser::getQuotedString() {
         }
         advance();
     }
-    eat(curQuoteChar);
+    if (!tryEat(curQuoteChar)) {
+        return ParseFailure();
+    }
     return value;
 }
 
-QString Parser::spanText(QStringView textView) {
-//    return spanText(textView.toString());
-
-    const auto &&it = m_spans.constFind(textView);
+/*!
+ * \brief Returns the span of the \a textView in the source text without
+ * copying it. A view which isn't a part of the source text is copied.
+ */
+TextSpan Parser::spanText(QStringView textView) const {
+    const QChar *begin = m_srcText.constData();
 
-    if (it != m_spans.cend()) {
-        return *it;
-    } else {
-        const QString &&copy = textView.toString();
-        return *m_spans.insert(copy, std::move(copy));
+    if (!m_srcText.isNull() && (textView.data() >= begin)
+        && (textView.data() + textView.size() <= begin + m_srcText.size())) {
+        return TextSpan::of(m_srcText, textView);
     }
-
-//    const auto &&it = m_spans.find(textView);
-
-//    if (it != m_spans.cend()) {
-//        return it->second;
-//    } else {
-//        const QString &&copy = textView.toString();
-//        return m_spans.emplace(copy, std::move(copy)).first->second;
-//    }
+    return TextSpan(textView.toString());
 }
 
-QString Parser::spanText(const QString &text) {
-//    return text;
-
-//    return *m_spans.insert(text);
-
-//    m_spans.insert(text);
-//    return *m_spans.find(text);
-
-    return *m_spans.insert(text, text);
-//    return m_spans.try_emplace(text, text).first->second;
+TextSpan Parser::spanText(const QString &text) const {
+    return TextSpan(text);
 }
 
-QString Parser::spanText(QString &&text) {
-//    return text;
-
-//    return *m_spans.insert(std::move(text));
-
-//    m_spans.insert(std::move(text));
-//    return *m_spans.find(text);
-
-    return *m_spans.insert(text, std::move(text));
-//    return m_spans.try_emplace(text, std::move(text)).first->second;
+TextSpan Parser::spanText(QString &&text) const {
+    return TextSpan(std::move(text));
 }
 
-QString Parser::spanText(int start) {
+/*!
+ * \brief Returns the span of the source text from \a start to
+ * the current position.
+ */
+TextSpan Parser::spanText(int start) const {
     return spanText(m_text.mid(start, m_pos - start));
 }
 
 bool Parser::parse() {
     m_errors.clear();
+    m_cancelled = false;
     setPos(0);
     return parseImpl();
 }
@@ -1,17 +1,17 @@
 #ifndef PARSER_H
 #define PARSER_H
 
+#include "charset.h"
+#include "textspan.h"
+
 #include <QVariantList>
 #include <QDebug>
 #include <QCoreApplication>
 
+#include <functional>
+#include <optional>
 #include <stdexcept>
 
-using StringHash = QHash<QStringView, QString>;
-//using StringHash = std::unordered_map<QStringView, QString>;
-
-//using StringHash = QSet<QString>;
-
 QLatin1Char constexpr operator ""_QL1(const char chr) {
     return QLatin1Char(chr);
 }
@@ -20,6 +20,83 @@ namespace Command {
     class McfunctionParser;
 }
 
+/*!
+ * \brief A tag which constructs a failed \c ParseResult.
+ */
+struct ParseFailure {};
+
+/*!
+ * \brief The value returned by a parse method that can fail.
+ *
+ * A failed result carries no error by itself, the error is held in the
+ * failure slot of the parser until the caller takes it. Unlike throwing an
+ * exception, returning a failure doesn't unwind the stack, so callers can
+ * backtrack by resetting the position of the parser.
+ *
+ * \sa Parser::fail(), Parser::takeFailure()
+ */
+template<typename T = void>
+class ParseResult {
+public:
+    ParseResult(const T &value) : m_value(value), m_ok(true) {
+    }
+    ParseResult(T &&value) : m_value(std::move(value)), m_ok(true) {
+    }
+    ParseResult(ParseFailure) {
+    }
+
+    bool ok() const {
+        return m_ok;
+    }
+    explicit operator bool() const {
+        return m_ok;
+    }
+
+    T &value() {
+        Q_ASSERT(m_ok);
+        return m_value;
+    }
+    const T &value() const {
+        Q_ASSERT(m_ok);
+        return m_value;
+    }
+    T &operator*() {
+        return value();
+    }
+    const T &operator*() const {
+        return value();
+    }
+    T * operator->() {
+        return &value();
+    }
+    const T * operator->() const {
+        return &value();
+    }
+
+private:
+    T m_value = T();
+    bool m_ok = false;
+};
+
+template<>
+class ParseResult<void> {
+public:
+    ParseResult() : m_ok(true) {
+    }
+    ParseResult(ParseFailure) {
+    }
+
+    bool ok() const {
+        return m_ok;
+    }
+    explicit operator bool() const {
+        return m_ok;
+    }
+
+private:
+    bool m_ok = false;
+};
+
 class Parser {
     Q_DECLARE_TR_FUNCTIONS(Parser);
 public:
@@ -37,11 +114,14 @@ public:
                        int length                   = 0,
                        const QVariantList &args     = {});
 
+        QString localizedDescription() const;
         QString toLocalizedMessage() const;
 
         bool operator==(const Error &o) const;
     };
     using Errors = QVector<Error>;
+    template<typename T = void>
+    using Result = ParseResult<T>;
 
     Parser();
     explicit Parser(const QString &text);
@@ -69,12 +149,14 @@ public:
     // The below method is added to avoid clazy-range-loop-detach warning
     Errors &errors();
 
-    StringHash spans() const;
+    using CancellationCheck = std::function<bool()>;
+    void setCancellationCheck(CancellationCheck check);
+    bool wasCancelled() const;
 
     friend Command::McfunctionParser;
 
 protected:
-    enum EatOption { // For use in eat() method
+    enum EatOption { // For use in tryEat() method
         NoOption    = 0x0,
         SkipLeftWs  = 0x1,
         SkipRightWs = 0x2,
@@ -83,29 +165,26 @@ protected:
     Q_DECLARE_FLAGS(EatOptions, EatOption);
 
     Errors m_errors;
-    StringHash m_spans;
-
-    void throwError [[noreturn]](const QString &msg,
-                                 const QVariantList &args = {});
-    void throwError [[noreturn]](const char *msg,
-                                 const QVariantList &args = {});
-    void throwError [[noreturn]](const QString &msg, const QVariantList &args,
-                                 int pos, int length = 0);
-    void throwError [[noreturn]](const char *msg, const QVariantList &args,
-                                 int pos, int length = 0);
 
     void reportError(const char *msg, const QVariantList &args = {});
     void reportError(const char *msg, const QVariantList &args,
                      int pos, int length = 0);
 
+    ParseFailure fail(const char *msg, const QVariantList &args = {});
+    ParseFailure fail(const char *msg, const QVariantList &args,
+                      int pos, int length = 0);
+    bool hasFailure() const;
+    Error takeFailure();
+
     void advance(int n = 1);
     QStringView advanceView(QStringView sv);
 
-    bool expect(QChar chr, const char *errMsg = nullptr);
-    QString eat(QChar chr, const char *errMsg = nullptr,
-                EatOptions options            = NoOption);
+    Result<> tryExpect(QChar chr, const char *errMsg = nullptr);
+    Result<TextSpan> tryEat(QChar chr, const char *errMsg = nullptr,
+                            EatOptions options            = NoOption);
     QStringView getUntil(QChar chr);
     QStringView getRest();
+    QStringView getWithCharset(const Charset &charset);
     QStringView getWithCharset(const QString &charset);
     QStringView getWithCharset(const QLatin1String &charset);
     QStringView getWithRegex(const QString &pattern);
@@ -114,24 +193,30 @@ protected:
     QStringView peekNext(int n) const;
     QStringView peekUntil(QChar chr) const;
     QStringView peekRest() const;
-    QString skipWs(bool once = true);
+    TextSpan skipWs(bool once = true);
+
+    Result<QString> tryGetQuotedString();
 
-    QString getQuotedString();
+    TextSpan spanText(QStringView textView) const;
+    TextSpan spanText(const QString &text) const;
+    TextSpan spanText(QString &&text) const;
+    TextSpan spanText(int start) const;
 
-    QString spanText(QStringView textView);
-    QString spanText(const QString& text);
-    QString spanText(QString&& text);
-    QString spanText(int start);
+    bool checkCancelled();
 
     virtual bool parseImpl() {
         return false;
     };
 
 private:
+    CancellationCheck m_cancellationCheck;
+    // The error of the last failure which hasn't been taken yet
+    std::optional<Error> m_failure;
     QStringView m_text;
     QString m_srcText;
-    int m_pos = 0;
+    int m_pos         = 0;
     QChar m_curChar;
+    bool m_cancelled = false;
 };
 
 #endif // PARSER_H
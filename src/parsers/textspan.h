@@ -0,0 +1,113 @@
+#ifndef TEXTSPAN_H
+#define TEXTSPAN_H
+
+#include <QString>
+#include <QStringView>
+
+/*!
+ * \brief A substring of an immutable text buffer.
+ *
+ * A span refers to its buffer by an offset and a length. The buffer is
+ * an implicitly shared QString, so spans of the text being parsed share the
+ * source of the parse instead of copying it, and keep it alive as long as
+ * they exist. A span can also cover a whole string that isn't part of
+ * the source, such as a literal.
+ *
+ * \sa Parser::spanText()
+ */
+class TextSpan {
+public:
+    TextSpan() = default;
+    TextSpan(const QString &text)
+        : m_buffer(text), m_length(text.size()) {
+    }
+    TextSpan(QString &&text)
+        : m_buffer(std::move(text)), m_length(m_buffer.size()) {
+    }
+#ifndef QT_NO_CAST_FROM_ASCII
+    TextSpan(const char *text) : TextSpan(QString::fromUtf8(text)) {
+    }
+#endif
+    TextSpan(const QString &buffer, const int offset, const int length)
+        : m_buffer(buffer), m_offset(offset), m_length(length) {
+        Q_ASSERT(offset >= 0 && length >= 0);
+        Q_ASSERT(offset + length <= buffer.size());
+    }
+
+    /*!
+     * \brief Returns the span of the \a view, which must be a part of
+     * the \a buffer.
+     */
+    static TextSpan of(const QString &buffer, QStringView view) {
+        if (view.isNull()) {
+            return TextSpan(buffer, 0, 0);
+        }
+        return TextSpan(buffer, int(view.data() - buffer.constData()),
+                        int(view.size()));
+    }
+
+    const QString &buffer() const {
+        return m_buffer;
+    }
+    int offset() const {
+        return m_offset;
+    }
+    int length() const {
+        return m_length;
+    }
+    int size() const {
+        return m_length;
+    }
+    bool isEmpty() const {
+        return m_length == 0;
+    }
+    bool isNull() const {
+        return m_buffer.isNull();
+    }
+
+    QStringView view() const {
+        return QStringView(m_buffer).mid(m_offset, m_length);
+    }
+
+    /*!
+     * \brief Returns the text of the span, which only allocates a string if
+     * the span doesn't cover its whole buffer.
+     */
+    QString toString() const {
+        if ((m_offset == 0) && (m_length == m_buffer.size())) {
+            return m_buffer;
+        }
+        return m_buffer.mid(m_offset, m_length);
+    }
+
+    TextSpan mid(const int pos, const int n = -1) const {
+        const int length = ((n < 0) || (pos + n > m_length))
+                               ? m_length - pos : n;
+
+        return TextSpan(m_buffer, m_offset + pos, length);
+    }
+    TextSpan chopped(const int n) const {
+        return TextSpan(m_buffer, m_offset, m_length - n);
+    }
+
+    bool operator==(QStringView other) const {
+        return view() == other;
+    }
+    bool operator!=(QStringView other) const {
+        return view() != other;
+    }
+    bool operator==(const QChar ch) const {
+        return (m_length == 1) && (m_buffer.at(m_offset) == ch);
+    }
+
+    friend QString &operator+=(QString &str, const TextSpan &span) {
+        return str.append(span.view().data(), span.length());
+    }
+
+private:
+    QString m_buffer;
+    int m_offset = 0;
+    int m_length = 0;
+};
+
+#endif // TEXTSPAN_H
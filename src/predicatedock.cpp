@@ -10,6 +10,7 @@
 #include <QDebug>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QJsonArray>
 
 PredicateDock::PredicateDock(QWidget *parent) :
     QDockWidget(parent), ui(new Ui::PredicateDock) {
@@ -51,18 +52,17 @@ void PredicateDock::changeEvent(QEvent *event) {
 }
 
 void PredicateDock::onReadBtn() {
-    QString &&input =
-        qobject_cast<MainWindow *>(parent())->getCodeEditorText();
-    QJsonDocument &&json_doc = QJsonDocument::fromJson(input.toUtf8());
-
-    if (json_doc.isNull() || json_doc.isEmpty())
-        return;
+    const QJsonValue &&json =
+        qobject_cast<MainWindow *>(parent())->getCodeEditorJson();
 
     if (Game::version() >= Game::v1_16
-        && json_doc.isArray()) {
-        ui->dataInterface->setJson(json_doc.array());
+        && json.isArray()) {
+        if (json.toArray().isEmpty())
+            return;
+
+        ui->dataInterface->setJson(json.toArray());
     } else {
-        QJsonObject root = json_doc.object();
+        QJsonObject root = json.toObject();
         if (root.isEmpty())
             return;
 
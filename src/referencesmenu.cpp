@@ -0,0 +1,43 @@
+#include "referencesmenu.h"
+
+#include "globalhelpers.h"
+
+/*!
+ * \class ReferencesMenu
+ * \brief A menu which lists the \a locations of a symbol by their paths
+ * relative to \a dirPath and their line numbers.
+ *
+ * Only the first locations are listed, since a menu can't be scrolled
+ * comfortably.
+ */
+
+ReferencesMenu::ReferencesMenu(const QString &title, const QString &dirPath,
+                               const QVector<SymbolIndex::Location> &locations,
+                               QWidget *parent)
+    : QMenu(title, parent) {
+    constexpr int maxLocations = 50;
+
+    if (locations.isEmpty()) {
+        addAction(tr("None"))->setEnabled(false);
+        return;
+    }
+
+    const int count = qMin(locations.size(), maxLocations);
+    for (int i = 0; i < count; ++i) {
+        const auto &location = locations.at(i);
+        QString   &&text     = QStringLiteral("%1:%2").arg(
+            Glhp::relPath(dirPath, location.path),
+            QString::number(location.line + 1));
+        if (location.role == SymbolIndex::Role::Definition) {
+            text = tr("%1 (definition)").arg(text);
+        }
+        connect(addAction(text), &QAction::triggered, this,
+                [this, path = location.path, lineNo = location.line]() {
+            emit locationTriggered(path, lineNo);
+        });
+    }
+    if (locations.size() > maxLocations) {
+        addAction(tr("%n more...", nullptr,
+                     locations.size() - maxLocations))->setEnabled(false);
+    }
+}
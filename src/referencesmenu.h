@@ -0,0 +1,19 @@
+#ifndef REFERENCESMENU_H
+#define REFERENCESMENU_H
+
+#include "symbolindex.h"
+
+#include <QMenu>
+
+class ReferencesMenu : public QMenu {
+    Q_OBJECT
+public:
+    explicit ReferencesMenu(const QString &title, const QString &dirPath,
+                            const QVector<SymbolIndex::Location> &locations,
+                            QWidget *parent = nullptr);
+
+signals:
+    void locationTriggered(const QString &path, const int lineNo);
+};
+
+#endif // REFERENCESMENU_H
@@ -107,6 +107,8 @@ void SettingsDialog::onAccepted() {
                         ui->editorTabAsSpacesCheck->isChecked());
     m_settings.setValue("showSpacesAndTabs",
                         ui->editorShowSpacesCheck->isChecked());
+    m_settings.setValue("validateIds",
+                        ui->editorValidateIdsCheck->isChecked());
     m_settings.endGroup();
 
     m_settings.sync();
@@ -202,6 +204,8 @@ void SettingsDialog::initSettings() {
         ui->editorTabAsSpacesCheck->setChecked(false);
     if (m_settings.value(QStringLiteral("showSpacesAndTabs"), false).toBool())
         ui->editorShowSpacesCheck->setChecked(true);
+    if (!m_settings.value(QStringLiteral("validateIds"), true).toBool())
+        ui->editorValidateIdsCheck->setChecked(false);
     m_settings.endGroup();
 }
 
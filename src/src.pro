@@ -34,13 +34,17 @@ SOURCES += \
     advancementitem.cpp \
     advancementtab.cpp \
     advancementtabdock.cpp \
+    analysisworker.cpp \
     basecondition.cpp \
     blockitemselectordialog.cpp \
     codeeditor.cpp \
     codefile.cpp \
     codegutter.cpp \
     codepalette.cpp \
+    completionindex.cpp \
     darkfusionstyle.cpp \
+    datapackidlist.cpp \
+    datapackindex.cpp \
     datapackfileiconprovider.cpp \
     datapacktreeview.cpp \
     datawidgetcontroller.cpp \
@@ -51,12 +55,15 @@ SOURCES += \
     filenamedelegate.cpp \
     fileswitcher.cpp \
     game.cpp \
+    gamedatabundle.cpp \
+    gamedatacache.cpp \
     gameinfomodel.cpp \
     globalhelpers.cpp \
     highlighter.cpp \
     imgviewer.cpp \
     inventoryitem.cpp \
     inventoryitemfiltermodel.cpp \
+    inventoryitemmodel.cpp \
     inventoryslot.cpp \
     inventorysloteditor.cpp \
     itemconditiondialog.cpp \
@@ -74,6 +81,7 @@ SOURCES += \
     loottablepool.cpp \
     main.cpp \
     mainwindow.cpp \
+    mappedfile.cpp \
     mcbuildhighlighter.cpp \
     mcfunctionhighlighter.cpp \
     modelfunctions.cpp \
@@ -110,6 +118,8 @@ SOURCES += \
     parsers/command/nodes/targetselectornode.cpp \
     parsers/command/nodes/timenode.cpp \
     parsers/command/parsenodecache.cpp \
+    parsers/command/parseresultcache.cpp \
+    parsers/command/schema/compiledschema.cpp \
     parsers/command/schema/schemaargumentnode.cpp \
     parsers/command/schema/schemaliteralnode.cpp \
     parsers/command/schema/schemaloader.cpp \
@@ -122,8 +132,13 @@ SOURCES += \
     parsers/command/visitors/nodevisitor.cpp \
     parsers/command/visitors/overloadnodevisitor.cpp \
     parsers/command/visitors/reprprinter.cpp \
+    parsers/command/visitors/semanticvalidator.cpp \
     parsers/command/visitors/sourceprinter.cpp \
+    parsers/command/visitors/symbolcollector.cpp \
+    parsers/jsonnode.cpp \
     parsers/jsonparser.cpp \
+    parsers/jsonschema.cpp \
+    parsers/jsonvalidator.cpp \
     parsers/linesplitter.cpp \
     parsers/parser.cpp \
     platforms/windows_specific.cpp \
@@ -132,6 +147,7 @@ SOURCES += \
     rawjsontextedit.cpp \
     rawjsontexteditor.cpp \
     rawjsontextobjectinterface.cpp \
+    referencesmenu.cpp \
     scoreboardtextobjectdialog.cpp \
     settingsdialog.cpp \
     stackedwidget.cpp \
@@ -139,9 +155,11 @@ SOURCES += \
     statusbar.cpp \
     stringvectormodel.cpp \
     stripedscrollbar.cpp \
+    symbolindex.cpp \
 #    stylesheetreapplier.cpp \
     tabbeddocumentinterface.cpp \
     tagselectordialog.cpp \
+    textureatlas.cpp \
     translatedtextobjectdialog.cpp \
     truefalsebox.cpp \
     vieweventfilter.cpp \
@@ -153,13 +171,17 @@ HEADERS += \
     advancementitem.h \
     advancementtab.h \
     advancementtabdock.h \
+    analysisworker.h \
     basecondition.h \
     blockitemselectordialog.h \
     codeeditor.h \
     codefile.h \
     codegutter.h \
     codepalette.h \
+    completionindex.h \
     darkfusionstyle.h \
+    datapackidlist.h \
+    datapackindex.h \
     datapackfileiconprovider.h \
     datapacktreeview.h \
     datawidgetcontroller.h \
@@ -170,12 +192,15 @@ HEADERS += \
     filenamedelegate.h \
     fileswitcher.h \
     game.h \
+    gamedatabundle.h \
+    gamedatacache.h \
     gameinfomodel.h \
     globalhelpers.h \
     highlighter.h \
     imgviewer.h \
     inventoryitem.h \
     inventoryitemfiltermodel.h \
+    inventoryitemmodel.h \
     inventoryslot.h \
     inventorysloteditor.h \
     itemconditiondialog.h \
@@ -192,6 +217,7 @@ HEADERS += \
     loottablefunction.h \
     loottablepool.h \
     mainwindow.h \
+    mappedfile.h \
     mcbuildhighlighter.h \
     mcdatapacker_pch.h \
     mcfunctionhighlighter.h \
@@ -199,6 +225,7 @@ HEADERS += \
     nbttextobjectdialog.h \
     newdatapackdialog.h \
     norwegianwoodstyle.h \
+    parsers/charset.h \
     parsers/command/mcfunctionparser.h \
     parsers/command/nodes/anglenode.h \
     parsers/command/nodes/argumentnode.h \
@@ -228,9 +255,11 @@ HEADERS += \
     parsers/command/nodes/targetselectornode.h \
     parsers/command/nodes/timenode.h \
     parsers/command/parsenodecache.h \
+    parsers/command/parseresultcache.h \
     parsers/command/minecraftparser.h \
     parsers/command/re2c_functions.re \
     parsers/command/re2c_generated_functions.h \
+    parsers/command/schema/compiledschema.h \
     parsers/command/schema/schemaargumentnode.h \
     parsers/command/schema/schemaliteralnode.h \
     parsers/command/schema/schemaloader.h \
@@ -242,16 +271,23 @@ HEADERS += \
     parsers/command/visitors/nodeformatter.h \
     parsers/command/visitors/overloadnodevisitor.h \
     parsers/command/visitors/reprprinter.h \
+    parsers/command/visitors/semanticvalidator.h \
     parsers/command/visitors/sourceprinter.h \
+    parsers/command/visitors/symbolcollector.h \
+    parsers/jsonnode.h \
     parsers/jsonparser.h \
+    parsers/jsonschema.h \
+    parsers/jsonvalidator.h \
     parsers/linesplitter.h \
     parsers/parser.h \
+    parsers/textspan.h \
     platforms/windows_specific.h \
     predicatedock.h \
     problemarea.h \
     rawjsontextedit.h \
     rawjsontexteditor.h \
     rawjsontextobjectinterface.h \
+    referencesmenu.h \
     scoreboardtextobjectdialog.h \
     settingsdialog.h \
     stackedwidget.h \
@@ -259,9 +295,11 @@ HEADERS += \
     statusbar.h \
     stringvectormodel.h \
     stripedscrollbar.h \
+    symbolindex.h \
 #    stylesheetreapplier.h \ # Already added in mcdatapackerwidgets.pri
     tabbeddocumentinterface.h \
     tagselectordialog.h \
+    textureatlas.h \
     translatedtextobjectdialog.h \
     truefalsebox.h \
     vieweventfilter.h \
@@ -323,7 +361,62 @@ RESOURCES += \
     ../resource/minecraft/minecraft.qrc \
     ../resource/app/icons/default/default.qrc
 
+win32: PYTHON = python
+else: PYTHON = python3
+
+# Flatten the game data of each version into binary bundles (see
+# tools/build_game_bundle.py), which is rerun by the build when the game data
+# or the tool changes. Without Python, the game data is loaded from the JSON
+# files at runtime instead.
+GAME_BUNDLE_TOOL   = $$PWD/../tools/build_game_bundle.py
+GAME_BUNDLE_DIR    = $$OUT_PWD/gamebundles
+GAME_BUNDLE_INPUTS = $$GAME_BUNDLE_TOOL \
+    $$files($$PWD/../resource/minecraft/info/*.json, true)
+
+system($$PYTHON -c pass) {
+    # The generated qrc file is added to RESOURCES, so rcc embeds it
+    gamebundles.input        = GAME_BUNDLE_INPUTS
+    gamebundles.output       = $$GAME_BUNDLE_DIR/gamebundles.qrc
+    gamebundles.commands     = $$PYTHON $$shell_quote($$GAME_BUNDLE_TOOL) \
+        $$shell_quote($$PWD/../resource/minecraft/info) \
+        $$shell_quote($$GAME_BUNDLE_DIR)
+    gamebundles.CONFIG      += combine no_link
+    gamebundles.variable_out = RESOURCES
+    gamebundles.name         = Building game data bundles
+    QMAKE_EXTRA_COMPILERS   += gamebundles
+} else {
+    warning("Cannot find Python; JSON files will be used.")
+}
+
+# Pack the item and block icons into a prebuilt texture atlas (see
+# tools/build_texture_atlas.py), which is rerun by the build when the icons,
+# the game data or the tool changes. Without Python, the icons are loaded from
+# the PNG files at runtime instead.
+TEXTURE_ATLAS_TOOL   = $$PWD/../tools/build_texture_atlas.py
+TEXTURE_ATLAS_DIR    = $$OUT_PWD/textureatlas
+TEXTURE_ATLAS_INPUTS = $$TEXTURE_ATLAS_TOOL \
+    $$files($$PWD/../resource/minecraft/info/*.json, true) \
+    $$files($$PWD/../resource/minecraft/texture/*.png, true)
+
+system($$PYTHON -c pass) {
+    # The generated qrc file is added to RESOURCES, so rcc embeds it
+    textureatlas.input        = TEXTURE_ATLAS_INPUTS
+    textureatlas.output       = $$TEXTURE_ATLAS_DIR/textureatlas.qrc
+    textureatlas.commands     = $$PYTHON $$shell_quote($$TEXTURE_ATLAS_TOOL) \
+        $$shell_quote($$PWD/../resource/minecraft/info) \
+        $$shell_quote($$PWD/../resource/minecraft/texture) \
+        $$shell_quote($$TEXTURE_ATLAS_DIR)
+    textureatlas.CONFIG      += combine no_link
+    textureatlas.variable_out = RESOURCES
+    textureatlas.name         = Building texture atlas
+    QMAKE_EXTRA_COMPILERS    += textureatlas
+} else {
+    warning("Cannot find Python; PNG files will be used.")
+}
+
 DISTFILES += \
+    ../tools/build_game_bundle.py \
+    ../tools/build_texture_atlas.py \
     ../lib/QFindDialogs/LICENSE \
     ../resource/app/fonts/LICENSE_Monocraft.txt
 
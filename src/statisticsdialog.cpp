@@ -3,19 +3,23 @@
 
 #include "mainwindow.h"
 #include "parsers/command/mcfunctionparser.h"
-#include "parsers/command/nodes/macronode.h"
+#include "parsers/command/parseresultcache.h"
 #include "globalhelpers.h"
+#include "mappedfile.h"
 #include "platforms/windows_specific.h"
 #include "game.h"
 
 #include <QDirIterator>
 #include <QProgressDialog>
+#include <QThreadPool>
 #include <QTableWidgetItem>
 #include <QOperatingSystemVersion>
 #include <QElapsedTimer>
 #include <QTextDocument>
 #include <QTextBlock>
 
+#include <algorithm>
+
 
 StatisticsDialog::StatisticsDialog(MainWindow *parent) :
     QDialog(parent), ui(new Ui::StatisticsDialog) {
@@ -34,8 +38,6 @@ StatisticsDialog::StatisticsDialog(MainWindow *parent) :
                                    QDir::current().dirName(),
                                    m_mainWin->getPackInfo().description));
 
-    m_parser = new Command::McfunctionParser();
-
     QElapsedTimer timer;
     timer.start();
     collectAndSetupData();
@@ -47,7 +49,6 @@ StatisticsDialog::StatisticsDialog(MainWindow *parent) :
 }
 
 StatisticsDialog::~StatisticsDialog() {
-    delete m_parser;
     delete ui;
 }
 
@@ -73,23 +74,35 @@ void StatisticsDialog::collectAndSetupData() {
 
     dir.setFilter(QDir::AllEntries | QDir::NoDotAndDotDot);
 
-    int          entriesCount = 0;
-    QDirIterator counterIt(dir, QDirIterator::Subdirectories);
-    while (counterIt.hasNext()) {
-        counterIt.next();
-        ++entriesCount;
-    }
+    Command::ParseResultCache cache(dirPath);
+
+    ScanJob job;
+    job.dirPath   = dirPath;
+    job.cache     = &cache;
+    job.nodeCache = QSharedPointer<Command::ParseNodeCache>::create();
+    job.schema    = Command::SchemaParser::currentSchema();
 
     QDirIterator  it(dir, QDirIterator::Subdirectories);
-    int           fileCount   = 0;
     int           folderCount = 0;
     QSet<QString> namespaces;
+    while (it.hasNext()) {
+        const QString &&path = it.next();
 
-    QMap<CodeFile::FileType, uint> fileTypeCounts;
+        const auto &&finfo = it.fileInfo();
+        if (finfo.isFile()) {
+            job.filePaths << path;
+        } else if (finfo.isDir()) {
+            ++folderCount;
+            const QString &&nspace = Glhp::relNamespace(dirPath, path);
+            if (!nspace.isEmpty())
+                namespaces += nspace;
+        }
+    }
+    const int fileCount = job.filePaths.size();
 
     hide();
-    QProgressDialog progress(QString(), tr("Abort"), 0,
-                             entriesCount, this);
+    QProgressDialog progress(tr("Scanning %Ln file(s)...", nullptr, fileCount),
+                             tr("Abort"), 0, fileCount, this);
     progress.setWindowTitle(tr("Scanning datapack..."));
     /*progress.setMinimumDuration(1000); */
     progress.setWindowModality(Qt::WindowModal);
@@ -98,36 +111,45 @@ void StatisticsDialog::collectAndSetupData() {
     const auto hostRect = geometry();
     progress.move(hostRect.center() - progress.rect().center());
 
-    int i = 0;
-    while (it.hasNext()) {
-        const QString &&path = it.next();
-        ++i;
-
-        progress.setValue(i);
-        progress.setLabelText(tr("Currently scanning: %1").arg(
-                                  Glhp::relPath(dirPath, path)));
-        if (progress.wasCanceled())
-            break;
-
-        const auto &&finfo = it.fileInfo();
-        if (finfo.isFile()) {
-            ++fileCount;
-
-            const auto type = Glhp::pathToFileType(dirPath, path);
-            if (type == CodeFile::Function)
-                collectFunctionData(path);
-            if (fileTypeCounts.contains(type))
-                ++fileTypeCounts[type];
-            else
-                fileTypeCounts[type] = 1;
-        } else if (finfo.isDir()) {
-            ++folderCount;
-            const QString &&nspace = Glhp::relNamespace(dirPath, path);
-            if (!nspace.isEmpty())
-                namespaces += nspace;
+    // Each worker owns its parser and counters, which are merged afterwards
+    QThreadPool pool;
+    const int   workerCount = qBound(1, pool.maxThreadCount(), fileCount);
+    QVector<ScanResult> results(workerCount);
+    for (auto &result: results) {
+        pool.start([&job, &result]() {
+            scanFiles(job, result);
+        });
+    }
+    while (!pool.waitForDone(50)) {
+        if (progress.wasCanceled()) {
+            job.isCanceled.storeRelaxed(1);
         }
+        progress.setValue(job.doneCount.loadRelaxed());
+        QCoreApplication::processEvents();
+    }
+    progress.setValue(fileCount);
+    if (!job.isCanceled.loadRelaxed()) {
+        cache.save();
+    }
+
+    QMap<CodeFile::FileType, uint> fileTypeCounts;
+    for (const auto &result: qAsConst(results)) {
+        mergeScanResult(result, fileTypeCounts);
+    }
+    // Workers finish in any order, so the errors are sorted by location
+    std::stable_sort(m_syntaxErrorsInfo.begin(), m_syntaxErrorsInfo.end(),
+                     [](const SyntaxErrorInfo &a, const SyntaxErrorInfo &b) {
+        return (a.path != b.path) ? (a.path < b.path) : (a.line < b.line);
+    });
+
+    for (const auto &error: qAsConst(m_syntaxErrorsInfo)) {
+        const int row = ui->syntaxErrorTable->rowCount();
+        ui->syntaxErrorTable->insertRow(row);
+        ui->syntaxErrorTable->setItem(row, 0, new QTableWidgetItem(error.path));
+        ui->syntaxErrorTable->setItem(
+            row, 1, new QTableWidgetItem(QString::number(error.line)));
+        ui->syntaxErrorTable->setItem(row, 2, new QTableWidgetItem(error.msg));
     }
-    progress.setValue(entriesCount);
 
     /* "General" tab */
 
@@ -215,83 +237,81 @@ void StatisticsDialog::collectAndSetupData() {
     show();
 }
 
-void StatisticsDialog::collectFunctionData(const QString &path) {
-    QString text;
+void StatisticsDialog::mergeScanResult(
+    const ScanResult &result, QMap<CodeFile::FileType, uint> &fileTypeCounts) {
+    for (auto it = result.fileTypeCounts.cbegin();
+         it != result.fileTypeCounts.cend(); ++it) {
+        fileTypeCounts[it.key()] += it.value();
+    }
+    m_nodeCounter.merge(result.nodeCounter);
+    m_syntaxErrorsInfo += result.syntaxErrors;
+    m_commandLines     += result.commandLines;
+    m_commentLines     += result.commentLines;
+    m_macroLines       += result.macroLines;
+    m_syntaxErrors     += result.syntaxErrors.size();
+}
 
-    if (QFile file(path); file.open(QFile::ReadOnly | QFile::Text)) {
-        QTextStream in(&file);
-        in.setCodec("UTF-8");
+/*!
+ * \brief Takes files from the \a job until there are none left or the job
+ * has been canceled, and collects their statistics into the \a result.
+ *
+ * This function is run by each worker thread.
+ */
+void StatisticsDialog::scanFiles(ScanJob &job, ScanResult &result) {
+    Command::McfunctionParser parser;
+
+    parser.setNodeCache(job.nodeCache);
+    parser.setSchema(job.schema);
+
+    const int fileCount = job.filePaths.size();
+    for (int i = job.nextIndex.fetchAndAddRelaxed(1); i < fileCount;
+         i = job.nextIndex.fetchAndAddRelaxed(1)) {
+        if (job.isCanceled.loadRelaxed())
+            break;
 
-        text = in.readAll();
+        const QString &path = job.filePaths.at(i);
+        const auto     type = Glhp::pathToFileType(job.dirPath, path);
+        if (type == CodeFile::Function)
+            collectFunctionData(path, job, parser, result);
+        ++result.fileTypeCounts[type];
+        job.doneCount.fetchAndAddRelaxed(1);
     }
+}
 
-    if (!text.isNull()) {
-        Q_ASSERT(m_parser != nullptr);
-        m_parser->parse(text);
-        if (m_parser->errors().isEmpty()) {
-            if (m_parser->syntaxTree()->isValid()) {
-                const auto &lines = m_parser->syntaxTree()->lines();
-                for (const auto &logiLine: lines) {
-                    switch (logiLine->kind()) {
-                        case Command::ParseNode::Kind::Span: {
-                            const auto span =
-                                static_cast<Command::SpanNode *>(logiLine.get());
-                            const auto &trimmed = span->text().trimmed();
-                            if (trimmed.isEmpty()) {
-                                continue;
-                            } else if (trimmed.front() == '#'_QL1) {
-                                ++m_commentLines;
-                                break;
-                            }
-                        }
-                        case Command::ParseNode::Kind::Macro: {
-                            const auto macro =
-                                static_cast<Command::MacroNode *>(logiLine.get());
-                            if (macro->isValid()) {
-                                ++m_macroLines;
-                            }
-                            break;
-                        }
-                        case Command::ParseNode::Kind::Root: {
-                            const auto root =
-                                static_cast<Command::RootNode *>(logiLine.get());
-                            if (root->isValid()) {
-                                m_nodeCounter.startVisiting(root);
-                                ++m_commandLines;
-                            }
-                        }
-                        default: {
-                        }
-                    }
-                }
-            } else {
-                const int row = ui->syntaxErrorTable->rowCount();
-                ui->syntaxErrorTable->insertRow(row);
-                ui->syntaxErrorTable->setItem(
-                    row, 0,
-                    new QTableWidgetItem(Glhp::relPath(m_dirPath, path)));
-                ui->syntaxErrorTable->setItem(
-                    row, 1, new QTableWidgetItem("1"));
-                ui->syntaxErrorTable->setItem(0, 2, new QTableWidgetItem(
-                                                  tr("Invalid command")));
-                ++m_syntaxErrors;
-            }
-        } else {
-            const auto doc = std::make_unique<QTextDocument>(text);
-            for (const auto &error: qAsConst(m_parser->errors())) {
-                const int row = ui->syntaxErrorTable->rowCount();
-                ui->syntaxErrorTable->insertRow(row);
-                const int line = doc->findBlock(error.pos).blockNumber() + 1;
-                ui->syntaxErrorTable->setItem(
-                    row, 0,
-                    new QTableWidgetItem(Glhp::relPath(m_dirPath, path)));
-                ui->syntaxErrorTable->setItem(
-                    row, 1, new QTableWidgetItem(QString::number(line)));
-                ui->syntaxErrorTable->setItem(
-                    row, 2, new QTableWidgetItem(
-                        error.toLocalizedMessage()));
-                ++m_syntaxErrors;
-            }
+void StatisticsDialog::collectFunctionData(const QString &path,
+                                           const ScanJob &job,
+                                           Command::McfunctionParser &parser,
+                                           ScanResult &result) {
+    const QString &&text = MappedFile::readText(path);
+
+    if (text.isNull()) {
+        return;
+    }
+
+    // Unchanged files are loaded from the cache instead of being parsed
+    const auto &&cacheKey = Command::ParseResultCache::keyOf(text,
+                                                             job.schema);
+    Command::ParseResultCache::Entry entry;
+    if (!job.cache->lookup(cacheKey, entry)) {
+        parser.parse(text);
+        entry = Command::ParseResultCache::Entry::fromParser(parser, text);
+        job.cache->insert(cacheKey, entry);
+    }
+
+    const QString &&relPath = Glhp::relPath(job.dirPath, path);
+    if (!entry.errors.isEmpty()) {
+        for (int i = 0; i < entry.errors.size(); ++i) {
+            result.syntaxErrors << SyntaxErrorInfo{
+                relPath, entry.errors.at(i).toLocalizedMessage(),
+                entry.errorLines.value(i, 1) };
         }
+    } else if (!entry.isValid) {
+        result.syntaxErrors << SyntaxErrorInfo{
+            relPath, tr("Invalid command"), 1 };
+    } else {
+        result.nodeCounter.merge(entry.nodeCounter);
+        result.commandLines += entry.commandLines;
+        result.commentLines += entry.commentLines;
+        result.macroLines   += entry.macroLines;
     }
 }
@@ -1,7 +1,10 @@
 #ifndef STATISTICSDIALOG_H
 #define STATISTICSDIALOG_H
 
+#include "codefile.h"
+
 #include <QDialog>
+#include <QAtomicInt>
 
 #include "parsers/command/visitors/nodecounter.h"
 
@@ -12,7 +15,10 @@ namespace Ui {
 
 namespace Command {
     class McfunctionParser;
-};
+    class ParseNodeCache;
+    class ParseResultCache;
+    class SchemaSnapshot;
+}
 
 class MainWindow;
 
@@ -26,6 +32,34 @@ class StatisticsDialog : public QDialog
         int     line = -1;
     };
 
+    /*!
+     * \brief The files to be scanned, which are shared by all workers.
+     */
+    struct ScanJob {
+        QStringList                filePaths;
+        QString                    dirPath;
+        Command::ParseResultCache *cache = nullptr;
+        // Lines shared by files are parsed once across workers
+        QSharedPointer<Command::ParseNodeCache> nodeCache;
+        // All files are parsed with the same schema
+        QSharedPointer<const Command::SchemaSnapshot> schema;
+        QAtomicInt                 nextIndex  = 0;
+        QAtomicInt                 doneCount  = 0;
+        QAtomicInt                 isCanceled = 0;
+    };
+
+    /*!
+     * \brief The statistics collected by a single worker.
+     */
+    struct ScanResult {
+        QVector<SyntaxErrorInfo>       syntaxErrors;
+        QMap<CodeFile::FileType, uint> fileTypeCounts;
+        Command::NodeCounter           nodeCounter;
+        uint                           commandLines = 0;
+        uint                           commentLines = 0;
+        uint                           macroLines   = 0;
+    };
+
 public:
     explicit StatisticsDialog(MainWindow *parent = nullptr);
     ~StatisticsDialog();
@@ -40,8 +74,7 @@ private:
     QVector<SyntaxErrorInfo> m_syntaxErrorsInfo;
     QString m_dirPath;
     Ui::StatisticsDialog *ui;
-    MainWindow *m_mainWin               = nullptr;
-    Command::McfunctionParser *m_parser = nullptr;
+    MainWindow *m_mainWin = nullptr;
     Command::NodeCounter m_nodeCounter;
     uint m_commandLines = 0;
     uint m_commentLines = 0;
@@ -49,7 +82,13 @@ private:
     uint m_syntaxErrors = 0;
 
     void collectAndSetupData();
-    void collectFunctionData(const QString &path);
+    void mergeScanResult(const ScanResult &result,
+                         QMap<CodeFile::FileType, uint> &fileTypeCounts);
+
+    static void scanFiles(ScanJob &job, ScanResult &result);
+    static void collectFunctionData(const QString &path, const ScanJob &job,
+                                    Command::McfunctionParser &parser,
+                                    ScanResult &result);
 };
 
 #endif /* STATISTICSDIALOG_H */
@@ -6,6 +6,8 @@
 #include <QStyleOptionSlider>
 #include <QTextBlock>
 
+#include <algorithm>
+
 StripedScrollBar::StripedScrollBar(Qt::Orientation orientation, QWidget *parent)
     : QScrollBar(orientation, parent) {
     if (auto *editor = qobject_cast<CodeEditor *>(parent)) {
@@ -28,53 +30,132 @@ void StripedScrollBar::resizeEvent(QResizeEvent *event) {
     redrawStripes();
 }
 
+/*!
+ * \brief Updates the stripes of the problems of the editor.
+ *
+ * Problems are mapped to their blocks through the document instead of
+ * visiting every block, and problems which fall on the same row are drawn
+ * as one stripe. If neither the geometry nor the line count has changed,
+ * only the stripes which differ from the previous ones are redrawn.
+ */
 void StripedScrollBar::redrawStripes() {
-    static const QColor errorColor(255, 0, 0, 100);
-    static const QColor warningColor(255, 255, 0, 100);
-
-    m_stripes = QPixmap(size());
-    m_stripes.fill(Qt::transparent);
-    QPainter p(&m_stripes);
-    p.setPen(Qt::NoPen);
-
     Q_ASSERT(m_editor->document());
-    auto     *doc   = m_editor->document();
-    const int lines = doc->blockCount();
+    if (orientation() != Qt::Vertical) {
+        return;
+    }
 
     QStyleOptionSlider option;
     option.initFrom(this);
     option.orientation = orientation();
-    const auto &&r = style()->subControlRect(QStyle::CC_ScrollBar, &option,
-                                             QStyle::SC_ScrollBarGroove, this);
-    int x, y, w, h;
-    r.getRect(&x, &y, &w, &h);
-
-    const auto &problems    = m_editor->m_problems;
-    auto       *prevProblem = problems.cbegin();
-    auto        block       = doc->firstBlock();
-
-    const auto predicate = [&block](const ProblemInfo &problem) {
-                               return block.contains(problem.pos);
-                           };
-
-    if (orientation() == Qt::Vertical) {
-        for (; block != doc->end(); block = block.next()) {
-            const int stripeY = y + (h * block.blockNumber() / lines);
-            int       i       = 0;
-            for (auto problem =
-                     std::find_if(prevProblem, problems.cend(), predicate);
-                 (problem != problems.cend()) && block.contains(problem->pos);
-                 ++problem) {
-                p.setBrush((problem->type == ProblemInfo::Type::Error)
-                            ? errorColor : warningColor);
-                const int stripeThickness = qBound(1, h / lines, 32);
-                p.drawRect(x, stripeY, w, stripeThickness);
-
-                prevProblem = problem;
-                ++i;
-                if (i >= 3)
-                    break;
+    const auto &&groove = style()->subControlRect(
+        QStyle::CC_ScrollBar, &option, QStyle::SC_ScrollBarGroove, this);
+    const int lines = m_editor->document()->blockCount();
+
+    const bool isFullRedraw = (m_stripes.size() != size())
+                              || (groove != m_groove)
+                              || (lines != m_lineCount);
+
+    m_groove    = groove;
+    m_lineCount = lines;
+
+    QVector<Stripe> stripes = stripesOf(m_editor->m_problems);
+
+    if (isFullRedraw) {
+        if (m_stripes.size() != size()) {
+            m_stripes = QPixmap(size());
+        }
+        m_stripes.fill(Qt::transparent);
+
+        QPainter p(&m_stripes);
+        p.setPen(Qt::NoPen);
+        for (const auto &stripe: stripes) {
+            drawStripe(p, stripe);
+        }
+    } else {
+        QPainter p(&m_stripes);
+        p.setPen(Qt::NoPen);
+
+        // Both lists are sorted by position, so they are compared in one pass
+        const auto *oldIt  = m_drawnStripes.cbegin();
+        const auto *oldEnd = m_drawnStripes.cend();
+        const auto *newIt  = stripes.cbegin();
+        const auto *newEnd = stripes.cend();
+        while ((oldIt != oldEnd) || (newIt != newEnd)) {
+            if ((newIt == newEnd)
+                || ((oldIt != oldEnd) && (oldIt->y < newIt->y))) {
+                clearStripe(p, *oldIt);
+                ++oldIt;
+            } else if ((oldIt == oldEnd) || (newIt->y < oldIt->y)) {
+                drawStripe(p, *newIt);
+                ++newIt;
+            } else {
+                if (!(*oldIt == *newIt)) {
+                    clearStripe(p, *oldIt);
+                    drawStripe(p, *newIt);
+                }
+                ++oldIt;
+                ++newIt;
             }
         }
     }
+    m_drawnStripes = std::move(stripes);
+}
+
+/*!
+ * \brief Returns the stripes of the \a problems sorted by position, with
+ * at most one stripe per row. Errors take precedence over warnings.
+ */
+QVector<StripedScrollBar::Stripe> StripedScrollBar::stripesOf(
+    const QVector<ProblemInfo> &problems) const {
+    const auto     *doc = m_editor->document();
+    QVector<Stripe> stripes;
+
+    stripes.reserve(problems.size());
+    for (const auto &problem: problems) {
+        QTextBlock block = doc->findBlock(problem.pos);
+        if (!block.isValid()) {
+            block = doc->lastBlock();
+        }
+        stripes << Stripe{
+            m_groove.y() + (m_groove.height() * block.blockNumber()
+                            / m_lineCount),
+            problem.type == ProblemInfo::Type::Error };
+    }
+    std::sort(stripes.begin(), stripes.end(),
+              [](const Stripe &a, const Stripe &b) {
+        return a.y < b.y;
+    });
+
+    int count = 0;
+    for (int i = 0; i < stripes.size(); ++i) {
+        if ((count > 0) && (stripes[count - 1].y == stripes[i].y)) {
+            stripes[count - 1].isError |= stripes[i].isError;
+        } else {
+            stripes[count++] = stripes[i];
+        }
+    }
+    stripes.resize(count);
+    return stripes;
+}
+
+void StripedScrollBar::drawStripe(QPainter &painter,
+                                  const Stripe &stripe) const {
+    static const QColor errorColor(255, 0, 0, 100);
+    static const QColor warningColor(255, 255, 0, 100);
+
+    painter.setBrush(stripe.isError ? errorColor : warningColor);
+    painter.drawRect(m_groove.x(), stripe.y,
+                     m_groove.width(), stripeThickness());
+}
+
+void StripedScrollBar::clearStripe(QPainter &painter,
+                                   const Stripe &stripe) const {
+    painter.setCompositionMode(QPainter::CompositionMode_Clear);
+    painter.fillRect(m_groove.x(), stripe.y,
+                     m_groove.width(), stripeThickness(), Qt::transparent);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+}
+
+int StripedScrollBar::stripeThickness() const {
+    return qBound(1, m_groove.height() / m_lineCount, 32);
 }
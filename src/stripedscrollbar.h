@@ -4,6 +4,7 @@
 #include <QScrollBar>
 
 class CodeEditor;
+struct ProblemInfo;
 
 class StripedScrollBar : public QScrollBar {
     Q_OBJECT
@@ -17,8 +18,25 @@ protected:
     void resizeEvent(QResizeEvent *event) override;
 
 private:
+    struct Stripe {
+        int  y       = 0;
+        bool isError = false;
+
+        bool operator==(const Stripe &other) const {
+            return (y == other.y) && (isError == other.isError);
+        }
+    };
+
     CodeEditor *m_editor = nullptr;
     QPixmap m_stripes;
+    QVector<Stripe> m_drawnStripes;
+    QRect m_groove;
+    int m_lineCount = 0;
+
+    QVector<Stripe> stripesOf(const QVector<ProblemInfo> &problems) const;
+    void drawStripe(QPainter &painter, const Stripe &stripe) const;
+    void clearStripe(QPainter &painter, const Stripe &stripe) const;
+    int stripeThickness() const;
 };
 
 #endif /* STRIPEDSCROLLBAR_H */
@@ -0,0 +1,517 @@
+#include "symbolindex.h"
+
+#include "datapackindex.h"
+#include "globalhelpers.h"
+#include "mappedfile.h"
+#include "parsers/command/mcfunctionparser.h"
+
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+
+#include <algorithm>
+#include <tuple>
+
+/*!
+ * \class SymbolIndex
+ * \brief An index of where the functions, function tags, scoreboard
+ * objectives, storages, teams and bossbars of the opened datapack are defined
+ * and used.
+ *
+ * Each symbol has a posting list of its locations, which are small
+ * fixed-size records referring to files by their IDs. Each file keeps the
+ * symbols it has postings in, so that a file can be indexed again without
+ * touching the other ones. The IDs of removed files and of symbols without
+ * postings are reused, so the index doesn't grow as files are edited.
+ *
+ * Besides functions, function tags list functions and tags, and advancements
+ * run functions as rewards.
+ *
+ * The index follows the DatapackIndex: when files are added or removed, only
+ * the files whose modification time or size has changed are parsed again,
+ * in background threads. Saved files are updated by updateFile().
+ * The index can be read from any thread.
+ */
+
+SymbolIndex::SymbolIndex(QObject *parent) : QObject(parent) {
+    m_indexer.setMaxThreadCount(1);
+    connect(DatapackIndex::instance(), &DatapackIndex::idsChanged,
+            this, &SymbolIndex::onIdsChanged);
+}
+
+SymbolIndex::~SymbolIndex() {
+    m_generation.fetchAndAddRelaxed(1);
+    m_indexer.waitForDone();
+}
+
+/*!
+ * \brief Returns the index, which is created on the first call.
+ *
+ * Like the DatapackIndex, the index is owned by the application object,
+ * which destroys its children in the order they were created. The first
+ * call must be made before the DatapackIndex is created, so that indexing
+ * threads are stopped before the DatapackIndex is destroyed.
+ */
+SymbolIndex * SymbolIndex::instance() {
+    static auto *index = new SymbolIndex(qApp);
+
+    return index;
+}
+
+/*!
+ * \brief Indexes the file at \a path again if it's a function or
+ * a function tag of the datapack.
+ */
+void SymbolIndex::updateFile(const QString &path) {
+    QString dirPath;
+    {
+        QReadLocker locker(&m_lock);
+        dirPath = m_dirPath;
+    }
+    if (dirPath.isEmpty()
+        || !path.startsWith(dirPath + QStringLiteral("/data/"))) {
+        return;
+    }
+
+    const int generation = m_generation.loadRelaxed();
+    m_indexer.start([this, generation, dirPath, path]() {
+        index(generation, dirPath, { path }, false);
+    });
+}
+
+/*!
+ * \brief Returns the locations of the symbol of the \a kind named \a name,
+ * sorted by their paths and lines.
+ */
+QVector<SymbolIndex::Location> SymbolIndex::locations(const Kind kind,
+                                                      const QString &name)
+const {
+    QReadLocker locker(&m_lock);
+
+    const int symbol = m_symbolIds[int(kind)].value(name, -1);
+
+    if (symbol == -1) {
+        return {};
+    }
+
+    const auto       &postings = m_symbols.at(symbol).postings;
+    QVector<Location> ret;
+    ret.reserve(postings.size());
+    for (const auto &posting: postings) {
+        ret << Location{ m_files.at(posting.file).path, posting.line,
+                         posting.column, posting.length, posting.role };
+    }
+    locker.unlock();
+
+    std::sort(ret.begin(), ret.end(), [](const Location &a,
+                                         const Location &b) {
+        return std::tie(a.path, a.line, a.column)
+               < std::tie(b.path, b.line, b.column);
+    });
+    return ret;
+}
+
+/*!
+ * \brief Returns the IDs of the functions which are defined in the datapack
+ * but neither called, listed in a function tag nor rewarded by
+ * an advancement.
+ */
+QVector<QString> SymbolIndex::unusedFunctions() const {
+    QReadLocker      locker(&m_lock);
+    QVector<QString> ret;
+
+    const auto &functions = m_symbolIds[int(Kind::Function)];
+    for (auto it = functions.cbegin(); it != functions.cend(); ++it) {
+        bool isDefined = false;
+        bool isUsed    = false;
+        for (const auto &posting: m_symbols.at(it.value()).postings) {
+            if (posting.role == Role::Definition) {
+                isDefined = true;
+            } else {
+                isUsed = true;
+                break;
+            }
+        }
+        if (isDefined && !isUsed) {
+            ret << it.key();
+        }
+    }
+    locker.unlock();
+
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+void SymbolIndex::onIdsChanged() {
+    const auto     *datapack = DatapackIndex::instance();
+    const QString &&dirPath  = datapack->dirPath();
+    int             generation;
+    {
+        QWriteLocker locker(&m_lock);
+        if (dirPath != m_dirPath) {
+            // Another datapack has been opened, abandon the pending updates
+            m_dirPath = dirPath;
+            for (auto &symbolIds: m_symbolIds) {
+                symbolIds.clear();
+            }
+            m_symbols.clear();
+            m_files.clear();
+            m_freeSymbolIds.clear();
+            m_freeFileIds.clear();
+            m_fileIds.clear();
+            m_generation.fetchAndAddRelaxed(1);
+        }
+        generation = m_generation.loadRelaxed();
+    }
+    if (dirPath.isEmpty()) {
+        emit symbolsChanged();
+        return;
+    }
+
+    QStringList paths;
+    for (const auto &entry: datapack->entries(QStringLiteral("functions"))) {
+        if (entry.path.endsWith(QLatin1String(".mcfunction"))) {
+            paths << entry.path;
+        }
+    }
+    for (const auto &entry:
+         datapack->entries(QStringLiteral("tags/functions"))) {
+        if (entry.path.endsWith(QLatin1String(".json"))) {
+            paths << entry.path;
+        }
+    }
+    for (const auto &entry: datapack->entries(QStringLiteral("advancements"))) {
+        if (entry.path.endsWith(QLatin1String(".json"))) {
+            paths << entry.path;
+        }
+    }
+
+    m_indexer.start([this, generation, dirPath, paths]() {
+        index(generation, dirPath, paths, true);
+    });
+}
+
+/*!
+ * \brief Indexes the files at \a paths which have changed since they were
+ * indexed. If \a isFullScan is true, \a paths are all the files to index and
+ * the other files are removed from the index.
+ *
+ * This method runs in the indexer thread. The files are parsed by a pool of
+ * workers, and the changes are discarded if another datapack has been opened
+ * in the meantime.
+ */
+void SymbolIndex::index(const int generation, const QString &dirPath,
+                        const QStringList &paths, const bool isFullScan) {
+    QStringList  changedPaths;
+    QVector<int> removedFiles;
+    {
+        QReadLocker locker(&m_lock);
+        if (generation != m_generation.loadRelaxed()) {
+            return;
+        }
+
+        for (const auto &path: paths) {
+            const QFileInfo info(path);
+            const int       fileId = m_fileIds.value(path, -1);
+            if (!info.isFile()) {
+                if (fileId != -1) {
+                    removedFiles << fileId;
+                }
+                continue;
+            }
+            if (fileId != -1) {
+                const auto &file = m_files.at(fileId);
+                if ((file.lastModified == info.lastModified())
+                    && (file.size == info.size())) {
+                    continue;
+                }
+            }
+            changedPaths << path;
+        }
+        if (isFullScan) {
+            const QSet<QString> pathSet(paths.cbegin(), paths.cend());
+            for (auto it = m_fileIds.cbegin(); it != m_fileIds.cend(); ++it) {
+                if (!pathSet.contains(it.key())) {
+                    removedFiles << it.value();
+                }
+            }
+        }
+    }
+    if (changedPaths.isEmpty() && removedFiles.isEmpty()) {
+        return;
+    }
+
+    // Each worker owns its parser and takes the next file until none is left
+    QVector<FileSymbols> results(changedPaths.size());
+    QAtomicInt           nextIndex = 0;
+    QThreadPool          pool;
+    const int            workerCount = qBound(1, pool.maxThreadCount(),
+                                              changedPaths.size());
+    for (int worker = 0; worker < workerCount; ++worker) {
+        pool.start([this, generation, &dirPath, &changedPaths, &results,
+                    &nextIndex]() {
+            Command::McfunctionParser parser;
+
+            const int fileCount = changedPaths.size();
+            for (int i = nextIndex.fetchAndAddRelaxed(1); i < fileCount;
+                 i = nextIndex.fetchAndAddRelaxed(1)) {
+                if (generation != m_generation.loadRelaxed()) {
+                    break;
+                }
+                results[i] = readFile(dirPath, changedPaths.at(i), parser);
+            }
+        });
+    }
+    pool.waitForDone();
+
+    {
+        QWriteLocker locker(&m_lock);
+        if (generation != m_generation.loadRelaxed()) {
+            return;
+        }
+        for (const int fileId: qAsConst(removedFiles)) {
+            removeFile(fileId);
+        }
+        for (auto &result: results) {
+            addFile(std::move(result));
+        }
+    }
+    QMetaObject::invokeMethod(this, [this]() {
+        emit symbolsChanged();
+    }, Qt::QueuedConnection);
+}
+
+/*!
+ * \brief Replaces the postings of the file of the \a symbols.
+ * The index must be locked for writing.
+ */
+void SymbolIndex::addFile(FileSymbols &&symbols) {
+    int fileId = m_fileIds.value(symbols.path, -1);
+
+    if (fileId == -1) {
+        if (!m_freeFileIds.isEmpty()) {
+            fileId          = m_freeFileIds.takeLast();
+            m_files[fileId] = FileEntry{ symbols.path, QDateTime(), 0, {} };
+        } else {
+            fileId = m_files.size();
+            m_files << FileEntry{ symbols.path, QDateTime(), 0, {} };
+        }
+        m_fileIds.insert(symbols.path, fileId);
+    } else {
+        removePostings(fileId);
+    }
+
+    auto &file = m_files[fileId];
+    file.lastModified = symbols.lastModified;
+    file.size         = symbols.size;
+    for (auto &occurrence: symbols.occurrences) {
+        auto &symbolIds = m_symbolIds[int(occurrence.kind)];
+        int   symbol    = symbolIds.value(occurrence.name, -1);
+        if (symbol == -1) {
+            SymbolEntry entry{ occurrence.name, {}, occurrence.kind };
+            if (!m_freeSymbolIds.isEmpty()) {
+                symbol            = m_freeSymbolIds.takeLast();
+                m_symbols[symbol] = std::move(entry);
+            } else {
+                symbol = m_symbols.size();
+                m_symbols << std::move(entry);
+            }
+            symbolIds.insert(std::move(occurrence.name), symbol);
+        }
+        m_symbols[symbol].postings << Posting{
+            fileId, occurrence.line, occurrence.column,
+            quint16(qMin(occurrence.length, 0xFFFF)), occurrence.role };
+        file.symbols << symbol;
+    }
+    std::sort(file.symbols.begin(), file.symbols.end());
+    file.symbols.erase(std::unique(file.symbols.begin(), file.symbols.end()),
+                       file.symbols.end());
+}
+
+/*!
+ * \brief Removes the file and its postings. Its ID is reused by the next
+ * added file. The index must be locked for writing.
+ */
+void SymbolIndex::removeFile(const int fileId) {
+    removePostings(fileId);
+    m_fileIds.remove(m_files.at(fileId).path);
+    m_files[fileId] = FileEntry();
+    m_freeFileIds << fileId;
+}
+
+/*!
+ * \brief Removes the postings of the file, and the symbols which have no
+ * postings left. The index must be locked for writing.
+ */
+void SymbolIndex::removePostings(const int fileId) {
+    auto &file = m_files[fileId];
+
+    for (const int symbol: qAsConst(file.symbols)) {
+        auto &entry    = m_symbols[symbol];
+        auto &postings = entry.postings;
+        postings.erase(std::remove_if(postings.begin(), postings.end(),
+                                      [fileId](const Posting &posting) {
+            return posting.file == fileId;
+        }), postings.end());
+        if (postings.isEmpty()) {
+            m_symbolIds[int(entry.kind)].remove(entry.name);
+            entry = SymbolEntry();
+            m_freeSymbolIds << symbol;
+        }
+    }
+    file.symbols.clear();
+}
+
+/*!
+ * \brief Collects the symbols which the function, function tag or
+ * advancement file at \a path defines and uses.
+ *
+ * This function is run by each worker thread.
+ */
+SymbolIndex::FileSymbols SymbolIndex::readFile(
+    const QString &dirPath, const QString &path,
+    Command::McfunctionParser &parser) {
+    using Command::SymbolCollector;
+
+    const QFileInfo info(path);
+    FileSymbols     ret{ path, info.lastModified(), info.size(), {} };
+
+    const QString &&text = MappedFile::readText(path);
+    if (text.isNull()) {
+        return ret;
+    }
+
+    const auto      type = Glhp::pathToFileType(dirPath, path);
+    const QString &&id   = Glhp::toNamespacedID(dirPath, path, true);
+    if (type == CodeFile::Function) {
+        ret.occurrences << Occurrence{ id, Kind::Function, Role::Definition,
+                                       0, 0, 0 };
+
+        parser.parse(text);
+
+        const auto &&tree         = parser.syntaxTree();
+        const auto  &mapper       = tree->sourceMapper();
+        const auto  &backslashMap = mapper.backslashMap;
+        const auto &&lines        = tree->lines();
+        SymbolCollector collector;
+        int             physLine      = 0; // Of the position below
+        int             physLineStart = 0;
+        for (int i = 0; i < lines.size(); ++i) {
+            auto *line = lines.at(i).get();
+            if (line->kind() != Command::ParseNode::Kind::Root) {
+                continue;
+            }
+            collector.startVisiting(line);
+
+            const int firstLine = mapper.logicalLines.value(i, i);
+            for (; physLine < firstLine; ++physLine) {
+                physLineStart = text.indexOf('\n', physLineStart) + 1;
+            }
+            const int lineStart = mapper.logicalPosOf(physLineStart);
+            for (const auto &symbol: collector.symbols()) {
+                // Each line continuation before the symbol moves it to
+                // the next physical line, after the indentation
+                const int logiPos = lineStart + symbol.pos;
+                int       line    = firstLine;
+                int       column  = symbol.pos;
+                for (auto it = backslashMap.lowerBound(lineStart);
+                     (it != backslashMap.cend()) && (it.key() <= logiPos);
+                     ++it) {
+                    ++line;
+                    column = logiPos - it.key() + it->trivia.length() - 2;
+                }
+                ret.occurrences << Occurrence{
+                    symbol.name, symbol.kind, symbol.role, line, column,
+                    symbol.length };
+            }
+            collector.reset();
+        }
+    } else if (type == CodeFile::FunctionTag) {
+        ret.occurrences << Occurrence{ id, Kind::FunctionTag,
+                                       Role::Definition, 0, 0, 0 };
+        readTagValues(text, ret.occurrences);
+    } else if (type == CodeFile::Advancement) {
+        readAdvancementRewards(text, ret.occurrences);
+    }
+    return ret;
+}
+
+/*!
+ * \brief Adds the functions and function tags listed in the function tag
+ * with the JSON \a text to the \a occurrences as uses.
+ */
+void SymbolIndex::readTagValues(const QString &text,
+                                QVector<Occurrence> &occurrences) {
+    const auto &&values = QJsonDocument::fromJson(text.toUtf8()).object()
+                          .value(QLatin1String("values")).toArray();
+
+    // The values are located in the text in order
+    int searchFrom = 0;
+    int line       = 0;
+    int lineStart  = 0;
+
+    for (const auto &value: values) {
+        QString &&ref = value.isObject()
+                            ? value.toObject().value(
+            QLatin1String("id")).toString() : value.toString();
+        if (ref.isEmpty()) {
+            continue;
+        }
+
+        const int pos    = text.indexOf('"' + ref + '"', searchFrom);
+        const int length = ref.size();
+        if (pos != -1) {
+            for (int i = text.indexOf('\n', searchFrom); (i != -1) && (i < pos);
+                 i = text.indexOf('\n', i + 1)) {
+                ++line;
+                lineStart = i + 1;
+            }
+            searchFrom = pos + length + 2;
+        }
+
+        const bool isTag = ref.startsWith('#');
+        if (isTag) {
+            ref.remove(0, 1);
+        }
+        if (!ref.contains(':')) {
+            ref.prepend(QLatin1String("minecraft:"));
+        }
+        occurrences << Occurrence{
+            std::move(ref), isTag ? Kind::FunctionTag : Kind::Function,
+            Role::Use, line, (pos != -1) ? pos + 1 - lineStart : 0, length };
+    }
+}
+
+/*!
+ * \brief Adds the function which the advancement with the JSON \a text runs
+ * as its reward to the \a occurrences as a use.
+ */
+void SymbolIndex::readAdvancementRewards(const QString &text,
+                                         QVector<Occurrence> &occurrences) {
+    const auto &&rewards = QJsonDocument::fromJson(text.toUtf8()).object()
+                           .value(QLatin1String("rewards")).toObject();
+    QString &&ref = rewards.value(QLatin1String("function")).toString();
+
+    if (ref.isEmpty()) {
+        return;
+    }
+
+    const int rewardsPos = text.indexOf(QLatin1String("\"rewards\""));
+    const int pos        = text.indexOf('"' + ref + '"', qMax(rewardsPos, 0));
+    const int length     = ref.size();
+    int       line       = 0;
+    int       column     = 0;
+    if (pos != -1) {
+        line   = std::count(text.cbegin(), text.cbegin() + pos, u'\n');
+        column = pos - text.lastIndexOf('\n', pos);
+    }
+
+    if (!ref.contains(':')) {
+        ref.prepend(QLatin1String("minecraft:"));
+    }
+    occurrences << Occurrence{ std::move(ref), Kind::Function, Role::Use,
+                               line, column, length };
+}
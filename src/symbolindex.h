@@ -0,0 +1,114 @@
+#ifndef SYMBOLINDEX_H
+#define SYMBOLINDEX_H
+
+#include "parsers/command/visitors/symbolcollector.h"
+
+#include <QObject>
+#include <QDateTime>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QThreadPool>
+
+#include <array>
+
+namespace Command {
+    class McfunctionParser;
+}
+
+class SymbolIndex : public QObject {
+    Q_OBJECT
+
+public:
+    using Kind = Command::SymbolCollector::Kind;
+    using Role = Command::SymbolCollector::Role;
+
+    /*!
+     * \brief Where a symbol is defined or used.
+     */
+    struct Location {
+        QString path;
+        int     line   = 0; // Physical line number, starting from 0
+        int     column = 0; // Position in the physical line
+        int     length = 0;
+        Role    role   = Role::Use;
+    };
+
+    static SymbolIndex * instance();
+
+    void updateFile(const QString &path);
+
+    QVector<Location> locations(const Kind kind, const QString &name) const;
+    QVector<QString> unusedFunctions() const;
+
+signals:
+    void symbolsChanged();
+
+private:
+    struct Posting {
+        int     file;
+        int     line;
+        int     column;
+        quint16 length;
+        Role    role;
+    };
+
+    struct SymbolEntry {
+        QString          name;
+        QVector<Posting> postings;
+        Kind             kind = Kind::Function;
+    };
+
+    struct FileEntry {
+        QString      path;
+        QDateTime    lastModified;
+        qint64       size = 0;
+        QVector<int> symbols; // Symbols which have postings in the file
+    };
+
+    struct Occurrence {
+        QString name;
+        Kind    kind;
+        Role    role;
+        int     line;
+        int     column;
+        int     length;
+    };
+
+    struct FileSymbols {
+        QString             path;
+        QDateTime           lastModified;
+        qint64              size = 0;
+        QVector<Occurrence> occurrences;
+    };
+
+    mutable QReadWriteLock m_lock;
+    QString m_dirPath;
+    std::array<QHash<QString, int>,
+               Command::SymbolCollector::kindCount> m_symbolIds;
+    QVector<SymbolEntry> m_symbols; // Indexes are symbol IDs
+    QVector<FileEntry> m_files;     // Indexes are file IDs
+    QVector<int> m_freeSymbolIds;   // IDs of removed entries to be reused
+    QVector<int> m_freeFileIds;
+    QHash<QString, int> m_fileIds;
+    QThreadPool m_indexer;
+    QAtomicInt m_generation = 0;
+
+    explicit SymbolIndex(QObject *parent = nullptr);
+    ~SymbolIndex();
+
+    void onIdsChanged();
+    void index(const int generation, const QString &dirPath,
+               const QStringList &paths, const bool isFullScan);
+    void addFile(FileSymbols &&symbols);
+    void removeFile(const int fileId);
+    void removePostings(const int fileId);
+
+    static FileSymbols readFile(const QString &dirPath, const QString &path,
+                                Command::McfunctionParser &parser);
+    static void readTagValues(const QString &text,
+                              QVector<Occurrence> &occurrences);
+    static void readAdvancementRewards(const QString &text,
+                                       QVector<Occurrence> &occurrences);
+};
+
+#endif // SYMBOLINDEX_H
@@ -8,8 +8,10 @@
 #include "mcbuildhighlighter.h"
 #include "jsonhighlighter.h"
 #include "mainwindow.h"
+#include "mappedfile.h"
 #include "parsers/command/mcfunctionparser.h"
 #include "parsers/jsonparser.h"
+#include "symbolindex.h"
 
 #include <QMessageBox>
 #include <QTextStream>
@@ -153,6 +155,7 @@ bool TabbedDocumentInterface::saveFile(int index, const QString &filepath) {
             doc->setModified(false);
             updateTabTitle(index, false);
             files[index].isModified = false;
+            SymbolIndex::instance()->updateFile(filepath);
         }
 
         return ok;
@@ -234,12 +237,10 @@ void TabbedDocumentInterface::addFile(const QString &path) {
         } else {
             switch (newFile.fileType) {
                 case CodeFile::Function: {
-                    auto &&parser =
-                        std::make_unique<Command::McfunctionParser>();
                     codeEditor->setHighlighter(
-                        new McfunctionHighlighter(codeEditor->document(),
-                                                  parser.get()));
-                    codeEditor->setParser(std::move(parser));
+                        new McfunctionHighlighter(codeEditor->document()));
+                    codeEditor->setParser(
+                        std::make_unique<Command::McfunctionParser>());
                     break;
                 }
                 /*
@@ -277,6 +278,8 @@ void TabbedDocumentInterface::addFile(const QString &path) {
                 this, &TabbedDocumentInterface::onModificationChanged);
         connect(codeEditor, &CodeEditor::openFileRequest,
                 this, &TabbedDocumentInterface::onOpenFile);
+        connect(codeEditor, &CodeEditor::openFileWithLineRequest,
+                this, &TabbedDocumentInterface::onOpenFileWithLine);
 
         connect(codeEditor, &QPlainTextEdit::copyAvailable,
                 this, &TabbedDocumentInterface::updateEditMenuRequest);
@@ -581,35 +584,30 @@ void TabbedDocumentInterface::onSwitchPrevFile() {
 }
 
 QString TabbedDocumentInterface::readTextFile(const QString &path, bool &ok) {
-    QFile   file(path);
-    QString content;
-
-    // Removing QFile::Text enum allows '\r' to be recognized as a line sepatator
-    if (!file.open(QFile::ReadOnly)) {
-        QMessageBox::information(this, tr("Loading text file error"),
-                                 tr("Cannot read file %1:\n%2.")
-                                 .arg(QDir::toNativeSeparators(path),
-                                      file.errorString()));
-        ok = false;
-    } else {
-        QTextStream in(&file);
-        in.setCodec("UTF-8");
-
 #ifndef QT_NO_CURSOR
-        QGuiApplication::setOverrideCursor(Qt::WaitCursor);
+    QGuiApplication::setOverrideCursor(Qt::WaitCursor);
 #endif
 
-        while (!in.atEnd()) {
-            content += in.readLine();
-            if (!in.atEnd())
-                content += '\n';
-        }
-        ok = true;
+    QString errorString;
+    QString content = MappedFile::readText(path, &errorString);
 
 #ifndef QT_NO_CURSOR
-        QApplication::restoreOverrideCursor();
+    QApplication::restoreOverrideCursor();
 #endif
+
+    if (content.isNull()) {
+        QMessageBox::information(this, tr("Loading text file error"),
+                                 tr("Cannot read file %1:\n%2.")
+                                 .arg(QDir::toNativeSeparators(path),
+                                      errorString));
+        ok = false;
+        return content;
+    }
+
+    // The last line break isn't shown as an empty line
+    if (content.endsWith('\n')) {
+        content.chop(1);
     }
-    file.close();
+    ok = true;
     return content;
 }
@@ -0,0 +1,140 @@
+#include "textureatlas.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QtEndian>
+
+#include <cstring>
+
+namespace {
+    // "MCTA": Minecraft Texture Atlas
+    constexpr char    atlasMagic[4]      = { 'M', 'C', 'T', 'A' };
+    constexpr quint32 atlasFormatVersion = 1;
+    constexpr int     headerSize         = 20;
+
+    /*!
+     * \internal
+     * \brief Returns the image shared by the atlases of all versions, which
+     * is only loaded once.
+     */
+    const QPixmap &atlasPixmap() {
+        static const QPixmap pixmap(
+            QStringLiteral(":/minecraft/texture/atlas.png"));
+
+        return pixmap;
+    }
+}
+
+/*!
+ * \brief Reads the index of the atlas at \a indexPath.
+ */
+TextureAtlas::TextureAtlas(const QString &indexPath) {
+    QFile file(indexPath);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QByteArray &&data = file.readAll();
+    const auto        *pos  = reinterpret_cast<const uchar *>(data.constData());
+    const auto        *end  = pos + data.size();
+    if ((data.size() < headerSize)
+        || (std::memcmp(pos, atlasMagic, sizeof(atlasMagic)) != 0)
+        || (qFromLittleEndian<quint32>(pos + 4) != atlasFormatVersion)) {
+        qWarning() << "Invalid texture atlas index:" << indexPath;
+        return;
+    }
+
+    const auto cellSize = qFromLittleEndian<quint32>(pos + 8);
+    const auto columns  = qFromLittleEndian<quint32>(pos + 12);
+    const auto count    = qFromLittleEndian<quint32>(pos + 16);
+    pos += headerSize;
+
+    m_cells.reserve(count);
+    for (quint32 i = 0; i < count; ++i) {
+        if (end - pos < 8) {
+            break;
+        }
+        const auto cell     = qFromLittleEndian<quint32>(pos);
+        const auto nameSize = qFromLittleEndian<quint32>(pos + 4);
+        pos += 8;
+        if (quint32(end - pos) < nameSize) {
+            break;
+        }
+        m_cells.insert(QString::fromUtf8(reinterpret_cast<const char *>(pos),
+                                         nameSize), cell);
+        pos += nameSize;
+    }
+    if (m_cells.size() != int(count)) {
+        qWarning() << "Truncated texture atlas index:" << indexPath;
+        m_cells.clear();
+        return;
+    }
+
+    m_cellSize = cellSize;
+    m_columns  = columns;
+}
+
+const TextureAtlas * TextureAtlas::forVersion(const QString &version) {
+    static QMutex mutex;
+    static QHash<QString, QSharedPointer<TextureAtlas> > atlases;
+    QMutexLocker locker(&mutex);
+
+    auto it = atlases.find(version);
+
+    if (it == atlases.end()) {
+        auto &&atlas = QSharedPointer<TextureAtlas>::create(
+            QStringLiteral(":/minecraft/%1/texture.atlas").arg(version));
+        if (!atlas->isValid()) {
+            atlas.reset();
+        }
+        it = atlases.insert(version, atlas);
+    }
+    return it.value().get();
+}
+
+bool TextureAtlas::isValid() const {
+    return (m_cellSize > 0) && (m_columns > 0);
+}
+
+bool TextureAtlas::contains(const QString &id) const {
+    return m_cells.contains(id);
+}
+
+int TextureAtlas::cellSize() const {
+    return m_cellSize;
+}
+
+/*!
+ * \brief Returns the rectangle of the icon of \a id in the atlas image, or
+ * a null rectangle if the atlas has no icon for the ID.
+ */
+QRect TextureAtlas::rect(const QString &id) const {
+    const auto it = m_cells.constFind(id);
+
+    if (it == m_cells.cend()) {
+        return QRect();
+    }
+    return QRect((*it % m_columns) * m_cellSize, (*it / m_columns) * m_cellSize,
+                 m_cellSize, m_cellSize);
+}
+
+/*!
+ * \brief Returns the icon of \a id scaled to \a size, or a null pixmap if
+ * the atlas has no icon for the ID. It must be called from the GUI thread.
+ */
+QPixmap TextureAtlas::pixmap(const QString &id, const int size) const {
+    const QRect &&rect = this->rect(id);
+
+    if (rect.isNull() || atlasPixmap().isNull()) {
+        return QPixmap();
+    }
+
+    QPixmap pixmap = atlasPixmap().copy(rect);
+    if (size != m_cellSize) {
+        pixmap = pixmap.scaled(size, size, Qt::KeepAspectRatio);
+    }
+    return pixmap;
+}
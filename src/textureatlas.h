@@ -0,0 +1,34 @@
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <QHash>
+#include <QPixmap>
+
+/*!
+ * \brief The prebuilt icons of the items and blocks of a version.
+ *
+ * Atlases are generated at build time by \c tools/build_texture_atlas.py,
+ * which scales every icon to a cell of a single image shared by all versions
+ * and writes the cell of each ID per version. Looking an icon up is a hash
+ * probe and a copy of the cell, instead of decoding and scaling a PNG file.
+ */
+class TextureAtlas {
+public:
+    explicit TextureAtlas(const QString &indexPath);
+
+    static const TextureAtlas * forVersion(const QString &version);
+
+    bool isValid() const;
+    bool contains(const QString &id) const;
+    int cellSize() const;
+    QRect rect(const QString &id) const;
+
+    QPixmap pixmap(const QString &id, const int size) const;
+
+private:
+    QHash<QString, int> m_cells;
+    int m_cellSize = 0;
+    int m_columns  = 0;
+};
+
+#endif // TEXTUREATLAS_H
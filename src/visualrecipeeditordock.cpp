@@ -394,14 +394,13 @@ QJsonValue ingredientsToJson(const QVector<InventoryItem> &items,
 }
 
 void VisualRecipeEditorDock::readRecipe() {
-    QString input = qobject_cast<MainWindow *>(parent())->getCodeEditorText();
+    const QJsonValue &&json =
+        qobject_cast<MainWindow *>(parent())->getCodeEditorJson();
 
-    QJsonDocument json_doc = QJsonDocument::fromJson(input.toUtf8());
-
-    if (json_doc.isNull() || (!json_doc.isObject()))
+    if (!json.isObject())
         return;
 
-    QJsonObject root = json_doc.object();
+    QJsonObject root = json.toObject();
     if (root.isEmpty())
         return;
 
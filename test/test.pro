@@ -1,7 +1,14 @@
 TEMPLATE = subdirs
 
 SUBDIRS += unit/parser/command/nodes/DoubleNode \
+    unit/CompletionIndex \
+    unit/GameDataCache \
     unit/GlobalHelpers \
+    unit/MappedFile \
+    unit/McfunctionHighlighter \
+    unit/SymbolIndex \
+    unit/parser/JsonParser \
+    unit/parser/JsonSchemaValidator \
     unit/parser/LineSplitter \
     unit/parser/command/nodes/IntRangeNode \
     unit/parser/command/nodes/LiteralNode \
@@ -14,4 +21,6 @@ SUBDIRS += unit/parser/command/nodes/DoubleNode \
     unit/parser/command/nodes/TimeNode \
     unit/parser/command/nodes/UuidNode \
     unit/parser/command/SchemaParser \
-    unit/parser/command/MinecraftParser
+    unit/parser/command/MinecraftParser \
+    unit/parser/command/McfunctionParser \
+    unit/parser/command/SemanticValidator
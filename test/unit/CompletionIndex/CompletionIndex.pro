@@ -0,0 +1,14 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase c++17
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES +=  \
+    ../../../src/completionindex.cpp \
+    tst_testcompletionindex.cpp
+
+HEADERS += \
+    ../../../src/completionindex.h
@@ -0,0 +1,138 @@
+#include <QtTest>
+
+#include "../../../src/completionindex.h"
+
+class TestCompletionIndex : public QObject {
+    Q_OBJECT
+
+public:
+    TestCompletionIndex();
+    ~TestCompletionIndex();
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void sortAndDeduplicate();
+    void prefixRange();
+    void prefixRange_narrowing();
+    void fuzzyScore_data();
+    void fuzzyScore();
+    void complete();
+    void complete_fuzzy();
+    void complete_limit();
+};
+
+TestCompletionIndex::TestCompletionIndex() {
+}
+
+TestCompletionIndex::~TestCompletionIndex() {
+}
+
+void TestCompletionIndex::initTestCase() {
+}
+
+void TestCompletionIndex::cleanupTestCase() {
+}
+
+void TestCompletionIndex::sortAndDeduplicate() {
+    const CompletionIndex index({ "stone", "Acacia_log", "stone", "dirt" });
+
+    QCOMPARE(index.size(), 3);
+    QCOMPARE(index.at(0), QStringLiteral("Acacia_log"));
+    QCOMPARE(index.at(1), QStringLiteral("dirt"));
+    QCOMPARE(index.at(2), QStringLiteral("stone"));
+    QCOMPARE(index.keyAt(0).toString(), QStringLiteral("acacia_log"));
+}
+
+void TestCompletionIndex::prefixRange() {
+    const CompletionIndex index(
+        { "stone", "stone_bricks", "stonecutter", "dirt", "sand", "Stick" });
+
+    auto &&range = index.prefixRange(u"stone");
+
+    QCOMPARE(range.begin, 3);
+    QCOMPARE(range.end, 6);
+    range = index.prefixRange(u"st");
+    QCOMPARE(range.begin, 2);
+    QCOMPARE(range.end, 6);
+    QCOMPARE(index.at(range.begin), QStringLiteral("Stick"));
+    QVERIFY(index.prefixRange(u"z").isEmpty());
+    QCOMPARE(index.prefixRange(u"").end, index.size());
+}
+
+void TestCompletionIndex::prefixRange_narrowing() {
+    const CompletionIndex index(
+        { "stone", "stone_bricks", "stonecutter", "dirt", "sand" });
+
+    const auto &&outer = index.prefixRange(u"sto");
+    const auto &&inner = index.prefixRange(u"stone_", outer);
+
+    QCOMPARE(inner.begin, index.prefixRange(u"stone_").begin);
+    QCOMPARE(inner.end, index.prefixRange(u"stone_").end);
+    QCOMPARE(index.at(inner.begin), QStringLiteral("stone_bricks"));
+}
+
+void TestCompletionIndex::fuzzyScore_data() {
+    QTest::addColumn<QString>("key");
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<bool>("matches");
+
+    QTest::newRow("Subsequence") << "diamond_sword" << "dsw" << true;
+    QTest::newRow("Not in order") << "diamond_sword" << "swd" << false;
+    QTest::newRow("Too long") << "dirt" << "dirty" << false;
+    QTest::newRow("Namespaced") << "minecraft:oak_log" << "olog" << true;
+}
+
+void TestCompletionIndex::fuzzyScore() {
+    QFETCH(QString, key);
+    QFETCH(QString, pattern);
+    QFETCH(bool, matches);
+
+    QCOMPARE(CompletionIndex::fuzzyScore(key, pattern) >= 0, matches);
+}
+
+void TestCompletionIndex::complete() {
+    CompletionQuery query;
+
+    query.addWords({ "stone", "stone_bricks", "dirt" });
+    query.addWords({ "stonecutter", "stone", "sand" });
+
+    QCOMPARE(query.complete(QStringLiteral("St"), 10),
+             QVector<QString>({ "stone", "stone_bricks", "stonecutter" }));
+    QCOMPARE(query.complete(QStringLiteral("stone_"), 10),
+             QVector<QString>({ "stone_bricks" }));
+    // Removing characters searches the whole indexes again
+    QCOMPARE(query.complete(QStringLiteral("d"), 1),
+             QVector<QString>({ "dirt" }));
+}
+
+void TestCompletionIndex::complete_fuzzy() {
+    CompletionQuery query;
+
+    query.addWords({ "deepslate_wall", "diamond_sword", "diamond_shovel" });
+
+    const auto &&completions = query.complete(QStringLiteral("dsw"), 10);
+    QCOMPARE(completions.size(), 2);
+    QCOMPARE(completions.at(0), QStringLiteral("diamond_sword"));
+    QCOMPARE(completions.at(1), QStringLiteral("deepslate_wall"));
+}
+
+void TestCompletionIndex::complete_limit() {
+    QVector<QString> words;
+
+    for (int i = 0; i < 1000; ++i) {
+        words << QStringLiteral("item_%1").arg(i, 4, 10, QChar('0'));
+    }
+
+    CompletionQuery query;
+    query.addWords(words);
+
+    const auto &&completions = query.complete(QStringLiteral("item_0"), 5);
+    QCOMPARE(completions.size(), 5);
+    QCOMPARE(completions.first(), QStringLiteral("item_0000"));
+    QCOMPARE(completions.last(), QStringLiteral("item_0004"));
+}
+
+QTEST_APPLESS_MAIN(TestCompletionIndex)
+
+#include "tst_testcompletionindex.moc"
@@ -0,0 +1,21 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase c++17
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES +=  \
+    ../../../src/game.cpp \
+    ../../../src/gamedatabundle.cpp \
+    ../../../src/gamedatacache.cpp \
+    tst_testgamedatacache.cpp
+
+HEADERS += \
+    ../../../src/game.h \
+    ../../../src/gamedatabundle.h \
+    ../../../src/gamedatacache.h
+
+RESOURCES += \
+    ../../../resource/minecraft/info/1.15/1.15.qrc
@@ -0,0 +1,145 @@
+#include <QtTest>
+
+#include "../../../src/gamedatacache.h"
+
+class TestGameDataCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestGameDataCache();
+    ~TestGameDataCache();
+
+private:
+    static GameDataCache::InfoHandle info(const QString &type);
+
+private slots:
+    void init();
+    void cleanupTestCase();
+    void cached();
+    void clear();
+    void evictLeastRecentlyUsed();
+    void lowerBudget();
+    void raiseBudget();
+    void statistics();
+};
+
+TestGameDataCache::TestGameDataCache() {
+}
+
+TestGameDataCache::~TestGameDataCache() {
+}
+
+GameDataCache::InfoHandle TestGameDataCache::info(const QString &type) {
+    return GameDataCache::instance()->info(type, QStringLiteral("1.15"));
+}
+
+void TestGameDataCache::init() {
+    auto *cache = GameDataCache::instance();
+
+    cache->clear();
+    cache->setByteBudget(GameDataCache::defaultByteBudget);
+}
+
+void TestGameDataCache::cleanupTestCase() {
+    init();
+}
+
+void TestGameDataCache::cached() {
+    const auto &&dimensions = info("dimension");
+
+    QVERIFY(dimensions->contains("overworld"));
+    QCOMPARE(info("dimension").get(), dimensions.get());
+
+    const auto &&biomes = info("biome");
+    QVERIFY(biomes->contains("ocean"));
+    QVERIFY(biomes.get() != dimensions.get());
+    QCOMPARE(info("dimension").get(), dimensions.get());
+    QCOMPARE(info("biome").get(), biomes.get());
+}
+
+void TestGameDataCache::clear() {
+    const auto &&dimensions = info("dimension");
+
+    GameDataCache::instance()->clear();
+
+    const auto &&reloaded = info("dimension");
+    QVERIFY(reloaded.get() != dimensions.get());
+    QCOMPARE(*reloaded, *dimensions);
+}
+
+void TestGameDataCache::evictLeastRecentlyUsed() {
+    auto *cache = GameDataCache::instance();
+
+    // Only the most recently used entry fits in the budget
+    cache->setByteBudget(0);
+    QCOMPARE(cache->byteBudget(), size_t(0));
+
+    const auto &&dimensions = info("dimension");
+    const auto &&biomes     = info("biome");
+    QCOMPARE(info("biome").get(), biomes.get());
+
+    // The evicted handle stays valid
+    const auto &&reloaded = info("dimension");
+    QVERIFY(reloaded.get() != dimensions.get());
+    QCOMPARE(*reloaded, *dimensions);
+    QVERIFY(dimensions->contains("overworld"));
+
+    QVERIFY(info("biome").get() != biomes.get());
+}
+
+void TestGameDataCache::lowerBudget() {
+    auto *cache = GameDataCache::instance();
+
+    const auto &&dimensions = info("dimension");
+    const auto &&biomes     = info("biome");
+
+    // The biomes become the least recently used entry
+    QCOMPARE(info("dimension").get(), dimensions.get());
+
+    cache->setByteBudget(0);
+    QCOMPARE(info("dimension").get(), dimensions.get());
+    QVERIFY(info("biome").get() != biomes.get());
+}
+
+void TestGameDataCache::raiseBudget() {
+    auto *cache = GameDataCache::instance();
+
+    cache->setByteBudget(0);
+    info("dimension");
+    info("biome");
+
+    cache->setByteBudget(GameDataCache::defaultByteBudget);
+    QCOMPARE(cache->byteBudget(), GameDataCache::defaultByteBudget);
+
+    const auto &&dimensions = info("dimension");
+    const auto &&biomes     = info("biome");
+    QCOMPARE(info("dimension").get(), dimensions.get());
+    QCOMPARE(info("biome").get(), biomes.get());
+}
+
+void TestGameDataCache::statistics() {
+    auto *cache = GameDataCache::instance();
+
+    QCOMPARE(cache->byteSize(), size_t(0));
+    const quint64 hits   = cache->hits();
+    const quint64 misses = cache->misses();
+
+    info("dimension");
+    QCOMPARE(cache->hits(), hits);
+    QCOMPARE(cache->misses(), misses + 1);
+    const size_t byteSize = cache->byteSize();
+    QVERIFY(byteSize > 0);
+
+    info("dimension");
+    QCOMPARE(cache->hits(), hits + 1);
+    QCOMPARE(cache->misses(), misses + 1);
+    QCOMPARE(cache->byteSize(), byteSize);
+
+    cache->clear();
+    QCOMPARE(cache->byteSize(), size_t(0));
+}
+
+QTEST_APPLESS_MAIN(TestGameDataCache)
+
+#include "tst_testgamedatacache.moc"
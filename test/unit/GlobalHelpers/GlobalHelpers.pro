@@ -6,10 +6,12 @@ TEMPLATE = app
 
 SOURCES +=  tst_testglobalhelpers.cpp \
     ../../../src/codefile.cpp \
+    ../../../src/datapackindex.cpp \
     ../../../src/globalhelpers.cpp
 
 HEADERS += \
     ../../../src/codefile.h \
+    ../../../src/datapackindex.h \
     ../../../src/globalhelpers.h
 
 include($$PWD/../../../lib/uberswitch/uberswitch.pri)
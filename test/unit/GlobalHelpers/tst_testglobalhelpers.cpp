@@ -2,6 +2,7 @@
 #include <QCoreApplication>
 
 #include "../../../src/globalhelpers.h"
+#include "../../../src/datapackindex.h"
 
 class TestGlobalHelpers : public QObject
 {
@@ -19,6 +20,7 @@ private slots:
     void removePrefix();
     void isPathRelativeTo();
     void toNamespacedId();
+    void datapackIndex();
 };
 
 TestGlobalHelpers::TestGlobalHelpers() {
@@ -142,6 +144,54 @@ void TestGlobalHelpers::toNamespacedId() {
     Q_UNUSED(result)
 }
 
+void TestGlobalHelpers::datapackIndex() {
+    QTemporaryDir packDir;
+
+    QVERIFY(packDir.isValid());
+    const QString dirpath = packDir.path();
+
+    const auto &&createFile = [&dirpath](const QString &relPath) {
+        const QString &&path = dirpath + "/data/"_QL1 + relPath;
+        QDir().mkpath(QFileInfo(path).path());
+        QFile file(path);
+        QVERIFY(file.open(QFile::WriteOnly));
+    };
+    createFile("test/functions/fun.mcfunction");
+    createFile("test/functions/sub/fun2.mcfunction");
+    createFile("test/loot_tables/fun.json");
+    createFile("minecraft/tags/functions/load.json");
+    createFile("test/worldgen/biome/ocean.json");
+
+    auto *index = DatapackIndex::instance();
+    index->load(dirpath);
+    QVERIFY(index->isLoaded(dirpath));
+
+    QCOMPARE(index->locate(u"test:fun"),
+             dirpath + "/data/test/functions/fun.mcfunction");
+    QCOMPARE(index->locate(u"test:sub/fun2"),
+             dirpath + "/data/test/functions/sub/fun2.mcfunction");
+    QCOMPARE(index->locate(u"#minecraft:load"),
+             dirpath + "/data/minecraft/tags/functions/load.json");
+    QCOMPARE(index->locate(u"minecraft:load"), QString());
+    QCOMPARE(index->locate(u"test:ocean"),
+             dirpath + "/data/test/worldgen/biome/ocean.json");
+
+    auto &&functionIds = Glhp::fileIdList(dirpath, "functions");
+    std::sort(functionIds.begin(), functionIds.end());
+    QCOMPARE(functionIds, QVector<QString>({ "test:fun", "test:sub/fun2" }));
+    QCOMPARE(Glhp::fileIdList(dirpath, "tags/functions", QString(), false),
+             QVector<QString>{ "#minecraft:load" });
+    QCOMPARE(Glhp::fileIdList(dirpath, "worldgen"),
+             QVector<QString>{ "test:ocean" });
+
+    createFile("test/predicates/pred.json");
+    QTRY_COMPARE(index->locate(u"test:pred"),
+                 dirpath + "/data/test/predicates/pred.json");
+
+    index->clear();
+    QVERIFY(!index->isLoaded(dirpath));
+}
+
 QTEST_MAIN(TestGlobalHelpers)
 
 #include "tst_testglobalhelpers.moc"
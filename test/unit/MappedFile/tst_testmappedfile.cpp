@@ -0,0 +1,93 @@
+#include <QtTest>
+
+#include "../../../src/mappedfile.h"
+
+class TestMappedFile : public QObject {
+    Q_OBJECT
+
+public:
+    TestMappedFile();
+    ~TestMappedFile();
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void decodeText_data();
+    void decodeText();
+    void readText();
+    void readText_missing();
+};
+
+TestMappedFile::TestMappedFile() {
+}
+
+TestMappedFile::~TestMappedFile() {
+}
+
+void TestMappedFile::initTestCase() {
+}
+
+void TestMappedFile::cleanupTestCase() {
+}
+
+void TestMappedFile::decodeText_data() {
+    QTest::addColumn<QByteArray>("bytes");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("Empty") << QByteArray() << QString("");
+    QTest::newRow("ASCII") << QByteArray("say hi") << QString("say hi");
+    QTest::newRow("Long ASCII")
+        << QByteArray("execute as @a run say hello world")
+        << QString("execute as @a run say hello world");
+    QTest::newRow("Byte order mark")
+        << QByteArray("\xEF\xBB\xBFsay hi") << QString("say hi");
+    QTest::newRow("Line endings")
+        << QByteArray("a\r\nb\rc\nd\r\n\r\ne")
+        << QString("a\nb\nc\nd\n\ne");
+    QTest::newRow("CRLF after 16 bytes")
+        << QByteArray("0123456789abcdef\r\n0123456789abcdef")
+        << QString("0123456789abcdef\n0123456789abcdef");
+    QTest::newRow("Multi-byte")
+        << QByteArray("say \xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80 after the emoji")
+        << QString::fromUtf8(
+        "say \xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80 after the emoji");
+    QTest::newRow("Invalid bytes")
+        << QByteArray("a\xFF" "b\xC3")
+        << QString("a") + QChar(QChar::ReplacementCharacter) + "b"
+        + QChar(QChar::ReplacementCharacter);
+    QTest::newRow("Surrogate") << QByteArray("\xED\xA0\x80")
+                               << QString(3, QChar::ReplacementCharacter);
+}
+
+void TestMappedFile::decodeText() {
+    QFETCH(QByteArray, bytes);
+    QFETCH(QString, expected);
+
+    QCOMPARE(MappedFile::decodeText(bytes.constData(), bytes.size()),
+             expected);
+}
+
+void TestMappedFile::readText() {
+    QTemporaryFile file;
+
+    QVERIFY(file.open());
+    file.write("function #minecraft:tick\r\n# \xE2\x9C\x93\r\n");
+    file.close();
+
+    QString errorString;
+    QCOMPARE(MappedFile::readText(file.fileName(), &errorString),
+             QString::fromUtf8("function #minecraft:tick\n# \xE2\x9C\x93\n"));
+    QVERIFY(errorString.isEmpty());
+}
+
+void TestMappedFile::readText_missing() {
+    QString errorString;
+
+    QVERIFY(MappedFile::readText(QStringLiteral("does/not/exist.mcfunction"),
+                                 &errorString).isNull());
+    QVERIFY(!errorString.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(TestMappedFile)
+
+#include "tst_testmappedfile.moc"
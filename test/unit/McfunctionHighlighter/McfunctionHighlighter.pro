@@ -0,0 +1,33 @@
+QT += testlib
+QT += gui
+CONFIG += qt warn_on depend_includepath testcase c++17
+
+TEMPLATE = app
+
+INCLUDEPATH += $$PWD/../../../src
+
+SOURCES +=  tst_testmcfunctionhighlighter.cpp \
+    ../../../src/codefile.cpp \
+    ../../../src/codepalette.cpp \
+    ../../../src/datapackindex.cpp \
+    ../../../src/globalhelpers.cpp \
+    ../../../src/highlighter.cpp \
+    ../../../src/mcfunctionhighlighter.cpp \
+    ../../../src/parsers/command/nodes/filenode.cpp \
+    ../../../src/parsers/command/nodes/parsenode.cpp \
+    ../../../src/parsers/command/nodes/rootnode.cpp \
+    ../../../src/parsers/linesplitter.cpp
+
+HEADERS += \
+    ../../../src/codefile.h \
+    ../../../src/codepalette.h \
+    ../../../src/datapackindex.h \
+    ../../../src/globalhelpers.h \
+    ../../../src/highlighter.h \
+    ../../../src/mcfunctionhighlighter.h \
+    ../../../src/parsers/command/nodes/filenode.h \
+    ../../../src/parsers/command/nodes/parsenode.h \
+    ../../../src/parsers/command/nodes/rootnode.h \
+    ../../../src/parsers/linesplitter.h
+
+include($$PWD/../../../lib/uberswitch/uberswitch.pri)
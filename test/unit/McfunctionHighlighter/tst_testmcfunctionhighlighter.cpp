@@ -0,0 +1,96 @@
+#include <QtTest>
+#include <QTextDocument>
+
+#include "../../../src/mcfunctionhighlighter.h"
+#include "../../../src/parsers/command/nodes/rootnode.h"
+#include "../../../src/parsers/linesplitter.h"
+
+using FormatRanges = McfunctionHighlighter::FormatRanges;
+
+class TestMcfunctionHighlighter : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMcfunctionHighlighter();
+    ~TestMcfunctionHighlighter();
+
+private:
+    static QStringList spans(const QVector<FormatRanges> &lines);
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void splitLine_sharedNode();
+};
+
+TestMcfunctionHighlighter::TestMcfunctionHighlighter() {
+}
+
+TestMcfunctionHighlighter::~TestMcfunctionHighlighter() {
+}
+
+void TestMcfunctionHighlighter::initTestCase() {
+}
+
+void TestMcfunctionHighlighter::cleanupTestCase() {
+}
+
+QStringList TestMcfunctionHighlighter::spans(
+    const QVector<FormatRanges> &lines) {
+    QStringList list;
+
+    for (const auto &line: lines) {
+        QStringList lineSpans;
+        for (const auto &range: line) {
+            lineSpans << QString("%1+%2").arg(range.start).arg(range.length);
+        }
+        list << lineSpans.join(' ');
+    }
+    return list;
+}
+
+void TestMcfunctionHighlighter::splitLine_sharedNode() {
+    // The three logical lines have the same text, so the parser gives them
+    // the same node and the analyzer the same format ranges
+    const QString text = "say \\\n    hi\nsay hi\nsay \\\n  hi";
+    QTextDocument doc(text);
+    McfunctionHighlighter highlighter(&doc);
+
+    LineSplitter splitter(text);
+    const Command::NodePtr command =
+        QSharedPointer<Command::RootNode>::create(6);
+    const auto &&tree = QSharedPointer<Command::FileNode>::create();
+    while (splitter.hasNextLine()) {
+        QCOMPARE(splitter.nextLogicalLine(), "say hi");
+        tree->append(command);
+    }
+    QCOMPARE(tree->size(), 3);
+    tree->setSourceMapper(splitter.sourceMapper());
+
+    const FormatRanges ranges{ { 0, 3, QTextCharFormat() },
+                               { 4, 2, QTextCharFormat() } };
+    highlighter.setAnalysisResult(tree, { ranges, ranges, ranges });
+
+    const int firstPos  = doc.findBlockByNumber(0).position();
+    const int singlePos = doc.findBlockByNumber(2).position();
+    const int secondPos = doc.findBlockByNumber(3).position();
+
+    const QStringList continued{ "0+3", "4+2" };
+    const QStringList single{ "0+3 4+2" };
+    const QStringList lessIndented{ "0+3", "2+2" };
+
+    QCOMPARE(spans(highlighter.splitLine(0, firstPos)), continued);
+    QCOMPARE(spans(highlighter.splitLine(1, singlePos)), single);
+    QCOMPARE(spans(highlighter.splitLine(2, secondPos)), lessIndented);
+
+    // Cached splits must not leak into the other copies
+    QCOMPARE(spans(highlighter.splitLine(0, firstPos)), continued);
+    QCOMPARE(spans(highlighter.splitLine(1, singlePos)), single);
+    QCOMPARE(spans(highlighter.splitLine(2, secondPos)), lessIndented);
+    QCOMPARE(spans(highlighter.splitLine(1, singlePos)), single);
+}
+
+QTEST_MAIN(TestMcfunctionHighlighter)
+
+#include "tst_testmcfunctionhighlighter.moc"
@@ -0,0 +1,225 @@
+#include <QtTest>
+
+#include "../../../src/symbolindex.h"
+#include "../../../src/datapackindex.h"
+#include "../../../src/parsers/command/minecraftparser.h"
+
+using Kind = SymbolIndex::Kind;
+
+class TestSymbolIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestSymbolIndex();
+    ~TestSymbolIndex();
+
+private:
+    QTemporaryDir m_dir;
+
+    QString pathOf(const QString &relPath) const;
+    void writeFile(const QString &relPath, const QString &text) const;
+    QStringList describe(const QVector<SymbolIndex::Location> &locations) const;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void query();
+    void jsonReferences();
+    void continuedLines();
+    void updateFile();
+    void removeFile();
+    void addRemovedFile();
+};
+
+TestSymbolIndex::TestSymbolIndex() {
+}
+
+TestSymbolIndex::~TestSymbolIndex() {
+}
+
+QString TestSymbolIndex::pathOf(const QString &relPath) const {
+    return m_dir.filePath(relPath);
+}
+
+void TestSymbolIndex::writeFile(const QString &relPath,
+                                const QString &text) const {
+    const QString &&path = pathOf(relPath);
+
+    QDir().mkpath(QFileInfo(path).path());
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(text.toUtf8());
+}
+
+QStringList TestSymbolIndex::describe(
+    const QVector<SymbolIndex::Location> &locations) const {
+    QStringList list;
+    const QDir  dir(m_dir.path());
+
+    for (const auto &location: locations) {
+        list << QString("%1:%2:%3+%4%5").arg(
+            dir.relativeFilePath(location.path)).arg(location.line)
+            .arg(location.column).arg(location.length)
+            .arg((location.role == SymbolIndex::Role::Definition)
+                     ? " (definition)" : "");
+    }
+    return list;
+}
+
+void TestSymbolIndex::initTestCase() {
+    Command::MinecraftParser::setGameVer(QVersionNumber(1, 20, 2));
+    QVERIFY(m_dir.isValid());
+
+    writeFile("pack.mcmeta",
+              R"({"pack": {"pack_format": 18, "description": ""}})");
+    writeFile("data/test/functions/main.mcfunction",
+              "function test:used\n"
+              "scoreboard objectives add kills dummy\n"
+              "execute as @a \\\n"
+              "    run function test:continued\n");
+    writeFile("data/test/functions/used.mcfunction",
+              "scoreboard players add @s kills 1\n");
+    writeFile("data/test/functions/continued.mcfunction", "say continued\n");
+    writeFile("data/test/functions/unused.mcfunction", "say unused\n");
+    writeFile("data/test/functions/reward.mcfunction", "say reward\n");
+    writeFile("data/test/tags/functions/load.json",
+              R"({"values": ["test:main"]})");
+    writeFile("data/test/advancements/first.json",
+              "{\n"
+              "    \"criteria\": {\n"
+              "        \"tick\": {\n"
+              "            \"trigger\": \"minecraft:tick\"\n"
+              "        }\n"
+              "    },\n"
+              "    \"rewards\": {\n"
+              "        \"function\": \"test:reward\"\n"
+              "    }\n"
+              "}\n");
+
+    SymbolIndex::instance();
+    DatapackIndex::instance()->load(m_dir.path());
+
+    const QVector<QString> unused{ "test:unused" };
+    QTRY_COMPARE(SymbolIndex::instance()->unusedFunctions(), unused);
+}
+
+void TestSymbolIndex::cleanupTestCase() {
+    DatapackIndex::instance()->clear();
+}
+
+void TestSymbolIndex::query() {
+    const auto *index = SymbolIndex::instance();
+
+    const QStringList used{
+        "data/test/functions/main.mcfunction:0:9+9",
+        "data/test/functions/used.mcfunction:0:0+0 (definition)",
+    };
+    QCOMPARE(describe(index->locations(Kind::Function, "test:used")), used);
+
+    const QStringList kills{
+        "data/test/functions/main.mcfunction:1:26+5 (definition)",
+        "data/test/functions/used.mcfunction:0:26+5",
+    };
+    QCOMPARE(describe(index->locations(Kind::Objective, "kills")), kills);
+
+    const QStringList load{
+        "data/test/tags/functions/load.json:0:0+0 (definition)",
+    };
+    QCOMPARE(describe(index->locations(Kind::FunctionTag, "test:load")),
+             load);
+
+    QVERIFY(index->locations(Kind::Function, "test:missing").isEmpty());
+    QVERIFY(index->locations(Kind::Objective, "test:used").isEmpty());
+}
+
+void TestSymbolIndex::jsonReferences() {
+    const auto *index = SymbolIndex::instance();
+
+    const QStringList main{
+        "data/test/functions/main.mcfunction:0:0+0 (definition)",
+        "data/test/tags/functions/load.json:0:13+9",
+    };
+    QCOMPARE(describe(index->locations(Kind::Function, "test:main")), main);
+
+    const QStringList reward{
+        "data/test/advancements/first.json:7:21+11",
+        "data/test/functions/reward.mcfunction:0:0+0 (definition)",
+    };
+    QCOMPARE(describe(index->locations(Kind::Function, "test:reward")),
+             reward);
+}
+
+void TestSymbolIndex::continuedLines() {
+    const auto *index = SymbolIndex::instance();
+
+    // Both the line and the column are physical
+    const QStringList continued{
+        "data/test/functions/continued.mcfunction:0:0+0 (definition)",
+        "data/test/functions/main.mcfunction:3:17+14",
+    };
+    QCOMPARE(describe(index->locations(Kind::Function, "test:continued")),
+             continued);
+}
+
+void TestSymbolIndex::updateFile() {
+    auto *index = SymbolIndex::instance();
+
+    writeFile("data/test/functions/main.mcfunction",
+              "scoreboard objectives add kills dummy\n"
+              "execute as @a run function test:continued\n");
+    index->updateFile(pathOf("data/test/functions/main.mcfunction"));
+
+    const QVector<QString> unused{ "test:unused", "test:used" };
+    QTRY_COMPARE(index->unusedFunctions(), unused);
+
+    const QStringList kills{
+        "data/test/functions/main.mcfunction:0:26+5 (definition)",
+        "data/test/functions/used.mcfunction:0:26+5",
+    };
+    QCOMPARE(describe(index->locations(Kind::Objective, "kills")), kills);
+
+    const QStringList continued{
+        "data/test/functions/continued.mcfunction:0:0+0 (definition)",
+        "data/test/functions/main.mcfunction:1:27+14",
+    };
+    QCOMPARE(describe(index->locations(Kind::Function, "test:continued")),
+             continued);
+}
+
+void TestSymbolIndex::removeFile() {
+    auto *index = SymbolIndex::instance();
+
+    QVERIFY(QFile::remove(pathOf("data/test/functions/unused.mcfunction")));
+    index->updateFile(pathOf("data/test/functions/unused.mcfunction"));
+
+    const QVector<QString> unused{ "test:used" };
+    QTRY_COMPARE(index->unusedFunctions(), unused);
+    QVERIFY(index->locations(Kind::Function, "test:unused").isEmpty());
+}
+
+void TestSymbolIndex::addRemovedFile() {
+    auto *index = SymbolIndex::instance();
+
+    // The file and the symbol get the IDs which have been freed
+    writeFile("data/test/functions/unused.mcfunction",
+              "scoreboard objectives add deaths dummy\n");
+    index->updateFile(pathOf("data/test/functions/unused.mcfunction"));
+
+    const QVector<QString> unused{ "test:unused", "test:used" };
+    QTRY_COMPARE(index->unusedFunctions(), unused);
+
+    const QStringList deaths{
+        "data/test/functions/unused.mcfunction:0:26+6 (definition)",
+    };
+    QCOMPARE(describe(index->locations(Kind::Objective, "deaths")), deaths);
+
+    const QStringList used{
+        "data/test/functions/used.mcfunction:0:0+0 (definition)",
+    };
+    QCOMPARE(describe(index->locations(Kind::Function, "test:used")), used);
+}
+
+QTEST_GUILESS_MAIN(TestSymbolIndex)
+
+#include "tst_testsymbolindex.moc"
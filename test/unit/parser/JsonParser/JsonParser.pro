@@ -0,0 +1,18 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase c++17
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES +=  \
+    ../../../../src/parsers/jsonnode.cpp \
+    ../../../../src/parsers/jsonparser.cpp \
+    ../../../../src/parsers/parser.cpp \
+    tst_testjsonparser.cpp
+
+HEADERS += \
+    ../../../../src/parsers/jsonnode.h \
+    ../../../../src/parsers/jsonparser.h \
+    ../../../../src/parsers/parser.h
@@ -0,0 +1,265 @@
+#include <QtTest>
+
+#include "../../../../src/parsers/jsonparser.h"
+
+using Json::Node;
+using Json::NodePtr;
+
+class TestJsonParser : public QObject {
+    Q_OBJECT
+
+public:
+    TestJsonParser();
+    ~TestJsonParser();
+
+private:
+    static bool sameTree(const Node *a, const Node *b);
+    static bool hasErrorNode(const Node *node);
+    static bool errorsArePropagated(const Node *node);
+    static bool sameErrors(const Parser::Errors &a, const Parser::Errors &b);
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void validDocument();
+    void errorRecovery_data();
+    void errorRecovery();
+    void hasErrors_data();
+    void hasErrors();
+    void reparse_data();
+    void reparse();
+    void reparse_reusesValues();
+};
+
+TestJsonParser::TestJsonParser() {
+}
+
+TestJsonParser::~TestJsonParser() {
+}
+
+bool TestJsonParser::sameTree(const Node *a, const Node *b) {
+    if ((a->kind() != b->kind()) || (a->length() != b->length())
+        || (a->hasErrors() != b->hasErrors())
+        || (a->isClosed() != b->isClosed())
+        || (a->children().size() != b->children().size())) {
+        return false;
+    }
+    for (int i = 0; i < a->children().size(); ++i) {
+        const auto &childA = a->children().at(i);
+        const auto &childB = b->children().at(i);
+        if ((childA.offset != childB.offset)
+            || !sameTree(childA.node.get(), childB.node.get())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TestJsonParser::hasErrorNode(const Node *node) {
+    if ((node->kind() == Node::Kind::Error) || !node->isClosed()) {
+        return true;
+    }
+    for (const auto &child: node->children()) {
+        if (hasErrorNode(child.node.get())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TestJsonParser::errorsArePropagated(const Node *node) {
+    if (hasErrorNode(node) && !node->hasErrors()) {
+        return false;
+    }
+    for (const auto &child: node->children()) {
+        if (!errorsArePropagated(child.node.get())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TestJsonParser::sameErrors(const Parser::Errors &a,
+                                const Parser::Errors &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (int i = 0; i < a.size(); ++i) {
+        if (!(a[i] == b[i]) || (qstrcmp(a[i].what(), b[i].what()) != 0)
+            || (a[i].args != b[i].args)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TestJsonParser::initTestCase() {
+}
+
+void TestJsonParser::cleanupTestCase() {
+}
+
+void TestJsonParser::validDocument() {
+    const QString text = QStringLiteral(
+        R"({ "a": [1, -2.5e3, true, false, null], // comment
+             "b": { "c": "d\"e" } })");
+    JsonParser parser;
+
+    QVERIFY(parser.parse(text));
+    QVERIFY(parser.errors().isEmpty());
+
+    const auto &&tree = parser.syntaxTree();
+    QVERIFY(!tree->hasErrors());
+    QCOMPARE(tree->length(), text.size());
+
+    const auto &&value = tree->toJsonValue(text).toObject();
+    QCOMPARE(value.value("a").toArray().size(), 5);
+    QCOMPARE(value.value("b").toObject().value("c").toString(), "d\"e");
+}
+
+void TestJsonParser::errorRecovery_data() {
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<int>("errorPos");
+    QTest::addColumn<QStringList>("keys");
+
+    QTest::newRow("Invalid word") << R"({"a": tru, "b": 1})" << 6
+                                  << QStringList{ "a", "b" };
+    QTest::newRow("Invalid number") << R"({"a": 1x, "b": 1})" << 6
+                                    << QStringList{ "a", "b" };
+    QTest::newRow("Missing comma") << R"({"a": 1 "b": 1})" << 8
+                                   << QStringList{ "a", "b" };
+    QTest::newRow("Missing colon") << R"({"a" 1, "b": 1})" << 5
+                                   << QStringList{ "a", "b" };
+    QTest::newRow("Unclosed object") << R"({"a": 1, "b": 1)" << 15
+                                     << QStringList{ "a", "b" };
+    QTest::newRow("Trailing value") << R"({"a": 1, "b": 1} junk)" << 17
+                                    << QStringList{ "a", "b" };
+}
+
+void TestJsonParser::errorRecovery() {
+    QFETCH(QString, text);
+    QFETCH(int, errorPos);
+    QFETCH(QStringList, keys);
+
+    JsonParser parser;
+
+    QVERIFY(!parser.parse(text));
+    QVERIFY(!parser.errors().isEmpty());
+    QCOMPARE(parser.errors().constFirst().pos, errorPos);
+
+    // The rest of the document is still parsed
+    const auto &&tree = parser.syntaxTree();
+    QCOMPARE(tree->length(), text.size());
+    QVERIFY(tree->hasErrors());
+
+    const auto &object = tree->children().constFirst();
+    QCOMPARE(object.node->kind(), Node::Kind::Object);
+
+    QStringList memberKeys;
+    for (const auto &child: object.node->children()) {
+        if (const auto &&key = child.node->key()) {
+            memberKeys << text.mid(object.offset + child.offset + 1,
+                                   key->length() - 2);
+        }
+    }
+    QCOMPARE(memberKeys, keys);
+}
+
+void TestJsonParser::hasErrors_data() {
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<bool>("hasErrors");
+
+    QTest::newRow("Valid") << R"({"a": [true]})" << false;
+    QTest::newRow("Invalid word") << R"({"a": [tru]})" << true;
+    QTest::newRow("Invalid number") << R"({"a": [1x]})" << true;
+    QTest::newRow("Skipped character") << R"({"a": [#]})" << true;
+    QTest::newRow("Trailing value") << R"({"a": [true]} junk)" << true;
+    QTest::newRow("Unclosed string") << R"({"a": ["b]})" << true;
+}
+
+void TestJsonParser::hasErrors() {
+    QFETCH(QString, text);
+    QFETCH(bool, hasErrors);
+
+    JsonParser parser;
+
+    parser.parse(text);
+
+    const auto &&tree = parser.syntaxTree();
+    QCOMPARE(tree->hasErrors(), hasErrors);
+    QCOMPARE(parser.errors().isEmpty(), !hasErrors);
+
+    // The flag is propagated to every ancestor of an error
+    QVERIFY(errorsArePropagated(tree.get()));
+}
+
+void TestJsonParser::reparse_data() {
+    QTest::addColumn<QString>("before");
+    QTest::addColumn<int>("pos");
+    QTest::addColumn<int>("removed");
+    QTest::addColumn<QString>("inserted");
+
+    const QString doc = QStringLiteral(
+        R"({"a": [1, 2, 3], "b": {"c": true}, "d": "e"})");
+
+    QTest::newRow("Insert into number") << doc << 8 << 0 << "0";
+    QTest::newRow("Replace a key") << doc << 18 << 1 << "bb";
+    QTest::newRow("Remove a member") << doc << 16 << 18 << "";
+    QTest::newRow("Break a string") << doc << 40 << 1 << "";
+    QTest::newRow("Open an object") << doc << 0 << 1 << "";
+    QTest::newRow("Insert a comment") << doc << 15 << 0 << " // x\n";
+    QTest::newRow("Next to invalid value")
+        << QStringLiteral(R"({"a": tru, "b": 1})") << 9 << 0 << " ";
+    QTest::newRow("Fix an invalid value")
+        << QStringLiteral(R"({"a": tru, "b": 1})") << 9 << 0 << "e";
+    QTest::newRow("After an invalid word")
+        << QStringLiteral(R"([{"a": tru}, 1])") << 13 << 1 << "2";
+    QTest::newRow("After an invalid number")
+        << QStringLiteral(R"([[1x], 2])") << 7 << 1 << "3";
+    QTest::newRow("After trailing junk")
+        << QStringLiteral(R"({"a": 1} junk)") << 13 << 0 << "s";
+    QTest::newRow("Append to empty") << QString() << 0 << 0 << "[1]";
+}
+
+void TestJsonParser::reparse() {
+    QFETCH(QString, before);
+    QFETCH(int, pos);
+    QFETCH(int, removed);
+    QFETCH(QString, inserted);
+
+    QString after = before;
+    after.replace(pos, removed, inserted);
+
+    JsonParser incremental;
+    incremental.parse(before);
+    const bool ok = incremental.reparse(after, pos, removed,
+                                        inserted.size());
+
+    JsonParser full;
+    QCOMPARE(ok, full.parse(after));
+    QVERIFY(sameTree(incremental.syntaxTree().get(),
+                     full.syntaxTree().get()));
+    QVERIFY(sameErrors(incremental.errors(), full.errors()));
+}
+
+void TestJsonParser::reparse_reusesValues() {
+    const QString before = QStringLiteral(R"({"a": {"b": 1}, "c": 2})");
+    QString       after  = before;
+
+    after.replace(21, 1, "3");
+
+    JsonParser parser;
+    parser.parse(before);
+
+    const auto &&oldObject = parser.syntaxTree()->children().constFirst()
+                             .node->children().constFirst().node->value();
+    parser.reparse(after, 21, 1, 1);
+
+    const auto &&newObject = parser.syntaxTree()->children().constFirst()
+                             .node->children().constFirst().node->value();
+    QCOMPARE(newObject.get(), oldObject.get());
+}
+
+QTEST_APPLESS_MAIN(TestJsonParser)
+
+#include "tst_testjsonparser.moc"
@@ -0,0 +1,24 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase c++17
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += ../../../../src
+
+SOURCES +=  \
+    ../../../../src/parsers/jsonnode.cpp \
+    ../../../../src/parsers/jsonparser.cpp \
+    ../../../../src/parsers/jsonschema.cpp \
+    ../../../../src/parsers/jsonvalidator.cpp \
+    ../../../../src/parsers/parser.cpp \
+    tst_testjsonschemavalidator.cpp
+
+HEADERS += \
+    ../../../../src/parsers/jsonnode.h \
+    ../../../../src/parsers/jsonparser.h \
+    ../../../../src/parsers/jsonschema.h \
+    ../../../../src/parsers/jsonvalidator.h \
+    ../../../../src/parsers/parser.h
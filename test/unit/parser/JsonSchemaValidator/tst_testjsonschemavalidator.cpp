@@ -0,0 +1,173 @@
+#include <QtTest>
+
+#include "../../../../src/parsers/jsonparser.h"
+#include "../../../../src/parsers/jsonvalidator.h"
+
+class TestJsonSchemaValidator : public QObject {
+    Q_OBJECT
+
+public:
+    TestJsonSchemaValidator();
+    ~TestJsonSchemaValidator();
+
+private:
+    Parser::Errors validate(const QString &text,
+                            const CodeFile::FileType fileType,
+                            const QString &version = QStringLiteral("1.20.4"));
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void validLootTable();
+    void missingKey();
+    void unknownKey();
+    void unknownFunction();
+    void typeMismatch();
+    void untypedNumberProvider();
+    void versionedConditions();
+    void predicateArray();
+    void outOfRange();
+    void unknownFileType();
+};
+
+TestJsonSchemaValidator::TestJsonSchemaValidator() {
+}
+
+TestJsonSchemaValidator::~TestJsonSchemaValidator() {
+}
+
+Parser::Errors TestJsonSchemaValidator::validate(
+    const QString &text, const CodeFile::FileType fileType,
+    const QString &version) {
+    JsonParser parser;
+
+    parser.parse(text);
+    Json::SchemaValidator validator(Json::Schema::forVersion(version));
+    return validator.validate(parser.syntaxTree(), text, fileType);
+}
+
+void TestJsonSchemaValidator::initTestCase() {
+}
+
+void TestJsonSchemaValidator::cleanupTestCase() {
+}
+
+void TestJsonSchemaValidator::validLootTable() {
+    const QString text = QStringLiteral(R"({
+    "type": "minecraft:block",
+    "pools": [
+        {
+            "rolls": 1,
+            "entries": [
+                {
+                    "type": "minecraft:item",
+                    "name": "minecraft:stone",
+                    "functions": [
+                        {
+                            "function": "set_count",
+                            "count": { "min": 1, "max": 3 }
+                        }
+                    ]
+                }
+            ],
+            "conditions": [ { "condition": "minecraft:survives_explosion" } ]
+        }
+    ]
+})");
+
+    QVERIFY(validate(text, CodeFile::LootTable).isEmpty());
+}
+
+void TestJsonSchemaValidator::missingKey() {
+    const QString text =
+        QStringLiteral(R"({"pools": [{"entries": []}]})");
+    const auto &&problems = validate(text, CodeFile::LootTable);
+
+    QCOMPARE(problems.size(), 1);
+    QCOMPARE(problems[0].what(), "Missing key: %1");
+    QCOMPARE(problems[0].args, QVariantList{ "rolls" });
+    QCOMPARE(problems[0].pos, text.indexOf("{\"entries"));
+}
+
+void TestJsonSchemaValidator::unknownKey() {
+    const QString text =
+        QStringLiteral(R"({"replace": false, "valeus": [], "values": []})");
+    const auto &&problems = validate(text, CodeFile::BlockTag);
+
+    QCOMPARE(problems.size(), 1);
+    QCOMPARE(problems[0].what(), "Unknown key: %1");
+    QCOMPARE(problems[0].pos, text.indexOf("\"valeus\""));
+    QCOMPARE(problems[0].length, 8);
+}
+
+void TestJsonSchemaValidator::unknownFunction() {
+    const QString text =
+        QStringLiteral(R"({"function": "minecraft:set_cuont", "count": 1})");
+    const auto &&problems = validate(text, CodeFile::ItemModifier);
+
+    QCOMPARE(problems.size(), 1);
+    QCOMPARE(problems[0].what(), "Unknown %2: %1");
+    QCOMPARE(problems[0].args,
+             (QVariantList{ "minecraft:set_cuont", "function" }));
+}
+
+void TestJsonSchemaValidator::typeMismatch() {
+    const QString text =
+        QStringLiteral(R"({"function": "set_count", "count": "3"})");
+    const auto &&problems = validate(text, CodeFile::ItemModifier);
+
+    QCOMPARE(problems.size(), 1);
+    QCOMPARE(problems[0].what(), "Expected %1, got %2");
+    QCOMPARE(problems[0].args,
+             (QVariantList{ "number or object", "string" }));
+    QCOMPARE(problems[0].pos, text.indexOf("\"3\""));
+}
+
+void TestJsonSchemaValidator::untypedNumberProvider() {
+    const QString untyped = QStringLiteral(
+        R"({"function": "set_count", "count": {"min": 1}})");
+    const QString binomial = QStringLiteral(
+        R"({"function": "set_count",
+            "count": {"type": "binomial", "n": 3, "p": 0.5}})");
+
+    QCOMPARE(validate(untyped, CodeFile::ItemModifier).size(), 1);
+    QVERIFY(validate(binomial, CodeFile::ItemModifier).isEmpty());
+}
+
+void TestJsonSchemaValidator::versionedConditions() {
+    const QString text = QStringLiteral(
+        R"({"condition": "any_of", "terms": [{"condition": "inverted",
+            "term": {"condition": "killed_by_player"}}]})");
+
+    QVERIFY(validate(text, CodeFile::Predicate).isEmpty());
+    QCOMPARE(validate(text, CodeFile::Predicate, "1.19.4").size(), 1);
+}
+
+void TestJsonSchemaValidator::predicateArray() {
+    const QString text = QStringLiteral(
+        R"([{"condition": "random_chance", "chance": 0.5},
+            {"condition": "weather_check", "raining": "yes"}])");
+    const auto &&problems = validate(text, CodeFile::Predicate);
+
+    QCOMPARE(problems.size(), 1);
+    QCOMPARE(problems[0].pos, text.indexOf("\"yes\""));
+    QCOMPARE(validate(text, CodeFile::Predicate, "1.15").size(), 1);
+}
+
+void TestJsonSchemaValidator::outOfRange() {
+    const QString text = QStringLiteral(
+        R"({"type": "crafting_shapeless", "ingredients": [{"item": "a:b"}],
+            "result": {"item": "a:c", "count": 65}})");
+    const auto &&problems = validate(text, CodeFile::Recipe);
+
+    QCOMPARE(problems.size(), 1);
+    QCOMPARE(problems[0].what(), "Expected a number between %1 and %2");
+}
+
+void TestJsonSchemaValidator::unknownFileType() {
+    QVERIFY(validate(QStringLiteral("{}"), CodeFile::JsonText).isEmpty());
+}
+
+QTEST_APPLESS_MAIN(TestJsonSchemaValidator)
+
+#include "tst_testjsonschemavalidator.moc"
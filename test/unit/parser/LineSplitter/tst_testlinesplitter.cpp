@@ -19,6 +19,7 @@ private slots:
     void lineContinuation_multiple();
     void lineContinuation_multiple_ignoreSpaces();
     void actuallyShort();
+    void startAtOffset();
 };
 
 TestLineSplitter::TestLineSplitter() {
@@ -144,6 +145,24 @@ bar)");
     QCOMPARE(splitter.nextLogicalLine(), QString());
 }
 
+void TestLineSplitter::startAtOffset() {
+    const QString text = QStringLiteral("say a\nexecute \\\n  run say b\nsay c");
+    LineSplitter  splitter(text, 6, 1, 6);
+
+    QVERIFY(splitter.hasNextLine());
+    QCOMPARE(splitter.nextLogicalLine(), "execute run say b");
+    QCOMPARE(splitter.physicalPos(), 28);
+    QCOMPARE(splitter.logicalPos(), 24);
+    QVERIFY(splitter.lastLineIsContinuation());
+    QCOMPARE(splitter.nextLogicalLine(), "say c");
+    QVERIFY(!splitter.hasNextLine());
+
+    const auto &&srcMapper = splitter.sourceMapper();
+    QCOMPARE(srcMapper.logicalLines, QVector<int>({ 1, 3 }));
+    QCOMPARE(srcMapper.physicalPositions.value(24), 28);
+    QCOMPARE(srcMapper.logicalPositions.value(28), 24);
+}
+
 QTEST_APPLESS_MAIN(TestLineSplitter)
 
 #include "tst_testlinesplitter.moc"
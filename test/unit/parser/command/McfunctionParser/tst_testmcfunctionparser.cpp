@@ -0,0 +1,252 @@
+#include <QtTest>
+
+#include "../../../../../src/parsers/command/mcfunctionparser.h"
+#include "../../../../../src/parsers/command/nodes/macronode.h"
+#include "../../../../../src/parsers/command/visitors/reprprinter.h"
+
+using namespace Command;
+
+class TestMcfunctionParser : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMcfunctionParser();
+    ~TestMcfunctionParser();
+
+private:
+    static QString describe(const NodePtr &node);
+    static QStringList describe(const FileNode *tree);
+    static QStringList describe(const Parser::Errors &errors);
+    static QStringList describe(const SourceMapper &srcMapper);
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void reparse_data();
+    void reparse();
+    void reparse_keepsUnchangedLines();
+};
+
+TestMcfunctionParser::TestMcfunctionParser() {
+}
+
+TestMcfunctionParser::~TestMcfunctionParser() {
+}
+
+void TestMcfunctionParser::initTestCase() {
+    MinecraftParser::setGameVer(QVersionNumber(1, 20, 2));
+    MinecraftParser::setTestMode(true);
+}
+
+void TestMcfunctionParser::cleanupTestCase() {
+}
+
+QString TestMcfunctionParser::describe(const NodePtr &node) {
+    QString repr = QString("%1[%2]%3").arg(static_cast<int>(node->kind()))
+                   .arg(node->length()).arg(node->isValid() ? "" : "!");
+
+    switch (node->kind()) {
+        case ParseNode::Kind::Root: {
+            ReprPrinter printer;
+            printer.startVisiting(node.get());
+            repr += printer.repr();
+            break;
+        }
+        case ParseNode::Kind::Macro: {
+            const auto &&segments =
+                qSharedPointerCast<MacroNode>(node)->segments();
+            for (const auto &segment: segments) {
+                repr += ' ' + describe(segment);
+            }
+            break;
+        }
+        default: {
+            repr += node->leftText().toString() + node->text()
+                    + node->rightText().toString();
+        }
+    }
+    return repr;
+}
+
+QStringList TestMcfunctionParser::describe(const FileNode *tree) {
+    QStringList lines;
+
+    for (int i = 0; i < tree->size(); ++i) {
+        lines << describe(tree->at(i));
+    }
+    return lines;
+}
+
+QStringList TestMcfunctionParser::describe(const Parser::Errors &errors) {
+    QStringList list;
+
+    for (const auto &error: errors) {
+        list << QString("%1+%2 %3").arg(error.pos).arg(error.length)
+            .arg(error.toLocalizedMessage());
+    }
+    return list;
+}
+
+QStringList TestMcfunctionParser::describe(const SourceMapper &srcMapper) {
+    QStringList list;
+
+    for (auto it = srcMapper.backslashMap.cbegin();
+         it != srcMapper.backslashMap.cend(); ++it) {
+        list << QString("backslash %1: %2 '%3'").arg(it.key())
+            .arg(it->pos).arg(it->trivia);
+    }
+    for (auto it = srcMapper.physicalPositions.cbegin();
+         it != srcMapper.physicalPositions.cend(); ++it) {
+        list << QString("physical %1: %2").arg(it.key()).arg(it.value());
+    }
+    for (auto it = srcMapper.logicalPositions.cbegin();
+         it != srcMapper.logicalPositions.cend(); ++it) {
+        list << QString("logical %1: %2").arg(it.key()).arg(it.value());
+    }
+    for (int i = 0; i < srcMapper.logicalLines.size(); ++i) {
+        list << QString("line %1: %2").arg(i)
+            .arg(srcMapper.logicalLines.at(i));
+    }
+    return list;
+}
+
+void TestMcfunctionParser::reparse_data() {
+    QTest::addColumn<QString>("before");
+    QTest::addColumn<int>("position");
+    QTest::addColumn<int>("removed");
+    QTest::addColumn<QString>("inserted");
+
+    const QString commands = "say hi\ntp @s ~ ~ ~\nsay bye";
+    QTest::newRow("insert into line") << commands
+                                      << commands.indexOf("~ ~ ~") + 2 << 0
+                                      << "1";
+    QTest::newRow("break line") << commands << commands.indexOf("tp") + 1
+                                << 1 << "q";
+    QTest::newRow("edit last line") << commands << commands.length() - 3
+                                    << 3 << "everyone";
+    QTest::newRow("append line") << commands << commands.length() << 0
+                                 << "\nsay more";
+    QTest::newRow("replace everything") << commands << 0
+                                        << commands.length()
+                                        << "tp @s ~ ~ foo\n";
+
+    const QString invalid = "say hi\nsya bye\ntp @s ~ ~ foo\nsay end";
+    QTest::newRow("fix line") << invalid << invalid.indexOf("sya") + 1 << 2
+                              << "ay";
+    QTest::newRow("edit between invalid lines")
+        << invalid << invalid.indexOf("hi") << 2 << "hello";
+    QTest::newRow("edit after invalid lines")
+        << invalid << invalid.indexOf("end") << 3 << "the end";
+
+    QTest::newRow("join lines") << commands << commands.indexOf('\n') << 1
+                                << "";
+    const int hiPos = commands.indexOf("hi");
+    QTest::newRow("join three lines")
+        << commands << hiPos << commands.indexOf("bye") - hiPos << "";
+    QTest::newRow("split line") << commands << commands.indexOf("hi") << 0
+                                << "\n";
+    QTest::newRow("insert lines") << commands << commands.indexOf("tp")
+                                  << 0 << "say a\nsya b\nsay c\n";
+    const int tpPos = commands.indexOf("tp");
+    QTest::newRow("remove line")
+        << commands << tpPos << commands.indexOf("say bye") - tpPos << "";
+    const QString blankLines = "say a\n\n\nsay b";
+    QTest::newRow("fill blank line") << blankLines << 7 << 0 << "say c";
+
+    const QString continued =
+        "say a\nexecute as @a \\\n    run tp @s ~ ~ ~\nsay b";
+    QTest::newRow("edit before continuation")
+        << continued << continued.indexOf("a\n") << 1 << "aa";
+    QTest::newRow("edit continued line")
+        << continued << continued.lastIndexOf("~") << 1 << "foo";
+    QTest::newRow("edit first part of continuation")
+        << continued << continued.indexOf("@a") << 2 << "@e[limit=1]";
+    QTest::newRow("edit after continuation")
+        << continued << continued.lastIndexOf('b') << 1 << "bb";
+    QTest::newRow("remove continuation")
+        << continued << continued.indexOf('\\') << 6 << "";
+    QTest::newRow("break continuation")
+        << continued << continued.indexOf('\\') << 1 << "";
+    QTest::newRow("add continuation")
+        << commands << commands.indexOf("~ ~ ~") << 0 << "\\\n  ";
+    QTest::newRow("continue continuation")
+        << continued << continued.indexOf("~ ~ ~") << 0 << "\\\n  ";
+    QTest::newRow("join line to continuation")
+        << continued << continued.lastIndexOf('\n') << 1 << "";
+
+    const QString comment = "# note \\\nsay hi\nsay bye";
+    QTest::newRow("end comment continuation")
+        << comment << comment.indexOf('\\') << 1 << "";
+    QTest::newRow("continue comment")
+        << commands << 0 << 0 << "# note \\\n";
+    QTest::newRow("edit continued comment")
+        << comment << comment.indexOf("hi") << 2 << "hello";
+
+    const QString macros = "$say $(msg)\n$tp @s $(x) ~ ~\nsay end";
+    QTest::newRow("edit macro variable")
+        << macros << macros.indexOf("msg") << 3 << "text";
+    QTest::newRow("invalid macro variable")
+        << macros << macros.indexOf("msg") + 1 << 0 << " ";
+    QTest::newRow("unterminated macro variable")
+        << macros << macros.indexOf(')') << 1 << "";
+    QTest::newRow("remove macro variable")
+        << macros << macros.indexOf("$(msg)") << 6 << "hi";
+    QTest::newRow("turn macro into command")
+        << macros << 0 << 1 << "";
+    QTest::newRow("turn command into macro")
+        << macros << macros.indexOf("say end") << 0 << "$";
+    const QString continuedMacro = "$say \\\n  $(msg)\nsay end";
+    QTest::newRow("edit continued macro")
+        << continuedMacro << continuedMacro.indexOf("msg") << 3 << "text";
+    QTest::newRow("remove macro continuation")
+        << continuedMacro << continuedMacro.indexOf('\\') << 4 << "";
+}
+
+void TestMcfunctionParser::reparse() {
+    QFETCH(QString, before);
+    QFETCH(int, position);
+    QFETCH(int, removed);
+    QFETCH(QString, inserted);
+
+    QString after = before;
+
+    after.replace(position, removed, inserted);
+
+    McfunctionParser incremental;
+    incremental.parse(before);
+    const bool ok = incremental.reparse(after, position, removed,
+                                        inserted.size());
+
+    McfunctionParser full;
+    QCOMPARE(ok, full.parse(after));
+    QCOMPARE(incremental.text(), after);
+    QCOMPARE(describe(incremental.syntaxTree().get()),
+             describe(full.syntaxTree().get()));
+    QCOMPARE(describe(incremental.errors()), describe(full.errors()));
+    QCOMPARE(describe(incremental.syntaxTree()->sourceMapper()),
+             describe(full.syntaxTree()->sourceMapper()));
+}
+
+void TestMcfunctionParser::reparse_keepsUnchangedLines() {
+    const QString before = "say a\ntp @s ~ ~ ~\nsay b";
+    QString       after  = before;
+
+    after.replace(before.indexOf("~ ~ ~"), 1, "~1");
+
+    McfunctionParser parser;
+    parser.parse(before);
+
+    const auto &&oldLines = parser.syntaxTree()->lines();
+    parser.reparse(after, before.indexOf("~ ~ ~"), 1, 2);
+
+    const auto &&newLines = parser.syntaxTree()->lines();
+    QCOMPARE(newLines.size(), oldLines.size());
+    QCOMPARE(newLines.at(0).get(), oldLines.at(0).get());
+    QVERIFY(newLines.at(1).get() != oldLines.at(1).get());
+    QCOMPARE(newLines.at(2).get(), oldLines.at(2).get());
+}
+
+QTEST_APPLESS_MAIN(TestMcfunctionParser)
+
+#include "tst_testmcfunctionparser.moc"
@@ -15,6 +15,7 @@ CONFIG(debug, debug|release) {
 #DEFINES += QT_ASCII_CAST_WARNINGS
 
 SOURCES +=  tst_testminecraftparser.cpp \
+    ../../../../../src/gamedatabundle.cpp \
     ../../../../../src/parsers/command/minecraftparser.cpp \
     ../../../../../src/parsers/command/nodes/argumentnode.cpp \
     ../../../../../src/parsers/command/nodes/axesnode.cpp \
@@ -43,6 +44,7 @@ SOURCES +=  tst_testminecraftparser.cpp \
     ../../../../../src/parsers/command/parsenodecache.cpp \
     ../../../../../src/parsers/command/schema/schemaloader.cpp \
     ../../../../../src/parsers/command/schemaparser.cpp \
+    ../../../../../src/parsers/command/schema/compiledschema.cpp \
     ../../../../../src/parsers/command/schema/schemaargumentnode.cpp \
     ../../../../../src/parsers/command/schema/schemaliteralnode.cpp \
     ../../../../../src/parsers/command/schema/schemanode.cpp \
@@ -54,6 +56,7 @@ SOURCES +=  tst_testminecraftparser.cpp \
     ../../../../../src/parsers/command/re2c_generated_functions.cpp
 
 HEADERS += \
+    ../../../../../src/gamedatabundle.h \
     ../../../../../src/parsers/command/minecraftparser.h \
     ../../../../../src/parsers/command/nodes/argumentnode.h \
     ../../../../../src/parsers/command/nodes/axesnode.h \
@@ -83,6 +86,7 @@ HEADERS += \
     ../../../../../src/parsers/command/parsenodecache.h \
     ../../../../../src/parsers/command/schema/schemaloader.h \
     ../../../../../src/parsers/command/schemaparser.h \
+    ../../../../../src/parsers/command/schema/compiledschema.h \
     ../../../../../src/parsers/command/schema/schemaargumentnode.h \
     ../../../../../src/parsers/command/schema/schemaliteralnode.h \
     ../../../../../src/parsers/command/schema/schemanode.h \
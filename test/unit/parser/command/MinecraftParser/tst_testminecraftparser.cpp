@@ -40,6 +40,10 @@ private slots:
     void benchmark();
     void benchmarkCommandBoxes_data();
     void benchmarkCommandBoxes();
+    void benchmarkSchemaDispatch_data();
+    void benchmarkSchemaDispatch();
+    void benchmarkIncompleteCommands_data();
+    void benchmarkIncompleteCommands();
 };
 
 TestMinecraftParser::TestMinecraftParser() {
@@ -594,6 +598,65 @@ void TestMinecraftParser::benchmarkCommandBoxes() {
     QVERIFY(result->isValid());
 }
 
+void TestMinecraftParser::benchmarkSchemaDispatch_data() {
+    QTest::addColumn<QString>("command");
+
+    /* Short commands spend most of the time in walking the schema graph. */
+    QTest::addRow("Literals only") << "gamerule doDaylightCycle false";
+    QTest::addRow("Short execute") << "execute as @a at @s run say hi";
+    QTest::addRow("Long execute") <<
+        "execute as @a at @s positioned ~ ~1 ~ if entity @s[tag=a] "
+        "unless entity @s[tag=b] align xyz anchored eyes facing ^ ^ ^1 "
+        "rotated ~ 0 in minecraft:overworld positioned as @s "
+        "if block ~ ~-1 ~ minecraft:stone run scoreboard players add @s obj 1";
+    QTest::addRow("Redirect chain") <<
+        "execute as @a as @s as @s as @s as @s as @s as @s as @s as @s "
+        "as @s as @s as @s as @s as @s as @s as @s run kill @s";
+}
+
+void TestMinecraftParser::benchmarkSchemaDispatch() {
+    QFETCH(QString, command);
+
+    MinecraftParser           parser(command);
+    QSharedPointer<ParseNode> result;
+    QBENCHMARK {
+        result = parser.parse();
+    }
+    Q_ASSERT(result);
+    for (const auto &error: qAsConst(parser.errors())) {
+        qDebug() << error.toLocalizedMessage();
+    }
+    QVERIFY(result->isValid());
+}
+
+void TestMinecraftParser::benchmarkIncompleteCommands_data() {
+    QTest::addColumn<QString>("command");
+
+    /* Half-typed commands, which fail and backtrack while being edited. */
+    QTest::addRow("Incomplete execute") << "execute as @a";
+    QTest::addRow("Incomplete selector") << "tp @e[type=zombie,tag=";
+    QTest::addRow("Incomplete compound tag") <<
+        "give @s minecraft:stone{display:{Name:'\"Stone\"'";
+    QTest::addRow("Incomplete list tag") << "data merge entity @s {Tags:[\"a\",";
+    QTest::addRow("Incomplete coordinates") << "summon zombie ~ ~";
+    QTest::addRow("Invalid numeric tag") << "data merge entity @s {Age:1.2.3}";
+}
+
+void TestMinecraftParser::benchmarkIncompleteCommands() {
+    QFETCH(QString, command);
+
+    MinecraftParser           parser(command);
+    QSharedPointer<ParseNode> result;
+    QBENCHMARK {
+        result = parser.parse();
+    }
+    QVERIFY(result);
+    QVERIFY(!parser.errors().isEmpty());
+    for (const auto &error: qAsConst(parser.errors())) {
+        qDebug() << error.toLocalizedMessage();
+    }
+}
+
 QTEST_MAIN(TestMinecraftParser)
 
 #include "tst_testminecraftparser.moc"
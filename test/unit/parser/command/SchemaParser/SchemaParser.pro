@@ -16,6 +16,7 @@ SOURCES +=  tst_testschemaparser.cpp \
     ../../../../../src/parsers/command/parsenodecache.cpp \
     ../../../../../src/parsers/command/schema/schemaloader.cpp \
     ../../../../../src/parsers/command/schemaparser.cpp \
+    ../../../../../src/parsers/command/schema/compiledschema.cpp \
     ../../../../../src/parsers/command/schema/schemaargumentnode.cpp \
     ../../../../../src/parsers/command/schema/schemaliteralnode.cpp \
     ../../../../../src/parsers/command/schema/schemanode.cpp \
@@ -33,6 +34,7 @@ HEADERS += \
     ../../../../../src/parsers/command/parsenodecache.h \
     ../../../../../src/parsers/command/schema/schemaloader.h \
     ../../../../../src/parsers/command/schemaparser.h \
+    ../../../../../src/parsers/command/schema/compiledschema.h \
     ../../../../../src/parsers/command/schema/schemaargumentnode.h \
     ../../../../../src/parsers/command/schema/schemaliteralnode.h \
     ../../../../../src/parsers/command/schema/schemanode.h \
@@ -0,0 +1,194 @@
+#include <QtTest>
+
+#include "../../../../../src/parsers/command/minecraftparser.h"
+#include "../../../../../src/parsers/command/visitors/semanticvalidator.h"
+#include "../../../../../src/datapackindex.h"
+
+using namespace Command;
+
+class TestSemanticValidator : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestSemanticValidator();
+    ~TestSemanticValidator();
+
+private:
+    QTemporaryDir m_dir;
+    QString m_oldCurrentPath;
+
+    void writeFile(const QString &relPath, const QString &text) const;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void idSet_sorted();
+    void idSet_containsPrefix_data();
+    void idSet_containsPrefix();
+    void idSet_empty();
+    void problems_data();
+    void problems();
+};
+
+TestSemanticValidator::TestSemanticValidator() {
+}
+
+TestSemanticValidator::~TestSemanticValidator() {
+}
+
+void TestSemanticValidator::writeFile(const QString &relPath,
+                                      const QString &text) const {
+    const QString &&path = m_dir.filePath(relPath);
+
+    QDir().mkpath(QFileInfo(path).path());
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(text.toUtf8());
+}
+
+void TestSemanticValidator::initTestCase() {
+    MinecraftParser::setGameVer(QVersionNumber(1, 20, 4));
+    QVERIFY(m_dir.isValid());
+
+    writeFile("pack.mcmeta",
+              R"({"pack": {"pack_format": 26, "description": ""}})");
+    writeFile("data/test/functions/exists.mcfunction", "say exists\n");
+    writeFile("data/test/tags/functions/load.json",
+              R"({"values": ["test:exists"]})");
+    writeFile("data/minecraft/functions/foo.mcfunction", "say foo\n");
+
+    // The datapack IDs are only checked for the current datapack
+    m_oldCurrentPath = QDir::currentPath();
+    QVERIFY(QDir::setCurrent(m_dir.path()));
+    DatapackIndex::instance()->load(QDir::currentPath());
+}
+
+void TestSemanticValidator::cleanupTestCase() {
+    DatapackIndex::instance()->clear();
+    QDir::setCurrent(m_oldCurrentPath);
+}
+
+void TestSemanticValidator::idSet_sorted() {
+    const IdSet ids({ "b:b", "a:c", "a:a", "b:b", "a:c" });
+
+    QCOMPARE(ids.size(), 3);
+    QVERIFY(ids.contains(u"a:a"));
+    QVERIFY(ids.contains(u"a:c"));
+    QVERIFY(ids.contains(u"b:b"));
+    QVERIFY(!ids.contains(u"a:b"));
+    QVERIFY(!ids.contains(u"a:"));
+    QVERIFY(!ids.contains(u"c:c"));
+
+    // The IDs can be looked up by views into a longer text
+    const QString command = "give @s a:c 1";
+    QVERIFY(ids.contains(QStringView(command).mid(8, 3)));
+    QVERIFY(!ids.contains(QStringView(command).mid(8, 5)));
+}
+
+void TestSemanticValidator::idSet_containsPrefix_data() {
+    QTest::addColumn<QString>("prefix");
+    QTest::addColumn<bool>("expected");
+
+    QTest::newRow("Namespace") << "test:" << true;
+    QTest::newRow("Part of namespace") << "tes" << true;
+    QTest::newRow("Whole ID") << "test:foo/bar" << true;
+    QTest::newRow("Last namespace") << "zzz:" << true;
+    QTest::newRow("Empty") << "" << true;
+    QTest::newRow("Other namespace") << "other:" << false;
+    QTest::newRow("Longer than ID") << "test:foo/bar/baz" << false;
+    QTest::newRow("After last ID") << "zzz:zz" << false;
+}
+
+void TestSemanticValidator::idSet_containsPrefix() {
+    QFETCH(QString, prefix);
+    QFETCH(bool, expected);
+
+    const IdSet ids({ "zzz:z", "test:foo/bar", "minecraft:stone",
+                      "test:baz" });
+
+    QCOMPARE(ids.containsPrefix(prefix), expected);
+}
+
+void TestSemanticValidator::idSet_empty() {
+    const IdSet defaultSet;
+
+    QVERIFY(defaultSet.isEmpty());
+    QCOMPARE(defaultSet.size(), 0);
+    QVERIFY(!defaultSet.contains(u""));
+    QVERIFY(!defaultSet.containsPrefix(u""));
+
+    const IdSet emptySet(QVector<QString>{});
+    QVERIFY(emptySet.isEmpty());
+    QVERIFY(!emptySet.contains(u"minecraft:stone"));
+}
+
+void TestSemanticValidator::problems_data() {
+    QTest::addColumn<QString>("command");
+    QTest::addColumn<QStringList>("expected");
+
+    QTest::newRow("Item") << "give @s minecraft:diamond" << QStringList();
+    QTest::newRow("Block item") << "give @s stone" << QStringList();
+    QTest::newRow("Unknown item")
+        << "give @s minecraft:stonee"
+        << QStringList{ "8+16 Unknown item: minecraft:stonee" };
+    QTest::newRow("Unknown item without namespace")
+        << "give @s stonee" << QStringList{ "8+6 Unknown item: stonee" };
+    QTest::newRow("Non-vanilla item") << "give @s test:thing"
+                                      << QStringList();
+    QTest::newRow("Block") << "setblock ~ ~ ~ dirt" << QStringList();
+    QTest::newRow("Unknown block")
+        << "setblock ~ ~ ~ minecraft:dirtt"
+        << QStringList{ "15+15 Unknown block: minecraft:dirtt" };
+    QTest::newRow("Unknown dimension")
+        << "execute in overworldd run say hi"
+        << QStringList{ "11+10 Unknown dimension: overworldd" };
+    QTest::newRow("Non-vanilla dimension") << "execute in test:dim run say hi"
+                                           << QStringList();
+
+    QTest::newRow("Function") << "function test:exists" << QStringList();
+    QTest::newRow("Unknown function")
+        << "function test:missing"
+        << QStringList{ "9+12 Unknown function: test:missing" };
+    QTest::newRow("Function of other datapack")
+        << "function other:missing" << QStringList();
+    QTest::newRow("Function without namespace") << "function foo"
+                                                << QStringList();
+    QTest::newRow("Unknown function without namespace")
+        << "function bar" << QStringList{ "9+3 Unknown function: bar" };
+    QTest::newRow("Function tag") << "function #test:load" << QStringList();
+    QTest::newRow("Unknown function tag")
+        << "function #test:missing"
+        << QStringList{ "9+13 Unknown function tag: #test:missing" };
+    QTest::newRow("Multiple problems")
+        << "execute in overworldd run give @s stonee"
+        << QStringList{ "11+10 Unknown dimension: overworldd",
+                        "34+6 Unknown item: stonee" };
+}
+
+void TestSemanticValidator::problems() {
+    QFETCH(QString, command);
+    QFETCH(QStringList, expected);
+
+    MinecraftParser parser;
+    parser.setText(command);
+    const auto result = parser.parse();
+    QVERIFY(result->isValid());
+
+    SemanticValidator validator;
+    validator.startVisiting(result.get());
+
+    QStringList problems;
+    for (const auto &problem: validator.problems()) {
+        problems << QString("%1+%2 %3").arg(problem.pos).arg(problem.length)
+            .arg(problem.localizedDescription());
+    }
+    QCOMPARE(problems, expected);
+
+    validator.reset();
+    QVERIFY(validator.problems().isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestSemanticValidator)
+
+#include "tst_testsemanticvalidator.moc"
@@ -0,0 +1,229 @@
+"""Flattens the game data of each version into a binary bundle.
+
+Usage: build_game_bundle.py <info dir> <output dir>
+
+For each version directory in the info directory, the info maps (with their
+"base"/"removed"/"added" inheritance resolved), the registries and the command
+schema are written into "<version>.bundle" in the output directory, which is
+read by GameDataBundle in the application. A "gamebundles.qrc" file embedding
+all bundles is also generated. Bundles are only rewritten if their content
+changes. The qrc file is always rewritten, since the build uses it to know
+that the bundles are up to date.
+
+Bundle layout (all integers are little-endian):
+    header:  b"MCGB", u32 format version, u32 entry count
+    entries: u32 name offset, u32 name size, u32 kind, u32 data offset,
+             u32 data size; sorted by the UTF-8 name
+    data:    entry names and payloads
+
+Payload kinds:
+    0 (info):     an encoded value (see encode_value())
+    1 (registry): u32 count, then (u32 size, UTF-8 bytes) for each ID
+    2 (schema):   the command schema in MessagePack
+"""
+
+from pathlib import Path
+import json
+import struct
+import sys
+
+DEFAULT_VERSION = "1.20.4"
+MINIMUM_VERSION = "1.15"
+
+MAGIC = b"MCGB"
+FORMAT_VERSION = 1
+
+KIND_INFO = 0
+KIND_REGISTRY = 1
+KIND_SCHEMA = 2
+
+TAG_NULL = 0
+TAG_FALSE = 1
+TAG_TRUE = 2
+TAG_DOUBLE = 3
+TAG_STRING = 4
+TAG_ARRAY = 5
+TAG_OBJECT = 6
+
+
+def find_info_file(info_dir: Path, info_type: str, version: str):
+    # Same fallbacks as Game::loadInfo()
+    for ver in (version, DEFAULT_VERSION, MINIMUM_VERSION):
+        filepath = info_dir / ver / (info_type + ".json")
+        if filepath.is_file():
+            return filepath
+    return None
+
+
+def load_info(info_dir: Path, info_type: str, version: str) -> dict:
+    filepath = find_info_file(info_dir, info_type, version)
+    if filepath is None:
+        return {}
+    with open(filepath, encoding="utf-8") as f:
+        root = json.load(f)
+    if not isinstance(root, dict) or not root:
+        return {}
+
+    ret = {}
+    if "base" in root:
+        ret.update(load_info(info_dir, info_type, root.pop("base")))
+    if "removed" in root:
+        for key in root.pop("removed"):
+            ret.pop(key, None)
+    if "added" in root:
+        ret.update(root["added"])
+    else:
+        ret.update(root)
+    return ret
+
+
+def encode_string(s: str) -> bytes:
+    data = s.encode("utf-8")
+    return struct.pack("<I", len(data)) + data
+
+
+def encode_value(value) -> bytes:
+    if value is None:
+        return bytes([TAG_NULL])
+    if value is True:
+        return bytes([TAG_TRUE])
+    if value is False:
+        return bytes([TAG_FALSE])
+    if isinstance(value, (int, float)):
+        # QJsonValue::toVariant() converts all numbers to double in Qt 5
+        return bytes([TAG_DOUBLE]) + struct.pack("<d", float(value))
+    if isinstance(value, str):
+        return bytes([TAG_STRING]) + encode_string(value)
+    if isinstance(value, list):
+        return (bytes([TAG_ARRAY]) + struct.pack("<I", len(value))
+                + b"".join(encode_value(item) for item in value))
+    if isinstance(value, dict):
+        return (bytes([TAG_OBJECT]) + struct.pack("<I", len(value))
+                + b"".join(encode_string(key) + encode_value(item)
+                           for key, item in value.items()))
+    raise TypeError(f"Unsupported value: {value!r}")
+
+
+def encode_registry(ids: list) -> bytes:
+    return struct.pack("<I", len(ids)) + b"".join(
+        encode_string(str(id_)) for id_ in ids)
+
+
+def encode_msgpack(value) -> bytes:
+    if value is None:
+        return b"\xc0"
+    if value is True:
+        return b"\xc3"
+    if value is False:
+        return b"\xc2"
+    if isinstance(value, int):
+        if 0 <= value < 0x80:
+            return struct.pack("B", value)
+        if -32 <= value < 0:
+            return struct.pack("b", value)
+        if -(1 << 63) <= value < (1 << 63):
+            return b"\xd3" + struct.pack(">q", value)
+        return b"\xcf" + struct.pack(">Q", value)
+    if isinstance(value, float):
+        return b"\xcb" + struct.pack(">d", value)
+    if isinstance(value, str):
+        data = value.encode("utf-8")
+        if len(data) < 32:
+            return struct.pack("B", 0xa0 | len(data)) + data
+        return b"\xdb" + struct.pack(">I", len(data)) + data
+    if isinstance(value, list):
+        if len(value) < 16:
+            head = struct.pack("B", 0x90 | len(value))
+        else:
+            head = b"\xdd" + struct.pack(">I", len(value))
+        return head + b"".join(encode_msgpack(item) for item in value)
+    if isinstance(value, dict):
+        if len(value) < 16:
+            head = struct.pack("B", 0x80 | len(value))
+        else:
+            head = b"\xdf" + struct.pack(">I", len(value))
+        return head + b"".join(encode_msgpack(key) + encode_msgpack(item)
+                               for key, item in value.items())
+    raise TypeError(f"Unsupported value: {value!r}")
+
+
+def collect_entries(info_dir: Path, version: str) -> dict:
+    version_dir = info_dir / version
+    entries = {}
+
+    for filepath in sorted(version_dir.rglob("*.json")):
+        rel_path = filepath.relative_to(version_dir)
+        if rel_path.parts[0] in ("registries", "summary"):
+            continue
+        info_type = rel_path.with_suffix("").as_posix()
+        entries["info/" + info_type] = (
+            KIND_INFO, encode_value(load_info(info_dir, info_type, version)))
+
+    registries_dir = version_dir / "registries"
+    for filepath in sorted(registries_dir.rglob("data.min.json")):
+        registry = filepath.parent.relative_to(registries_dir).as_posix()
+        with open(filepath, encoding="utf-8") as f:
+            ids = json.load(f)
+        if isinstance(ids, list):
+            entries["registry/" + registry] = (KIND_REGISTRY,
+                                               encode_registry(ids))
+
+    schema_path = version_dir / "summary" / "commands" / "data.min.json"
+    if schema_path.is_file():
+        with open(schema_path, encoding="utf-8") as f:
+            entries["schema/commands"] = (KIND_SCHEMA,
+                                          encode_msgpack(json.load(f)))
+    return entries
+
+
+def build_bundle(entries: dict) -> bytes:
+    names = sorted(entries, key=lambda name: name.encode("utf-8"))
+    header_size = 12 + 20 * len(names)
+    table = b""
+    data = b""
+
+    for name in names:
+        kind, payload = entries[name]
+        name_bytes = name.encode("utf-8")
+        name_offset = header_size + len(data)
+        data += name_bytes
+        data += b"\0" * (-len(data) % 4)
+        payload_offset = header_size + len(data)
+        data += payload
+        data += b"\0" * (-len(data) % 4)
+        table += struct.pack("<5I", name_offset, len(name_bytes), kind,
+                             payload_offset, len(payload))
+
+    return (MAGIC + struct.pack("<II", FORMAT_VERSION, len(names))
+            + table + data)
+
+
+def write_if_changed(filepath: Path, data: bytes):
+    if filepath.is_file() and filepath.read_bytes() == data:
+        return
+    filepath.write_bytes(data)
+
+
+def main(info_dir: Path, output_dir: Path):
+    output_dir.mkdir(parents=True, exist_ok=True)
+    versions = sorted(child.name for child in info_dir.iterdir()
+                      if (child / (child.name + ".qrc")).is_file())
+
+    qrc = "<RCC>\n"
+    for version in versions:
+        bundle_name = version + ".bundle"
+        write_if_changed(output_dir / bundle_name,
+                         build_bundle(collect_entries(info_dir, version)))
+        qrc += (f'    <qresource prefix="/minecraft/{version}">\n'
+                f'        <file alias="game.bundle" '
+                f'compression-algorithm="none">{bundle_name}</file>\n'
+                f'    </qresource>\n')
+    qrc += "</RCC>\n"
+    (output_dir / "gamebundles.qrc").write_bytes(qrc.encode("utf-8"))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print(__doc__)
+        sys.exit(1)
+    main(Path(sys.argv[1]), Path(sys.argv[2]))
@@ -0,0 +1,274 @@
+"""Packs the item, block and inventory icons into a prebuilt texture atlas.
+
+Usage: build_texture_atlas.py <info dir> <texture dir> <output dir>
+
+Every icon that InventoryItem can show is decoded, scaled to fit a 32x32 cell
+(keeping its aspect ratio, with nearest-neighbor sampling, like
+QPixmap::scaled() with Qt::FastTransformation) and centered, then all cells
+are written into "atlas.png" in the output directory. The textures don't
+depend on the game version, but which texture an ID uses does (an ID is an
+item in one version and a block in another), so the ID to cell index is
+written per version into "<version>.atlas". A "textureatlas.qrc" file
+embedding all of them is also generated. The atlas and the indexes are only
+rewritten if their content changes. The qrc file is always rewritten, since
+the build uses it to know that the atlas is up to date.
+
+Index layout (all integers are little-endian):
+    header:  b"MCTA", u32 format version, u32 cell size, u32 column count,
+             u32 entry count
+    entries: u32 cell index, u32 name size, UTF-8 name (without the
+             "minecraft:" namespace); sorted by the name
+
+The cell with the index i is at (i % columns, i // columns) * cell size.
+Only the PNG features used by the bundled textures are supported:
+non-interlaced images with a bit depth of at most 8.
+"""
+
+from pathlib import Path
+import struct
+import sys
+import zlib
+
+from build_game_bundle import load_info, write_if_changed
+
+MAGIC = b"MCTA"
+FORMAT_VERSION = 1
+CELL_SIZE = 32
+
+PNG_SIGNATURE = b"\x89PNG\r\n\x1a\n"
+CHANNELS = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}
+
+
+def unfilter(raw: bytes, width: int, height: int, bpp: int,
+             row_size: int) -> list:
+    rows = []
+    prev = bytearray(row_size)
+    pos = 0
+    for _ in range(height):
+        kind = raw[pos]
+        row = bytearray(raw[pos + 1:pos + 1 + row_size])
+        pos += 1 + row_size
+        if kind == 1:
+            for i in range(bpp, row_size):
+                row[i] = (row[i] + row[i - bpp]) & 0xFF
+        elif kind == 2:
+            for i in range(row_size):
+                row[i] = (row[i] + prev[i]) & 0xFF
+        elif kind == 3:
+            for i in range(row_size):
+                left = row[i - bpp] if i >= bpp else 0
+                row[i] = (row[i] + ((left + prev[i]) >> 1)) & 0xFF
+        elif kind == 4:
+            for i in range(row_size):
+                a = row[i - bpp] if i >= bpp else 0
+                b = prev[i]
+                c = prev[i - bpp] if i >= bpp else 0
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                if pa <= pb and pa <= pc:
+                    pred = a
+                elif pb <= pc:
+                    pred = b
+                else:
+                    pred = c
+                row[i] = (row[i] + pred) & 0xFF
+        elif kind != 0:
+            raise ValueError(f"Unknown PNG filter type: {kind}")
+        rows.append(row)
+        prev = row
+    return rows
+
+
+def unpack_samples(row: bytes, count: int, depth: int) -> list:
+    if depth == 8:
+        return list(row[:count])
+    per_byte = 8 // depth
+    mask = (1 << depth) - 1
+    samples = []
+    for i in range(count):
+        shift = 8 - depth * (i % per_byte + 1)
+        samples.append((row[i // per_byte] >> shift) & mask)
+    return samples
+
+
+def read_png(filepath: Path):
+    """Returns the width, height and RGBA pixels (a list of rows of 4-tuples)
+    of the PNG file."""
+    data = filepath.read_bytes()
+    if not data.startswith(PNG_SIGNATURE):
+        raise ValueError(f"{filepath} isn't a PNG file")
+
+    pos = len(PNG_SIGNATURE)
+    idat = b""
+    palette = []
+    trns = b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            (width, height, depth, color_type,
+             _, _, interlace) = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, length, 3)]
+        elif kind == b"tRNS":
+            trns = chunk
+        elif kind == b"IDAT":
+            idat += chunk
+        elif kind == b"IEND":
+            break
+
+    if interlace != 0 or depth > 8:
+        raise ValueError(f"{filepath}: unsupported PNG format")
+
+    channels = CHANNELS[color_type]
+    row_size = (width * channels * depth + 7) // 8
+    bpp = max(1, channels * depth // 8)
+    rows = unfilter(zlib.decompress(idat), width, height, bpp, row_size)
+    max_value = (1 << depth) - 1
+
+    pixels = []
+    for row in rows:
+        samples = unpack_samples(row, width * channels, depth)
+        out = []
+        for x in range(width):
+            s = samples[x * channels:(x + 1) * channels]
+            if color_type == 3:
+                rgb = palette[s[0]]
+                alpha = trns[s[0]] if s[0] < len(trns) else 255
+                out.append((*rgb, alpha))
+            elif color_type in (0, 4):
+                gray = s[0] * 255 // max_value
+                if color_type == 4:
+                    alpha = s[1]
+                elif trns and s[0] == struct.unpack(">H", trns[:2])[0]:
+                    alpha = 0
+                else:
+                    alpha = 255
+                out.append((gray, gray, gray, alpha))
+            else:
+                alpha = s[3] if color_type == 6 else 255
+                if (color_type == 2 and trns
+                        and tuple(s) == struct.unpack(">3H", trns[:6])):
+                    alpha = 0
+                out.append((s[0], s[1], s[2], alpha))
+        pixels.append(out)
+    return width, height, pixels
+
+
+def write_png(width: int, height: int, rows: list) -> bytes:
+    def chunk(kind: bytes, payload: bytes) -> bytes:
+        return (struct.pack(">I", len(payload)) + kind + payload
+                + struct.pack(">I", zlib.crc32(kind + payload) & 0xFFFFFFFF))
+
+    raw = b"".join(b"\0" + bytes(row) for row in rows)
+    return (PNG_SIGNATURE
+            + chunk(b"IHDR", struct.pack(">IIBBBBB", width, height,
+                                         8, 6, 0, 0, 0))
+            + chunk(b"IDAT", zlib.compress(raw, 9))
+            + chunk(b"IEND", b""))
+
+
+def fit_to_cell(width: int, height: int, pixels: list) -> list:
+    """Scales the image to fit a cell like InventoryItem::loadPixmap() does,
+    and returns the rows of the cell as RGBA bytes."""
+    # Same rounding as QSize::scaled() with Qt::KeepAspectRatio
+    scaled_w, scaled_h = CELL_SIZE * width // height, CELL_SIZE
+    if scaled_w > CELL_SIZE:
+        scaled_w, scaled_h = CELL_SIZE, CELL_SIZE * height // width
+    scaled_w, scaled_h = max(1, scaled_w), max(1, scaled_h)
+    left = (CELL_SIZE - scaled_w) // 2
+    top = (CELL_SIZE - scaled_h) // 2
+
+    cell = [bytearray(CELL_SIZE * 4) for _ in range(CELL_SIZE)]
+    for y in range(scaled_h):
+        src_row = pixels[y * height // scaled_h]
+        dst_row = cell[top + y]
+        for x in range(scaled_w):
+            pos = (left + x) * 4
+            dst_row[pos:pos + 4] = bytes(src_row[x * width // scaled_w])
+    return cell
+
+
+def resolve_texture(texture_dir: Path, id_: str, items: dict):
+    # Same lookup as InventoryItem::loadPixmap()
+    if id_.endswith("banner_pattern"):
+        candidates = ["item/banner_pattern.png"]
+    elif id_ in items:
+        candidates = [f"item/{id_}.png"]
+    else:
+        candidates = [f"inv_item/{id_}.png"]
+    candidates.append(f"block/{id_}.png")
+
+    for candidate in candidates:
+        if (texture_dir / candidate).is_file():
+            return candidate
+    return None
+
+
+def build_index(cells: dict, columns: int, textures: dict) -> bytes:
+    names = sorted(textures, key=lambda name: name.encode("utf-8"))
+    data = MAGIC + struct.pack("<4I", FORMAT_VERSION, CELL_SIZE, columns,
+                               len(names))
+    for name in names:
+        name_bytes = name.encode("utf-8")
+        data += struct.pack("<II", cells[textures[name]], len(name_bytes))
+        data += name_bytes
+    return data
+
+
+def main(info_dir: Path, texture_dir: Path, output_dir: Path):
+    output_dir.mkdir(parents=True, exist_ok=True)
+    versions = sorted(child.name for child in info_dir.iterdir()
+                      if (child / (child.name + ".qrc")).is_file())
+
+    # The texture of each ID in each version
+    version_textures = {}
+    for version in versions:
+        items = load_info(info_dir, "item", version)
+        blocks = load_info(info_dir, "block", version)
+        textures = {}
+        for id_ in list(items) + list(blocks):
+            texture = resolve_texture(texture_dir, id_, items)
+            if texture is not None:
+                textures[id_] = texture
+        version_textures[version] = textures
+
+    paths = sorted({path for textures in version_textures.values()
+                    for path in textures.values()})
+    cells = {path: index for index, path in enumerate(paths)}
+    columns = max(1, int(len(paths) ** 0.5 + 0.999))
+    rows = max(1, (len(paths) + columns - 1) // columns)
+
+    atlas = [bytearray(columns * CELL_SIZE * 4)
+             for _ in range(rows * CELL_SIZE)]
+    for path, index in cells.items():
+        cell = fit_to_cell(*read_png(texture_dir / path))
+        left = (index % columns) * CELL_SIZE * 4
+        top = (index // columns) * CELL_SIZE
+        for y, cell_row in enumerate(cell):
+            atlas[top + y][left:left + CELL_SIZE * 4] = cell_row
+    write_if_changed(output_dir / "atlas.png",
+                     write_png(columns * CELL_SIZE, rows * CELL_SIZE, atlas))
+
+    qrc = ("<RCC>\n"
+           '    <qresource prefix="/minecraft/texture">\n'
+           '        <file compression-algorithm="none">atlas.png</file>\n'
+           "    </qresource>\n")
+    for version in versions:
+        index_name = version + ".atlas"
+        write_if_changed(output_dir / index_name,
+                         build_index(cells, columns,
+                                     version_textures[version]))
+        qrc += (f'    <qresource prefix="/minecraft/{version}">\n'
+                f'        <file alias="texture.atlas">{index_name}</file>\n'
+                f'    </qresource>\n')
+    qrc += "</RCC>\n"
+    (output_dir / "textureatlas.qrc").write_bytes(qrc.encode("utf-8"))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 4:
+        print(__doc__)
+        sys.exit(1)
+    main(Path(sys.argv[1]), Path(sys.argv[2]), Path(sys.argv[3]))